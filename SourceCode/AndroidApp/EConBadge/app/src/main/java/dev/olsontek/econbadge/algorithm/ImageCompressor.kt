@@ -0,0 +1,101 @@
+package dev.olsontek.econbadge.algorithm
+
+import java.io.ByteArrayOutputStream
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+/***************************************************************************************************
+ * CONSTANTS
+ **************************************************************************************************/
+/* Compressed image magic, the first byte can never appear in a raw 4bpp image */
+private val COMPRESSED_MAGIC = byteArrayOf(0xEC.toByte(), 0xB1.toByte(), 'R'.code.toByte(), 'L'.code.toByte())
+
+/* Compressed image header size: magic, raw size, data size */
+private const val HEADER_SIZE = 12
+
+/* Maximal number of bytes in a literal token */
+private const val MAX_LITERAL = 128
+
+/* Maximal number of bytes in a repeat token */
+private const val MAX_REPEAT = 32768
+
+/* Minimal run length encoded as a repeat token */
+private const val MIN_REPEAT = 3
+
+/***************************************************************************************************
+ * MAIN CLASS
+ **************************************************************************************************/
+class ImageCompressor {
+
+    /***********************************************************************************************
+     * PUBLIC TYPES AND ENUMERATIONS
+     **********************************************************************************************/
+    companion object {
+        /* Encodes a raw 4bpp image in the badge compressed format (see ImageCodec.h) */
+        fun compress(rawData: ByteArray): ByteArray {
+            val stream = ByteArrayOutputStream(rawData.size / 4)
+            var literalStart = 0
+            var i = 0
+
+            while (i < rawData.size) {
+                var runLength = 1
+                while (i + runLength < rawData.size &&
+                       runLength < MAX_REPEAT &&
+                       rawData[i + runLength] == rawData[i]) {
+                    ++runLength
+                }
+
+                if (runLength >= MIN_REPEAT) {
+                    flushLiteral(stream, rawData, literalStart, i)
+                    stream.write(0x80 or ((runLength - 1) shr 8))
+                    stream.write((runLength - 1) and 0xFF)
+                    stream.write(rawData[i].toInt())
+                    i += runLength
+                    literalStart = i
+                }
+                else {
+                    ++i
+                }
+            }
+            flushLiteral(stream, rawData, literalStart, i)
+
+            val data = stream.toByteArray()
+            val header = ByteBuffer.allocate(HEADER_SIZE).order(ByteOrder.LITTLE_ENDIAN)
+            header.put(COMPRESSED_MAGIC)
+            header.putInt(rawData.size)
+            header.putInt(data.size)
+
+            return header.array() + data
+        }
+
+        private fun flushLiteral(stream: ByteArrayOutputStream, rawData: ByteArray, start: Int, end: Int) {
+            var offset = start
+            while (offset < end) {
+                val size = minOf(end - offset, MAX_LITERAL)
+                stream.write(size - 1)
+                stream.write(rawData, offset, size)
+                offset += size
+            }
+        }
+    }
+
+    /***********************************************************************************************
+     * PRIVATE TYPES AND ENUMERATIONS
+     **********************************************************************************************/
+    /* None */
+
+    /***********************************************************************************************
+     * PRIVATE ATTRIBUTES
+     **********************************************************************************************/
+    /* None */
+
+    /***********************************************************************************************
+     * PRIVATE METHODS
+     **********************************************************************************************/
+    /* None */
+
+    /***********************************************************************************************
+     * PUBLIC METHODS
+     **********************************************************************************************/
+    /* None */
+}
@@ -3,11 +3,13 @@ package dev.olsontek.econbadge.connectivity
 import android.content.Context
 import android.util.Log
 import dev.olsontek.econbadge.R
+import dev.olsontek.econbadge.algorithm.ImageCompressor
 import dev.olsontek.econbadge.data.EInkImage
 import kotlinx.coroutines.launch
 import kotlinx.coroutines.runBlocking
 import kotlinx.coroutines.sync.Semaphore
 import java.nio.ByteBuffer
+import java.nio.ByteOrder
 
 /***************************************************************************************************
  * CONSTANTS
@@ -21,6 +23,12 @@ private const val UPDATE_TIMEOUT_MS = 500000
 /* General command timeout in milliseconds */
 private const val COMMAND_TIMEOUT_MS = 5000
 
+/* Size of the link information sent by the badge */
+private const val LINK_INFO_SIZE = 22
+
+/* Offset of the data segment size in the link information */
+private const val LINK_INFO_SEGMENT_SIZE_OFFSET = 2
+
 /***************************************************************************************************
  * MAIN CLASS
  **************************************************************************************************/
@@ -140,7 +148,16 @@ class CommandManager(private val bleManager: ECBBluetoothManager, private val co
         CMD_LEDBORDER_CLEAR_ANIMATIONS(28),
         CMD_LEDBORDER_GET_ANIMATIONS(29),
 
-        MAX_COMMAND_TYPE(30);
+        CMD_GET_LINK_INFO(30),
+        CMD_RESUME_TRANSFER(31),
+
+        CMD_BATCH(32),
+        CMD_GET_PIPELINE_INFO(33),
+        CMD_GET_BLE_STATS(34),
+        CMD_SET_LINK_COMPRESSION(35),
+        CMD_EINK_GET_IMAGE_PAGE(36),
+
+        MAX_COMMAND_TYPE(37);
     }
 
     /***********************************************************************************************
@@ -381,6 +398,27 @@ class CommandManager(private val bleManager: ECBBluetoothManager, private val co
         }
     }
 
+    fun getLinkInfo(callback: (CommandStatus) -> Unit) {
+        baseSendCommand(
+            CommandType.CMD_GET_LINK_INFO,
+            ByteArray(0)
+        ) { commandStatus: CommandStatus, response: ByteArray?, _: Int ->
+            if (commandStatus == CommandStatus.SUCCESS && response!!.size < LINK_INFO_SIZE) {
+                callback(CommandStatus.COMM_ERROR)
+            } else {
+                if (commandStatus == CommandStatus.SUCCESS) {
+                    /* Chunk the data writes by the segment size granted to the badge */
+                    val segmentSize = ByteBuffer.wrap(response!!)
+                        .order(ByteOrder.LITTLE_ENDIAN)
+                        .getShort(LINK_INFO_SEGMENT_SIZE_OFFSET)
+                        .toInt() and 0xFFFF
+                    bleManager.setDataSegmentSize(segmentSize)
+                }
+                callback(commandStatus)
+            }
+        }
+    }
+
     fun getSoftwareVersion(callback: (CommandStatus, String) -> Unit) {
         Log.d(MODULE_NAME, "Getting software version")
         bleManager.readSoftwareVersion(
@@ -926,8 +964,9 @@ class CommandManager(private val bleManager: ECBBluetoothManager, private val co
                     UPDATE_TIMEOUT_MS
                 )
 
+                /* Images are sent compressed, the badge stores them as is */
                 bleManager.sendData(
-                    imageData,
+                    ImageCompressor.compress(imageData),
                     progressCallback = null,
                     sendDataEndCallback = { status: ECBBluetoothManager.ECBBleError ->
                         Log.d(MODULE_NAME, "Sending image: $status.")
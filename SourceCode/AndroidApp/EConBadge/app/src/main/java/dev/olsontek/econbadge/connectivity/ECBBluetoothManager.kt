@@ -54,6 +54,12 @@ private const val HW_VERSION_READ_ID = Long.MAX_VALUE - 1
 /* Requested MTU for the BLE communication */
 private const val GATT_MAX_MTU_SIZE = 517
 
+/* Size of the ATT write header in bytes */
+private const val GATT_ATT_HEADER_SIZE = 3
+
+/* Data segment size before the MTU exchange, default ATT MTU minus the header */
+private const val DEFAULT_DATA_SEGMENT_SIZE = 23 - GATT_ATT_HEADER_SIZE
+
 /* Time in milliseconds before the BLE scan should timeout */
 private const val BLE_SCAN_DURATION = 15000L
 
@@ -258,6 +264,10 @@ class ECBBluetoothManager private constructor(context: Context, handler: EventCa
     /* Connection state */
     private var wasConnected = false
 
+    /* Size of the data writes, granted by the MTU exchange and reported by the badge */
+    @Volatile
+    private var dataSegmentSize = DEFAULT_DATA_SEGMENT_SIZE
+
     /* GATT callback object */
     @SuppressLint("MissingPermission")
     private val gattCallback = object : BluetoothGattCallback() {
@@ -267,6 +277,7 @@ class ECBBluetoothManager private constructor(context: Context, handler: EventCa
                     Log.i(MODULE_NAME, "Successfully connected to $gatt.device.address")
 
                     wasConnected = true
+                    dataSegmentSize = DEFAULT_DATA_SEGMENT_SIZE
                     ecbGatt = gatt
                     ecbGatt?.discoverServices()
                 } else if (newState == BluetoothProfile.STATE_DISCONNECTED) {
@@ -332,6 +343,11 @@ class ECBBluetoothManager private constructor(context: Context, handler: EventCa
         override fun onMtuChanged(gatt: BluetoothGatt?, mtu: Int, status: Int) {
             super.onMtuChanged(gatt, mtu, status)
 
+            if (status == BluetoothGatt.GATT_SUCCESS) {
+                dataSegmentSize = mtu - GATT_ATT_HEADER_SIZE
+                Log.i(MODULE_NAME, "MTU $mtu granted, data segment size $dataSegmentSize")
+            }
+
             if (waitDescriptorSem.availablePermits < 1) {
                 waitDescriptorSem.release()
             }
@@ -826,13 +842,14 @@ class ECBBluetoothManager private constructor(context: Context, handler: EventCa
 
     @SuppressLint("MissingPermission")
     private suspend fun bleSenderRoutine() {
-        val mtuBase = 503
-        val buffer = ByteArray(mtuBase)
-
         while (true) {
             /* Get the next sender */
             val sender = dataSenderChannel.receive()
 
+            /* Chunk by the segment size granted for the connection */
+            val mtuBase = dataSegmentSize
+            val buffer = ByteArray(mtuBase)
+
             val dataChar = ecbGatt?.getService(UUID.fromString(ECB_SERVICE_UUID))
                 ?.getCharacteristic(UUID.fromString(ECB_DATA_UUID))
 
@@ -1070,6 +1087,15 @@ class ECBBluetoothManager private constructor(context: Context, handler: EventCa
         }
     }
 
+    fun setDataSegmentSize(size: Int) {
+        /* The badge reports the segment size it accepts for the connection */
+        if (size in DEFAULT_DATA_SEGMENT_SIZE..(GATT_MAX_MTU_SIZE - GATT_ATT_HEADER_SIZE)) {
+            dataSegmentSize = size
+        } else {
+            Log.e(MODULE_NAME, "Invalid data segment size $size")
+        }
+    }
+
     @SuppressLint("MissingPermission")
     fun disconnect() {
         if (ecbGatt != null) {
@@ -107,9 +107,19 @@ class ECBManager private constructor(activity: MainActivity) : EventCallbackHand
                 if (result != CommandManager.CommandStatus.SUCCESS || response != "PONG") {
                     finalStatus = ECBBleError.NOT_CONNECTED
                     ecbDisconnect()
+                    for (listener in listeners) {
+                        listener.onConnect(finalStatus)
+                    }
+                    return@sendPing
                 }
-                for (listener in listeners) {
-                    listener.onConnect(finalStatus)
+
+                /* Get the data segment size granted for the connection, the size
+                 * granted by the MTU exchange is kept on failure
+                 */
+                commandManager.getLinkInfo { _: CommandManager.CommandStatus ->
+                    for (listener in listeners) {
+                        listener.onConnect(finalStatus)
+                    }
                 }
             }
         } else {
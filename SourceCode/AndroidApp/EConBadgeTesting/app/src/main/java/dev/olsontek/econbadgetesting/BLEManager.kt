@@ -31,6 +31,7 @@ private const val ECB_DATA_UUID = "83670c18-0000-1000-8000-00805f9b34fb"
 private const val ECB_HW_VERSION_UUID = "997ca8f9-0000-1000-8000-00805f9b34fb"
 private const val ECB_SW_VERSION_UUID = "20a14f57-0000-1000-8000-00805f9b34fb"
 private const val GATT_MAX_MTU_SIZE = 517
+private const val GATT_ATT_HEADER_SIZE = 3
 private const val ECB_TOKEN = "0000000000000000"
 
 @OptIn(ExperimentalStdlibApi::class)
@@ -112,7 +113,7 @@ class BLEManager(activity: MainActivity) {
         val commandCharUUID = UUID.fromString(ECB_DATA_UUID)
         val commandChar = ecbGatt?.getService(ecbMainServiceUUID)?.getCharacteristic(commandCharUUID)
 
-        val mtuBase = 503
+        val mtuBase = dataSegmentSize
         val buffer = ByteArray(mtuBase)
         var toSend = dataBuffer.size
         var sent = 0
@@ -290,6 +291,14 @@ class BLEManager(activity: MainActivity) {
             }
         }
 
+        override fun onMtuChanged(gatt: BluetoothGatt?, mtu: Int, status: Int) {
+            super.onMtuChanged(gatt, mtu, status)
+
+            if (status == BluetoothGatt.GATT_SUCCESS) {
+                dataSegmentSize = mtu - GATT_ATT_HEADER_SIZE
+            }
+        }
+
         override fun onCharacteristicWrite(
             gatt: BluetoothGatt,
             characteristic: BluetoothGattCharacteristic,
@@ -427,4 +436,7 @@ class BLEManager(activity: MainActivity) {
 
     private var ecbGatt: BluetoothGatt? = null
     private var mainAct = activity
+
+    @Volatile
+    private var dataSegmentSize = 23 - GATT_ATT_HEADER_SIZE
 }
\ No newline at end of file
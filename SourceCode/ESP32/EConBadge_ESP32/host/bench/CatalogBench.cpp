@@ -0,0 +1,221 @@
+/*******************************************************************************
+ * @file CatalogBench.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file benchmarks the image listing allocations.
+ *
+ * @details This file benchmarks the image listing allocations. The image
+ * directory is filled with images, then the directory count, the catalog
+ * build done at the first boot and the menu scrolls through the catalog are
+ * run. The heap allocations, the blocks still allocated afterwards and the
+ * time are reported for each step.
+ *
+ * Usage: CatalogBench [image count] [scrolls]
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <new>            /* std::bad_alloc */
+#include <chrono>         /* std::chrono */
+#include <cstdio>         /* printf */
+#include <cstdlib>        /* atoi, malloc */
+#include <cstring>        /* memcpy */
+#include <Types.h>        /* Defined types */
+#include <Logger.h>       /* Logger service */
+#include <Storage.h>      /* Storage service */
+#include <ImageCatalog.h> /* Image catalog */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Default number of images. */
+#define BENCH_IMAGE_COUNT 1000
+/** @brief Default number of menu scrolls. */
+#define BENCH_SCROLLS 10000
+/** @brief Number of names displayed by the menu image list. */
+#define BENCH_MENU_ITEMS 6
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/** @brief Defines the heap counters at a point of the benchmark. */
+typedef struct
+{
+    /** @brief Number of allocations. */
+    size_t   allocs;
+    /** @brief Number of releases. */
+    size_t   frees;
+    /** @brief Time in microseconds. */
+    uint64_t time;
+} SBenchPoint;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+
+/** @brief Number of heap allocations. */
+static size_t sAllocs = 0;
+/** @brief Number of heap releases. */
+static size_t sFrees = 0;
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* The heap allocations are counted, the arrays use these operators too */
+void* operator new(size_t size)
+{
+    void* pBlock;
+
+    pBlock = malloc(size != 0 ? size : 1);
+    if(pBlock == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    ++sAllocs;
+
+    return pBlock;
+}
+
+void operator delete(void* pBlock) noexcept
+{
+    if(pBlock != nullptr)
+    {
+        ++sFrees;
+        free(pBlock);
+    }
+}
+
+void operator delete(void* pBlock, size_t size) noexcept
+{
+    (void)size;
+    operator delete(pBlock);
+}
+
+/** @brief Gets the heap counters and the time. */
+static void GetPoint(SBenchPoint& rPoint)
+{
+    rPoint.allocs = sAllocs;
+    rPoint.frees  = sFrees;
+    rPoint.time   = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+/** @brief Prints the heap counters between two points. */
+static void PrintStep(const char*        pkName,
+                      const SBenchPoint& rkStart,
+                      const SBenchPoint& rkEnd,
+                      const size_t       kRounds)
+{
+    printf("  %-10s %9zu allocs %7zu live %11.1f us %9.2f allocs/op\n",
+           pkName,
+           rkEnd.allocs - rkStart.allocs,
+           (rkEnd.allocs - rkStart.allocs) - (rkEnd.frees - rkStart.frees),
+           (double)(rkEnd.time - rkStart.time),
+           (double)(rkEnd.allocs - rkStart.allocs) / kRounds);
+}
+
+int main(int argc, char** argv)
+{
+    Storage*      pStore;
+    ImageCatalog* pCatalog;
+    FsFile        file;
+    SBenchPoint   start;
+    SBenchPoint   end;
+    size_t        imageCount;
+    size_t        scrolls;
+    size_t        count;
+    size_t        i;
+    char          pName[64];
+    char          pStartName[IMAGE_CATALOG_NAME_SIZE];
+    char          pNames[BENCH_MENU_ITEMS][IMAGE_CATALOG_NAME_SIZE];
+
+    imageCount = argc > 1 ? (size_t)MAX(atoi(argv[1]), 1) : BENCH_IMAGE_COUNT;
+    scrolls    = argc > 2 ? (size_t)MAX(atoi(argv[2]), 1) : BENCH_SCROLLS;
+
+    INIT_LOGGER(ECB_LOG_LEVEL_ERROR);
+
+    /* Names past the small string size, as uploaded by the client */
+    pStore = Storage::GetInstance();
+    pStore->CreateDirectory(IMAGE_DIR_PATH);
+    for(i = 0; i < imageCount; ++i)
+    {
+        snprintf(pName,
+                 sizeof(pName),
+                 IMAGE_DIR_PATH "/badge_image_%05zu.bin",
+                 i);
+        file = pStore->Open(pName, FILE_WRITE);
+        file.close();
+    }
+
+    printf("%zu images, %zu scrolls\n", imageCount, scrolls);
+
+    GetPoint(start);
+    count = pStore->GetFilesCount(IMAGE_DIR_PATH);
+    GetPoint(end);
+    PrintStep("Count", start, end, 1);
+
+    /* No catalog yet, it is built from the directory */
+    GetPoint(start);
+    pCatalog = ImageCatalog::GetInstance();
+    GetPoint(end);
+    PrintStep("Build", start, end, 1);
+
+    /* The menu scrolls down the image list */
+    pCatalog->GetNamesFrom("", 0, BENCH_MENU_ITEMS, pNames);
+    GetPoint(start);
+    for(i = 0; i < scrolls; ++i)
+    {
+        memcpy(pStartName, pNames[1], IMAGE_CATALOG_NAME_SIZE);
+        pCatalog->GetNamesFrom(pStartName, 0, BENCH_MENU_ITEMS, pNames);
+    }
+    GetPoint(end);
+    PrintStep("Scroll", start, end, scrolls);
+
+    if(count != imageCount || pCatalog->GetCount() != imageCount)
+    {
+        printf("  FAILED: %zu files, %zu cataloged\n",
+               count,
+               pCatalog->GetCount());
+        return 1;
+    }
+
+    return 0;
+}
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+/* None */
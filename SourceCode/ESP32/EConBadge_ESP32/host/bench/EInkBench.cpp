@@ -0,0 +1,270 @@
+/*******************************************************************************
+ * @file EInkBench.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file benchmarks the EInk display paths on the simulated panel.
+ *
+ * @details This file benchmarks the EInk display paths on the simulated panel.
+ * The SetDisplayedImage path is timed for the raw and compressed version of
+ * each image, and the Clear path is timed. The benchmark reports the time of
+ * the whole command, of the frame transfer, the SPI wire time at the driver
+ * clock and the refresh sequence time. Each displayed image is written as a
+ * PPM image in the current directory.
+ *
+ * Usage: EInkBench <refresh ms> <rounds> <images dir> <image names...>
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <string>             /* std::string */
+#include <vector>             /* std::vector */
+#include <cstdio>             /* fopen */
+#include <cstdlib>            /* atoi */
+#include <Types.h>            /* Defined types */
+#include <HWMgr.h>            /* Time services */
+#include <Logger.h>           /* Logger service */
+#include <HostBus.h>          /* Host bus */
+#include <Storage.h>          /* Storage service */
+#include <BlueToothMgr.h>     /* Bluetooth manager */
+#include <EInkPanelSim.h>     /* Simulated panel */
+#include <WaveshareEInkMgr.h> /* EInk display manager */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Reset time of the panel in microseconds. */
+#define BENCH_RESET_TIME 10000
+/** @brief Power on / off time of the panel in microseconds. */
+#define BENCH_POWER_TIME 100000
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/** @brief Byte buffer. */
+typedef std::vector<uint8_t> TBuffer;
+
+/** @brief Accumulated timings of a display path, in microseconds. */
+typedef struct
+{
+    /** @brief Whole command time. */
+    uint64_t total;
+    /** @brief Frame transfer time. */
+    uint64_t frame;
+    /** @brief SPI wire time. */
+    uint64_t wire;
+    /** @brief Refresh sequence time. */
+    uint64_t refresh;
+    /** @brief Number of failed commands. */
+    uint32_t errors;
+} SBenchTimings;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+
+/** @brief The simulated panel. */
+static EInkPanelSim* spPanel;
+
+/** @brief The display manager. */
+static EInkDisplayManager* spManager;
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/** @brief Copies a converted image in the images directory of the SD card. */
+static bool StoreImage(const std::string& rkPath, const std::string& rkName)
+{
+    TBuffer content(2 * EINK_SIM_FRAME_SIZE);
+    FILE*   pFile;
+    FsFile  file;
+    size_t  size;
+
+    pFile = fopen(rkPath.c_str(), "rb");
+    if(pFile == nullptr)
+    {
+        return false;
+    }
+    size = fread(content.data(), 1, content.size(), pFile);
+    fclose(pFile);
+
+    file = Storage::GetInstance()->Open("/images/" + rkName, FILE_WRITE);
+    if(!file)
+    {
+        return false;
+    }
+    size = file.write(content.data(), size) == size;
+    file.close();
+
+    return size != 0;
+}
+
+/** @brief Runs a display command and accumulates its timings. */
+static void TimeCommand(const std::string& rkName, SBenchTimings& rTimings)
+{
+    SCommandResponse response;
+    SEInkPanelStats  stats;
+    SHostSpiCounters counters;
+    uint64_t         startTime;
+
+    memset(&response, 0, sizeof(SCommandResponse));
+    HostBus::ClearSpiCounters();
+
+    startTime = HWManager::GetTime();
+    if(rkName.empty())
+    {
+        spManager->Clear(response);
+    }
+    else
+    {
+        spManager->SetDisplayedImage(rkName, response);
+    }
+    rTimings.total += HWManager::GetTime() - startTime;
+
+    spPanel->GetStats(stats);
+    HostBus::GetSpiCounters(counters);
+    rTimings.frame   += stats.frameTime;
+    rTimings.refresh += stats.refreshTime;
+    rTimings.wire    += counters.wireTime;
+    if(response.header.errorCode != NO_ERROR)
+    {
+        ++rTimings.errors;
+    }
+}
+
+/** @brief Prints the mean timings of a display path. */
+static void PrintTimings(const std::string&   rkName,
+                         const SBenchTimings& rkTimings,
+                         const int            kRounds)
+{
+    printf("%-12s %9.1f %9.1f %9.1f %9.1f %6u\n",
+           rkName.c_str(),
+           rkTimings.total / 1000.0 / kRounds,
+           rkTimings.frame / 1000.0 / kRounds,
+           rkTimings.wire / 1000.0 / kRounds,
+           rkTimings.refresh / 1000.0 / kRounds,
+           rkTimings.errors);
+}
+
+int main(int argc, char** argv)
+{
+    SEInkPanelTimings timings;
+    SBenchTimings     results;
+    BluetoothManager* pBtMgr;
+    std::string       path;
+    std::string       name;
+    int               rounds;
+    int               round;
+    int               i;
+    int               j;
+
+    static const char* skpExtensions[2] = { ".raw", ".rle" };
+
+    if(argc < 4)
+    {
+        printf("Usage: %s <refresh ms> <rounds> <images dir> <names...>\n",
+               argv[0]);
+        return 1;
+    }
+
+    INIT_LOGGER(ECB_LOG_LEVEL_ERROR);
+
+    timings.resetTime   = BENCH_RESET_TIME;
+    timings.powerTime   = BENCH_POWER_TIME;
+    timings.refreshTime = (uint64_t)atoi(argv[1]) * 1000;
+    rounds              = MAX(atoi(argv[2]), 1);
+    spPanel             = new EInkPanelSim(timings);
+
+    Storage::GetInstance()->CreateDirectory("/images");
+    for(i = 4; i < argc; ++i)
+    {
+        path = std::string(argv[3]) + "/" + argv[i];
+        for(j = 0; j < 2; ++j)
+        {
+            name = argv[i] + std::string(skpExtensions[j]);
+            if(!StoreImage(path + skpExtensions[j], name))
+            {
+                printf("Failed to store %s%s\n", path.c_str(),
+                       skpExtensions[j]);
+                return 1;
+            }
+        }
+    }
+
+    pBtMgr    = new BluetoothManager();
+    spManager = new EInkDisplayManager(pBtMgr);
+    spManager->Init();
+
+    printf("%-12s %9s %9s %9s %9s %6s\n",
+           "Image", "Total ms", "Frame ms", "Wire ms", "Refr. ms", "Errors");
+
+    /* The same image is not displayed twice in a row */
+    for(i = 4; i < argc; ++i)
+    {
+        for(j = 0; j < 2; ++j)
+        {
+            name = argv[i] + std::string(skpExtensions[j]);
+            memset(&results, 0, sizeof(SBenchTimings));
+            for(round = 0; round < rounds; ++round)
+            {
+                TimeCommand(name, results);
+                TimeCommand("", results);
+            }
+            spPanel->WritePpm(argv[i] + std::string(".ppm"));
+            memset(&results, 0, sizeof(SBenchTimings));
+            for(round = 0; round < rounds; ++round)
+            {
+                TimeCommand("", results);
+                TimeCommand(name, results);
+            }
+            PrintTimings(name, results, 2 * rounds);
+        }
+    }
+
+    memset(&results, 0, sizeof(SBenchTimings));
+    for(round = 0; round < rounds; ++round)
+    {
+        TimeCommand("", results);
+    }
+    PrintTimings("Clear", results, rounds);
+
+    delete spPanel;
+
+    return 0;
+}
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+/* None */
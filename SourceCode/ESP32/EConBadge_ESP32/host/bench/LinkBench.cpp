@@ -0,0 +1,397 @@
+/*******************************************************************************
+ * @file LinkBench.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file benchmarks the protocol over the loopback transport.
+ *
+ * @details This file benchmarks the protocol over the loopback transport. The
+ * bluetooth manager is driven end to end on links modeling the badge radio:
+ * raw and compressed image upload and download, image listing and LED border
+ * queries. The throughputs, the query latency and the link counters are
+ * reported for each link.
+ *
+ * Usage: LinkBench [image size] [rounds]
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <vector>              /* std::vector */
+#include <cstdio>              /* printf */
+#include <cstdlib>             /* atoi */
+#include <Types.h>             /* Defined types */
+#include <HWMgr.h>             /* Time services */
+#include <Logger.h>            /* Logger service */
+#include <Storage.h>           /* Files cursor */
+#include <BlueToothMgr.h>      /* Bluetooth manager */
+#include <LoopbackPeer.h>      /* Loopback peer */
+#include <LoopbackDevice.h>    /* Loopback device */
+#include <LoopbackTransport.h> /* Loopback transport */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Default size of the transferred images, a raw EInk image. */
+#define BENCH_IMAGE_SIZE 134400
+/** @brief Default number of rounds of each transfer. */
+#define BENCH_ROUNDS 2
+/** @brief Number of images reported by the listing. */
+#define BENCH_IMAGE_COUNT 200
+/** @brief Number of LED border queries. */
+#define BENCH_QUERIES 50
+
+/** @brief Command and transfer timeout in milliseconds. */
+#define BENCH_TIMEOUT 30000
+
+/** @brief Default communication token. */
+#define BENCH_TOKEN "0000000000000000"
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/** @brief Byte buffer. */
+typedef std::vector<uint8_t> TBuffer;
+
+/** @brief Defines a benchmarked link. */
+typedef struct
+{
+    /** @brief Link name. */
+    const char*     pName;
+    /** @brief Link configuration. */
+    SLoopbackConfig config;
+} SBenchLink;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+
+/** @brief Benchmarked links: MTU, interval, latency, bandwidth, loss, depth. */
+static const SBenchLink sksLinks[] = {
+    { "Unbounded",    { 247, 6,  0,    0,      0,   8, 1 } },
+    { "2M PHY",       { 247, 6,  3750, 160000, 0,   8, 1 } },
+    { "2M PHY lossy", { 247, 6,  3750, 160000, 300, 8, 7 } },
+    { "MTU 185",      { 185, 24, 7500, 40000,  0,   8, 1 } }
+};
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/** @brief Builds an image with compressible and random areas. */
+static void BuildImage(const size_t kSize, TBuffer& rImage)
+{
+    uint32_t state;
+    size_t   i;
+
+    state = 1;
+    rImage.resize(kSize);
+    for(i = 0; i < kSize; ++i)
+    {
+        state = state * 1103515245 + 12345;
+        if((i / 640) % 7 == 0)
+        {
+            rImage[i] = 0x11;
+        }
+        else if((i / 9000) % 2 == 0)
+        {
+            rImage[i] = (state >> 24) & 0x33;
+        }
+        else
+        {
+            rImage[i] = state >> 24;
+        }
+    }
+}
+
+/** @brief Sets the compression of the next transfer. */
+static bool SetCompression(LoopbackPeer& rPeer, const bool kCompressed)
+{
+    SCommandResponse response;
+    uint8_t          mode;
+
+    mode = kCompressed ? BLE_COMPRESSION_LZ : BLE_COMPRESSION_NONE;
+    return rPeer.Command(CMD_SET_LINK_COMPRESSION,
+                         &mode,
+                         sizeof(mode),
+                         response,
+                         BENCH_TIMEOUT);
+}
+
+/** @brief Uploads an image, returns the time in microseconds, 0 on error. */
+static uint64_t Upload(LoopbackDevice& rDevice,
+                       LoopbackPeer&   rPeer,
+                       const TBuffer&  rkImage,
+                       const bool      kCompressed)
+{
+    SCommandResponse response;
+    TBuffer          received;
+    uint64_t         startTime;
+    bool             success;
+
+    success   = SetCompression(rPeer, kCompressed);
+    startTime = HWManager::GetTime();
+    success   = success &&
+                rPeer.Command(CMD_EINK_NEW_IMAGE,
+                              nullptr,
+                              0,
+                              response,
+                              BENCH_TIMEOUT) &&
+                rPeer.Upload(rkImage.data(),
+                             rkImage.size(),
+                             kCompressed,
+                             BENCH_TIMEOUT) &&
+                rPeer.WaitResponse(response, BENCH_TIMEOUT);
+    startTime = HWManager::GetTime() - startTime;
+
+    rDevice.GetImage(received);
+
+    return success && received == rkImage ? startTime : 0;
+}
+
+/** @brief Downloads an image, returns the time in microseconds, 0 on error. */
+static uint64_t Download(LoopbackPeer&  rPeer,
+                         const TBuffer& rkImage,
+                         const bool     kCompressed)
+{
+    SCommandResponse response;
+    TBuffer          received;
+    uint64_t         startTime;
+    bool             success;
+
+    success   = SetCompression(rPeer, kCompressed);
+    startTime = HWManager::GetTime();
+    success   = success &&
+                rPeer.Command(CMD_EINK_GET_IMAGE_DATA,
+                              nullptr,
+                              0,
+                              response,
+                              BENCH_TIMEOUT) &&
+                rPeer.Download(received,
+                               rkImage.size(),
+                               true,
+                               kCompressed,
+                               BENCH_TIMEOUT) &&
+                rPeer.WaitResponse(response, BENCH_TIMEOUT);
+    startTime = HWManager::GetTime() - startTime;
+
+    return success && received == rkImage ? startTime : 0;
+}
+
+/** @brief Lists the images, returns the time in microseconds, 0 on error. */
+static uint64_t List(LoopbackPeer& rPeer)
+{
+    SCommandResponse  response;
+    SImagePageRequest request;
+    SImagePageHeader  pageHeader;
+    TBuffer           page;
+    uint32_t          count;
+    uint64_t          startTime;
+
+    request.cursor = 0;
+    request.count  = IMAGE_PAGE_MAX_ENTRIES;
+    request.flags  = IMAGE_PAGE_FLAG_RECORDS;
+    count          = 0;
+    startTime      = HWManager::GetTime();
+    while(request.cursor != FILES_CURSOR_END)
+    {
+        if(!rPeer.Command(CMD_EINK_GET_IMAGE_PAGE,
+                          &request,
+                          sizeof(SImagePageRequest),
+                          response,
+                          BENCH_TIMEOUT))
+        {
+            return 0;
+        }
+        memcpy(&pageHeader, response.pResponse, sizeof(SImagePageHeader));
+        if(!rPeer.Download(page,
+                           pageHeader.size,
+                           false,
+                           false,
+                           BENCH_TIMEOUT) ||
+           !rPeer.WaitResponse(response, BENCH_TIMEOUT))
+        {
+            return 0;
+        }
+        count          += pageHeader.count;
+        request.cursor  = pageHeader.nextCursor;
+    }
+
+    return count == BENCH_IMAGE_COUNT ? HWManager::GetTime() - startTime : 0;
+}
+
+/** @brief Prints the throughput of a transfer. */
+static void PrintTransfer(const char*    pkName,
+                          const size_t   kSize,
+                          const uint64_t kTime,
+                          const int      kRounds)
+{
+    if(kTime == 0)
+    {
+        printf("  %-16s FAILED\n", pkName);
+        return;
+    }
+    printf("  %-16s %9.1f ms %9.1f kB/s\n",
+           pkName,
+           kTime / 1000.0 / kRounds,
+           (double)kSize * kRounds * 1000.0 / kTime);
+}
+
+/** @brief Runs the benchmark on a link. */
+static void BenchLink(const SBenchLink& rkLink,
+                      const TBuffer&    rkImage,
+                      const int         kRounds)
+{
+    LoopbackTransport* pTransport;
+    BluetoothManager*  pBtMgr;
+    LoopbackDevice*    pDevice;
+    LoopbackPeer*      pPeer;
+    SCommandResponse   response;
+    SLoopbackCounters  counters;
+    uint64_t           pTimes[4];
+    uint64_t           time;
+    uint64_t           startTime;
+    uint32_t           queries;
+    int                round;
+    int                i;
+
+    /* The tasks of the manager are not stopped, the link is left idle */
+    pTransport = new LoopbackTransport(rkLink.config);
+    pBtMgr     = new BluetoothManager();
+    pDevice    = new LoopbackDevice(pBtMgr, rkImage.size(), BENCH_IMAGE_COUNT);
+    pPeer      = new LoopbackPeer(pTransport, BENCH_TOKEN);
+    pBtMgr->Init(pDevice, pTransport);
+    pTransport->Connect();
+
+    printf("%s: MTU %u, latency %uus, bandwidth %uB/s, loss %u/10000\n",
+           rkLink.pName,
+           rkLink.config.mtu,
+           rkLink.config.latency,
+           rkLink.config.bandwidth,
+           rkLink.config.lossRate);
+
+    memset(pTimes, 0, sizeof(pTimes));
+    for(i = 0; i < 4; ++i)
+    {
+        for(round = 0; round < kRounds; ++round)
+        {
+            if(i < 2)
+            {
+                time = Upload(*pDevice, *pPeer, rkImage, i == 1);
+            }
+            else
+            {
+                time = Download(*pPeer, rkImage, i == 3);
+            }
+            if(time == 0)
+            {
+                pTimes[i] = 0;
+                break;
+            }
+            pTimes[i] += time;
+        }
+    }
+    PrintTransfer("Upload raw", rkImage.size(), pTimes[0], kRounds);
+    PrintTransfer("Upload LZ", rkImage.size(), pTimes[1], kRounds);
+    PrintTransfer("Download raw", rkImage.size(), pTimes[2], kRounds);
+    PrintTransfer("Download LZ", rkImage.size(), pTimes[3], kRounds);
+
+    time = List(*pPeer);
+    if(time == 0)
+    {
+        printf("  %-16s FAILED\n", "Listing");
+    }
+    else
+    {
+        printf("  %-16s %9.1f ms %9u images\n",
+               "Listing",
+               time / 1000.0,
+               BENCH_IMAGE_COUNT);
+    }
+
+    queries   = 0;
+    startTime = HWManager::GetTime();
+    for(i = 0; i < BENCH_QUERIES; ++i)
+    {
+        if(pPeer->Command(CMD_LEDBORDER_GET_BRIGHTNESS,
+                          nullptr,
+                          0,
+                          response,
+                          BENCH_TIMEOUT) &&
+           response.pResponse[0] == LOOPBACK_DEVICE_BRIGHTNESS)
+        {
+            ++queries;
+        }
+    }
+    printf("  %-16s %9.2f ms %9u/%u\n",
+           "LED query",
+           (HWManager::GetTime() - startTime) / 1000.0 / BENCH_QUERIES,
+           queries,
+           BENCH_QUERIES);
+
+    pTransport->GetCounters(counters);
+    printf("  Link: %u to device, %u to peer, %u lost, %u congestions, "
+           "%u retransmits\n",
+           counters.framesToDevice,
+           counters.framesToPeer,
+           counters.lostFrames,
+           counters.congestions,
+           pPeer->GetRetransmits());
+
+    pTransport->Disconnect();
+}
+
+int main(int argc, char** argv)
+{
+    TBuffer image;
+    size_t  imageSize;
+    int     rounds;
+    size_t  i;
+
+    imageSize = argc > 1 ? (size_t)atoi(argv[1]) : BENCH_IMAGE_SIZE;
+    rounds    = argc > 2 ? MAX(atoi(argv[2]), 1) : BENCH_ROUNDS;
+
+    INIT_LOGGER(ECB_LOG_LEVEL_ERROR);
+
+    BuildImage(imageSize, image);
+    for(i = 0; i < sizeof(sksLinks) / sizeof(sksLinks[0]); ++i)
+    {
+        BenchLink(sksLinks[i], image, rounds);
+    }
+
+    return 0;
+}
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+/* None */
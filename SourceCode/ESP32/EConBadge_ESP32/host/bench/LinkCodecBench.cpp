@@ -0,0 +1,241 @@
+/*******************************************************************************
+ * @file LinkCodecBench.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file benchmarks the link compression codec.
+ *
+ * @details This file benchmarks the link compression codec. The converted
+ * images, raw and compressed, and synthetic streams are encoded in blocks of
+ * LINK_CODEC_BLOCK bytes as the bluetooth manager does. The compression ratio
+ * and the encode and decode throughputs are reported for each stream.
+ *
+ * Usage: LinkCodecBench <rounds> <images dir> <image names...>
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <chrono>      /* std::chrono */
+#include <string>      /* std::string */
+#include <vector>      /* std::vector */
+#include <cstdio>      /* printf */
+#include <cstdlib>     /* atoi */
+#include <Types.h>     /* Defined types */
+#include <LinkCodec.h> /* Link compression codec */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Size of a raw EInk image, the size of the synthetic streams. */
+#define BENCH_STREAM_SIZE 134400
+
+/** @brief Maximal size of a converted image file. */
+#define BENCH_FILE_MAX_SIZE (2 * BENCH_STREAM_SIZE)
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/** @brief Byte buffer. */
+typedef std::vector<uint8_t> TBuffer;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/** @brief Gets the time in microseconds. */
+static uint64_t GetTime(void)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+/** @brief Reads a file. */
+static bool ReadFile(const std::string& rkPath, TBuffer& rContent)
+{
+    FILE*  pFile;
+    size_t read;
+
+    pFile = fopen(rkPath.c_str(), "rb");
+    if(pFile == nullptr)
+    {
+        return false;
+    }
+    rContent.resize(BENCH_FILE_MAX_SIZE);
+    read = fread(rContent.data(), 1, rContent.size(), pFile);
+    rContent.resize(read);
+    fclose(pFile);
+
+    return true;
+}
+
+/** @brief Encodes a stream block per block. */
+static void Encode(LinkEncoder& rEncoder, const TBuffer& rkRaw, TBuffer& rOut)
+{
+    size_t pos;
+    size_t size;
+    size_t encoded;
+
+    rOut.resize(LINK_CODEC_MAX_ENCODED_SIZE(LINK_CODEC_BLOCK) *
+                (rkRaw.size() / LINK_CODEC_BLOCK + 1));
+    rEncoder.Reset();
+    encoded = 0;
+    for(pos = 0; pos < rkRaw.size(); pos += size)
+    {
+        size     = MIN((size_t)LINK_CODEC_BLOCK, rkRaw.size() - pos);
+        encoded += rEncoder.Encode(rkRaw.data() + pos,
+                                   size,
+                                   rOut.data() + encoded);
+    }
+    rOut.resize(encoded);
+}
+
+/** @brief Benchmarks a stream and prints its results. */
+static void Bench(const char*    pkName,
+                  const TBuffer& rkRaw,
+                  const int      kRounds)
+{
+    LinkEncoder* pEncoder;
+    LinkDecoder* pDecoder;
+    TBuffer      encoded;
+    TBuffer      decoded(rkRaw.size());
+    size_t       consumed;
+    size_t       produced;
+    uint64_t     encodeTime;
+    uint64_t     decodeTime;
+    uint64_t     startTime;
+    int          round;
+
+    pEncoder = new LinkEncoder();
+    pDecoder = new LinkDecoder();
+
+    startTime = GetTime();
+    for(round = 0; round < kRounds; ++round)
+    {
+        Encode(*pEncoder, rkRaw, encoded);
+    }
+    encodeTime = GetTime() - startTime;
+
+    produced  = 0;
+    startTime = GetTime();
+    for(round = 0; round < kRounds; ++round)
+    {
+        pDecoder->Reset();
+        produced = pDecoder->Decode(encoded.data(),
+                                    encoded.size(),
+                                    consumed,
+                                    decoded.data(),
+                                    decoded.size());
+    }
+    decodeTime = GetTime() - startTime;
+
+    if(produced != rkRaw.size() || pDecoder->HasError() || decoded != rkRaw)
+    {
+        printf("  %-14s FAILED\n", pkName);
+    }
+    else
+    {
+        printf("  %-14s %7zu -> %7zu bytes %6.1f%% %9.1f MB/s %9.1f MB/s\n",
+               pkName,
+               rkRaw.size(),
+               encoded.size(),
+               100.0 * encoded.size() / MAX(rkRaw.size(), (size_t)1),
+               (double)rkRaw.size() * kRounds / MAX(encodeTime, (uint64_t)1),
+               (double)rkRaw.size() * kRounds / MAX(decodeTime, (uint64_t)1));
+    }
+
+    delete pEncoder;
+    delete pDecoder;
+}
+
+int main(int argc, char** argv)
+{
+    std::string path;
+    std::string name;
+    TBuffer     stream;
+    uint32_t    state;
+    size_t      i;
+    int         rounds;
+    int         arg;
+
+    rounds = argc > 1 ? MAX(atoi(argv[1]), 1) : 10;
+
+    printf("  %-14s %7s    %7s       %7s %14s %14s\n",
+           "Stream", "Raw", "Encoded", "Ratio", "Encode", "Decode");
+
+    /* Synthetic streams: uniform, random and half random */
+    Bench("Uniform", TBuffer(BENCH_STREAM_SIZE, 0x11), rounds);
+
+    state = 1;
+    stream.resize(BENCH_STREAM_SIZE);
+    for(i = 0; i < stream.size(); ++i)
+    {
+        state     = state * 1103515245 + 12345;
+        stream[i] = state >> 24;
+    }
+    Bench("Random", stream, rounds);
+
+    for(i = 0; i < stream.size(); i += 2)
+    {
+        stream[i] = 0x11;
+    }
+    Bench("Half random", stream, rounds);
+
+    /* Converted images, as uploaded by the client */
+    for(arg = 3; arg < argc; ++arg)
+    {
+        path = std::string(argv[2]) + "/" + argv[arg];
+        if(ReadFile(path + ".raw", stream))
+        {
+            name = std::string(argv[arg]) + ".raw";
+            Bench(name.c_str(), stream, rounds);
+        }
+        if(ReadFile(path + ".rle", stream))
+        {
+            name = std::string(argv[arg]) + ".rle";
+            Bench(name.c_str(), stream, rounds);
+        }
+    }
+
+    return 0;
+}
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+/* None */
@@ -0,0 +1,202 @@
+/*******************************************************************************
+ * @file RingBench.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file benchmarks the ring buffer.
+ *
+ * @details This file benchmarks the ring buffer. A producer thread pushes
+ * frames of the BLE segment sizes in the manager receive ring and a consumer
+ * thread copies the contiguous runs out, as ReceiveData does. The stream is
+ * run with the producer waiting for space and with the producer dropping the
+ * frames that do not fit, the throughput, the dropped bytes and the high
+ * watermark are reported.
+ *
+ * Usage: RingBench [size in MB]
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <atomic>       /* std::atomic */
+#include <chrono>       /* std::chrono */
+#include <thread>       /* std::thread */
+#include <vector>       /* std::vector */
+#include <cstdio>       /* printf */
+#include <cstdlib>      /* atoi */
+#include <cstring>      /* memcpy */
+#include <Types.h>      /* Defined types */
+#include <RingBuffer.h> /* Ring buffer */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Size of the ring, the manager receive ring size. */
+#define BENCH_RING_SIZE 8192
+/** @brief Default number of megabytes streamed per run. */
+#define BENCH_STREAM_MB 64
+/** @brief Size of the consumer buffer, the EInk manager buffer size. */
+#define BENCH_READ_SIZE 1024
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/** @brief Defines the result of a run. */
+typedef struct
+{
+    /** @brief Run time in microseconds. */
+    uint64_t time;
+    /** @brief Number of bytes received by the consumer. */
+    size_t   received;
+    /** @brief Number of bytes dropped on overflow. */
+    uint32_t dropped;
+    /** @brief Maximal number of bytes in the ring. */
+    size_t   highWatermark;
+} SBenchResult;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+
+/** @brief Benchmarked frame sizes: MTU 23, 185, 247 and the message MTU. */
+static const size_t sksFrameSizes[] = { 20, 182, 244, 512 };
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/** @brief Pushes the stream, waits for space or drops the frames. */
+static void Produce(RingBuffer*        pRing,
+                    const size_t       kFrameSize,
+                    const size_t       kStreamSize,
+                    const bool         kWait,
+                    std::atomic<bool>* pDone)
+{
+    std::vector<uint8_t> frame(kFrameSize, 0x5A);
+    size_t               sent;
+
+    for(sent = 0; sent < kStreamSize; sent += kFrameSize)
+    {
+        while(kWait && pRing->GetFree() < kFrameSize)
+        {
+            std::this_thread::yield();
+        }
+        pRing->Push(frame.data(), kFrameSize);
+    }
+    *pDone = true;
+}
+
+/** @brief Runs the stream of a frame size. */
+static void Run(const size_t  kFrameSize,
+                const size_t  kStreamSize,
+                const bool    kWait,
+                SBenchResult& rResult)
+{
+    RingBuffer           ring(BENCH_RING_SIZE);
+    std::vector<uint8_t> buffer(BENCH_READ_SIZE);
+    std::atomic<bool>    done;
+    const uint8_t*       pkRun;
+    size_t               size;
+    size_t               offset;
+
+    std::chrono::steady_clock::time_point start;
+
+    done   = false;
+    offset = 0;
+    rResult.received = 0;
+
+    start = std::chrono::steady_clock::now();
+    std::thread producer(Produce, &ring, kFrameSize, kStreamSize, kWait, &done);
+    while(!done || ring.GetUsed() != 0)
+    {
+        size = ring.Peek(pkRun);
+        if(size == 0)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        size = MIN(size, BENCH_READ_SIZE - offset);
+        memcpy(buffer.data() + offset, pkRun, size);
+        ring.Consume(size);
+        offset = (offset + size) % BENCH_READ_SIZE;
+        rResult.received += size;
+    }
+    producer.join();
+
+    rResult.time = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start
+    ).count();
+    rResult.dropped       = ring.GetDroppedBytes();
+    rResult.highWatermark = ring.GetHighWatermark();
+}
+
+/** @brief Prints the result of a run. */
+static void PrintResult(const char*         pkMode,
+                        const size_t        kFrameSize,
+                        const size_t        kStreamSize,
+                        const SBenchResult& rkResult)
+{
+    printf("  %-8s %4zu B %9.1f MB/s %9.2f%% dropped %6zu B watermark\n",
+           pkMode,
+           kFrameSize,
+           (double)rkResult.received / MAX(rkResult.time, (uint64_t)1),
+           100.0 * rkResult.dropped / kStreamSize,
+           rkResult.highWatermark);
+}
+
+int main(int argc, char** argv)
+{
+    SBenchResult result;
+    size_t       streamSize;
+    size_t       i;
+
+    streamSize  = argc > 1 ? (size_t)MAX(atoi(argv[1]), 1) : BENCH_STREAM_MB;
+    streamSize *= 1024 * 1024;
+
+    printf("Ring %u B, %zu MB per run\n",
+           BENCH_RING_SIZE,
+           streamSize / (1024 * 1024));
+    for(i = 0; i < sizeof(sksFrameSizes) / sizeof(sksFrameSizes[0]); ++i)
+    {
+        Run(sksFrameSizes[i], streamSize, true, result);
+        PrintResult("Wait", sksFrameSizes[i], streamSize, result);
+        Run(sksFrameSizes[i], streamSize, false, result);
+        PrintResult("Drop", sksFrameSizes[i], streamSize, result);
+    }
+
+    return 0;
+}
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+/* None */
@@ -0,0 +1,171 @@
+/*******************************************************************************
+ * @file Arduino.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file defines the Arduino services used by the firmware on the
+ * host.
+ *
+ * @details This file defines the Arduino services used by the firmware on the
+ * host. The GPIO are routed to the host bus where the simulated devices are
+ * attached, the serial port prints on the standard output.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __HOST_ARDUINO_H_
+#define __HOST_ARDUINO_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <string>               /* std::string */
+#include <cstdio>               /* printf */
+#include <cstdarg>              /* va_list */
+#include <cstdint>              /* Standard Int Types */
+#include <cstring>              /* memcpy, memset */
+#include <sys/types.h>          /* ssize_t */
+#include <esp32-hal-gpio.h>     /* GPIO constants */
+#include <freertos/FreeRTOS.h>  /* FreeRTOS services */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+#define LOW  0x0
+#define HIGH 0x1
+
+#define INPUT  0x01
+#define OUTPUT 0x03
+
+#define RISING  0x01
+#define FALLING 0x02
+#define CHANGE  0x03
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+#define IRAM_ATTR
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+
+class HardwareSerial;
+/** @brief Host serial port. */
+extern HardwareSerial Serial;
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+void    pinMode(const uint8_t kPin, const uint8_t kMode);
+void    digitalWrite(const uint8_t kPin, const uint8_t kLevel);
+int     digitalRead(const uint8_t kPin);
+int     digitalPinToInterrupt(const uint8_t kPin);
+void    attachInterrupt(const uint8_t kPin,
+                        void          (*handler)(void),
+                        const int     kMode);
+void    detachInterrupt(const uint8_t kPin);
+void    ets_delay_us(const uint32_t kDelayUs);
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/**
+ * @brief Arduino string.
+ *
+ * @details Arduino string, only the services used by the firmware are
+ * provided.
+ */
+class String
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        String(const char* pkString = "")
+        {
+            value_ = pkString;
+        }
+
+        const char* c_str(void) const
+        {
+            return value_.c_str();
+        }
+
+        unsigned int length(void) const
+        {
+            return value_.size();
+        }
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+        /* None */
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        /** @brief The string value. */
+        std::string value_;
+};
+
+/**
+ * @brief Host serial port.
+ *
+ * @details Host serial port. The output is printed on the standard output or
+ * captured in a string by the tests.
+ */
+class HardwareSerial
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        HardwareSerial(void);
+
+        void begin(const unsigned long kBaudRate);
+
+        int printf(const char* pkFormat, ...)
+            __attribute__((format(printf, 2, 3)));
+
+        /**
+         * @brief Redirects the output to a string.
+         *
+         * @param[out] pCapture The string that receives the output, nullptr
+         * to print on the standard output.
+         */
+        void setCapture(std::string* pCapture);
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+        /* None */
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        /** @brief The string that receives the output, if any. */
+        std::string* pCapture_;
+};
+
+#endif /* #ifndef __HOST_ARDUINO_H_ */
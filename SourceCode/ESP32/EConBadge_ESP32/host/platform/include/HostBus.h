@@ -0,0 +1,203 @@
+/*******************************************************************************
+ * @file HostBus.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file defines the host bus where the simulated devices are
+ * attached.
+ *
+ * @details This file defines the host bus where the simulated devices are
+ * attached. The devices observe the GPIO written by the firmware and the
+ * bytes sent on the SPI bus, they drive the input GPIO and raise their
+ * interrupts.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __HOST_HOST_BUS_H_
+#define __HOST_HOST_BUS_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint> /* Standard Int Types */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/** @brief SPI bus traffic counters. */
+typedef struct
+{
+    /** @brief Number of bytes written on the bus. */
+    uint64_t bytes;
+    /** @brief Number of write calls. */
+    uint64_t writes;
+    /** @brief Wire time of the written bytes in microseconds. */
+    uint64_t wireTime;
+} SHostSpiCounters;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/**
+ * @brief Device attached to the host bus.
+ *
+ * @details Device attached to the host bus. The callbacks are called on the
+ * thread that accessed the bus, with the bus lock held.
+ */
+class HostDevice
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        virtual ~HostDevice(void) {}
+
+        /**
+         * @brief Called when the firmware writes a GPIO.
+         *
+         * @param[in] kPin The GPIO.
+         * @param[in] kLevel The written level.
+         */
+        virtual void OnPinWrite(const uint8_t kPin, const uint8_t kLevel) = 0;
+
+        /**
+         * @brief Called when the firmware writes bytes on the SPI bus.
+         *
+         * @param[in] pkData The written bytes.
+         * @param[in] kSize The number of bytes.
+         */
+        virtual void OnSpiWrite(const uint8_t* pkData,
+                                const uint32_t kSize) = 0;
+};
+
+/**
+ * @brief Host bus.
+ *
+ * @details Host bus. Holds the GPIO levels, the interrupt handlers and the
+ * attached devices.
+ */
+class HostBus
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        /**
+         * @brief Attaches a device to the bus.
+         *
+         * @param[in] pDevice The device to attach.
+         */
+        static void Attach(HostDevice* pDevice);
+
+        /**
+         * @brief Detaches a device from the bus.
+         *
+         * @param[in] pDevice The device to detach.
+         */
+        static void Detach(HostDevice* pDevice);
+
+        /**
+         * @brief Drives an input GPIO.
+         *
+         * @details Drives an input GPIO. The interrupt handler attached to
+         * the GPIO is called when the edge matches its mode.
+         *
+         * @param[in] kPin The GPIO.
+         * @param[in] kLevel The level to drive.
+         */
+        static void DrivePin(const uint8_t kPin, const uint8_t kLevel);
+
+        /**
+         * @brief Gets the level of a GPIO.
+         *
+         * @param[in] kPin The GPIO.
+         *
+         * @return The level of the GPIO is returned.
+         */
+        static uint8_t GetPin(const uint8_t kPin);
+
+        /**
+         * @brief Gets the SPI bus traffic counters.
+         *
+         * @param[out] rCounters The counters.
+         */
+        static void GetSpiCounters(SHostSpiCounters& rCounters);
+
+        /**
+         * @brief Clears the SPI bus traffic counters.
+         */
+        static void ClearSpiCounters(void);
+
+        /**
+         * @brief Takes the bus lock.
+         *
+         * @details Takes the bus lock. Used by the devices that drive the
+         * GPIO from their own thread to update their state consistently with
+         * the bus accesses. The lock is recursive.
+         */
+        static void Lock(void);
+
+        /**
+         * @brief Releases the bus lock.
+         */
+        static void Unlock(void);
+
+        /* Used by the host platform */
+        static void WritePin(const uint8_t kPin, const uint8_t kLevel);
+        static void AttachIsr(const uint8_t kPin,
+                              void          (*handler)(void),
+                              const int     kMode);
+        static void WriteSpi(const uint8_t* pkData,
+                             const uint32_t kSize,
+                             const uint32_t kClock);
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+        /* None */
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        /* None */
+};
+
+#endif /* #ifndef __HOST_HOST_BUS_H_ */
@@ -0,0 +1,135 @@
+/*******************************************************************************
+ * @file SPI.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file defines the SPI bus used by the firmware on the host.
+ *
+ * @details This file defines the SPI bus used by the firmware on the host.
+ * The bytes written on the bus are forwarded to the devices attached to the
+ * host bus and accounted with the clock of the current transaction.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __HOST_SPI_H_
+#define __HOST_SPI_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint>   /* Standard Int Types */
+#include <Arduino.h> /* Arduino services */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+#define MSBFIRST 1
+#define LSBFIRST 0
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x01
+#define SPI_MODE2 0x02
+#define SPI_MODE3 0x03
+
+#define FSPI 1
+#define HSPI 2
+#define VSPI 3
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+
+class SPIClass;
+/** @brief Default SPI bus. */
+extern SPIClass SPI;
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/** @brief SPI transaction settings. */
+class SPISettings
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        SPISettings(const uint32_t kClock,
+                    const uint8_t  kBitOrder,
+                    const uint8_t  kDataMode);
+
+        /** @brief The bus clock in Hz. */
+        uint32_t clock;
+};
+
+/**
+ * @brief Host SPI bus.
+ *
+ * @details Host SPI bus. Only the writes are modeled, the read values are
+ * always 0.
+ */
+class SPIClass
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        explicit SPIClass(const uint8_t kBus = VSPI);
+
+        void    begin(const int8_t kSck  = -1,
+                      const int8_t kMiso = -1,
+                      const int8_t kMosi = -1,
+                      const int8_t kSs   = -1);
+        void    end(void);
+        void    beginTransaction(const SPISettings& rkSettings);
+        void    endTransaction(void);
+        uint8_t transfer(const uint8_t kData);
+        void    writeBytes(const uint8_t* pkData, const uint32_t kSize);
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+        /* None */
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        /** @brief The bus number. */
+        uint8_t  bus_;
+        /** @brief The clock of the current transaction. */
+        uint32_t clock_;
+};
+
+#endif /* #ifndef __HOST_SPI_H_ */
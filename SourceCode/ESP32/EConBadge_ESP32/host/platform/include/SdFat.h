@@ -0,0 +1,231 @@
+/*******************************************************************************
+ * @file SdFat.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file defines the SD card services used by the firmware on the
+ * host.
+ *
+ * @details This file defines the SD card services used by the firmware on the
+ * host. The SD card is replaced by a file system held in memory, shared by all
+ * the SdFs instances of the process. The directories list their entries in
+ * creation order, as the FAT directories do.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __HOST_SDFAT_H_
+#define __HOST_SDFAT_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <memory>    /* std::shared_ptr */
+#include <string>    /* std::string */
+#include <vector>    /* std::vector */
+#include <cstdint>   /* Standard Int Types */
+#include <SPI.h>     /* SPI services */
+#include <Arduino.h> /* Arduino services */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+#define O_RDONLY 0x0000
+#define O_WRONLY 0x0001
+#define O_RDWR   0x0002
+#define O_APPEND 0x0008
+#define O_CREAT  0x0200
+#define O_TRUNC  0x0400
+#define O_EXCL   0x0800
+#define O_AT_END 0x4000
+
+#define FILE_READ  O_RDONLY
+#define FILE_WRITE (O_RDWR | O_CREAT | O_AT_END)
+
+#define DEDICATED_SPI 1
+
+/** @brief Size of a directory entry, used for the directory positions. */
+#define HOST_FS_DIR_ENTRY_SIZE 32
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+#define SD_SCK_MHZ(MHZ) ((MHZ) * 1000000)
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/** @brief File open flags. */
+typedef int oflag_t;
+
+/** @brief SD card identification register. */
+typedef struct
+{
+    uint8_t pData[16];
+} cid_t;
+
+/** @brief SD card configuration register. */
+typedef struct
+{
+    uint8_t pData[8];
+} scr_t;
+
+/** @brief SD card specific data register. */
+typedef struct
+{
+    uint8_t pData[16];
+
+    /** @brief Returns the card capacity in 512 bytes sectors. */
+    uint32_t capacity(void) const
+    {
+        return 0x00400000;
+    }
+} csd_t;
+
+/** @brief A node of the host file system. */
+typedef struct SHostFsNode
+{
+    /** @brief Tells if the node is a directory. */
+    bool                     isDirectory;
+    /** @brief The file content. */
+    std::vector<uint8_t>     content;
+    /** @brief The directory entries, in creation order. */
+    std::vector<std::string> entries;
+} SHostFsNode;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/** @brief SD card SPI configuration. */
+class SdSpiConfig
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        SdSpiConfig(const uint8_t  kCsPin,
+                    const uint8_t  kOptions,
+                    const uint32_t kClock,
+                    SPIClass*      pSpi);
+};
+
+/** @brief SD card. */
+class SdCard
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        uint8_t type(void) const;
+        bool readCID(cid_t* pCid) const;
+        bool readCSD(csd_t* pCsd) const;
+        bool readOCR(uint32_t* pOcr) const;
+        bool readSCR(scr_t* pScr) const;
+};
+
+/**
+ * @brief Host file.
+ *
+ * @details Host file. The file references its node, a removed file stays
+ * readable until it is closed.
+ */
+class FsFile
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        FsFile(void);
+
+        bool open(const char* pkPath, const oflag_t kFlags = O_RDONLY);
+        bool close(void);
+        explicit operator bool(void) const;
+        bool isDirectory(void) const;
+
+        int read(void* pBuffer, const size_t kSize);
+        size_t write(const void* pkBuffer, const size_t kSize);
+        size_t print(const char* pkString);
+        String readString(void);
+        int available(void) const;
+
+        bool seekSet(const uint64_t kPosition);
+        uint64_t curPosition(void) const;
+        uint64_t size(void) const;
+        uint64_t fileSize(void) const;
+        bool truncate(const uint64_t kSize);
+        bool sync(void);
+
+        FsFile openNextFile(const oflag_t kFlags = O_RDONLY);
+        size_t getName(char* pName, const size_t kSize) const;
+        bool getModifyDateTime(uint16_t* pDate, uint16_t* pTime) const;
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+        /* None */
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        /** @brief The file node. */
+        std::shared_ptr<SHostFsNode> pNode_;
+        /** @brief The file path. */
+        std::string                  path_;
+        /** @brief The file position, or the next entry of a directory. */
+        uint64_t                     position_;
+        /** @brief Tells if the file can be written. */
+        bool                         writable_;
+};
+
+/** @brief Host SD card file system. */
+class SdFs
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        bool begin(const SdSpiConfig& rkConfig);
+        SdCard* card(void);
+        void initErrorHalt(HardwareSerial* pSerial);
+
+        bool exists(const char* pkPath) const;
+        bool mkdir(const char* pkPath, const bool kParents = true);
+        bool rmdir(const char* pkPath);
+        bool remove(const char* pkPath);
+        bool rename(const char* pkOldPath, const char* pkNewPath);
+        bool format(void);
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+        /* None */
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        /** @brief The card. */
+        SdCard card_;
+};
+
+#endif /* #ifndef __HOST_SDFAT_H_ */
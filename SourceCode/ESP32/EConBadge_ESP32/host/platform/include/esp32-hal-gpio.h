@@ -0,0 +1,109 @@
+/*******************************************************************************
+ * @file esp32-hal-gpio.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file defines the ESP32 GPIO numbers on the host.
+ *
+ * @details This file defines the ESP32 GPIO numbers on the host. The host bus
+ * exposes the same pins as the ESP32.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __HOST_ESP32_HAL_GPIO_H_
+#define __HOST_ESP32_HAL_GPIO_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+#define INPUT_PULLUP   0x05
+#define INPUT_PULLDOWN 0x09
+
+/** @brief Number of GPIO modeled on the host bus. */
+#define GPIO_NUM_MAX 40
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/** @brief ESP32 GPIO numbers. */
+typedef enum
+{
+    GPIO_NUM_0  = 0,
+    GPIO_NUM_1  = 1,
+    GPIO_NUM_2  = 2,
+    GPIO_NUM_3  = 3,
+    GPIO_NUM_4  = 4,
+    GPIO_NUM_5  = 5,
+    GPIO_NUM_12 = 12,
+    GPIO_NUM_13 = 13,
+    GPIO_NUM_14 = 14,
+    GPIO_NUM_15 = 15,
+    GPIO_NUM_16 = 16,
+    GPIO_NUM_17 = 17,
+    GPIO_NUM_18 = 18,
+    GPIO_NUM_19 = 19,
+    GPIO_NUM_21 = 21,
+    GPIO_NUM_22 = 22,
+    GPIO_NUM_23 = 23,
+    GPIO_NUM_25 = 25,
+    GPIO_NUM_26 = 26,
+    GPIO_NUM_27 = 27,
+    GPIO_NUM_32 = 32,
+    GPIO_NUM_33 = 33,
+    GPIO_NUM_34 = 34,
+    GPIO_NUM_35 = 35,
+    GPIO_NUM_36 = 36,
+    GPIO_NUM_39 = 39
+} gpio_num_t;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/* None */
+
+#endif /* #ifndef __HOST_ESP32_HAL_GPIO_H_ */
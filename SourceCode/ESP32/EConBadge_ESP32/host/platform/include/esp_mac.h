@@ -0,0 +1,76 @@
+/*******************************************************************************
+ * @file esp_mac.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file defines the ESP32 MAC address services on the host.
+ *
+ * @details This file defines the ESP32 MAC address services on the host. A
+ * fixed address is returned.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __HOST_ESP_MAC_H_
+#define __HOST_ESP_MAC_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint> /* Standard Int Types */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Bluetooth MAC address. */
+#define ESP_MAC_BT 2
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+int esp_read_mac(uint8_t* pMac, const int kType);
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/* None */
+
+#endif /* #ifndef __HOST_ESP_MAC_H_ */
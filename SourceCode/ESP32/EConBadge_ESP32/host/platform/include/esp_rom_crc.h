@@ -0,0 +1,77 @@
+/*******************************************************************************
+ * @file esp_rom_crc.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file defines the ESP32 ROM CRC services on the host.
+ *
+ * @details This file defines the ESP32 ROM CRC services on the host. The
+ * CRC32 is the little endian IEEE 802.3 CRC used by the ESP32 ROM.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __HOST_ESP_ROM_CRC_H_
+#define __HOST_ESP_ROM_CRC_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint> /* Standard Int Types */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+uint32_t esp_rom_crc32_le(uint32_t       crc,
+                          const uint8_t* pkBuffer,
+                          uint32_t       size);
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/* None */
+
+#endif /* #ifndef __HOST_ESP_ROM_CRC_H_ */
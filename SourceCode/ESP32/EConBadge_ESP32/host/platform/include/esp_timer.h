@@ -0,0 +1,75 @@
+/*******************************************************************************
+ * @file esp_timer.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file defines the ESP32 timer services on the host.
+ *
+ * @details This file defines the ESP32 timer services on the host. The time
+ * is the host monotonic clock in microseconds.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __HOST_ESP_TIMER_H_
+#define __HOST_ESP_TIMER_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint> /* Standard Int Types */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+int64_t esp_timer_get_time(void);
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/* None */
+
+#endif /* #ifndef __HOST_ESP_TIMER_H_ */
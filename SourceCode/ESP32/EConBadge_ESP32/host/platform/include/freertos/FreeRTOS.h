@@ -0,0 +1,142 @@
+/*******************************************************************************
+ * @file FreeRTOS.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file defines the FreeRTOS services used by the firmware on the
+ * host.
+ *
+ * @details This file defines the FreeRTOS services used by the firmware on the
+ * host. Tasks are threads, queues and semaphores are implemented with the
+ * standard synchronization primitives. A tick is one millisecond.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __HOST_FREERTOS_H_
+#define __HOST_FREERTOS_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint> /* Standard Int Types */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+#define pdTRUE  1
+#define pdFALSE 0
+#define pdPASS  1
+#define pdFAIL  0
+
+#define portMAX_DELAY      0xFFFFFFFF
+#define portTICK_PERIOD_MS 1
+
+#define tskNO_AFFINITY 0x7FFFFFFF
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+#define pdMS_TO_TICKS(MS) ((TickType_t)(MS))
+
+#define portYIELD_FROM_ISR(...)
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+typedef int          BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t     TickType_t;
+typedef void*        SemaphoreHandle_t;
+typedef void*        QueueHandle_t;
+typedef void*        TaskHandle_t;
+typedef void         (*TaskFunction_t)(void*);
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+SemaphoreHandle_t xSemaphoreCreateCounting(const UBaseType_t kMax,
+                                           const UBaseType_t kInitial);
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex(void);
+BaseType_t        xSemaphoreTake(SemaphoreHandle_t semaphore,
+                                 const TickType_t  kTimeout);
+BaseType_t        xSemaphoreGive(SemaphoreHandle_t semaphore);
+BaseType_t        xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore,
+                                        BaseType_t*       pWoken);
+BaseType_t        xSemaphoreTakeRecursive(SemaphoreHandle_t semaphore,
+                                          const TickType_t  kTimeout);
+BaseType_t        xSemaphoreGiveRecursive(SemaphoreHandle_t semaphore);
+UBaseType_t       uxSemaphoreGetCount(SemaphoreHandle_t semaphore);
+void              vSemaphoreDelete(SemaphoreHandle_t semaphore);
+
+QueueHandle_t xQueueCreate(const UBaseType_t kLength,
+                           const UBaseType_t kItemSize);
+BaseType_t    xQueueSend(QueueHandle_t    queue,
+                         const void*      pkItem,
+                         const TickType_t kTimeout);
+BaseType_t    xQueueSendToFront(QueueHandle_t    queue,
+                                const void*      pkItem,
+                                const TickType_t kTimeout);
+BaseType_t    xQueueOverwrite(QueueHandle_t queue, const void* pkItem);
+BaseType_t    xQueueReceive(QueueHandle_t    queue,
+                            void*            pItem,
+                            const TickType_t kTimeout);
+BaseType_t    xQueuePeek(QueueHandle_t    queue,
+                         void*            pItem,
+                         const TickType_t kTimeout);
+BaseType_t    xQueueReset(QueueHandle_t queue);
+UBaseType_t   uxQueueMessagesWaiting(QueueHandle_t queue);
+UBaseType_t   uxQueueSpacesAvailable(QueueHandle_t queue);
+void          vQueueDelete(QueueHandle_t queue);
+
+BaseType_t   xTaskCreatePinnedToCore(TaskFunction_t    routine,
+                                     const char*       pkName,
+                                     const uint32_t    kStackSize,
+                                     void*             pParam,
+                                     const UBaseType_t kPriority,
+                                     TaskHandle_t*     pTask,
+                                     const BaseType_t  kCore);
+void         vTaskDelete(TaskHandle_t task);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+BaseType_t   xTaskNotifyGive(TaskHandle_t task);
+uint32_t     ulTaskNotifyTake(const BaseType_t kClear,
+                              const TickType_t kTimeout);
+void         vTaskDelay(const TickType_t kTicks);
+TickType_t   xTaskGetTickCount(void);
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/* None */
+
+#endif /* #ifndef __HOST_FREERTOS_H_ */
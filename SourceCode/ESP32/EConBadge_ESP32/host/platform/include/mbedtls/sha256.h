@@ -0,0 +1,94 @@
+/*******************************************************************************
+ * @file sha256.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file defines the mbedTLS SHA-256 services on the host.
+ *
+ * @details This file defines the mbedTLS SHA-256 services on the host. Only
+ * SHA-256 is provided, the SHA-224 mode is not supported.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __HOST_MBEDTLS_SHA256_H_
+#define __HOST_MBEDTLS_SHA256_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint> /* Standard Int Types */
+#include <cstddef> /* Standard size types */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/** @brief SHA-256 context. */
+typedef struct
+{
+    /** @brief Number of bytes hashed. */
+    uint64_t      total;
+    /** @brief Intermediate digest. */
+    uint32_t      state[8];
+    /** @brief Pending block. */
+    unsigned char buffer[64];
+} mbedtls_sha256_context;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+void mbedtls_sha256_init(mbedtls_sha256_context* pCtx);
+void mbedtls_sha256_free(mbedtls_sha256_context* pCtx);
+void mbedtls_sha256_clone(mbedtls_sha256_context*       pDst,
+                          const mbedtls_sha256_context* pkSrc);
+int  mbedtls_sha256_starts(mbedtls_sha256_context* pCtx, const int kIs224);
+int  mbedtls_sha256_update(mbedtls_sha256_context* pCtx,
+                           const unsigned char*    pkInput,
+                           const size_t            kSize);
+int  mbedtls_sha256_finish(mbedtls_sha256_context* pCtx,
+                           unsigned char*          pOutput);
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/* None */
+
+#endif /* #ifndef __HOST_MBEDTLS_SHA256_H_ */
@@ -0,0 +1,310 @@
+/*******************************************************************************
+ * @file Arduino.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file implements the Arduino services and the host bus.
+ *
+ * @details This file implements the Arduino services and the host bus. The
+ * GPIO levels and the interrupt handlers are kept per pin, the devices are
+ * called with the bus lock held so that they observe a consistent sequence.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <mutex>     /* std::recursive_mutex */
+#include <chrono>    /* std::chrono */
+#include <thread>    /* std::this_thread */
+#include <vector>    /* std::vector */
+#include <cstdarg>   /* va_list */
+#include <algorithm> /* std::find */
+#include <HostBus.h> /* Host bus */
+
+/* Header File */
+#include <Arduino.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Size of the serial output buffer. */
+#define SERIAL_BUFFER_SIZE 512
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/** @brief State of a GPIO. */
+typedef struct
+{
+    /** @brief The GPIO level. */
+    uint8_t level;
+    /** @brief The GPIO mode. */
+    uint8_t mode;
+    /** @brief The interrupt mode. */
+    int     isrMode;
+    /** @brief The interrupt handler. */
+    void    (*isr)(void);
+} SHostPin;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+
+/** @brief See Arduino.h */
+HardwareSerial Serial;
+
+/************************** Static global variables ***************************/
+
+/** @brief Bus lock, the devices can access the bus from their callbacks. */
+static std::recursive_mutex sBusLock;
+/** @brief The GPIO states. */
+static SHostPin spPins[GPIO_NUM_MAX];
+/** @brief The attached devices. */
+static std::vector<HostDevice*> sDevices;
+/** @brief The SPI bus traffic counters. */
+static SHostSpiCounters sSpiCounters;
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+void pinMode(const uint8_t kPin, const uint8_t kMode)
+{
+    std::lock_guard<std::recursive_mutex> lock(sBusLock);
+
+    if(kPin < GPIO_NUM_MAX)
+    {
+        spPins[kPin].mode = kMode;
+    }
+}
+
+void digitalWrite(const uint8_t kPin, const uint8_t kLevel)
+{
+    HostBus::WritePin(kPin, kLevel);
+}
+
+int digitalRead(const uint8_t kPin)
+{
+    return HostBus::GetPin(kPin);
+}
+
+int digitalPinToInterrupt(const uint8_t kPin)
+{
+    return kPin;
+}
+
+void attachInterrupt(const uint8_t kPin,
+                     void          (*handler)(void),
+                     const int     kMode)
+{
+    HostBus::AttachIsr(kPin, handler, kMode);
+}
+
+void detachInterrupt(const uint8_t kPin)
+{
+    HostBus::AttachIsr(kPin, nullptr, 0);
+}
+
+void ets_delay_us(const uint32_t kDelayUs)
+{
+    std::this_thread::sleep_for(std::chrono::microseconds(kDelayUs));
+}
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+HardwareSerial::HardwareSerial(void)
+{
+    pCapture_ = nullptr;
+}
+
+void HardwareSerial::begin(const unsigned long kBaudRate)
+{
+    (void)kBaudRate;
+}
+
+int HardwareSerial::printf(const char* pkFormat, ...)
+{
+    va_list argptr;
+    int     len;
+    char    pBuffer[SERIAL_BUFFER_SIZE];
+
+    va_start(argptr, pkFormat);
+    len = vsnprintf(pBuffer, sizeof(pBuffer), pkFormat, argptr);
+    va_end(argptr);
+
+    if(pCapture_ != nullptr)
+    {
+        pCapture_->append(pBuffer);
+    }
+    else
+    {
+        fputs(pBuffer, stdout);
+    }
+
+    return len;
+}
+
+void HardwareSerial::setCapture(std::string* pCapture)
+{
+    pCapture_ = pCapture;
+}
+
+void HostBus::Attach(HostDevice* pDevice)
+{
+    std::lock_guard<std::recursive_mutex> lock(sBusLock);
+
+    sDevices.push_back(pDevice);
+}
+
+void HostBus::Detach(HostDevice* pDevice)
+{
+    std::vector<HostDevice*>::iterator it;
+
+    std::lock_guard<std::recursive_mutex> lock(sBusLock);
+
+    it = std::find(sDevices.begin(), sDevices.end(), pDevice);
+    if(it != sDevices.end())
+    {
+        sDevices.erase(it);
+    }
+}
+
+void HostBus::DrivePin(const uint8_t kPin, const uint8_t kLevel)
+{
+    uint8_t   oldLevel;
+    bool      raise;
+    SHostPin* pPin;
+
+    std::lock_guard<std::recursive_mutex> lock(sBusLock);
+
+    if(kPin >= GPIO_NUM_MAX)
+    {
+        return;
+    }
+    pPin = &spPins[kPin];
+
+    oldLevel    = pPin->level;
+    pPin->level = kLevel;
+
+    if(pPin->isr == nullptr || oldLevel == kLevel)
+    {
+        return;
+    }
+    raise = (pPin->isrMode == CHANGE) ||
+            (pPin->isrMode == RISING && kLevel == HIGH) ||
+            (pPin->isrMode == FALLING && kLevel == LOW);
+    if(raise)
+    {
+        pPin->isr();
+    }
+}
+
+uint8_t HostBus::GetPin(const uint8_t kPin)
+{
+    std::lock_guard<std::recursive_mutex> lock(sBusLock);
+
+    return kPin < GPIO_NUM_MAX ? spPins[kPin].level : LOW;
+}
+
+void HostBus::GetSpiCounters(SHostSpiCounters& rCounters)
+{
+    std::lock_guard<std::recursive_mutex> lock(sBusLock);
+
+    rCounters = sSpiCounters;
+}
+
+void HostBus::ClearSpiCounters(void)
+{
+    std::lock_guard<std::recursive_mutex> lock(sBusLock);
+
+    memset(&sSpiCounters, 0, sizeof(SHostSpiCounters));
+}
+
+void HostBus::Lock(void)
+{
+    sBusLock.lock();
+}
+
+void HostBus::Unlock(void)
+{
+    sBusLock.unlock();
+}
+
+void HostBus::WritePin(const uint8_t kPin, const uint8_t kLevel)
+{
+    size_t i;
+
+    std::lock_guard<std::recursive_mutex> lock(sBusLock);
+
+    if(kPin >= GPIO_NUM_MAX)
+    {
+        return;
+    }
+    spPins[kPin].level = kLevel;
+
+    for(i = 0; i < sDevices.size(); ++i)
+    {
+        sDevices[i]->OnPinWrite(kPin, kLevel);
+    }
+}
+
+void HostBus::AttachIsr(const uint8_t kPin,
+                        void          (*handler)(void),
+                        const int     kMode)
+{
+    std::lock_guard<std::recursive_mutex> lock(sBusLock);
+
+    if(kPin < GPIO_NUM_MAX)
+    {
+        spPins[kPin].isr     = handler;
+        spPins[kPin].isrMode = kMode;
+    }
+}
+
+void HostBus::WriteSpi(const uint8_t* pkData,
+                       const uint32_t kSize,
+                       const uint32_t kClock)
+{
+    size_t i;
+
+    std::lock_guard<std::recursive_mutex> lock(sBusLock);
+
+    sSpiCounters.bytes  += kSize;
+    sSpiCounters.writes += 1;
+    if(kClock != 0)
+    {
+        sSpiCounters.wireTime += (uint64_t)kSize * 8 * 1000000 / kClock;
+    }
+
+    for(i = 0; i < sDevices.size(); ++i)
+    {
+        sDevices[i]->OnSpiWrite(pkData, kSize);
+    }
+}
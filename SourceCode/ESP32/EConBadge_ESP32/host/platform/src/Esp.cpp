@@ -0,0 +1,114 @@
+/*******************************************************************************
+ * @file Esp.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file implements the ESP32 SDK services on the host.
+ *
+ * @details This file implements the ESP32 SDK services on the host: the ROM
+ * CRC32, the microsecond timer and the MAC address.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <chrono>        /* std::chrono */
+#include <cstring>       /* memcpy */
+#include <esp_mac.h>     /* MAC address services */
+#include <esp_timer.h>   /* Timer services */
+#include <esp_rom_crc.h> /* CRC32 services */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Reflected CRC32 polynomial. */
+#define CRC32_POLYNOMIAL 0xEDB88320
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+
+/** @brief Host MAC address. */
+static const uint8_t skpHostMac[6] = { 0xEC, 0xB0, 0x00, 0x00, 0x00, 0x01 };
+
+/** @brief Start time of the process. */
+static const std::chrono::steady_clock::time_point sStartTime =
+    std::chrono::steady_clock::now();
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+uint32_t esp_rom_crc32_le(uint32_t       crc,
+                          const uint8_t* pkBuffer,
+                          uint32_t       size)
+{
+    uint8_t i;
+
+    crc = ~crc;
+    while(size-- > 0)
+    {
+        crc ^= *pkBuffer++;
+        for(i = 0; i < 8; ++i)
+        {
+            crc = (crc >> 1) ^ (CRC32_POLYNOMIAL & (0 - (crc & 1)));
+        }
+    }
+
+    return ~crc;
+}
+
+int64_t esp_timer_get_time(void)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - sStartTime
+    ).count();
+}
+
+int esp_read_mac(uint8_t* pMac, const int kType)
+{
+    (void)kType;
+
+    memcpy(pMac, skpHostMac, sizeof(skpHostMac));
+
+    return 0;
+}
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+/* None */
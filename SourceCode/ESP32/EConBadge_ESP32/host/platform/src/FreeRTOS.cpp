@@ -0,0 +1,539 @@
+/*******************************************************************************
+ * @file FreeRTOS.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file implements the FreeRTOS services used by the firmware on
+ * the host.
+ *
+ * @details This file implements the FreeRTOS services used by the firmware on
+ * the host. Each object owns a mutex and a condition variable, the waits
+ * are bounded by the FreeRTOS timeouts expressed in milliseconds.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <mutex>              /* std::mutex */
+#include <deque>              /* std::deque */
+#include <chrono>             /* std::chrono */
+#include <thread>             /* std::thread */
+#include <vector>             /* std::vector */
+#include <cstring>            /* memcpy */
+#include <condition_variable> /* std::condition_variable */
+
+/* Header File */
+#include <freertos/FreeRTOS.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/** @brief Host queue. */
+typedef struct
+{
+    /** @brief Queue lock. */
+    std::mutex                       lock;
+    /** @brief Signaled when an item is pushed or popped. */
+    std::condition_variable          signal;
+    /** @brief The queued items. */
+    std::deque<std::vector<uint8_t>> items;
+    /** @brief The size of an item. */
+    size_t                           itemSize;
+    /** @brief The queue length. */
+    size_t                           length;
+} SHostQueue;
+
+/** @brief Host semaphore, also used for the mutexes. */
+typedef struct
+{
+    /** @brief Semaphore lock. */
+    std::mutex              lock;
+    /** @brief Signaled when the semaphore is given. */
+    std::condition_variable signal;
+    /** @brief Current count. */
+    UBaseType_t             count;
+    /** @brief Maximal count. */
+    UBaseType_t             max;
+} SHostSemaphore;
+
+/** @brief Host task, only the notifications are modeled. */
+typedef struct
+{
+    /** @brief Notification lock. */
+    std::mutex              lock;
+    /** @brief Signaled when the task is notified. */
+    std::condition_variable signal;
+    /** @brief Notification value. */
+    uint32_t                notification;
+} SHostTask;
+
+/** @brief Thrown by a task that deletes itself to leave its thread. */
+typedef struct
+{
+    /** @brief The deleted task. */
+    SHostTask* pTask;
+} SHostTaskDeleted;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+
+/** @brief The task running on the current thread. */
+static thread_local SHostTask* spCurrentTask = nullptr;
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/**
+ * @brief Waits on a condition with a FreeRTOS timeout.
+ *
+ * @param[in, out] rLock The held lock.
+ * @param[in, out] rSignal The condition variable.
+ * @param[in] kTimeout The timeout in ticks.
+ * @param[in] kPredicate The condition to wait for.
+ *
+ * @return true is returned if the condition is met, false on timeout.
+ */
+template<typename TPredicate>
+static bool WaitFor(std::unique_lock<std::mutex>& rLock,
+                    std::condition_variable&      rSignal,
+                    const TickType_t              kTimeout,
+                    const TPredicate              kPredicate);
+
+/**
+ * @brief Pushes an item in a queue.
+ *
+ * @param[in] queue The queue.
+ * @param[in] pkItem The item to push.
+ * @param[in] kTimeout The timeout in ticks.
+ * @param[in] kFront Tells if the item is pushed in front of the queue.
+ *
+ * @return pdTRUE is returned on success, pdFALSE on timeout.
+ */
+static BaseType_t QueuePush(QueueHandle_t    queue,
+                            const void*      pkItem,
+                            const TickType_t kTimeout,
+                            const bool       kFront);
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+template<typename TPredicate>
+static bool WaitFor(std::unique_lock<std::mutex>& rLock,
+                    std::condition_variable&      rSignal,
+                    const TickType_t              kTimeout,
+                    const TPredicate              kPredicate)
+{
+    if(kTimeout == portMAX_DELAY)
+    {
+        rSignal.wait(rLock, kPredicate);
+        return true;
+    }
+    return rSignal.wait_for(rLock,
+                            std::chrono::milliseconds(kTimeout),
+                            kPredicate);
+}
+
+static BaseType_t QueuePush(QueueHandle_t    queue,
+                            const void*      pkItem,
+                            const TickType_t kTimeout,
+                            const bool       kFront)
+{
+    SHostQueue*    pQueue;
+    const uint8_t* pkBytes;
+
+    pQueue = (SHostQueue*)queue;
+    std::unique_lock<std::mutex> lock(pQueue->lock);
+
+    if(!WaitFor(lock, pQueue->signal, kTimeout,
+                [pQueue]{ return pQueue->items.size() < pQueue->length; }))
+    {
+        return pdFALSE;
+    }
+
+    pkBytes = (const uint8_t*)pkItem;
+    if(kFront)
+    {
+        pQueue->items.emplace_front(pkBytes, pkBytes + pQueue->itemSize);
+    }
+    else
+    {
+        pQueue->items.emplace_back(pkBytes, pkBytes + pQueue->itemSize);
+    }
+    pQueue->signal.notify_all();
+
+    return pdTRUE;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    return xSemaphoreCreateCounting(1, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    return xSemaphoreCreateCounting(1, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(const UBaseType_t kMax,
+                                           const UBaseType_t kInitial)
+{
+    SHostSemaphore* pSemaphore;
+
+    pSemaphore        = new SHostSemaphore;
+    pSemaphore->count = kInitial;
+    pSemaphore->max   = kMax;
+
+    return pSemaphore;
+}
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex(void)
+{
+    return new std::recursive_timed_mutex;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore,
+                          const TickType_t  kTimeout)
+{
+    SHostSemaphore* pSemaphore;
+
+    pSemaphore = (SHostSemaphore*)semaphore;
+    std::unique_lock<std::mutex> lock(pSemaphore->lock);
+
+    if(!WaitFor(lock, pSemaphore->signal, kTimeout,
+                [pSemaphore]{ return pSemaphore->count > 0; }))
+    {
+        return pdFALSE;
+    }
+    --pSemaphore->count;
+
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore)
+{
+    SHostSemaphore* pSemaphore;
+
+    pSemaphore = (SHostSemaphore*)semaphore;
+    std::lock_guard<std::mutex> lock(pSemaphore->lock);
+
+    if(pSemaphore->count >= pSemaphore->max)
+    {
+        return pdFALSE;
+    }
+    ++pSemaphore->count;
+    pSemaphore->signal.notify_all();
+
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore,
+                                 BaseType_t*       pWoken)
+{
+    if(pWoken != nullptr)
+    {
+        *pWoken = pdFALSE;
+    }
+    return xSemaphoreGive(semaphore);
+}
+
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t semaphore,
+                                   const TickType_t  kTimeout)
+{
+    std::recursive_timed_mutex* pMutex;
+
+    pMutex = (std::recursive_timed_mutex*)semaphore;
+    if(kTimeout == portMAX_DELAY)
+    {
+        pMutex->lock();
+        return pdTRUE;
+    }
+
+    return pMutex->try_lock_for(std::chrono::milliseconds(kTimeout)) ?
+           pdTRUE : pdFALSE;
+}
+
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t semaphore)
+{
+    ((std::recursive_timed_mutex*)semaphore)->unlock();
+    return pdTRUE;
+}
+
+UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t semaphore)
+{
+    SHostSemaphore* pSemaphore;
+
+    pSemaphore = (SHostSemaphore*)semaphore;
+    std::lock_guard<std::mutex> lock(pSemaphore->lock);
+
+    return pSemaphore->count;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore)
+{
+    delete (SHostSemaphore*)semaphore;
+}
+
+QueueHandle_t xQueueCreate(const UBaseType_t kLength,
+                           const UBaseType_t kItemSize)
+{
+    SHostQueue* pQueue;
+
+    pQueue           = new SHostQueue;
+    pQueue->itemSize = kItemSize;
+    pQueue->length   = kLength;
+
+    return pQueue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t    queue,
+                      const void*      pkItem,
+                      const TickType_t kTimeout)
+{
+    return QueuePush(queue, pkItem, kTimeout, false);
+}
+
+BaseType_t xQueueSendToFront(QueueHandle_t    queue,
+                             const void*      pkItem,
+                             const TickType_t kTimeout)
+{
+    return QueuePush(queue, pkItem, kTimeout, true);
+}
+
+BaseType_t xQueueOverwrite(QueueHandle_t queue, const void* pkItem)
+{
+    SHostQueue*    pQueue;
+    const uint8_t* pkBytes;
+
+    pQueue = (SHostQueue*)queue;
+    std::lock_guard<std::mutex> lock(pQueue->lock);
+
+    /* Only used on queues of length 1 */
+    pkBytes = (const uint8_t*)pkItem;
+    pQueue->items.clear();
+    pQueue->items.emplace_back(pkBytes, pkBytes + pQueue->itemSize);
+    pQueue->signal.notify_all();
+
+    return pdPASS;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t    queue,
+                         void*            pItem,
+                         const TickType_t kTimeout)
+{
+    SHostQueue* pQueue;
+
+    pQueue = (SHostQueue*)queue;
+    std::unique_lock<std::mutex> lock(pQueue->lock);
+
+    if(!WaitFor(lock, pQueue->signal, kTimeout,
+                [pQueue]{ return !pQueue->items.empty(); }))
+    {
+        return pdFALSE;
+    }
+    memcpy(pItem, pQueue->items.front().data(), pQueue->itemSize);
+    pQueue->items.pop_front();
+    pQueue->signal.notify_all();
+
+    return pdTRUE;
+}
+
+BaseType_t xQueuePeek(QueueHandle_t    queue,
+                      void*            pItem,
+                      const TickType_t kTimeout)
+{
+    SHostQueue* pQueue;
+
+    pQueue = (SHostQueue*)queue;
+    std::unique_lock<std::mutex> lock(pQueue->lock);
+
+    if(!WaitFor(lock, pQueue->signal, kTimeout,
+                [pQueue]{ return !pQueue->items.empty(); }))
+    {
+        return pdFALSE;
+    }
+    memcpy(pItem, pQueue->items.front().data(), pQueue->itemSize);
+
+    return pdTRUE;
+}
+
+BaseType_t xQueueReset(QueueHandle_t queue)
+{
+    SHostQueue* pQueue;
+
+    pQueue = (SHostQueue*)queue;
+    std::lock_guard<std::mutex> lock(pQueue->lock);
+
+    pQueue->items.clear();
+    pQueue->signal.notify_all();
+
+    return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue)
+{
+    SHostQueue* pQueue;
+
+    pQueue = (SHostQueue*)queue;
+    std::lock_guard<std::mutex> lock(pQueue->lock);
+
+    return pQueue->items.size();
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t queue)
+{
+    SHostQueue* pQueue;
+
+    pQueue = (SHostQueue*)queue;
+    std::lock_guard<std::mutex> lock(pQueue->lock);
+
+    return pQueue->length - pQueue->items.size();
+}
+
+void vQueueDelete(QueueHandle_t queue)
+{
+    delete (SHostQueue*)queue;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t    routine,
+                                   const char*       pkName,
+                                   const uint32_t    kStackSize,
+                                   void*             pParam,
+                                   const UBaseType_t kPriority,
+                                   TaskHandle_t*     pTask,
+                                   const BaseType_t  kCore)
+{
+    SHostTask* pNewTask;
+
+    (void)pkName;
+    (void)kStackSize;
+    (void)kPriority;
+    (void)kCore;
+
+    pNewTask               = new SHostTask;
+    pNewTask->notification = 0;
+    if(pTask != nullptr)
+    {
+        *pTask = pNewTask;
+    }
+
+    /* Tasks never return, the thread lives until the process exits or the
+     * task deletes itself.
+     */
+    std::thread([routine, pParam, pNewTask]
+    {
+        spCurrentTask = pNewTask;
+        try
+        {
+            routine(pParam);
+        }
+        catch(const SHostTaskDeleted& rkDeleted)
+        {
+            delete rkDeleted.pTask;
+        }
+    }).detach();
+
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    SHostTaskDeleted deleted;
+
+    /* Only the tasks deleting themselves are modeled */
+    if(task == nullptr || task == spCurrentTask)
+    {
+        deleted.pTask = spCurrentTask;
+        throw deleted;
+    }
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    if(spCurrentTask == nullptr)
+    {
+        spCurrentTask               = new SHostTask;
+        spCurrentTask->notification = 0;
+    }
+    return spCurrentTask;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    SHostTask* pTask;
+
+    pTask = (SHostTask*)task;
+    std::lock_guard<std::mutex> lock(pTask->lock);
+
+    ++pTask->notification;
+    pTask->signal.notify_all();
+
+    return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(const BaseType_t kClear,
+                          const TickType_t kTimeout)
+{
+    SHostTask* pTask;
+    uint32_t   value;
+
+    pTask = (SHostTask*)xTaskGetCurrentTaskHandle();
+    std::unique_lock<std::mutex> lock(pTask->lock);
+
+    if(!WaitFor(lock, pTask->signal, kTimeout,
+                [pTask]{ return pTask->notification > 0; }))
+    {
+        return 0;
+    }
+    value = pTask->notification;
+    pTask->notification = (kClear == pdTRUE) ? 0 : value - 1;
+
+    return value;
+}
+
+void vTaskDelay(const TickType_t kTicks)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(kTicks));
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+/* None */
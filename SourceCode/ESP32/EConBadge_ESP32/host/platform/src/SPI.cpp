@@ -0,0 +1,126 @@
+/*******************************************************************************
+ * @file SPI.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file implements the SPI bus used by the firmware on the host.
+ *
+ * @details This file implements the SPI bus used by the firmware on the host.
+ * The writes are forwarded to the host bus with the transaction clock.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <HostBus.h> /* Host bus */
+
+/* Header File */
+#include <SPI.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Clock used outside of the transactions. */
+#define SPI_DEFAULT_CLOCK 1000000
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+
+/** @brief See SPI.h */
+SPIClass SPI(VSPI);
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+SPISettings::SPISettings(const uint32_t kClock,
+                         const uint8_t  kBitOrder,
+                         const uint8_t  kDataMode)
+{
+    (void)kBitOrder;
+    (void)kDataMode;
+
+    clock = kClock;
+}
+
+SPIClass::SPIClass(const uint8_t kBus)
+{
+    bus_   = kBus;
+    clock_ = SPI_DEFAULT_CLOCK;
+}
+
+void SPIClass::begin(const int8_t kSck,
+                     const int8_t kMiso,
+                     const int8_t kMosi,
+                     const int8_t kSs)
+{
+    (void)kSck;
+    (void)kMiso;
+    (void)kMosi;
+    (void)kSs;
+}
+
+void SPIClass::end(void)
+{
+}
+
+void SPIClass::beginTransaction(const SPISettings& rkSettings)
+{
+    clock_ = rkSettings.clock;
+}
+
+void SPIClass::endTransaction(void)
+{
+    clock_ = SPI_DEFAULT_CLOCK;
+}
+
+uint8_t SPIClass::transfer(const uint8_t kData)
+{
+    HostBus::WriteSpi(&kData, 1, clock_);
+    return 0;
+}
+
+void SPIClass::writeBytes(const uint8_t* pkData, const uint32_t kSize)
+{
+    HostBus::WriteSpi(pkData, kSize, clock_);
+}
@@ -0,0 +1,627 @@
+/*******************************************************************************
+ * @file SdFat.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file implements the SD card services on the host.
+ *
+ * @details This file implements the SD card services on the host. The nodes
+ * are indexed by their full path. As on FAT, a removed entry leaves a hole in
+ * its directory so that the directory positions of the other entries do not
+ * move.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <map>       /* std::map */
+#include <mutex>     /* std::recursive_mutex */
+#include <algorithm> /* std::find */
+
+/* Header File */
+#include <SdFat.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief SD card type reported by the host card (SDHC). */
+#define HOST_FS_CARD_TYPE 3
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/** @brief Host file system nodes, indexed by path. */
+typedef std::map<std::string, std::shared_ptr<SHostFsNode>> TNodes;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+
+/** @brief File system lock, the firmware tasks share the file system. */
+static std::recursive_mutex sFsLock;
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/**
+ * @brief Returns the file system nodes, created with the root directory.
+ *
+ * @return The file system nodes are returned.
+ */
+static TNodes& GetNodes(void);
+
+/**
+ * @brief Splits a path in its parent directory and its name.
+ *
+ * @param[in] rkPath The path to split.
+ * @param[out] rParent The parent directory.
+ * @param[out] rName The name.
+ */
+static void SplitPath(const std::string& rkPath,
+                      std::string&       rParent,
+                      std::string&       rName);
+
+/**
+ * @brief Adds a node to the file system and to its parent directory.
+ *
+ * @param[in] rkPath The node path.
+ * @param[in] kIsDirectory Tells if the node is a directory.
+ *
+ * @return The new node is returned, nullptr if the parent does not exist.
+ */
+static std::shared_ptr<SHostFsNode> AddNode(const std::string& rkPath,
+                                            const bool         kIsDirectory);
+
+/**
+ * @brief Removes a node from the file system and leaves a hole in its parent
+ * directory.
+ *
+ * @param[in] rkPath The node path.
+ */
+static void RemoveNode(const std::string& rkPath);
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+static TNodes& GetNodes(void)
+{
+    static TNodes sNodes;
+
+    if(sNodes.empty())
+    {
+        sNodes["/"] = std::make_shared<SHostFsNode>();
+        sNodes["/"]->isDirectory = true;
+    }
+
+    return sNodes;
+}
+
+static void SplitPath(const std::string& rkPath,
+                      std::string&       rParent,
+                      std::string&       rName)
+{
+    size_t separator;
+
+    separator = rkPath.rfind('/');
+    if(separator == std::string::npos)
+    {
+        rParent = "/";
+        rName   = rkPath;
+    }
+    else
+    {
+        rParent = (separator == 0) ? "/" : rkPath.substr(0, separator);
+        rName   = rkPath.substr(separator + 1);
+    }
+}
+
+static std::shared_ptr<SHostFsNode> AddNode(const std::string& rkPath,
+                                            const bool         kIsDirectory)
+{
+    std::string                  parent;
+    std::string                  name;
+    std::shared_ptr<SHostFsNode> pNode;
+    TNodes::iterator             it;
+
+    SplitPath(rkPath, parent, name);
+    it = GetNodes().find(parent);
+    if(it == GetNodes().end() || !it->second->isDirectory || name.empty())
+    {
+        return nullptr;
+    }
+    it->second->entries.push_back(name);
+
+    pNode = std::make_shared<SHostFsNode>();
+    pNode->isDirectory = kIsDirectory;
+    GetNodes()[rkPath] = pNode;
+
+    return pNode;
+}
+
+static void RemoveNode(const std::string& rkPath)
+{
+    std::string                        parent;
+    std::string                        name;
+    std::vector<std::string>::iterator entry;
+    TNodes::iterator                   it;
+
+    GetNodes().erase(rkPath);
+
+    SplitPath(rkPath, parent, name);
+    it = GetNodes().find(parent);
+    if(it != GetNodes().end())
+    {
+        entry = std::find(it->second->entries.begin(),
+                          it->second->entries.end(),
+                          name);
+        if(entry != it->second->entries.end())
+        {
+            entry->clear();
+        }
+    }
+}
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+SdSpiConfig::SdSpiConfig(const uint8_t  kCsPin,
+                         const uint8_t  kOptions,
+                         const uint32_t kClock,
+                         SPIClass*      pSpi)
+{
+    (void)kCsPin;
+    (void)kOptions;
+    (void)kClock;
+    (void)pSpi;
+}
+
+uint8_t SdCard::type(void) const
+{
+    return HOST_FS_CARD_TYPE;
+}
+
+bool SdCard::readCID(cid_t* pCid) const
+{
+    memset(pCid, 0, sizeof(cid_t));
+    return true;
+}
+
+bool SdCard::readCSD(csd_t* pCsd) const
+{
+    memset(pCsd, 0, sizeof(csd_t));
+    return true;
+}
+
+bool SdCard::readOCR(uint32_t* pOcr) const
+{
+    *pOcr = 0;
+    return true;
+}
+
+bool SdCard::readSCR(scr_t* pScr) const
+{
+    memset(pScr, 0, sizeof(scr_t));
+    return true;
+}
+
+FsFile::FsFile(void)
+{
+    position_ = 0;
+    writable_ = false;
+}
+
+bool FsFile::open(const char* pkPath, const oflag_t kFlags)
+{
+    TNodes::iterator it;
+
+    std::lock_guard<std::recursive_mutex> lock(sFsLock);
+
+    close();
+
+    it = GetNodes().find(pkPath);
+    if(it != GetNodes().end())
+    {
+        if((kFlags & (O_CREAT | O_EXCL)) == (O_CREAT | O_EXCL))
+        {
+            return false;
+        }
+        pNode_ = it->second;
+    }
+    else if((kFlags & O_CREAT) != 0)
+    {
+        pNode_ = AddNode(pkPath, false);
+        if(pNode_ == nullptr)
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+
+    path_     = pkPath;
+    position_ = 0;
+    writable_ = (kFlags & (O_WRONLY | O_RDWR)) != 0;
+
+    if(writable_ && (kFlags & O_TRUNC) != 0)
+    {
+        pNode_->content.clear();
+    }
+    if((kFlags & O_AT_END) != 0)
+    {
+        position_ = pNode_->content.size();
+    }
+
+    return true;
+}
+
+bool FsFile::close(void)
+{
+    pNode_.reset();
+    path_.clear();
+    position_ = 0;
+    writable_ = false;
+
+    return true;
+}
+
+FsFile::operator bool(void) const
+{
+    return pNode_ != nullptr;
+}
+
+bool FsFile::isDirectory(void) const
+{
+    return pNode_ != nullptr && pNode_->isDirectory;
+}
+
+int FsFile::read(void* pBuffer, const size_t kSize)
+{
+    size_t readSize;
+
+    std::lock_guard<std::recursive_mutex> lock(sFsLock);
+
+    if(pNode_ == nullptr || pNode_->isDirectory)
+    {
+        return -1;
+    }
+    if(position_ >= pNode_->content.size())
+    {
+        return 0;
+    }
+
+    readSize = std::min(kSize, (size_t)(pNode_->content.size() - position_));
+    memcpy(pBuffer, pNode_->content.data() + position_, readSize);
+    position_ += readSize;
+
+    return readSize;
+}
+
+size_t FsFile::write(const void* pkBuffer, const size_t kSize)
+{
+    std::lock_guard<std::recursive_mutex> lock(sFsLock);
+
+    if(pNode_ == nullptr || pNode_->isDirectory || !writable_)
+    {
+        return 0;
+    }
+
+    if(pNode_->content.size() < position_ + kSize)
+    {
+        pNode_->content.resize(position_ + kSize);
+    }
+    memcpy(pNode_->content.data() + position_, pkBuffer, kSize);
+    position_ += kSize;
+
+    return kSize;
+}
+
+size_t FsFile::print(const char* pkString)
+{
+    return write(pkString, strlen(pkString));
+}
+
+String FsFile::readString(void)
+{
+    std::string content;
+    char        pBuffer[64];
+    int         readSize;
+
+    while((readSize = read(pBuffer, sizeof(pBuffer))) > 0)
+    {
+        content.append(pBuffer, readSize);
+    }
+
+    return String(content.c_str());
+}
+
+int FsFile::available(void) const
+{
+    std::lock_guard<std::recursive_mutex> lock(sFsLock);
+
+    if(pNode_ == nullptr || position_ >= pNode_->content.size())
+    {
+        return 0;
+    }
+
+    return pNode_->content.size() - position_;
+}
+
+bool FsFile::seekSet(const uint64_t kPosition)
+{
+    std::lock_guard<std::recursive_mutex> lock(sFsLock);
+
+    if(pNode_ == nullptr)
+    {
+        return false;
+    }
+
+    if(pNode_->isDirectory)
+    {
+        if(kPosition % HOST_FS_DIR_ENTRY_SIZE != 0 ||
+           kPosition / HOST_FS_DIR_ENTRY_SIZE > pNode_->entries.size())
+        {
+            return false;
+        }
+    }
+    else if(kPosition > pNode_->content.size())
+    {
+        return false;
+    }
+
+    position_ = kPosition;
+
+    return true;
+}
+
+uint64_t FsFile::curPosition(void) const
+{
+    return position_;
+}
+
+uint64_t FsFile::size(void) const
+{
+    std::lock_guard<std::recursive_mutex> lock(sFsLock);
+
+    if(pNode_ == nullptr || pNode_->isDirectory)
+    {
+        return 0;
+    }
+
+    return pNode_->content.size();
+}
+
+uint64_t FsFile::fileSize(void) const
+{
+    return size();
+}
+
+bool FsFile::truncate(const uint64_t kSize)
+{
+    std::lock_guard<std::recursive_mutex> lock(sFsLock);
+
+    if(pNode_ == nullptr || pNode_->isDirectory || !writable_)
+    {
+        return false;
+    }
+
+    pNode_->content.resize(kSize);
+    position_ = std::min(position_, kSize);
+
+    return true;
+}
+
+bool FsFile::sync(void)
+{
+    return pNode_ != nullptr;
+}
+
+FsFile FsFile::openNextFile(const oflag_t kFlags)
+{
+    FsFile      file;
+    std::string name;
+    size_t      entry;
+
+    std::lock_guard<std::recursive_mutex> lock(sFsLock);
+
+    if(!isDirectory())
+    {
+        return file;
+    }
+
+    /* Skip the holes left by the removed entries */
+    entry = position_ / HOST_FS_DIR_ENTRY_SIZE;
+    while(entry < pNode_->entries.size())
+    {
+        name = pNode_->entries[entry++];
+        position_ = entry * HOST_FS_DIR_ENTRY_SIZE;
+        if(!name.empty())
+        {
+            file.open(((path_ == "/") ? "" : path_ + "/").append(name).c_str(),
+                      kFlags);
+            break;
+        }
+    }
+
+    return file;
+}
+
+size_t FsFile::getName(char* pName, const size_t kSize) const
+{
+    size_t separator;
+
+    if(pNode_ == nullptr || kSize == 0)
+    {
+        return 0;
+    }
+
+    separator = path_.rfind('/');
+    snprintf(pName, kSize, "%s", path_.c_str() + separator + 1);
+
+    return strlen(pName);
+}
+
+bool FsFile::getModifyDateTime(uint16_t* pDate, uint16_t* pTime) const
+{
+    if(pNode_ == nullptr)
+    {
+        return false;
+    }
+
+    /* 16/10/2026 12:00:00 in the FAT format */
+    *pDate = ((2026 - 1980) << 9) | (10 << 5) | 16;
+    *pTime = 12 << 11;
+
+    return true;
+}
+
+bool SdFs::begin(const SdSpiConfig& rkConfig)
+{
+    (void)rkConfig;
+
+    std::lock_guard<std::recursive_mutex> lock(sFsLock);
+
+    GetNodes();
+
+    return true;
+}
+
+SdCard* SdFs::card(void)
+{
+    return &card_;
+}
+
+void SdFs::initErrorHalt(HardwareSerial* pSerial)
+{
+    pSerial->printf("SD card error\n");
+}
+
+bool SdFs::exists(const char* pkPath) const
+{
+    std::lock_guard<std::recursive_mutex> lock(sFsLock);
+
+    return GetNodes().count(pkPath) != 0;
+}
+
+bool SdFs::mkdir(const char* pkPath, const bool kParents)
+{
+    std::string parent;
+    std::string name;
+
+    std::lock_guard<std::recursive_mutex> lock(sFsLock);
+
+    if(GetNodes().count(pkPath) != 0)
+    {
+        return false;
+    }
+
+    SplitPath(pkPath, parent, name);
+    if(kParents && GetNodes().count(parent) == 0 && !mkdir(parent.c_str()))
+    {
+        return false;
+    }
+
+    return AddNode(pkPath, true) != nullptr;
+}
+
+bool SdFs::rmdir(const char* pkPath)
+{
+    TNodes::iterator it;
+
+    std::lock_guard<std::recursive_mutex> lock(sFsLock);
+
+    it = GetNodes().find(pkPath);
+    if(it == GetNodes().end() || !it->second->isDirectory ||
+       std::count(it->second->entries.begin(),
+                  it->second->entries.end(),
+                  std::string()) != (long)it->second->entries.size())
+    {
+        return false;
+    }
+
+    RemoveNode(pkPath);
+
+    return true;
+}
+
+bool SdFs::remove(const char* pkPath)
+{
+    TNodes::iterator it;
+
+    std::lock_guard<std::recursive_mutex> lock(sFsLock);
+
+    it = GetNodes().find(pkPath);
+    if(it == GetNodes().end() || it->second->isDirectory)
+    {
+        return false;
+    }
+
+    RemoveNode(pkPath);
+
+    return true;
+}
+
+bool SdFs::rename(const char* pkOldPath, const char* pkNewPath)
+{
+    std::shared_ptr<SHostFsNode> pNode;
+    std::shared_ptr<SHostFsNode> pNewNode;
+    TNodes::iterator             it;
+
+    std::lock_guard<std::recursive_mutex> lock(sFsLock);
+
+    it = GetNodes().find(pkOldPath);
+    if(it == GetNodes().end() || it->second->isDirectory ||
+       GetNodes().count(pkNewPath) != 0)
+    {
+        return false;
+    }
+    pNode = it->second;
+
+    pNewNode = AddNode(pkNewPath, false);
+    if(pNewNode == nullptr)
+    {
+        return false;
+    }
+    RemoveNode(pkOldPath);
+
+    /* The open files keep referencing the node */
+    GetNodes()[pkNewPath] = pNode;
+
+    return true;
+}
+
+bool SdFs::format(void)
+{
+    std::lock_guard<std::recursive_mutex> lock(sFsLock);
+
+    GetNodes().clear();
+    GetNodes();
+
+    return true;
+}
@@ -0,0 +1,255 @@
+/*******************************************************************************
+ * @file Sha256.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file implements the mbedTLS SHA-256 services on the host.
+ *
+ * @details This file implements the mbedTLS SHA-256 services on the host,
+ * following FIPS 180-4.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstring> /* memcpy, memset */
+
+/* Header File */
+#include <mbedtls/sha256.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief SHA-256 block size in bytes. */
+#define SHA256_BLOCK_SIZE 64
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/** @brief Rotates a 32 bits word right. */
+#define ROTR(X, N) (((X) >> (N)) | ((X) << (32 - (N))))
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+
+/** @brief SHA-256 round constants. */
+static const uint32_t skpRoundConstants[64] = {
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5,
+    0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+    0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3,
+    0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+    0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC,
+    0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+    0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7,
+    0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+    0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13,
+    0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+    0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3,
+    0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+    0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5,
+    0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+    0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208,
+    0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2
+};
+
+/** @brief SHA-256 initial digest. */
+static const uint32_t skpInitialState[8] = {
+    0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+    0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
+};
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/**
+ * @brief Hashes a block in the context digest.
+ *
+ * @param[in, out] pCtx The SHA-256 context.
+ * @param[in] pkBlock The block to hash.
+ */
+static void ProcessBlock(mbedtls_sha256_context* pCtx,
+                         const unsigned char*    pkBlock);
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+static void ProcessBlock(mbedtls_sha256_context* pCtx,
+                         const unsigned char*    pkBlock)
+{
+    uint32_t pWords[64];
+    uint32_t pState[8];
+    uint32_t s0;
+    uint32_t s1;
+    uint32_t temp1;
+    uint32_t temp2;
+    uint8_t  i;
+
+    for(i = 0; i < 16; ++i)
+    {
+        pWords[i] = ((uint32_t)pkBlock[i * 4] << 24) |
+                    ((uint32_t)pkBlock[i * 4 + 1] << 16) |
+                    ((uint32_t)pkBlock[i * 4 + 2] << 8) |
+                    (uint32_t)pkBlock[i * 4 + 3];
+    }
+    for(i = 16; i < 64; ++i)
+    {
+        s0 = ROTR(pWords[i - 15], 7) ^ ROTR(pWords[i - 15], 18) ^
+             (pWords[i - 15] >> 3);
+        s1 = ROTR(pWords[i - 2], 17) ^ ROTR(pWords[i - 2], 19) ^
+             (pWords[i - 2] >> 10);
+        pWords[i] = pWords[i - 16] + s0 + pWords[i - 7] + s1;
+    }
+
+    memcpy(pState, pCtx->state, sizeof(pState));
+    for(i = 0; i < 64; ++i)
+    {
+        s1    = ROTR(pState[4], 6) ^ ROTR(pState[4], 11) ^
+                ROTR(pState[4], 25);
+        temp1 = pState[7] + s1 +
+                ((pState[4] & pState[5]) ^ (~pState[4] & pState[6])) +
+                skpRoundConstants[i] + pWords[i];
+        s0    = ROTR(pState[0], 2) ^ ROTR(pState[0], 13) ^
+                ROTR(pState[0], 22);
+        temp2 = s0 + ((pState[0] & pState[1]) ^
+                      (pState[0] & pState[2]) ^
+                      (pState[1] & pState[2]));
+
+        pState[7] = pState[6];
+        pState[6] = pState[5];
+        pState[5] = pState[4];
+        pState[4] = pState[3] + temp1;
+        pState[3] = pState[2];
+        pState[2] = pState[1];
+        pState[1] = pState[0];
+        pState[0] = temp1 + temp2;
+    }
+
+    for(i = 0; i < 8; ++i)
+    {
+        pCtx->state[i] += pState[i];
+    }
+}
+
+void mbedtls_sha256_init(mbedtls_sha256_context* pCtx)
+{
+    memset(pCtx, 0, sizeof(mbedtls_sha256_context));
+}
+
+void mbedtls_sha256_free(mbedtls_sha256_context* pCtx)
+{
+    if(pCtx != nullptr)
+    {
+        memset(pCtx, 0, sizeof(mbedtls_sha256_context));
+    }
+}
+
+void mbedtls_sha256_clone(mbedtls_sha256_context*       pDst,
+                          const mbedtls_sha256_context* pkSrc)
+{
+    memcpy(pDst, pkSrc, sizeof(mbedtls_sha256_context));
+}
+
+int mbedtls_sha256_starts(mbedtls_sha256_context* pCtx, const int kIs224)
+{
+    if(kIs224 != 0)
+    {
+        return -1;
+    }
+
+    pCtx->total = 0;
+    memcpy(pCtx->state, skpInitialState, sizeof(skpInitialState));
+
+    return 0;
+}
+
+int mbedtls_sha256_update(mbedtls_sha256_context* pCtx,
+                          const unsigned char*    pkInput,
+                          const size_t            kSize)
+{
+    size_t used;
+    size_t toCopy;
+    size_t offset;
+
+    offset = 0;
+    while(offset < kSize)
+    {
+        used   = pCtx->total % SHA256_BLOCK_SIZE;
+        toCopy = SHA256_BLOCK_SIZE - used;
+        if(toCopy > kSize - offset)
+        {
+            toCopy = kSize - offset;
+        }
+
+        memcpy(pCtx->buffer + used, pkInput + offset, toCopy);
+        pCtx->total += toCopy;
+        offset      += toCopy;
+
+        if(pCtx->total % SHA256_BLOCK_SIZE == 0)
+        {
+            ProcessBlock(pCtx, pCtx->buffer);
+        }
+    }
+
+    return 0;
+}
+
+int mbedtls_sha256_finish(mbedtls_sha256_context* pCtx,
+                          unsigned char*          pOutput)
+{
+    unsigned char pPadding[SHA256_BLOCK_SIZE + 8];
+    uint64_t      bitLength;
+    size_t        paddingSize;
+    uint8_t       i;
+
+    /* One bit, zeros up to 56 bytes modulo 64, then the bit length */
+    bitLength   = pCtx->total * 8;
+    paddingSize = SHA256_BLOCK_SIZE + 56 - pCtx->total % SHA256_BLOCK_SIZE;
+    paddingSize %= SHA256_BLOCK_SIZE;
+    if(paddingSize == 0)
+    {
+        paddingSize = SHA256_BLOCK_SIZE;
+    }
+
+    memset(pPadding, 0, sizeof(pPadding));
+    pPadding[0] = 0x80;
+    for(i = 0; i < 8; ++i)
+    {
+        pPadding[paddingSize + i] = (unsigned char)(bitLength >> (56 - i * 8));
+    }
+    mbedtls_sha256_update(pCtx, pPadding, paddingSize + 8);
+
+    for(i = 0; i < 8; ++i)
+    {
+        pOutput[i * 4]     = (unsigned char)(pCtx->state[i] >> 24);
+        pOutput[i * 4 + 1] = (unsigned char)(pCtx->state[i] >> 16);
+        pOutput[i * 4 + 2] = (unsigned char)(pCtx->state[i] >> 8);
+        pOutput[i * 4 + 3] = (unsigned char)pCtx->state[i];
+    }
+
+    return 0;
+}
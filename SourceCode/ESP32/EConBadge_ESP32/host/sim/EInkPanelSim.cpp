@@ -0,0 +1,377 @@
+/*******************************************************************************
+ * @file EInkPanelSim.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file implements the simulated EInk panel.
+ *
+ * @details This file implements the simulated EInk panel. The timer thread
+ * takes the bus lock before the timer lock, as the bus callbacks do, so that
+ * a transition cannot end while the driver starts a new one.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <chrono>      /* std::chrono */
+#include <cstdio>      /* fopen */
+#include <cstring>     /* memcpy */
+#include <Types.h>     /* GPIO definitions */
+#include <Arduino.h>   /* GPIO levels */
+#include <esp_timer.h> /* Timer services */
+
+/* Header File */
+#include <EInkPanelSim.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Panel setting: resolution. */
+#define EINK_CMD_RESOLUTION 0x61
+/** @brief Panel setting: frame data. */
+#define EINK_CMD_FRAME 0x10
+/** @brief Panel setting: power on. */
+#define EINK_CMD_POWER_ON 0x04
+/** @brief Panel setting: refresh. */
+#define EINK_CMD_REFRESH 0x12
+/** @brief Panel setting: power off. */
+#define EINK_CMD_POWER_OFF 0x02
+
+/** @brief Number of colors of the panel. */
+#define EINK_SIM_COLORS 8
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+
+/** @brief Expected resolution setting, 600x448. */
+static const uint8_t skpResolution[4] = { 0x02, 0x58, 0x01, 0xC0 };
+
+/** @brief Panel colors in RGB, from the palette of the image converter. */
+static const uint8_t skpPalette[EINK_SIM_COLORS][3] = {
+    { 0x00, 0x00, 0x00 },
+    { 0xFF, 0xFF, 0xFF },
+    { 0x4B, 0x6E, 0x54 },
+    { 0x37, 0x43, 0x6A },
+    { 0xA4, 0x50, 0x4B },
+    { 0xDC, 0xCC, 0x5F },
+    { 0xC0, 0x66, 0x50 },
+    { 0xFF, 0xFF, 0xFF }
+};
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+EInkPanelSim::EInkPanelSim(const SEInkPanelTimings& rkTimings)
+{
+    timings_      = rkTimings;
+    dcLevel_      = HIGH;
+    csLevel_      = HIGH;
+    command_      = 0;
+    dataCount_    = 0;
+    poweredOn_    = false;
+    frameBytes_   = 0;
+    frameStart_   = 0;
+    refreshStart_ = 0;
+    busyPending_  = false;
+    busyLevel_    = HIGH;
+    busyEnd_      = 0;
+    stopTimer_    = false;
+    memset(&stats_, 0, sizeof(SEInkPanelStats));
+    memset(pResolution_, 0, sizeof(pResolution_));
+
+    /* The panel shows a white screen until its first refresh */
+    framebuffer_.assign(EINK_SIM_FRAME_SIZE, 0x11);
+    displayed_ = framebuffer_;
+
+    HostBus::DrivePin(GPIO_EINK_BUSY, HIGH);
+    HostBus::Attach(this);
+
+    timer_ = std::thread(&EInkPanelSim::TimerRoutine, this);
+}
+
+EInkPanelSim::~EInkPanelSim(void)
+{
+    HostBus::Detach(this);
+
+    {
+        std::lock_guard<std::mutex> lock(timerLock_);
+        stopTimer_ = true;
+        timerSignal_.notify_all();
+    }
+    timer_.join();
+}
+
+void EInkPanelSim::OnPinWrite(const uint8_t kPin, const uint8_t kLevel)
+{
+    if(kPin == GPIO_EINK_DC)
+    {
+        dcLevel_ = kLevel;
+    }
+    else if(kPin == GPIO_EINK_CS)
+    {
+        csLevel_ = kLevel;
+    }
+    else if(kPin == GPIO_EINK_RESET)
+    {
+        /* The panel is held in reset while the line is low */
+        poweredOn_ = false;
+        memset(pResolution_, 0, sizeof(pResolution_));
+        if(kLevel == HIGH)
+        {
+            StartBusy(HIGH, timings_.resetTime);
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(timerLock_);
+            busyPending_ = false;
+            HostBus::DrivePin(GPIO_EINK_BUSY, LOW);
+        }
+    }
+}
+
+void EInkPanelSim::OnSpiWrite(const uint8_t* pkData, const uint32_t kSize)
+{
+    uint32_t i;
+
+    if(csLevel_ != LOW)
+    {
+        return;
+    }
+
+    if(dcLevel_ == HIGH)
+    {
+        OnData(pkData, kSize);
+    }
+    else
+    {
+        for(i = 0; i < kSize; ++i)
+        {
+            OnCommand(pkData[i]);
+        }
+    }
+}
+
+std::vector<uint8_t> EInkPanelSim::GetDisplayed(void)
+{
+    std::vector<uint8_t> displayed;
+
+    HostBus::Lock();
+    displayed = displayed_;
+    HostBus::Unlock();
+
+    return displayed;
+}
+
+void EInkPanelSim::GetStats(SEInkPanelStats& rStats)
+{
+    HostBus::Lock();
+    rStats = stats_;
+    HostBus::Unlock();
+}
+
+bool EInkPanelSim::WritePpm(const std::string& rkPath)
+{
+    std::vector<uint8_t> displayed;
+    std::vector<uint8_t> pixels;
+    FILE*                pFile;
+    size_t               i;
+    bool                 status;
+
+    displayed = GetDisplayed();
+
+    /* Two pixels per byte, the left pixel in the high nibble */
+    pixels.reserve(EINK_SIM_WIDTH * EINK_SIM_HEIGHT * 3);
+    for(i = 0; i < displayed.size(); ++i)
+    {
+        pixels.insert(pixels.end(),
+                      skpPalette[(displayed[i] >> 4) & 0x7],
+                      skpPalette[(displayed[i] >> 4) & 0x7] + 3);
+        pixels.insert(pixels.end(),
+                      skpPalette[displayed[i] & 0x7],
+                      skpPalette[displayed[i] & 0x7] + 3);
+    }
+
+    pFile = fopen(rkPath.c_str(), "wb");
+    if(pFile == nullptr)
+    {
+        return false;
+    }
+    fprintf(pFile, "P6\n%d %d\n255\n", EINK_SIM_WIDTH, EINK_SIM_HEIGHT);
+    status = fwrite(pixels.data(), 1, pixels.size(), pFile) == pixels.size();
+    fclose(pFile);
+
+    return status;
+}
+
+void EInkPanelSim::OnCommand(const uint8_t kCommand)
+{
+    uint64_t time;
+
+    time       = esp_timer_get_time();
+    command_   = kCommand;
+    dataCount_ = 0;
+
+    switch(kCommand)
+    {
+        case EINK_CMD_RESOLUTION:
+            memset(pResolution_, 0, sizeof(pResolution_));
+            break;
+        case EINK_CMD_FRAME:
+            frameBytes_ = 0;
+            frameStart_ = time;
+            break;
+        case EINK_CMD_POWER_ON:
+            stats_.frameTime = time - frameStart_;
+            refreshStart_    = time;
+            poweredOn_       = true;
+            StartBusy(HIGH, timings_.powerTime);
+            break;
+        case EINK_CMD_REFRESH:
+            if(poweredOn_ &&
+               memcmp(pResolution_, skpResolution, sizeof(pResolution_)) == 0 &&
+               frameBytes_ == EINK_SIM_FRAME_SIZE)
+            {
+                displayed_ = framebuffer_;
+                ++stats_.refreshes;
+            }
+            else
+            {
+                printf("Simulated EInk: invalid refresh, power %d, "
+                       "%u frame bytes\n",
+                       poweredOn_,
+                       frameBytes_);
+                ++stats_.errors;
+            }
+            StartBusy(HIGH, timings_.refreshTime);
+            break;
+        case EINK_CMD_POWER_OFF:
+            stats_.refreshTime = time - refreshStart_ + timings_.powerTime;
+            poweredOn_         = false;
+            StartBusy(LOW, timings_.powerTime);
+            break;
+        default:
+            break;
+    }
+}
+
+void EInkPanelSim::OnData(const uint8_t* pkData, const uint32_t kSize)
+{
+    uint32_t i;
+    uint32_t toCopy;
+
+    if(command_ == EINK_CMD_RESOLUTION)
+    {
+        for(i = 0; i < kSize && dataCount_ + i < sizeof(pResolution_); ++i)
+        {
+            pResolution_[dataCount_ + i] = pkData[i];
+        }
+    }
+    else if(command_ == EINK_CMD_FRAME)
+    {
+        /* Extra bytes are counted, the refresh rejects the frame */
+        if(frameBytes_ < EINK_SIM_FRAME_SIZE)
+        {
+            toCopy = kSize;
+            if(toCopy > EINK_SIM_FRAME_SIZE - frameBytes_)
+            {
+                toCopy = EINK_SIM_FRAME_SIZE - frameBytes_;
+            }
+            memcpy(framebuffer_.data() + frameBytes_, pkData, toCopy);
+        }
+        frameBytes_ += kSize;
+    }
+
+    dataCount_ += kSize;
+}
+
+void EInkPanelSim::StartBusy(const uint8_t kLevel, const uint64_t kDuration)
+{
+    std::lock_guard<std::mutex> lock(timerLock_);
+
+    HostBus::DrivePin(GPIO_EINK_BUSY, kLevel == HIGH ? LOW : HIGH);
+
+    busyLevel_   = kLevel;
+    busyEnd_     = esp_timer_get_time() + kDuration;
+    busyPending_ = true;
+    timerSignal_.notify_all();
+}
+
+void EInkPanelSim::TimerRoutine(void)
+{
+    uint64_t time;
+    bool     expired;
+
+    std::unique_lock<std::mutex> lock(timerLock_);
+
+    while(!stopTimer_)
+    {
+        if(!busyPending_)
+        {
+            timerSignal_.wait(lock);
+            continue;
+        }
+
+        time = esp_timer_get_time();
+        if(time < busyEnd_)
+        {
+            timerSignal_.wait_for(lock,
+                                  std::chrono::microseconds(busyEnd_ - time));
+            continue;
+        }
+
+        /* Take the locks in the bus order and check the transition again */
+        lock.unlock();
+        HostBus::Lock();
+        lock.lock();
+        expired = busyPending_ && (uint64_t)esp_timer_get_time() >= busyEnd_;
+        if(expired)
+        {
+            busyPending_ = false;
+            HostBus::DrivePin(GPIO_EINK_BUSY, busyLevel_);
+        }
+        lock.unlock();
+        HostBus::Unlock();
+        lock.lock();
+    }
+}
@@ -0,0 +1,236 @@
+/*******************************************************************************
+ * @file EInkPanelSim.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file defines the simulated EInk panel.
+ *
+ * @details This file defines the simulated EInk panel. The panel is attached
+ * to the host bus and decodes the command sequence sent by the driver on the
+ * SPI bus into a 600x448 framebuffer. The BUSY line timings of the reset, the
+ * power on / off and the refresh are modeled, the displayed image can be
+ * written as a PPM image.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __HOST_EINK_PANEL_SIM_H_
+#define __HOST_EINK_PANEL_SIM_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <mutex>              /* std::mutex */
+#include <string>             /* std::string */
+#include <thread>             /* std::thread */
+#include <vector>             /* std::vector */
+#include <cstdint>            /* Standard Int Types */
+#include <HostBus.h>          /* Host bus */
+#include <condition_variable> /* std::condition_variable */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Simulated panel width in pixels. */
+#define EINK_SIM_WIDTH 600
+/** @brief Simulated panel height in pixels. */
+#define EINK_SIM_HEIGHT 448
+/** @brief Size in bytes of a simulated panel frame. */
+#define EINK_SIM_FRAME_SIZE ((EINK_SIM_WIDTH / 2) * EINK_SIM_HEIGHT)
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/** @brief BUSY line timings of the simulated panel, in microseconds. */
+typedef struct
+{
+    /** @brief BUSY low time after a reset. */
+    uint64_t resetTime;
+    /** @brief BUSY transition time of a power on or power off. */
+    uint64_t powerTime;
+    /** @brief BUSY low time of a refresh. */
+    uint64_t refreshTime;
+} SEInkPanelTimings;
+
+/** @brief Statistics of the simulated panel. */
+typedef struct
+{
+    /** @brief Number of valid refreshes. */
+    uint32_t refreshes;
+    /** @brief Number of refreshes rejected by the panel. */
+    uint32_t errors;
+    /** @brief Duration of the last frame transfer in microseconds. */
+    uint64_t frameTime;
+    /** @brief Duration of the last refresh sequence in microseconds. */
+    uint64_t refreshTime;
+} SEInkPanelStats;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/**
+ * @brief Simulated EInk panel.
+ *
+ * @details Simulated EInk panel. The frame data is stored in the framebuffer
+ * as it is received, a refresh copies the framebuffer to the displayed image
+ * if the resolution was set, the panel is powered on and a full frame was
+ * received. The BUSY line transitions are driven by a timer thread.
+ */
+class EInkPanelSim: public HostDevice
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        /**
+         * @brief Creates the panel and attaches it to the host bus.
+         *
+         * @param[in] rkTimings The BUSY line timings.
+         */
+        explicit EInkPanelSim(const SEInkPanelTimings& rkTimings);
+
+        /**
+         * @brief Detaches the panel from the host bus.
+         */
+        virtual ~EInkPanelSim(void);
+
+        virtual void OnPinWrite(const uint8_t kPin, const uint8_t kLevel);
+        virtual void OnSpiWrite(const uint8_t* pkData, const uint32_t kSize);
+
+        /**
+         * @brief Returns the displayed image, two pixels per byte.
+         *
+         * @return The displayed image is returned.
+         */
+        std::vector<uint8_t> GetDisplayed(void);
+
+        /**
+         * @brief Returns the panel statistics.
+         *
+         * @param[out] rStats The statistics.
+         */
+        void GetStats(SEInkPanelStats& rStats);
+
+        /**
+         * @brief Writes the displayed image as a binary PPM image.
+         *
+         * @param[in] rkPath The image path.
+         *
+         * @return true is returned on success, false otherwise.
+         */
+        bool WritePpm(const std::string& rkPath);
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+        /* None */
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        /**
+         * @brief Decodes a command.
+         *
+         * @param[in] kCommand The command.
+         */
+        void OnCommand(const uint8_t kCommand);
+
+        /**
+         * @brief Decodes data bytes of the current command.
+         *
+         * @param[in] pkData The data bytes.
+         * @param[in] kSize The number of bytes.
+         */
+        void OnData(const uint8_t* pkData, const uint32_t kSize);
+
+        /**
+         * @brief Drives BUSY to a level and schedules the opposite level.
+         *
+         * @param[in] kLevel The BUSY level after the transition.
+         * @param[in] kDuration The transition duration in microseconds.
+         */
+        void StartBusy(const uint8_t kLevel, const uint64_t kDuration);
+
+        /**
+         * @brief Timer routine, ends the BUSY transitions.
+         */
+        void TimerRoutine(void);
+
+        /** @brief The BUSY line timings. */
+        SEInkPanelTimings       timings_;
+        /** @brief The panel statistics. */
+        SEInkPanelStats         stats_;
+        /** @brief Level of the DC line. */
+        uint8_t                 dcLevel_;
+        /** @brief Level of the CS line. */
+        uint8_t                 csLevel_;
+        /** @brief Current command. */
+        uint8_t                 command_;
+        /** @brief Number of data bytes received for the current command. */
+        uint32_t                dataCount_;
+        /** @brief Resolution setting bytes. */
+        uint8_t                 pResolution_[4];
+        /** @brief Tells if the panel is powered on. */
+        bool                    poweredOn_;
+        /** @brief Number of frame bytes received. */
+        uint32_t                frameBytes_;
+        /** @brief Frame transfer start time in microseconds. */
+        uint64_t                frameStart_;
+        /** @brief Refresh sequence start time in microseconds. */
+        uint64_t                refreshStart_;
+        /** @brief The framebuffer, filled by the frame transfer. */
+        std::vector<uint8_t>    framebuffer_;
+        /** @brief The displayed image. */
+        std::vector<uint8_t>    displayed_;
+
+        /** @brief Timer lock, protects the pending transition. */
+        std::mutex              timerLock_;
+        /** @brief Signaled when a transition is scheduled. */
+        std::condition_variable timerSignal_;
+        /** @brief Tells if a transition is pending. */
+        bool                    busyPending_;
+        /** @brief BUSY level at the end of the pending transition. */
+        uint8_t                 busyLevel_;
+        /** @brief End time of the pending transition in microseconds. */
+        uint64_t                busyEnd_;
+        /** @brief Tells if the timer shall stop. */
+        bool                    stopTimer_;
+        /** @brief The timer thread. */
+        std::thread             timer_;
+};
+
+#endif /* #ifndef __HOST_EINK_PANEL_SIM_H_ */
@@ -0,0 +1,345 @@
+/*******************************************************************************
+ * @file LoopbackDevice.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file implements the loopback device.
+ *
+ * @details This file implements the loopback device. Each command is
+ * acknowledged before its data is transferred, and answered once the transfer
+ * is done, as the EInk jobs of the system state are.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdio>    /* snprintf */
+#include <cstring>   /* memcpy */
+#include <Logger.h>  /* Logger service */
+#include <Storage.h> /* Files cursor */
+
+/* Header File */
+#include <LoopbackDevice.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Command task stack size. */
+#define DEVICE_STACK_SIZE 4096
+/** @brief Command task priority. */
+#define DEVICE_PRIORITY 5
+/** @brief Depth of the command queue. */
+#define DEVICE_QUEUE_DEPTH 8
+
+/** @brief Data transfer timeout in milliseconds. */
+#define DEVICE_TRANSFER_TIMEOUT 5000
+
+/** @brief Maximal size of an image name. */
+#define DEVICE_NAME_SIZE 32
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+LoopbackDevice::LoopbackDevice(BluetoothManager* pBtMgr,
+                               const size_t      kImageSize,
+                               const uint32_t    kImageCount)
+{
+    pBtMgr_     = pBtMgr;
+    imageCount_ = kImageCount;
+    image_.assign(kImageSize, 0);
+    lock_       = xSemaphoreCreateMutex();
+
+    receiveChunk_ = 0;
+    receiveStall_ = 0;
+
+    commandQueue_ = xQueueCreate(DEVICE_QUEUE_DEPTH, sizeof(SCommandRequest));
+
+    xTaskCreatePinnedToCore(
+        CommandRoutine,
+        "LoopbackDevice",
+        DEVICE_STACK_SIZE,
+        this,
+        DEVICE_PRIORITY,
+        &thread_,
+        tskNO_AFFINITY
+    );
+}
+
+EErrorCode LoopbackDevice::EnqueueCommand(SCommandRequest& rCommand)
+{
+    if(xQueueSend(commandQueue_, &rCommand, 0) != pdTRUE)
+    {
+        return ACTION_FAILED;
+    }
+
+    return NO_ERROR;
+}
+
+void LoopbackDevice::GetImage(std::vector<uint8_t>& rImage)
+{
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    rImage = image_;
+    xSemaphoreGive(lock_);
+}
+
+void LoopbackDevice::SetImage(const std::vector<uint8_t>& rkImage)
+{
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    image_ = rkImage;
+    xSemaphoreGive(lock_);
+}
+
+void LoopbackDevice::SetStorageStall(const size_t kChunk, const uint32_t kStall)
+{
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    receiveChunk_ = kChunk;
+    receiveStall_ = kStall;
+    xSemaphoreGive(lock_);
+}
+
+void LoopbackDevice::ExecuteCommand(const SCommandRequest& rkCommand)
+{
+    SCommandResponse  response;
+    SImagePageRequest pageRequest;
+
+    memset(&response, 0, sizeof(SCommandResponse));
+    response.header.identifier = rkCommand.header.identifier;
+    response.header.errorCode  = NO_ERROR;
+
+    pBtMgr_->BeginTransfer();
+
+    switch(rkCommand.header.type)
+    {
+        case CMD_PING:
+            break;
+        case CMD_EINK_NEW_IMAGE:
+            ReceiveImage(response);
+            break;
+        case CMD_EINK_GET_IMAGE_DATA:
+            SendImage(response);
+            break;
+        case CMD_EINK_GET_IMAGE_PAGE:
+            memcpy(&pageRequest,
+                   rkCommand.pCommand,
+                   sizeof(SImagePageRequest));
+            SendImagePage(pageRequest, response);
+            break;
+        case CMD_LEDBORDER_GET_BRIGHTNESS:
+            response.header.size  = 1;
+            response.pResponse[0] = LOOPBACK_DEVICE_BRIGHTNESS;
+            break;
+        case CMD_SET_LINK_COMPRESSION:
+            pBtMgr_->SetCompression(rkCommand.pCommand[0], response);
+            break;
+        case CMD_GET_LINK_INFO:
+            pBtMgr_->GetLinkInfo(response);
+            break;
+        default:
+            response.header.errorCode = INVALID_COMMAND_REQ;
+            response.header.size      = 0;
+    }
+
+    pBtMgr_->EndTransfer();
+
+    pBtMgr_->SendCommandResponse(response);
+}
+
+void LoopbackDevice::ReceiveImage(SCommandResponse& rResponse)
+{
+    std::vector<uint8_t> image;
+    ssize_t              readBytes;
+    size_t               offset;
+    size_t               chunk;
+    uint32_t             stall;
+
+    /* Send the ack */
+    pBtMgr_->SendCommandResponse(rResponse);
+
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    image.assign(image_.size(), 0);
+    chunk = receiveChunk_ != 0 ? receiveChunk_ : image_.size();
+    stall = receiveStall_;
+    xSemaphoreGive(lock_);
+
+    /* The storage stalls between the chunks */
+    offset = 0;
+    while(offset < image.size())
+    {
+        readBytes = pBtMgr_->ReceiveData(image.data() + offset,
+                                         MIN(chunk, image.size() - offset),
+                                         DEVICE_TRANSFER_TIMEOUT);
+        if(readBytes <= 0)
+        {
+            break;
+        }
+        offset += readBytes;
+
+        if(stall != 0)
+        {
+            vTaskDelay(stall / portTICK_PERIOD_MS);
+        }
+    }
+    if(offset != image.size())
+    {
+        LOG_ERROR("Loopback device: image reception failed\n");
+        rResponse.header.errorCode = TRANS_RECV_FAILED;
+        return;
+    }
+
+    SetImage(image);
+}
+
+void LoopbackDevice::SendImage(SCommandResponse& rResponse)
+{
+    std::vector<uint8_t> image;
+    ssize_t              sentBytes;
+
+    /* Send the ack */
+    pBtMgr_->SendCommandResponse(rResponse);
+
+    GetImage(image);
+    sentBytes = pBtMgr_->SendData(image.data(),
+                                  image.size(),
+                                  DEVICE_TRANSFER_TIMEOUT);
+    if(sentBytes != (ssize_t)image.size())
+    {
+        LOG_ERROR("Loopback device: image sending failed\n");
+        rResponse.header.errorCode = TRANS_SEND_FAILED;
+        return;
+    }
+
+    pBtMgr_->SendDataEnd();
+}
+
+void LoopbackDevice::SendImagePage(const SImagePageRequest& rkRequest,
+                                   SCommandResponse&        rResponse)
+{
+    std::vector<uint8_t> page;
+    SImagePageHeader     pageHeader;
+    SImageRecord         record;
+    char                 pName[DEVICE_NAME_SIZE];
+    uint32_t             cursor;
+    uint16_t             count;
+    ssize_t              sentBytes;
+    uint32_t             imageSize;
+    int                  nameLength;
+
+    if(rkRequest.count == 0 || rkRequest.count > IMAGE_PAGE_MAX_ENTRIES)
+    {
+        rResponse.header.errorCode = INVALID_PARAM;
+        return;
+    }
+
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    imageSize = image_.size();
+    xSemaphoreGive(lock_);
+
+    /* Serialize the page */
+    cursor = rkRequest.cursor;
+    count  = 0;
+    while(cursor < imageCount_ && count < rkRequest.count)
+    {
+        nameLength = snprintf(pName, sizeof(pName), "image_%04u.bin", cursor);
+        if((rkRequest.flags & IMAGE_PAGE_FLAG_RECORDS) != 0)
+        {
+            record.size       = imageSize;
+            record.modifyDate = 0;
+            record.modifyTime = 0;
+            record.nameLength = nameLength;
+            page.insert(page.end(),
+                        (const uint8_t*)&record,
+                        (const uint8_t*)&record + sizeof(SImageRecord));
+            page.insert(page.end(), pName, pName + nameLength);
+        }
+        else
+        {
+            page.insert(page.end(), pName, pName + nameLength + 1);
+        }
+        ++cursor;
+        ++count;
+    }
+
+    /* Send the ack with the page header */
+    pageHeader.nextCursor = cursor < imageCount_ ? cursor : FILES_CURSOR_END;
+    pageHeader.count      = count;
+    pageHeader.size       = page.size();
+    rResponse.header.size = sizeof(SImagePageHeader);
+    memcpy(rResponse.pResponse, &pageHeader, sizeof(SImagePageHeader));
+    pBtMgr_->SendCommandResponse(rResponse);
+
+    rResponse.header.size = 0;
+    if(page.size() != 0)
+    {
+        sentBytes = pBtMgr_->SendData(page.data(),
+                                      page.size(),
+                                      DEVICE_TRANSFER_TIMEOUT);
+        if(sentBytes != (ssize_t)page.size())
+        {
+            LOG_ERROR("Loopback device: image page sending failed\n");
+            rResponse.header.errorCode = TRANS_SEND_FAILED;
+        }
+    }
+}
+
+void LoopbackDevice::CommandRoutine(void* pDeviceParam)
+{
+    LoopbackDevice* pDevice;
+    SCommandRequest command;
+
+    pDevice = (LoopbackDevice*)pDeviceParam;
+
+    while(true)
+    {
+        if(xQueueReceive(pDevice->commandQueue_,
+                         &command,
+                         portMAX_DELAY) == pdTRUE)
+        {
+            pDevice->ExecuteCommand(command);
+        }
+    }
+}
@@ -0,0 +1,201 @@
+/*******************************************************************************
+ * @file LoopbackDevice.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file defines the loopback device.
+ *
+ * @details This file defines the loopback device. The device is the command
+ * handler of the bluetooth manager on the host. It serves the image upload,
+ * image download, image listing and LED border queries from memory, with
+ * the same command and data sequences as the badge managers.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __HOST_LOOPBACK_DEVICE_H_
+#define __HOST_LOOPBACK_DEVICE_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <vector>         /* std::vector */
+#include <cstdint>        /* Standard Int Types */
+#include <Types.h>        /* Defined types */
+#include <BlueToothMgr.h> /* Bluetooth manager */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief LED border brightness returned by the loopback device. */
+#define LOOPBACK_DEVICE_BRIGHTNESS 42
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/**
+ * @brief The loopback device class.
+ *
+ * @details The loopback device class executes the commands in its own task,
+ * as the system state does on the badge. The uploaded image replaces the
+ * stored one, the listing reports a fixed number of images.
+ */
+class LoopbackDevice: public CommandHandler
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        /**
+         * @brief Construct a new Loopback Device object.
+         *
+         * @details Construct a new Loopback Device object and starts its
+         * command task.
+         *
+         * @param[in] pBtMgr The bluetooth manager.
+         * @param[in] kImageSize The size of the images.
+         * @param[in] kImageCount The number of images reported by the listing.
+         */
+        LoopbackDevice(BluetoothManager* pBtMgr,
+                       const size_t      kImageSize,
+                       const uint32_t    kImageCount);
+
+        /**
+         * @brief Enqueues a command.
+         *
+         * @param[in] rCommand The command to enqueue.
+         *
+         * @return Returns an error code on failure.
+         */
+        virtual EErrorCode EnqueueCommand(SCommandRequest& rCommand);
+
+        /**
+         * @brief Gets the stored image.
+         *
+         * @param[out] rImage The stored image.
+         */
+        void GetImage(std::vector<uint8_t>& rImage);
+
+        /**
+         * @brief Sets the stored image.
+         *
+         * @param[in] rkImage The image to store.
+         */
+        void SetImage(const std::vector<uint8_t>& rkImage);
+
+        /**
+         * @brief Simulates the storage stalls of the image uploads.
+         *
+         * @details Simulates the storage stalls of the image uploads. The
+         * uploaded images are received kChunk bytes at a time, with a pause
+         * of kStall milliseconds between two chunks.
+         *
+         * @param[in] kChunk The size of the received chunks, 0 to receive the
+         * image at once.
+         * @param[in] kStall The pause between two chunks in milliseconds.
+         */
+        void SetStorageStall(const size_t kChunk, const uint32_t kStall);
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+        /* None */
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        /**
+         * @brief Executes a command.
+         *
+         * @param[in] rkCommand The command to execute.
+         */
+        void ExecuteCommand(const SCommandRequest& rkCommand);
+
+        /**
+         * @brief Receives a new image.
+         *
+         * @param[out] rResponse The command response.
+         */
+        void ReceiveImage(SCommandResponse& rResponse);
+
+        /**
+         * @brief Sends the stored image.
+         *
+         * @param[out] rResponse The command response.
+         */
+        void SendImage(SCommandResponse& rResponse);
+
+        /**
+         * @brief Sends a page of the image list.
+         *
+         * @param[in] rkRequest The page request.
+         * @param[out] rResponse The command response.
+         */
+        void SendImagePage(const SImagePageRequest& rkRequest,
+                           SCommandResponse&        rResponse);
+
+        /**
+         * @brief Command task routine.
+         *
+         * @param[in] pDeviceParam The loopback device.
+         */
+        static void CommandRoutine(void* pDeviceParam);
+
+        /** @brief Stores the bluetooth manager. */
+        BluetoothManager*    pBtMgr_;
+        /** @brief Stores the command queue. */
+        QueueHandle_t        commandQueue_;
+        /** @brief Stores the command task. */
+        TaskHandle_t         thread_;
+        /** @brief Protects the stored image. */
+        SemaphoreHandle_t    lock_;
+        /** @brief Stores the image. */
+        std::vector<uint8_t> image_;
+        /** @brief Stores the number of images reported by the listing. */
+        uint32_t             imageCount_;
+        /** @brief Stores the size of the received chunks, 0 for the image. */
+        size_t               receiveChunk_;
+        /** @brief Stores the pause between two received chunks in ms. */
+        uint32_t             receiveStall_;
+};
+
+#endif /* #ifndef __HOST_LOOPBACK_DEVICE_H_ */
@@ -0,0 +1,407 @@
+/*******************************************************************************
+ * @file LoopbackPeer.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file implements the loopback peer.
+ *
+ * @details This file implements the loopback peer. The bulk upload sends the
+ * frames of the window that are not acknowledged yet, the last frame sent
+ * requests an acknowledge. When no acknowledge is received, all the frames of
+ * the window that are not acknowledged are sent again.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstddef>        /* offsetof */
+#include <cstring>        /* memcpy */
+#include <HWMgr.h>        /* Time services */
+#include <LinkCodec.h>    /* Link compression */
+#include <esp_rom_crc.h>  /* CRC32 services */
+#include <BlueToothMgr.h> /* Bulk frame definitions */
+
+/* Header File */
+#include <LoopbackPeer.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Size of the data end marker. */
+#define DATA_END_MARKER_SIZE 16
+
+/** @brief Time waited for a bulk acknowledge in milliseconds. */
+#define BULK_ACK_TIMEOUT 100
+
+/** @brief Bulk frame state: to send. */
+#define BULK_FRAME_PENDING 0
+/** @brief Bulk frame state: sent, not acknowledged. */
+#define BULK_FRAME_SENT    1
+/** @brief Bulk frame state: acknowledged. */
+#define BULK_FRAME_ACKED   2
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+
+/** @brief End marker of the data sent without predefined size. */
+static const uint8_t skpDataEndMarker[DATA_END_MARKER_SIZE] = {
+    0xFE, 0xDE, 0xAD, 0xC0, 0xDE, 0xEC, 0xBB, 0xAD,
+    0x0E, 0x12, 0x34, 0x56, 0x78, 0x90, 0xAA, 0xBB
+};
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/**
+ * @brief Encodes data with the link codec.
+ *
+ * @param[in] pkData The data to encode.
+ * @param[in] kSize The size of the data.
+ * @param[out] rStream The encoded stream.
+ */
+static void EncodeStream(const uint8_t*        pkData,
+                         const size_t          kSize,
+                         std::vector<uint8_t>& rStream);
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+static void EncodeStream(const uint8_t*        pkData,
+                         const size_t          kSize,
+                         std::vector<uint8_t>& rStream)
+{
+    LinkEncoder encoder;
+    uint8_t     pBlock[LINK_CODEC_MAX_ENCODED_SIZE(LINK_CODEC_BLOCK)];
+    size_t      offset;
+    size_t      toEncode;
+    size_t      encoded;
+
+    rStream.clear();
+    for(offset = 0; offset < kSize; offset += toEncode)
+    {
+        toEncode = MIN(kSize - offset, (size_t)LINK_CODEC_BLOCK);
+        encoded  = encoder.Encode(pkData + offset, toEncode, pBlock);
+        rStream.insert(rStream.end(), pBlock, pBlock + encoded);
+    }
+}
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+LoopbackPeer::LoopbackPeer(LoopbackTransport* pTransport,
+                           const std::string& rkToken)
+{
+    pTransport_  = pTransport;
+    token_       = rkToken;
+    identifier_  = 1;
+    session_     = 0;
+    retransmits_ = 0;
+}
+
+bool LoopbackPeer::Command(const uint8_t     kType,
+                           const void*       pkData,
+                           const uint8_t     kSize,
+                           SCommandResponse& rResponse,
+                           const uint64_t    kTimeout)
+{
+    SCommandRequest request;
+    uint32_t        identifier;
+
+    memset(&request, 0, sizeof(SCommandRequest));
+    identifier                = identifier_++;
+    request.header.identifier = identifier;
+    request.header.type       = kType;
+    request.header.size       = kSize;
+    memcpy(request.header.pToken,
+           token_.c_str(),
+           MIN(token_.size(), (size_t)COMM_TOKEN_SIZE));
+    if(kSize != 0)
+    {
+        memcpy(request.pCommand, pkData, kSize);
+    }
+
+    if(!pTransport_->PeerWrite(TRANSPORT_CHANNEL_COMMAND,
+                               (const uint8_t*)&request,
+                               sizeof(SCommandHeader) + kSize,
+                               kTimeout))
+    {
+        return false;
+    }
+
+    return WaitResponse(rResponse, kTimeout) &&
+           rResponse.header.identifier == identifier;
+}
+
+bool LoopbackPeer::WaitResponse(SCommandResponse& rResponse,
+                                const uint64_t    kTimeout)
+{
+    ssize_t readBytes;
+
+    memset(&rResponse, 0, sizeof(SCommandResponse));
+    readBytes = pTransport_->PeerRead(TRANSPORT_CHANNEL_COMMAND,
+                                      (uint8_t*)&rResponse,
+                                      sizeof(SCommandResponse),
+                                      kTimeout);
+
+    return readBytes >= (ssize_t)sizeof(SCommandHeader) &&
+           rResponse.header.errorCode == NO_ERROR;
+}
+
+bool LoopbackPeer::Upload(const uint8_t* pkData,
+                          const size_t   kSize,
+                          const bool     kCompressed,
+                          const uint64_t kTimeout)
+{
+    std::vector<uint8_t> stream;
+    std::vector<uint8_t> states;
+    SBLEBulkAck          ack;
+    size_t               payloadSize;
+    size_t               frameCount;
+    size_t               base;
+    size_t               last;
+    size_t               lastPending;
+    size_t               highest;
+    size_t               offset;
+    size_t               i;
+    ssize_t              readBytes;
+    uint64_t             endTime;
+
+    if(kCompressed)
+    {
+        EncodeStream(pkData, kSize, stream);
+    }
+    else
+    {
+        stream.assign(pkData, pkData + kSize);
+    }
+
+    payloadSize = pTransport_->GetSegmentSize() - sizeof(SBLEBulkFrameHeader);
+    frameCount  = (stream.size() + payloadSize - 1) / payloadSize;
+    states.assign(frameCount, BULK_FRAME_PENDING);
+    endTime     = HWManager::GetTime() + kTimeout * 1000;
+    ++session_;
+
+    base = 0;
+    while(base < frameCount)
+    {
+        if(HWManager::GetTime() > endTime)
+        {
+            return false;
+        }
+
+        /* Send the pending frames of the window, the last one requests an
+         * acknowledge.
+         */
+        last        = MIN(frameCount, base + BLE_BULK_WINDOW);
+        lastPending = last;
+        for(i = base; i < last; ++i)
+        {
+            if(states[i] == BULK_FRAME_PENDING)
+            {
+                lastPending = i;
+            }
+        }
+        for(i = base; i < last; ++i)
+        {
+            if(states[i] != BULK_FRAME_PENDING)
+            {
+                continue;
+            }
+            offset = i * payloadSize;
+            if(!SendBulkFrame(i,
+                              i == lastPending ? BLE_BULK_FLAG_ACK_REQ : 0,
+                              stream.data() + offset,
+                              MIN(payloadSize, stream.size() - offset)))
+            {
+                return false;
+            }
+            states[i] = BULK_FRAME_SENT;
+        }
+
+        readBytes = pTransport_->PeerRead(TRANSPORT_CHANNEL_BULK,
+                                          (uint8_t*)&ack,
+                                          sizeof(SBLEBulkAck),
+                                          BULK_ACK_TIMEOUT);
+        if(readBytes != sizeof(SBLEBulkAck))
+        {
+            /* No acknowledge, send the window again */
+            for(i = base; i < last; ++i)
+            {
+                if(states[i] == BULK_FRAME_SENT)
+                {
+                    states[i] = BULK_FRAME_PENDING;
+                    ++retransmits_;
+                }
+            }
+            continue;
+        }
+        if(ack.session != session_ || ack.nextSequence < base)
+        {
+            continue;
+        }
+
+        /* Frames before the next sequence are delivered */
+        for(i = base; i < frameCount && i < ack.nextSequence; ++i)
+        {
+            states[i] = BULK_FRAME_ACKED;
+        }
+        base = ack.nextSequence;
+
+        /* The device ring was full, the frames not delivered are sent again,
+         * including the ones acknowledged as held.
+         */
+        if((ack.flags & BLE_BULK_ACK_FLAG_RESUME) != 0)
+        {
+            for(i = base; i < frameCount && i < base + BLE_BULK_WINDOW; ++i)
+            {
+                if(states[i] != BULK_FRAME_PENDING)
+                {
+                    states[i] = BULK_FRAME_PENDING;
+                    ++retransmits_;
+                }
+            }
+            continue;
+        }
+
+        /* Frames missing before the last held one are sent again */
+        highest = base;
+        for(i = 0; i < 32 && base + i < frameCount; ++i)
+        {
+            if((ack.bitmap & (1UL << i)) != 0)
+            {
+                states[base + i] = BULK_FRAME_ACKED;
+                highest          = base + i;
+            }
+        }
+        for(i = base; i < highest; ++i)
+        {
+            if(states[i] == BULK_FRAME_SENT)
+            {
+                states[i] = BULK_FRAME_PENDING;
+                ++retransmits_;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool LoopbackPeer::Download(std::vector<uint8_t>& rData,
+                            const size_t          kSize,
+                            const bool            kEndMarker,
+                            const bool            kCompressed,
+                            const uint64_t        kTimeout)
+{
+    LinkDecoder decoder;
+    uint8_t     pFrame[BLE_MESSAGE_MTU];
+    ssize_t     readBytes;
+    size_t      decoded;
+    size_t      consumed;
+    size_t      received;
+
+    rData.assign(kSize, 0);
+    received = 0;
+    while(kEndMarker || received < kSize)
+    {
+        readBytes = pTransport_->PeerRead(TRANSPORT_CHANNEL_DATA,
+                                          pFrame,
+                                          sizeof(pFrame),
+                                          kTimeout);
+        if(readBytes < 0)
+        {
+            return false;
+        }
+        if(kEndMarker &&
+           readBytes == DATA_END_MARKER_SIZE &&
+           memcmp(pFrame, skpDataEndMarker, DATA_END_MARKER_SIZE) == 0)
+        {
+            break;
+        }
+
+        if(kCompressed)
+        {
+            decoded = decoder.Decode(pFrame,
+                                     readBytes,
+                                     consumed,
+                                     rData.data() + received,
+                                     kSize - received);
+            if(decoder.HasError() || consumed != (size_t)readBytes)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            if((size_t)readBytes > kSize - received)
+            {
+                return false;
+            }
+            memcpy(rData.data() + received, pFrame, readBytes);
+            decoded = readBytes;
+        }
+        received += decoded;
+    }
+
+    rData.resize(received);
+    return true;
+}
+
+uint32_t LoopbackPeer::GetRetransmits(void) const
+{
+    return retransmits_;
+}
+
+bool LoopbackPeer::SendBulkFrame(const uint16_t kSequence,
+                                 const uint8_t  kFlags,
+                                 const uint8_t* pkPayload,
+                                 const size_t   kSize)
+{
+    uint8_t              pFrame[BLE_MESSAGE_MTU];
+    SBLEBulkFrameHeader* pHeader;
+
+    pHeader           = (SBLEBulkFrameHeader*)pFrame;
+    pHeader->session  = session_;
+    pHeader->flags    = kFlags;
+    pHeader->sequence = kSequence;
+    pHeader->crc      = esp_rom_crc32_le(0,
+                                         pFrame,
+                                         offsetof(SBLEBulkFrameHeader, crc));
+    pHeader->crc      = esp_rom_crc32_le(pHeader->crc, pkPayload, kSize);
+    memcpy(pFrame + sizeof(SBLEBulkFrameHeader), pkPayload, kSize);
+
+    return pTransport_->PeerWrite(TRANSPORT_CHANNEL_BULK,
+                                  pFrame,
+                                  sizeof(SBLEBulkFrameHeader) + kSize,
+                                  BULK_ACK_TIMEOUT);
+}
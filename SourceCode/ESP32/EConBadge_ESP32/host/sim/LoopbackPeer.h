@@ -0,0 +1,205 @@
+/*******************************************************************************
+ * @file LoopbackPeer.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file defines the loopback peer.
+ *
+ * @details This file defines the loopback peer. The peer is the client side
+ * of the protocol on a loopback transport: it sends the commands, uploads
+ * data as bulk frames with selective retransmit and reads the data notified
+ * on the data channel.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __HOST_LOOPBACK_PEER_H_
+#define __HOST_LOOPBACK_PEER_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <string>              /* std::string */
+#include <vector>              /* std::vector */
+#include <cstdint>             /* Standard Int Types */
+#include <Types.h>             /* Defined types */
+#include <LoopbackTransport.h> /* Loopback transport */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/**
+ * @brief The loopback peer class.
+ *
+ * @details The loopback peer class implements the client side of the
+ * protocol. The compressed transfers are encoded and decoded with the link
+ * codec, as the client application does.
+ */
+class LoopbackPeer
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        /**
+         * @brief Construct a new Loopback Peer object.
+         *
+         * @param[in] pTransport The loopback transport.
+         * @param[in] rkToken The communication token.
+         */
+        LoopbackPeer(LoopbackTransport* pTransport, const std::string& rkToken);
+
+        /**
+         * @brief Sends a command and waits for its response.
+         *
+         * @param[in] kType The command type.
+         * @param[in] pkData The command data, can be nullptr.
+         * @param[in] kSize The command data size.
+         * @param[out] rResponse The command response.
+         * @param[in] kTimeout The timeout in milliseconds.
+         *
+         * @return true is returned if the response was received without
+         * error, false otherwise.
+         */
+        bool Command(const uint8_t     kType,
+                     const void*       pkData,
+                     const uint8_t     kSize,
+                     SCommandResponse& rResponse,
+                     const uint64_t    kTimeout);
+
+        /**
+         * @brief Waits for a response sent after the command ack.
+         *
+         * @param[out] rResponse The command response.
+         * @param[in] kTimeout The timeout in milliseconds.
+         *
+         * @return true is returned if the response was received without
+         * error, false otherwise.
+         */
+        bool WaitResponse(SCommandResponse& rResponse,
+                          const uint64_t    kTimeout);
+
+        /**
+         * @brief Uploads data as bulk frames.
+         *
+         * @details Uploads data as bulk frames. A window of frames is sent,
+         * the frames missing in the acknowledges are sent again until all
+         * the frames are acknowledged.
+         *
+         * @param[in] pkData The data to upload.
+         * @param[in] kSize The size of the data.
+         * @param[in] kCompressed Tells if the data is sent compressed.
+         * @param[in] kTimeout The timeout in milliseconds.
+         *
+         * @return true is returned on success, false otherwise.
+         */
+        bool Upload(const uint8_t* pkData,
+                    const size_t   kSize,
+                    const bool     kCompressed,
+                    const uint64_t kTimeout);
+
+        /**
+         * @brief Downloads data notified on the data channel.
+         *
+         * @param[out] rData The downloaded data.
+         * @param[in] kSize The size of the data, the size of the buffer when
+         * the data is followed by the end marker.
+         * @param[in] kEndMarker Tells if the data ends with the end marker.
+         * @param[in] kCompressed Tells if the data is sent compressed.
+         * @param[in] kTimeout The timeout between two frames in milliseconds.
+         *
+         * @return true is returned on success, false otherwise.
+         */
+        bool Download(std::vector<uint8_t>& rData,
+                      const size_t          kSize,
+                      const bool            kEndMarker,
+                      const bool            kCompressed,
+                      const uint64_t        kTimeout);
+
+        /**
+         * @brief Gets the number of bulk frames sent again.
+         *
+         * @return The number of bulk frames sent again is returned.
+         */
+        uint32_t GetRetransmits(void) const;
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+        /* None */
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        /**
+         * @brief Sends a bulk frame.
+         *
+         * @param[in] kSequence The frame sequence.
+         * @param[in] kFlags The frame flags.
+         * @param[in] pkPayload The frame payload.
+         * @param[in] kSize The frame payload size.
+         *
+         * @return true is returned on success, false otherwise.
+         */
+        bool SendBulkFrame(const uint16_t kSequence,
+                           const uint8_t  kFlags,
+                           const uint8_t* pkPayload,
+                           const size_t   kSize);
+
+        /** @brief Stores the loopback transport. */
+        LoopbackTransport* pTransport_;
+        /** @brief Stores the communication token. */
+        std::string        token_;
+        /** @brief Stores the identifier of the next command. */
+        uint32_t           identifier_;
+        /** @brief Stores the current bulk session. */
+        uint8_t            session_;
+        /** @brief Stores the number of bulk frames sent again. */
+        uint32_t           retransmits_;
+};
+
+#endif /* #ifndef __HOST_LOOPBACK_PEER_H_ */
@@ -0,0 +1,398 @@
+/*******************************************************************************
+ * @file LoopbackTransport.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file implements the loopback transport.
+ *
+ * @details This file implements the loopback transport. Each direction of the
+ * link serializes its frames at the configured bandwidth, the frames are then
+ * received after the configured latency. Only the bulk channel loses frames,
+ * the ATT writes and notifications of the other channels are reliable.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstring>        /* memcpy */
+#include <Types.h>        /* Custom defined types */
+#include <HWMgr.h>        /* HW layer component*/
+#include <Logger.h>       /* System logger */
+#include <BLETransport.h> /* BLE transport interface */
+
+/* Header File */
+#include <LoopbackTransport.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Loopback task stack size. */
+#define LOOPBACK_STACK_SIZE 4096
+/** @brief Loopback task priority. */
+#define LOOPBACK_PRIORITY 6
+/** @brief Number of frames written by the peer in flight. */
+#define LOOPBACK_TO_DEVICE_DEPTH 16
+/** @brief Loss rate resolution. */
+#define LOOPBACK_LOSS_RESOLUTION 10000
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/**
+ * @brief Waits until a frame is due.
+ *
+ * @param[in] kDueTime The frame due time in microseconds.
+ */
+static void WaitDueTime(const uint64_t kDueTime);
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+static void WaitDueTime(const uint64_t kDueTime)
+{
+    uint64_t now;
+
+    now = HWManager::GetTime();
+    if(now < kDueTime)
+    {
+        HWManager::DelayExecUs(kDueTime - now);
+    }
+}
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+LoopbackTransport::LoopbackTransport(const SLoopbackConfig& rkConfig)
+{
+    uint8_t i;
+
+    config_ = rkConfig;
+    if(config_.queueDepth == 0)
+    {
+        config_.queueDepth = 1;
+    }
+    if(config_.seed == 0)
+    {
+        config_.seed = 1;
+    }
+
+    memset(&counters_, 0, sizeof(SLoopbackCounters));
+    pHandler_         = nullptr;
+    thread_           = nullptr;
+    toDeviceFreeTime_ = 0;
+    toPeerFreeTime_   = 0;
+    lossState_        = config_.seed;
+    connected_        = false;
+    lastStatus_       = LOOPBACK_STATUS_NOT_CONNECTED;
+
+    toDevice_ = xQueueCreate(LOOPBACK_TO_DEVICE_DEPTH, sizeof(SLoopbackFrame));
+    for(i = 0; i < TRANSPORT_CHANNEL_COUNT; ++i)
+    {
+        pToPeer_[i] = xQueueCreate(config_.queueDepth, sizeof(SLoopbackFrame));
+    }
+    lock_ = xSemaphoreCreateMutex();
+}
+
+bool LoopbackTransport::Start(TransportHandler* pHandler)
+{
+    pHandler_ = pHandler;
+
+    xTaskCreatePinnedToCore(
+        DeliveryRoutine,
+        "LoopbackThread",
+        LOOPBACK_STACK_SIZE,
+        this,
+        LOOPBACK_PRIORITY,
+        &thread_,
+        tskNO_AFFINITY
+    );
+    if(thread_ == nullptr)
+    {
+        LOG_ERROR("Failed to start the loopback transport\n");
+        return false;
+    }
+
+    LOG_INFO("Loopback transport started, MTU %d\n", config_.mtu);
+    return true;
+}
+
+bool LoopbackTransport::IsConnected(void) const
+{
+    return connected_;
+}
+
+ETransportStatus LoopbackTransport::Send(const ETransportChannel kChannel,
+                                         const uint8_t*          pkData,
+                                         const size_t            kSize)
+{
+    SLoopbackFrame frame;
+    bool           isLost;
+
+    if(!connected_)
+    {
+        lastStatus_ = LOOPBACK_STATUS_NOT_CONNECTED;
+        return TRANSPORT_FAILED;
+    }
+    if(kSize > GetSegmentSize())
+    {
+        lastStatus_ = LOOPBACK_STATUS_TOO_LONG;
+        return TRANSPORT_FAILED;
+    }
+
+    frame.channel = kChannel;
+    frame.size    = kSize;
+    memcpy(frame.pData, pkData, kSize);
+
+    xSemaphoreTake(lock_, portMAX_DELAY);
+
+    /* A full link queue is the loopback equivalent of the stack mbufs */
+    if(uxQueueSpacesAvailable(pToPeer_[kChannel]) == 0)
+    {
+        ++counters_.congestions;
+        xSemaphoreGive(lock_);
+        lastStatus_ = LOOPBACK_STATUS_CONGESTED;
+        return TRANSPORT_CONGESTED;
+    }
+
+    /* A lost frame still used the link */
+    ScheduleFrame(frame, toPeerFreeTime_);
+    isLost = (kChannel == TRANSPORT_CHANNEL_BULK && IsFrameLost());
+    if(isLost)
+    {
+        ++counters_.lostFrames;
+    }
+    else
+    {
+        xQueueSend(pToPeer_[kChannel], &frame, 0);
+        ++counters_.framesToPeer;
+    }
+
+    xSemaphoreGive(lock_);
+
+    lastStatus_ = LOOPBACK_STATUS_OK;
+    return TRANSPORT_OK;
+}
+
+int LoopbackTransport::GetLastStatus(void) const
+{
+    return lastStatus_;
+}
+
+void LoopbackTransport::Connect(void)
+{
+    SBLELinkInfo info;
+
+    if(connected_ || pHandler_ == nullptr)
+    {
+        return;
+    }
+
+    memset(&info, 0, sizeof(SBLELinkInfo));
+    info.mtu          = config_.mtu;
+    info.segmentSize  = GetSegmentSize();
+    info.dataLength   = config_.mtu + 4;
+    info.txPhy        = 2;
+    info.rxPhy        = 2;
+    info.connInterval = config_.connInterval;
+
+    toDeviceFreeTime_ = 0;
+    toPeerFreeTime_   = 0;
+
+    pHandler_->OnConnect(info);
+    connected_ = true;
+
+    LOG_DEBUG("Loopback peer connected\n");
+}
+
+void LoopbackTransport::Disconnect(void)
+{
+    uint8_t i;
+
+    if(!connected_)
+    {
+        return;
+    }
+
+    connected_ = false;
+
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    xQueueReset(toDevice_);
+    for(i = 0; i < TRANSPORT_CHANNEL_COUNT; ++i)
+    {
+        xQueueReset(pToPeer_[i]);
+    }
+    xSemaphoreGive(lock_);
+
+    pHandler_->OnDisconnect();
+
+    LOG_DEBUG("Loopback peer disconnected\n");
+}
+
+bool LoopbackTransport::PeerWrite(const ETransportChannel kChannel,
+                                  const uint8_t*          pkData,
+                                  const size_t            kSize,
+                                  const uint64_t          kTimeout)
+{
+    SLoopbackFrame frame;
+    bool           isLost;
+
+    if(!connected_ || kSize > BLE_MESSAGE_MTU)
+    {
+        return false;
+    }
+
+    /* Only the commands are written with response, as long writes */
+    if(kChannel != TRANSPORT_CHANNEL_COMMAND && kSize > GetSegmentSize())
+    {
+        return false;
+    }
+
+    frame.channel = kChannel;
+    frame.size    = kSize;
+    memcpy(frame.pData, pkData, kSize);
+
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    ScheduleFrame(frame, toDeviceFreeTime_);
+    isLost = (kChannel == TRANSPORT_CHANNEL_BULK && IsFrameLost());
+    if(isLost)
+    {
+        ++counters_.lostFrames;
+    }
+    else
+    {
+        ++counters_.framesToDevice;
+    }
+    xSemaphoreGive(lock_);
+
+    if(isLost)
+    {
+        return true;
+    }
+
+    return xQueueSend(toDevice_, &frame, pdMS_TO_TICKS(kTimeout)) == pdTRUE;
+}
+
+ssize_t LoopbackTransport::PeerRead(const ETransportChannel kChannel,
+                                    uint8_t*                pBuffer,
+                                    const size_t            kSize,
+                                    const uint64_t          kTimeout)
+{
+    SLoopbackFrame frame;
+
+    if(xQueueReceive(pToPeer_[kChannel],
+                     &frame,
+                     pdMS_TO_TICKS(kTimeout)) != pdTRUE)
+    {
+        return -1;
+    }
+
+    WaitDueTime(frame.dueTime);
+
+    memcpy(pBuffer, frame.pData, MIN(kSize, frame.size));
+    return MIN(kSize, frame.size);
+}
+
+uint16_t LoopbackTransport::GetSegmentSize(void) const
+{
+    return BLE_SEGMENT_SIZE(config_.mtu);
+}
+
+void LoopbackTransport::GetCounters(SLoopbackCounters& rCounters) const
+{
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    rCounters = counters_;
+    xSemaphoreGive(lock_);
+}
+
+void LoopbackTransport::ScheduleFrame(SLoopbackFrame& rFrame,
+                                      uint64_t&       rLinkFreeTime)
+{
+    uint64_t startTime;
+
+    startTime = MAX(HWManager::GetTime(), rLinkFreeTime);
+    if(config_.bandwidth != 0)
+    {
+        startTime += (uint64_t)rFrame.size * 1000000 / config_.bandwidth;
+    }
+
+    rLinkFreeTime  = startTime;
+    rFrame.dueTime = startTime + config_.latency;
+}
+
+bool LoopbackTransport::IsFrameLost(void)
+{
+    if(config_.lossRate == 0)
+    {
+        return false;
+    }
+
+    /* Xorshift, reproducible for a given seed */
+    lossState_ ^= lossState_ << 13;
+    lossState_ ^= lossState_ >> 17;
+    lossState_ ^= lossState_ << 5;
+
+    return (lossState_ % LOOPBACK_LOSS_RESOLUTION) < config_.lossRate;
+}
+
+void LoopbackTransport::DeliveryRoutine(void* pTransportParam)
+{
+    LoopbackTransport* pTransport;
+    SLoopbackFrame     frame;
+
+    pTransport = (LoopbackTransport*)pTransportParam;
+
+    while(true)
+    {
+        if(xQueueReceive(pTransport->toDevice_,
+                         &frame,
+                         portMAX_DELAY) != pdTRUE)
+        {
+            continue;
+        }
+
+        WaitDueTime(frame.dueTime);
+
+        /* Frames in flight at disconnection are dropped */
+        if(pTransport->connected_)
+        {
+            pTransport->pHandler_->OnReceive(frame.channel,
+                                             frame.pData,
+                                             frame.size);
+        }
+    }
+}
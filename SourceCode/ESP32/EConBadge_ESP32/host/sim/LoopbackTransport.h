@@ -0,0 +1,303 @@
+/*******************************************************************************
+ * @file LoopbackTransport.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file defines the loopback transport.
+ *
+ * @details This file defines the loopback transport. The loopback transport is
+ * an in-process link between the bluetooth manager and a simulated client,
+ * the peer. The link latency, MTU, bandwidth and bulk frame loss are
+ * configurable, the protocol and flow control can be measured without a
+ * radio.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __HOST_LOOPBACK_TRANSPORT_H_
+#define __HOST_LOOPBACK_TRANSPORT_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint>        /* Standard Int Types */
+#include <Arduino.h>      /* Arduino framework */
+#include <BLETransport.h> /* BLE transport interface */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Loopback status: the frame was sent. */
+#define LOOPBACK_STATUS_OK            0
+/** @brief Loopback status: the link queue is full. */
+#define LOOPBACK_STATUS_CONGESTED     1
+/** @brief Loopback status: the frame exceeds the segment size. */
+#define LOOPBACK_STATUS_TOO_LONG      2
+/** @brief Loopback status: no peer is connected. */
+#define LOOPBACK_STATUS_NOT_CONNECTED 3
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/** @brief Defines the loopback link configuration. */
+typedef struct
+{
+    /** @brief ATT MTU of the link. */
+    uint16_t mtu;
+    /** @brief Connection interval reported to the manager, 1.25ms units. */
+    uint16_t connInterval;
+    /** @brief One-way latency in microseconds. */
+    uint32_t latency;
+    /** @brief Bandwidth of each direction in bytes per second, 0: infinite. */
+    uint32_t bandwidth;
+    /** @brief Bulk frame loss rate, in frames per 10000. */
+    uint16_t lossRate;
+    /** @brief Number of frames queued towards the peer on each channel. */
+    uint8_t  queueDepth;
+    /** @brief Seed of the loss generator, not 0. */
+    uint32_t seed;
+} SLoopbackConfig;
+
+/** @brief Defines the loopback link counters. */
+typedef struct
+{
+    /** @brief Frames written by the peer. */
+    uint32_t framesToDevice;
+    /** @brief Frames notified to the peer. */
+    uint32_t framesToPeer;
+    /** @brief Bulk frames lost on the link. */
+    uint32_t lostFrames;
+    /** @brief Notifications rejected on a full link queue. */
+    uint32_t congestions;
+} SLoopbackCounters;
+
+/** @brief Defines a frame in flight on the loopback link. */
+typedef struct
+{
+    /** @brief Channel of the frame. */
+    ETransportChannel channel;
+    /** @brief Size of the frame. */
+    uint16_t          size;
+    /** @brief Time at which the frame is received, in microseconds. */
+    uint64_t          dueTime;
+    /** @brief Frame data. */
+    uint8_t           pData[BLE_MESSAGE_MTU];
+} SLoopbackFrame;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/**
+ * @brief The loopback transport class.
+ *
+ * @details The loopback transport class links the bluetooth manager to a peer
+ * in the same process. The peer writes and reads the frames of the channels,
+ * the frames written by the peer are delivered to the manager by the loopback
+ * task once their latency has elapsed.
+ */
+class LoopbackTransport: public BLETransport
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        /**
+         * @brief Construct a new Loopback Transport object.
+         *
+         * @param[in] rkConfig The link configuration.
+         */
+        explicit LoopbackTransport(const SLoopbackConfig& rkConfig);
+
+        /**
+         * @brief Starts the transport.
+         *
+         * @details Starts the loopback task, the peer can connect after this
+         * call.
+         *
+         * @param[in] pHandler The transport handler.
+         *
+         * @return true is returned on success, false otherwise.
+         */
+        virtual bool Start(TransportHandler* pHandler);
+
+        /**
+         * @brief Tells if the peer is connected.
+         *
+         * @return true is returned if the peer is connected, false otherwise.
+         */
+        virtual bool IsConnected(void) const;
+
+        /**
+         * @brief Sends a frame to the peer.
+         *
+         * @param[in] kChannel The channel to send the frame on.
+         * @param[in] pkData The frame data.
+         * @param[in] kSize The frame size.
+         *
+         * @return The send status is returned.
+         */
+        virtual ETransportStatus Send(const ETransportChannel kChannel,
+                                      const uint8_t*          pkData,
+                                      const size_t            kSize);
+
+        /**
+         * @brief Gets the status of the last send.
+         *
+         * @return The LOOPBACK_STATUS_* of the last send is returned.
+         */
+        virtual int GetLastStatus(void) const;
+
+        /**
+         * @brief Connects the peer.
+         */
+        void Connect(void);
+
+        /**
+         * @brief Disconnects the peer.
+         *
+         * @details Disconnects the peer, the frames in flight are dropped.
+         */
+        void Disconnect(void);
+
+        /**
+         * @brief Writes a frame from the peer.
+         *
+         * @param[in] kChannel The channel to write the frame on.
+         * @param[in] pkData The frame data.
+         * @param[in] kSize The frame size, at most the segment size. The
+         * commands are written with response and can be up to
+         * BLE_MESSAGE_MTU long.
+         * @param[in] kTimeout The timeout in milliseconds.
+         *
+         * @return true is returned if the frame was written, a lost bulk
+         * frame is written. false is returned otherwise.
+         */
+        bool PeerWrite(const ETransportChannel kChannel,
+                       const uint8_t*          pkData,
+                       const size_t            kSize,
+                       const uint64_t          kTimeout);
+
+        /**
+         * @brief Reads a frame notified to the peer.
+         *
+         * @details Reads the next frame notified to the peer on a channel,
+         * the call returns when the frame latency has elapsed.
+         *
+         * @param[in] kChannel The channel to read the frame from.
+         * @param[out] pBuffer The buffer that receives the frame.
+         * @param[in] kSize The size of the buffer.
+         * @param[in] kTimeout The timeout in milliseconds.
+         *
+         * @return The frame size is returned, -1 on timeout.
+         */
+        ssize_t PeerRead(const ETransportChannel kChannel,
+                         uint8_t*                pBuffer,
+                         const size_t            kSize,
+                         const uint64_t          kTimeout);
+
+        /**
+         * @brief Gets the data segment size of the link.
+         *
+         * @return The data segment size of the link is returned.
+         */
+        uint16_t GetSegmentSize(void) const;
+
+        /**
+         * @brief Gets the link counters.
+         *
+         * @param[out] rCounters The counters to fill.
+         */
+        void GetCounters(SLoopbackCounters& rCounters) const;
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+        /* None */
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        /**
+         * @brief Schedules a frame on one direction of the link.
+         *
+         * @param[in, out] rFrame The frame, its due time is set.
+         * @param[in, out] rLinkFreeTime The time at which the link direction
+         * is free.
+         */
+        void ScheduleFrame(SLoopbackFrame& rFrame, uint64_t& rLinkFreeTime);
+
+        /**
+         * @brief Tells if the next bulk frame is lost.
+         *
+         * @return true is returned if the frame is lost, false otherwise.
+         */
+        bool IsFrameLost(void);
+
+        /**
+         * @brief Loopback task routine, delivers the peer frames.
+         *
+         * @param[in] pTransportParam The loopback transport.
+         */
+        static void DeliveryRoutine(void* pTransportParam);
+
+        /** @brief Stores the link configuration. */
+        SLoopbackConfig   config_;
+        /** @brief Stores the link counters. */
+        SLoopbackCounters counters_;
+        /** @brief Stores the transport handler. */
+        TransportHandler* pHandler_;
+        /** @brief Stores the frames written by the peer. */
+        QueueHandle_t     toDevice_;
+        /** @brief Stores the frames notified to the peer, per channel. */
+        QueueHandle_t     pToPeer_[TRANSPORT_CHANNEL_COUNT];
+        /** @brief Protects the link schedule and counters. */
+        SemaphoreHandle_t lock_;
+        /** @brief Stores the loopback task. */
+        TaskHandle_t      thread_;
+        /** @brief Time at which the peer to device direction is free. */
+        uint64_t          toDeviceFreeTime_;
+        /** @brief Time at which the device to peer direction is free. */
+        uint64_t          toPeerFreeTime_;
+        /** @brief Stores the loss generator state. */
+        uint32_t          lossState_;
+        /** @brief Tells if the peer is connected. */
+        volatile bool     connected_;
+        /** @brief Stores the status of the last send. */
+        int               lastStatus_;
+};
+
+#endif /* #ifndef __HOST_LOOPBACK_TRANSPORT_H_ */
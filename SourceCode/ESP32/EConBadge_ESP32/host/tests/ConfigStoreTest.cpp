@@ -0,0 +1,478 @@
+/*******************************************************************************
+ * @file ConfigStoreTest.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file tests the configuration store.
+ *
+ * @details This file tests the configuration store journal. The store is
+ * created once per process, so each boot scenario runs in its own process
+ * on an empty host SD card: the files left by the previous boot are written
+ * before the store is created, then the settings and the journal are checked.
+ *
+ * Usage: ConfigStoreTest <replay|torn|compaction|interrupted|legacy>
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <string>        /* std::string */
+#include <vector>        /* std::vector */
+#include <cstdio>        /* printf */
+#include <cstddef>       /* offsetof */
+#include <cstring>       /* memcpy, strcmp */
+#include <Types.h>       /* Defined types */
+#include <Logger.h>      /* Logger service */
+#include <Storage.h>     /* Storage service */
+#include <HostTest.h>    /* Test checks */
+#include <ConfigStore.h> /* Configuration store */
+#include <esp_rom_crc.h> /* CRC32 */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Temporary journal of the compaction, see ConfigStore.cpp. */
+#define TEST_JOURNAL_TMP_FILE_PATH CONFIG_JOURNAL_FILE_PATH ".tmp"
+/** @brief Default bluetooth token, see ConfigStore.cpp. */
+#define TEST_DEFAULT_BT_TOKEN "0000000000000000"
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/** @brief Raw file content. */
+typedef std::vector<uint8_t> TBytes;
+
+/** @brief Defines the settings replayed from a journal. */
+typedef struct
+{
+    /** @brief Values by key. */
+    std::string pValues[CONFIG_KEY_COUNT];
+    /** @brief Set flags by key. */
+    bool        pIsSet[CONFIG_KEY_COUNT];
+} SJournalState;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/** @brief Builds a journal header. */
+static TBytes MakeHeader(void)
+{
+    SConfigJournalHeader header;
+
+    header.magic    = CONFIG_JOURNAL_MAGIC;
+    header.version  = CONFIG_JOURNAL_VERSION;
+    header.reserved = 0;
+
+    return TBytes((const uint8_t*)&header,
+                  (const uint8_t*)&header + sizeof(header));
+}
+
+/** @brief Appends a journal record. */
+static void AddRecord(TBytes&            rJournal,
+                      const EConfigKey   kKey,
+                      const EConfigType  kType,
+                      const std::string& rkValue)
+{
+    SConfigRecordHeader record;
+
+    record.key  = kKey;
+    record.type = kType;
+    record.size = rkValue.size();
+    record.crc  = esp_rom_crc32_le(0,
+                                   (const uint8_t*)&record,
+                                   offsetof(SConfigRecordHeader, crc));
+    record.crc  = esp_rom_crc32_le(record.crc,
+                                   (const uint8_t*)rkValue.data(),
+                                   rkValue.size());
+
+    rJournal.insert(rJournal.end(),
+                    (const uint8_t*)&record,
+                    (const uint8_t*)&record + sizeof(record));
+    rJournal.insert(rJournal.end(), rkValue.begin(), rkValue.end());
+}
+
+/** @brief Encodes an integer value. */
+static std::string IntValue(const int32_t kValue)
+{
+    return std::string((const char*)&kValue, sizeof(int32_t));
+}
+
+/** @brief Writes a file of the host SD card. */
+static bool WriteFile(const char* pkPath, const TBytes& rkContent)
+{
+    FsFile file;
+    bool   status;
+
+    Storage::GetInstance()->Remove(pkPath);
+    file = Storage::GetInstance()->Open(pkPath, FILE_WRITE);
+    if(!file)
+    {
+        return false;
+    }
+    status = file.write(rkContent.data(), rkContent.size()) ==
+             rkContent.size();
+    file.close();
+
+    return status;
+}
+
+/** @brief Reads a file of the host SD card. */
+static bool ReadFile(const char* pkPath, TBytes& rContent)
+{
+    FsFile file;
+    bool   status;
+
+    rContent.clear();
+    file = Storage::GetInstance()->Open(pkPath, FILE_READ);
+    if(!file)
+    {
+        return false;
+    }
+    rContent.resize(file.fileSize());
+    status = rContent.empty() ||
+             file.read(rContent.data(), rContent.size()) ==
+             (int)rContent.size();
+    file.close();
+
+    return status;
+}
+
+/**
+ * @brief Replays the journal of the host SD card.
+ *
+ * @return true is returned if the journal is valid up to its last byte.
+ */
+static bool ReplayJournal(SJournalState& rState)
+{
+    TBytes               journal;
+    SConfigJournalHeader header;
+    SConfigRecordHeader  record;
+    size_t               offset;
+    uint32_t             crc;
+    uint8_t              i;
+
+    for(i = 0; i < CONFIG_KEY_COUNT; ++i)
+    {
+        rState.pValues[i].clear();
+        rState.pIsSet[i] = false;
+    }
+
+    if(!ReadFile(CONFIG_JOURNAL_FILE_PATH, journal) ||
+       journal.size() < sizeof(header))
+    {
+        return false;
+    }
+    memcpy(&header, journal.data(), sizeof(header));
+    if(header.magic != CONFIG_JOURNAL_MAGIC ||
+       header.version != CONFIG_JOURNAL_VERSION)
+    {
+        return false;
+    }
+
+    offset = sizeof(header);
+    while(offset + sizeof(record) <= journal.size())
+    {
+        memcpy(&record, journal.data() + offset, sizeof(record));
+        if(record.key >= CONFIG_KEY_COUNT ||
+           offset + sizeof(record) + record.size > journal.size())
+        {
+            return false;
+        }
+        crc = esp_rom_crc32_le(0,
+                               journal.data() + offset,
+                               offsetof(SConfigRecordHeader, crc));
+        crc = esp_rom_crc32_le(crc,
+                               journal.data() + offset + sizeof(record),
+                               record.size);
+        if(crc != record.crc)
+        {
+            return false;
+        }
+
+        rState.pValues[record.key].assign(
+            (const char*)journal.data() + offset + sizeof(record),
+            record.size
+        );
+        rState.pIsSet[record.key] = true;
+        offset += sizeof(record) + record.size;
+    }
+
+    return offset == journal.size();
+}
+
+/** @brief Gets the size of a file of the host SD card, 0 if missing. */
+static size_t GetFileSize(const char* pkPath)
+{
+    TBytes content;
+
+    ReadFile(pkPath, content);
+
+    return content.size();
+}
+
+/** @brief Checks the journal records are replayed in order. */
+static void TestReplay(void)
+{
+    ConfigStore*  pConfig;
+    TBytes        journal;
+    SJournalState state;
+    std::string   value;
+    size_t        size;
+
+    journal = MakeHeader();
+    AddRecord(journal, CONFIG_KEY_OWNER, CONFIG_TYPE_STRING, "Alice");
+    AddRecord(journal, CONFIG_KEY_LED_BRIGHTNESS,
+              CONFIG_TYPE_INTEGER, IntValue(42));
+    AddRecord(journal, CONFIG_KEY_OWNER, CONFIG_TYPE_STRING, "Bob");
+    AddRecord(journal, CONFIG_KEY_BT_TOKEN,
+              CONFIG_TYPE_STRING, "0123456789ABCDEF");
+    TEST_CHECK(WriteFile(CONFIG_JOURNAL_FILE_PATH, journal));
+
+    /* The last record of a key wins, the unset keys get their default */
+    pConfig = ConfigStore::GetInstance();
+    TEST_CHECK(pConfig->GetString(CONFIG_KEY_OWNER, value));
+    TEST_CHECK(value == "Bob");
+    TEST_CHECK(pConfig->GetString(CONFIG_KEY_BT_TOKEN, value));
+    TEST_CHECK(value == "0123456789ABCDEF");
+    TEST_CHECK(pConfig->GetString(CONFIG_KEY_CONTACT, value));
+    TEST_CHECK(value.empty());
+    TEST_CHECK(pConfig->GetInteger(CONFIG_KEY_LED_BRIGHTNESS) == 42);
+    TEST_CHECK(pConfig->GetInteger(CONFIG_KEY_LED_ENABLED) == 0);
+
+    /* A new value is appended, an unchanged one is not written */
+    TEST_CHECK(pConfig->SetString(CONFIG_KEY_CONTACT, "bob@mail"));
+    size = GetFileSize(CONFIG_JOURNAL_FILE_PATH);
+    TEST_CHECK(size == journal.size() + sizeof(SConfigRecordHeader) + 8);
+    TEST_CHECK(pConfig->SetString(CONFIG_KEY_OWNER, "Bob"));
+    TEST_CHECK(GetFileSize(CONFIG_JOURNAL_FILE_PATH) == size);
+
+    TEST_CHECK(ReplayJournal(state));
+    TEST_CHECK(state.pValues[CONFIG_KEY_OWNER] == "Bob");
+    TEST_CHECK(state.pValues[CONFIG_KEY_CONTACT] == "bob@mail");
+    TEST_CHECK(!state.pIsSet[CONFIG_KEY_CURRENT_IMAGE]);
+}
+
+/** @brief Checks a record torn by a power loss is dropped. */
+static void TestTornRecord(void)
+{
+    ConfigStore*  pConfig;
+    TBytes        journal;
+    SJournalState state;
+    std::string   value;
+    size_t        validSize;
+
+    journal = MakeHeader();
+    AddRecord(journal, CONFIG_KEY_OWNER, CONFIG_TYPE_STRING, "Alice");
+    validSize = journal.size();
+    AddRecord(journal, CONFIG_KEY_CONTACT, CONFIG_TYPE_STRING, "alice@mail");
+    journal.resize(journal.size() - 3);
+    TEST_CHECK(WriteFile(CONFIG_JOURNAL_FILE_PATH, journal));
+
+    /* The complete records are kept, the torn one is truncated */
+    pConfig = ConfigStore::GetInstance();
+    TEST_CHECK(pConfig->GetString(CONFIG_KEY_OWNER, value));
+    TEST_CHECK(value == "Alice");
+    TEST_CHECK(pConfig->GetString(CONFIG_KEY_CONTACT, value));
+    TEST_CHECK(value.empty());
+    TEST_CHECK(GetFileSize(CONFIG_JOURNAL_FILE_PATH) == validSize);
+
+    /* The next record follows the last complete one */
+    TEST_CHECK(pConfig->SetString(CONFIG_KEY_CONTACT, "new@mail"));
+    TEST_CHECK(ReplayJournal(state));
+    TEST_CHECK(state.pValues[CONFIG_KEY_OWNER] == "Alice");
+    TEST_CHECK(state.pValues[CONFIG_KEY_CONTACT] == "new@mail");
+}
+
+/** @brief Checks the journal is compacted before it outgrows its size. */
+static void TestCompaction(void)
+{
+    ConfigStore*  pConfig;
+    SJournalState state;
+    std::string   value;
+    size_t        size;
+    size_t        previousSize;
+    size_t        compactions;
+    int32_t       i;
+
+    /* No journal nor legacy file, an empty journal is created */
+    pConfig = ConfigStore::GetInstance();
+    TEST_CHECK(ReplayJournal(state));
+    TEST_CHECK(GetFileSize(CONFIG_JOURNAL_FILE_PATH) ==
+               sizeof(SConfigJournalHeader));
+    TEST_CHECK(pConfig->GetString(CONFIG_KEY_BT_TOKEN, value));
+    TEST_CHECK(value == TEST_DEFAULT_BT_TOKEN);
+
+    TEST_CHECK(pConfig->SetString(CONFIG_KEY_OWNER, "Alice"));
+    TEST_CHECK(pConfig->SetString(CONFIG_KEY_BT_TOKEN, "0123456789ABCDEF"));
+
+    /* Write twice the journal size of brightness records */
+    previousSize = GetFileSize(CONFIG_JOURNAL_FILE_PATH);
+    compactions  = 0;
+    for(i = 1;
+        i < (int32_t)(2 * CONFIG_JOURNAL_MAX_SIZE /
+                      (sizeof(SConfigRecordHeader) + sizeof(int32_t)));
+        ++i)
+    {
+        TEST_CHECK(pConfig->SetInteger(CONFIG_KEY_LED_BRIGHTNESS, i));
+        size = GetFileSize(CONFIG_JOURNAL_FILE_PATH);
+        TEST_CHECK(size <= CONFIG_JOURNAL_MAX_SIZE);
+        if(size < previousSize)
+        {
+            ++compactions;
+        }
+        previousSize = size;
+    }
+    TEST_CHECK(compactions >= 2);
+    TEST_CHECK(!Storage::GetInstance()->FileExists(
+        TEST_JOURNAL_TMP_FILE_PATH
+    ));
+
+    /* The compacted journal keeps every setting */
+    TEST_CHECK(ReplayJournal(state));
+    TEST_CHECK(state.pValues[CONFIG_KEY_OWNER] == "Alice");
+    TEST_CHECK(state.pValues[CONFIG_KEY_BT_TOKEN] == "0123456789ABCDEF");
+    TEST_CHECK(state.pValues[CONFIG_KEY_LED_BRIGHTNESS] == IntValue(i - 1));
+    TEST_CHECK(pConfig->GetInteger(CONFIG_KEY_LED_BRIGHTNESS) == i - 1);
+    TEST_CHECK(pConfig->GetString(CONFIG_KEY_OWNER, value));
+    TEST_CHECK(value == "Alice");
+}
+
+/** @brief Checks a compaction interrupted before the rename is completed. */
+static void TestInterruptedCompaction(void)
+{
+    ConfigStore*  pConfig;
+    TBytes        journal;
+    SJournalState state;
+    std::string   value;
+
+    /* The journal was removed, its replacement was not renamed yet */
+    journal = MakeHeader();
+    AddRecord(journal, CONFIG_KEY_OWNER, CONFIG_TYPE_STRING, "Alice");
+    AddRecord(journal, CONFIG_KEY_LED_ENABLED,
+              CONFIG_TYPE_INTEGER, IntValue(1));
+    TEST_CHECK(WriteFile(TEST_JOURNAL_TMP_FILE_PATH, journal));
+
+    pConfig = ConfigStore::GetInstance();
+    TEST_CHECK(pConfig->GetString(CONFIG_KEY_OWNER, value));
+    TEST_CHECK(value == "Alice");
+    TEST_CHECK(pConfig->GetInteger(CONFIG_KEY_LED_ENABLED) == 1);
+
+    TEST_CHECK(!Storage::GetInstance()->FileExists(
+        TEST_JOURNAL_TMP_FILE_PATH
+    ));
+    TEST_CHECK(ReplayJournal(state));
+    TEST_CHECK(state.pValues[CONFIG_KEY_OWNER] == "Alice");
+    TEST_CHECK(state.pValues[CONFIG_KEY_LED_ENABLED] == IntValue(1));
+}
+
+/** @brief Checks the settings files of the previous firmware are imported. */
+static void TestLegacyImport(void)
+{
+    Storage*      pStore;
+    ConfigStore*  pConfig;
+    SJournalState state;
+    std::string   value;
+
+    pStore = Storage::GetInstance();
+    pStore->CreateDirectory(LEDBORDER_DIR_PATH);
+    TEST_CHECK(pStore->SetContent(OWNER_FILE_PATH, "Alice"));
+    TEST_CHECK(pStore->SetContent(BLUETOOTH_TOKEN_FILE_PATH,
+                                  "0123456789ABCDEF"));
+    TEST_CHECK(pStore->SetContent(LEDBORDER_ENABLED_FILE_PATH, "1"));
+    TEST_CHECK(pStore->SetContent(LEDBORDER_BRIGHTNESS_FILE_PATH, "77"));
+
+    pConfig = ConfigStore::GetInstance();
+    TEST_CHECK(pConfig->GetString(CONFIG_KEY_OWNER, value));
+    TEST_CHECK(value == "Alice");
+    TEST_CHECK(pConfig->GetString(CONFIG_KEY_BT_TOKEN, value));
+    TEST_CHECK(value == "0123456789ABCDEF");
+    TEST_CHECK(pConfig->GetString(CONFIG_KEY_CONTACT, value));
+    TEST_CHECK(value.empty());
+    TEST_CHECK(pConfig->GetInteger(CONFIG_KEY_LED_ENABLED) == 1);
+    TEST_CHECK(pConfig->GetInteger(CONFIG_KEY_LED_BRIGHTNESS) == 77);
+
+    /* The imported settings are written to the journal */
+    TEST_CHECK(ReplayJournal(state));
+    TEST_CHECK(state.pValues[CONFIG_KEY_OWNER] == "Alice");
+    TEST_CHECK(state.pValues[CONFIG_KEY_LED_BRIGHTNESS] == IntValue(77));
+    TEST_CHECK(!state.pIsSet[CONFIG_KEY_CONTACT]);
+}
+
+int main(int argc, char** argv)
+{
+    INIT_LOGGER(ECB_LOG_LEVEL_ERROR);
+
+    if(argc < 2)
+    {
+        printf("Usage: %s <scenario>\n", argv[0]);
+        return 1;
+    }
+
+    if(strcmp(argv[1], "replay") == 0)
+    {
+        TEST_RUN(TestReplay);
+    }
+    else if(strcmp(argv[1], "torn") == 0)
+    {
+        TEST_RUN(TestTornRecord);
+    }
+    else if(strcmp(argv[1], "compaction") == 0)
+    {
+        TEST_RUN(TestCompaction);
+    }
+    else if(strcmp(argv[1], "interrupted") == 0)
+    {
+        TEST_RUN(TestInterruptedCompaction);
+    }
+    else if(strcmp(argv[1], "legacy") == 0)
+    {
+        TEST_RUN(TestLegacyImport);
+    }
+    else
+    {
+        printf("Unknown scenario %s\n", argv[1]);
+        return 1;
+    }
+
+    return TEST_RESULT();
+}
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+/* None */
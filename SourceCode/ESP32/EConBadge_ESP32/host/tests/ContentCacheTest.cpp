@@ -0,0 +1,275 @@
+/*******************************************************************************
+ * @file ContentCacheTest.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file tests the content cache.
+ *
+ * @details This file tests the content cache. The contents spanning several
+ * blocks, the least recently used eviction, the pinned entries, the rejected
+ * keys and contents and the statistics are checked, then the configuration
+ * store is checked to keep the bluetooth token pinned in its cache.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <string>         /* std::string */
+#include <Types.h>        /* Defined types */
+#include <Logger.h>       /* Logger service */
+#include <HostTest.h>     /* Test checks */
+#include <ConfigStore.h>  /* Configuration store */
+#include <ContentCache.h> /* Content cache */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Byte budget of the cache. */
+#define CACHE_BUDGET (CONTENT_CACHE_BLOCK_COUNT * CONTENT_CACHE_BLOCK_SIZE)
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/** @brief Builds a content of a given size. */
+static std::string MakeContent(const size_t kSize, const char kFirst)
+{
+    std::string content;
+    size_t      i;
+
+    for(i = 0; i < kSize; ++i)
+    {
+        content.push_back(kFirst + i % 26);
+    }
+
+    return content;
+}
+
+/** @brief Checks the contents are returned as set, across several blocks. */
+static void TestGetSet(void)
+{
+    ContentCache       cache;
+    SContentCacheStats stats;
+    std::string        content;
+
+    TEST_CHECK(!cache.Get("owner", content));
+
+    TEST_CHECK(cache.Set("owner", "Alexy"));
+    TEST_CHECK(cache.Get("owner", content));
+    TEST_CHECK(content == "Alexy");
+
+    /* A content spanning several blocks, then a shorter replacement */
+    TEST_CHECK(cache.Set("contact", MakeContent(100, 'a')));
+    TEST_CHECK(cache.Get("contact", content));
+    TEST_CHECK(content == MakeContent(100, 'a'));
+
+    TEST_CHECK(cache.Set("contact", MakeContent(10, 'A')));
+    TEST_CHECK(cache.Get("contact", content));
+    TEST_CHECK(content == MakeContent(10, 'A'));
+
+    /* An empty content is a hit */
+    TEST_CHECK(cache.Set("image", ""));
+    TEST_CHECK(cache.Get("image", content));
+    TEST_CHECK(content.empty());
+
+    cache.GetStats(stats);
+    TEST_CHECK(stats.hits == 4);
+    TEST_CHECK(stats.misses == 1);
+    TEST_CHECK(stats.entries == 3);
+    TEST_CHECK(stats.usedBytes == 15);
+    TEST_CHECK(stats.budget == CACHE_BUDGET);
+    TEST_CHECK(stats.evictions == 0);
+}
+
+/** @brief Checks the least recently used entry is evicted first. */
+static void TestEviction(void)
+{
+    ContentCache       cache;
+    SContentCacheStats stats;
+    std::string        content;
+    uint8_t            i;
+
+    for(i = 0; i < CONTENT_CACHE_ENTRY_COUNT; ++i)
+    {
+        TEST_CHECK(cache.Set("key" + std::to_string(i), "value"));
+    }
+
+    /* The first key becomes the most recent, the second is evicted */
+    TEST_CHECK(cache.Get("key0", content));
+    TEST_CHECK(cache.Set("new", "value"));
+    TEST_CHECK(cache.Get("key0", content));
+    TEST_CHECK(!cache.Get("key1", content));
+    TEST_CHECK(cache.Get("key2", content));
+
+    /* A content of the whole budget evicts every entry */
+    TEST_CHECK(cache.Set("big", MakeContent(CACHE_BUDGET, 'a')));
+    TEST_CHECK(cache.Get("big", content));
+    TEST_CHECK(content.size() == CACHE_BUDGET);
+    TEST_CHECK(!cache.Get("key0", content));
+    TEST_CHECK(!cache.Get("new", content));
+
+    cache.GetStats(stats);
+    TEST_CHECK(stats.entries == 1);
+    TEST_CHECK(stats.usedBytes == CACHE_BUDGET);
+    TEST_CHECK(stats.evictions == CONTENT_CACHE_ENTRY_COUNT + 1);
+}
+
+/** @brief Checks the pinned entries survive the evictions. */
+static void TestPinning(void)
+{
+    ContentCache       cache;
+    SContentCacheStats stats;
+    std::string        content;
+    uint8_t            i;
+
+    TEST_CHECK(!cache.SetPinned("token", true));
+    TEST_CHECK(cache.Set("token", "0000000000000000"));
+    TEST_CHECK(cache.SetPinned("token", true));
+
+    /* The pinned entry is the least recent, the others are evicted */
+    for(i = 0; i < 2 * CONTENT_CACHE_ENTRY_COUNT; ++i)
+    {
+        TEST_CHECK(cache.Set("key" + std::to_string(i), MakeContent(64, 'a')));
+    }
+    TEST_CHECK(cache.Get("token", content));
+    TEST_CHECK(content == "0000000000000000");
+
+    /* A new content keeps the pin */
+    TEST_CHECK(cache.Set("token", "1111111111111111"));
+    cache.GetStats(stats);
+    TEST_CHECK(stats.pinned == 1);
+
+    /* The budget left by the pinned entry is too small */
+    TEST_CHECK(!cache.Set("big", MakeContent(CACHE_BUDGET, 'a')));
+    TEST_CHECK(cache.Get("token", content));
+    TEST_CHECK(content == "1111111111111111");
+
+    TEST_CHECK(cache.SetPinned("token", false));
+    TEST_CHECK(cache.Set("big", MakeContent(CACHE_BUDGET, 'a')));
+    TEST_CHECK(!cache.Get("token", content));
+
+    cache.GetStats(stats);
+    TEST_CHECK(stats.pinned == 0);
+    TEST_CHECK(stats.rejects == 1);
+}
+
+/** @brief Checks the rejected keys and contents, the removal and clear. */
+static void TestRejectRemove(void)
+{
+    ContentCache       cache;
+    SContentCacheStats stats;
+    std::string        content;
+
+    /* A rejected content does not leave the previous one */
+    TEST_CHECK(cache.Set("owner", "Alexy"));
+    TEST_CHECK(!cache.Set("owner", MakeContent(CACHE_BUDGET + 1, 'a')));
+    TEST_CHECK(!cache.Get("owner", content));
+
+    TEST_CHECK(!cache.Set(std::string(CONTENT_CACHE_KEY_SIZE, 'k'), "value"));
+    TEST_CHECK(cache.Set(std::string(CONTENT_CACHE_KEY_SIZE - 1, 'k'), "v"));
+
+    cache.GetStats(stats);
+    TEST_CHECK(stats.rejects == 2);
+    TEST_CHECK(stats.entries == 1);
+
+    TEST_CHECK(cache.Set("owner", "Alexy"));
+    TEST_CHECK(cache.Set("contact", "mail"));
+    TEST_CHECK(cache.SetPinned("contact", true));
+    cache.Remove("owner");
+    cache.Remove("unknown");
+    TEST_CHECK(!cache.Get("owner", content));
+    TEST_CHECK(cache.Get("contact", content));
+
+    /* Clear also drops the pinned entries and frees the whole budget */
+    cache.Clear();
+    TEST_CHECK(!cache.Get("contact", content));
+    cache.GetStats(stats);
+    TEST_CHECK(stats.entries == 0);
+    TEST_CHECK(stats.pinned == 0);
+    TEST_CHECK(stats.usedBytes == 0);
+    TEST_CHECK(cache.Set("big", MakeContent(CACHE_BUDGET, 'a')));
+}
+
+/** @brief Checks the configuration store pins the bluetooth token. */
+static void TestConfigStore(void)
+{
+    ConfigStore*       pConfig;
+    SContentCacheStats stats;
+    SContentCacheStats after;
+    std::string        value;
+
+    pConfig = ConfigStore::GetInstance();
+    TEST_CHECK(pConfig->SetString(CONFIG_KEY_BT_TOKEN, "0123456789ABCDEF"));
+    TEST_CHECK(pConfig->SetString(CONFIG_KEY_OWNER, "Alexy"));
+
+    pConfig->GetCacheStats(stats);
+    TEST_CHECK(stats.pinned == 1);
+
+    /* The settings are read from the cache, unset ones are not looked up */
+    TEST_CHECK(pConfig->GetString(CONFIG_KEY_BT_TOKEN, value));
+    TEST_CHECK(value == "0123456789ABCDEF");
+    TEST_CHECK(pConfig->GetString(CONFIG_KEY_OWNER, value));
+    TEST_CHECK(value == "Alexy");
+    TEST_CHECK(pConfig->GetInteger(CONFIG_KEY_LED_ENABLED) == 0);
+
+    pConfig->GetCacheStats(after);
+    TEST_CHECK(after.hits == stats.hits + 2);
+    TEST_CHECK(after.misses == stats.misses);
+}
+
+int main(void)
+{
+    INIT_LOGGER(ECB_LOG_LEVEL_ERROR);
+
+    TEST_RUN(TestGetSet);
+    TEST_RUN(TestEviction);
+    TEST_RUN(TestPinning);
+    TEST_RUN(TestRejectRemove);
+    TEST_RUN(TestConfigStore);
+
+    return TEST_RESULT();
+}
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+/* None */
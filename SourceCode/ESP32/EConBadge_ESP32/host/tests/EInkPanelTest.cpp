@@ -0,0 +1,226 @@
+/*******************************************************************************
+ * @file EInkPanelTest.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file tests the EInk display manager on the simulated panel.
+ *
+ * @details This file tests the EInk display manager on the simulated panel.
+ * The images produced by the image converter are stored on the host SD card,
+ * displayed raw and compressed, and the image shown by the simulated panel
+ * is compared with the raw image. The first displayed image is written as a
+ * PPM image.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <string>             /* std::string */
+#include <vector>             /* std::vector */
+#include <cstdio>             /* fopen */
+#include <Types.h>            /* Defined types */
+#include <Logger.h>           /* Logger service */
+#include <Storage.h>          /* Storage service */
+#include <HostTest.h>         /* Test checks */
+#include <BlueToothMgr.h>     /* Bluetooth manager */
+#include <EInkPanelSim.h>     /* Simulated panel */
+#include <WaveshareEInkMgr.h> /* EInk display manager */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Path of the PPM image written by the test. */
+#define PPM_PATH "EInkPanelTest.ppm"
+
+/** @brief Size of the PPM image written by the test. */
+#define PPM_SIZE (15 + EINK_SIM_WIDTH * EINK_SIM_HEIGHT * 3)
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/** @brief Byte buffer. */
+typedef std::vector<uint8_t> TBuffer;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+
+/** @brief Panel timings, shortened to keep the test fast. */
+static const SEInkPanelTimings sksTimings = {
+    1000, /* Reset */
+    2000, /* Power on / off */
+    5000  /* Refresh */
+};
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/** @brief Reads a file. */
+static bool ReadFile(const std::string& rkPath, TBuffer& rContent)
+{
+    FILE*  pFile;
+    size_t read;
+
+    pFile = fopen(rkPath.c_str(), "rb");
+    if(pFile == nullptr)
+    {
+        return false;
+    }
+    rContent.resize(2 * EINK_SIM_FRAME_SIZE);
+    read = fread(rContent.data(), 1, rContent.size(), pFile);
+    rContent.resize(read);
+    fclose(pFile);
+
+    return true;
+}
+
+/** @brief Stores a file in the images directory of the host SD card. */
+static bool StoreImage(const std::string& rkName, const TBuffer& rkContent)
+{
+    FsFile file;
+    bool   status;
+
+    Storage::GetInstance()->CreateDirectory("/images");
+    file = Storage::GetInstance()->Open("/images/" + rkName, FILE_WRITE);
+    if(!file)
+    {
+        return false;
+    }
+    status = file.write(rkContent.data(), rkContent.size()) ==
+             rkContent.size();
+    file.close();
+
+    return status;
+}
+
+/** @brief Displays an image and checks the panel shows the expected frame. */
+static void CheckDisplay(EInkDisplayManager& rManager,
+                         EInkPanelSim&       rPanel,
+                         const std::string&  rkName,
+                         const TBuffer&      rkExpected)
+{
+    SCommandResponse response;
+
+    memset(&response, 0, sizeof(SCommandResponse));
+    rManager.SetDisplayedImage(rkName, response);
+    TEST_CHECK(response.header.errorCode == NO_ERROR);
+    TEST_CHECK(rPanel.GetDisplayed() == rkExpected);
+}
+
+int main(int argc, char** argv)
+{
+    EInkPanelSim*        pPanel;
+    EInkDisplayManager*  pManager;
+    BluetoothManager*    pBtMgr;
+    SCommandResponse     response;
+    SEInkPanelStats      stats;
+    std::vector<TBuffer> raws;
+    TBuffer              raw;
+    TBuffer              stream;
+    std::string          path;
+    FILE*                pFile;
+    long                 ppmSize;
+    int                  i;
+
+    INIT_LOGGER(ECB_LOG_LEVEL_ERROR);
+
+    pPanel = new EInkPanelSim(sksTimings);
+
+    /* Store the images before the catalog is built */
+    for(i = 2; i < argc; ++i)
+    {
+        path = std::string(argv[1]) + "/" + argv[i];
+        TEST_CHECK(ReadFile(path + ".raw", raw));
+        TEST_CHECK(ReadFile(path + ".rle", stream));
+        TEST_CHECK(StoreImage(std::string(argv[i]) + ".raw", raw));
+        TEST_CHECK(StoreImage(std::string(argv[i]) + ".rle", stream));
+        raws.push_back(raw);
+    }
+
+    /* No transport, the responses are not sent */
+    pBtMgr   = new BluetoothManager();
+    pManager = new EInkDisplayManager(pBtMgr);
+    pManager->Init();
+
+    printf("[ RUN  ] SetDisplayedImage\n");
+    for(i = 2; i < argc; ++i)
+    {
+        CheckDisplay(*pManager, *pPanel,
+                     std::string(argv[i]) + ".raw", raws[i - 2]);
+        if(i == 2)
+        {
+            TEST_CHECK(pPanel->WritePpm(PPM_PATH));
+        }
+        CheckDisplay(*pManager, *pPanel,
+                     std::string(argv[i]) + ".rle", raws[i - 2]);
+    }
+
+    printf("[ RUN  ] Clear\n");
+    memset(&response, 0, sizeof(SCommandResponse));
+    pManager->Clear(response);
+    TEST_CHECK(response.header.errorCode == NO_ERROR);
+    TEST_CHECK(pPanel->GetDisplayed() ==
+               TBuffer(EINK_SIM_FRAME_SIZE,
+                       (EPD_5IN65F_WHITE << 4) | EPD_5IN65F_WHITE));
+
+    printf("[ RUN  ] Missing image\n");
+    memset(&response, 0, sizeof(SCommandResponse));
+    pManager->SetDisplayedImage("missing", response);
+    TEST_CHECK(response.header.errorCode == FILE_NOT_FOUND);
+
+    pPanel->GetStats(stats);
+    TEST_CHECK(stats.errors == 0);
+    TEST_CHECK(stats.refreshes == (uint32_t)(2 * (argc - 2) + 1));
+
+    if(argc > 2)
+    {
+        pFile = fopen(PPM_PATH, "rb");
+        TEST_CHECK(pFile != nullptr);
+        if(pFile != nullptr)
+        {
+            fseek(pFile, 0, SEEK_END);
+            ppmSize = ftell(pFile);
+            fclose(pFile);
+            TEST_CHECK(ppmSize == PPM_SIZE);
+        }
+    }
+
+    delete pPanel;
+
+    return TEST_RESULT();
+}
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+/* None */
@@ -0,0 +1,130 @@
+/*******************************************************************************
+ * @file HostTest.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file defines the checks used by the host tests.
+ *
+ * @details This file defines the checks used by the host tests. A failed
+ * check is reported with its location and the test continues, the test
+ * returns the number of failed checks.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __HOST_HOST_TEST_H_
+#define __HOST_HOST_TEST_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdio> /* printf */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/**
+ * @brief Checks a condition.
+ *
+ * @param[in] COND The condition to check.
+ */
+#define TEST_CHECK(COND) {                                              \
+    if(!(COND))                                                         \
+    {                                                                   \
+        printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #COND); \
+        ++HostTest::FAILED_;                                            \
+    }                                                                   \
+}
+
+/**
+ * @brief Runs a test case.
+ *
+ * @param[in] TEST The test function.
+ */
+#define TEST_RUN(TEST) {                                                \
+    printf("[ RUN  ] %s\n", #TEST);                                     \
+    TEST();                                                             \
+}
+
+/**
+ * @brief Reports the result and returns the test exit code.
+ */
+#define TEST_RESULT() (HostTest::Report())
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/** @brief Host test results. */
+class HostTest
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        /**
+         * @brief Prints the result of the test.
+         *
+         * @return The number of failed checks is returned.
+         */
+        static int Report(void)
+        {
+            if(FAILED_ == 0)
+            {
+                printf("[ PASS ]\n");
+            }
+            else
+            {
+                printf("[ FAIL ] %d failed checks\n", FAILED_);
+            }
+            return FAILED_;
+        }
+
+        /** @brief Number of failed checks. */
+        static int FAILED_;
+};
+
+/** @brief See HostTest */
+int HostTest::FAILED_ = 0;
+
+#endif /* #ifndef __HOST_HOST_TEST_H_ */
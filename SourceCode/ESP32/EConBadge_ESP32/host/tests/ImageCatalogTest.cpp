@@ -0,0 +1,467 @@
+/*******************************************************************************
+ * @file ImageCatalogTest.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file tests the image catalog.
+ *
+ * @details This file tests the image catalog on the host SD card. The catalog
+ * is created once per process, so each boot scenario runs in its own process
+ * on an empty host SD card: the images and the catalog left by the previous
+ * boot are written before the catalog is created. The catalog is checked to be
+ * rebuilt when missing, torn or marked dirty, to be trusted otherwise, to keep
+ * its entries on a failed save and to reject the stale page cursors.
+ *
+ * Usage: ImageCatalogTest <cursor|missing|torn|dirty|clean|update>
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <string>         /* std::string */
+#include <vector>         /* std::vector */
+#include <cstdio>         /* printf */
+#include <cstddef>        /* offsetof */
+#include <cstring>        /* memset, strcmp, strncpy */
+#include <SdFat.h>        /* Host SD card */
+#include <Types.h>        /* Defined types */
+#include <Logger.h>       /* Logger service */
+#include <Storage.h>      /* Storage service */
+#include <HostTest.h>     /* Test checks */
+#include <esp_rom_crc.h>  /* CRC32 */
+#include <ImageCatalog.h> /* Image catalog */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Number of images stored before the catalog is built. */
+#define TEST_IMAGE_COUNT 5
+/** @brief Temporary catalog of the saves, see ImageCatalog.cpp. */
+#define TEST_CATALOG_TMP_FILE_PATH IMAGE_CATALOG_FILE_PATH ".tmp"
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/** @brief Catalog entries. */
+typedef std::vector<SImageCatalogEntry> TEntries;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/** @brief Stores an image in the images directory of the host SD card. */
+static bool StoreImage(const std::string& rkName, const size_t kSize)
+{
+    FsFile               file;
+    std::vector<uint8_t> content(kSize, 0xA5);
+    bool                 status;
+
+    Storage::GetInstance()->Remove(IMAGE_DIR_PATH "/" + rkName);
+    file = Storage::GetInstance()->Open(IMAGE_DIR_PATH "/" + rkName,
+                                        FILE_WRITE);
+    if(!file)
+    {
+        return false;
+    }
+    status = file.write(content.data(), content.size()) == content.size();
+    file.close();
+
+    return status;
+}
+
+/** @brief Stores the images image_0.bin to image_<count - 1>.bin. */
+static void StoreImages(const size_t kCount)
+{
+    size_t i;
+
+    Storage::GetInstance()->CreateDirectory(IMAGE_DIR_PATH);
+    for(i = 0; i < kCount; ++i)
+    {
+        TEST_CHECK(StoreImage("image_" + std::to_string(i) + ".bin", 64 + i));
+    }
+}
+
+/** @brief Builds a sealed catalog entry. */
+static SImageCatalogEntry MakeEntry(const char*    pkName,
+                                    const uint32_t kSize,
+                                    const uint32_t kDisplayCount)
+{
+    SImageCatalogEntry entry;
+
+    memset(&entry, 0, sizeof(SImageCatalogEntry));
+    strncpy(entry.pName, pkName, IMAGE_CATALOG_NAME_SIZE - 1);
+    entry.size         = kSize;
+    entry.displayCount = kDisplayCount;
+    entry.encoding     = IMAGE_ENCODING_RAW;
+    entry.crc          = esp_rom_crc32_le(0,
+                                          (const uint8_t*)&entry,
+                                          offsetof(SImageCatalogEntry, crc));
+
+    return entry;
+}
+
+/** @brief Writes a catalog, the last kTornSize bytes are not written. */
+static bool WriteCatalog(const TEntries& rkEntries,
+                         const uint16_t  kFlags,
+                         const size_t    kTornSize)
+{
+    FsFile               file;
+    SImageCatalogHeader  header;
+    std::vector<uint8_t> content;
+    bool                 status;
+
+    header.magic   = IMAGE_CATALOG_MAGIC;
+    header.version = IMAGE_CATALOG_VERSION;
+    header.flags   = kFlags;
+    header.count   = rkEntries.size();
+    header.crc     = esp_rom_crc32_le(0,
+                                      (const uint8_t*)&header,
+                                      offsetof(SImageCatalogHeader, crc));
+
+    content.insert(content.end(),
+                   (const uint8_t*)&header,
+                   (const uint8_t*)&header + sizeof(header));
+    content.insert(content.end(),
+                   (const uint8_t*)rkEntries.data(),
+                   (const uint8_t*)(rkEntries.data() + rkEntries.size()));
+    content.resize(content.size() - kTornSize);
+
+    file = Storage::GetInstance()->Open(IMAGE_CATALOG_FILE_PATH, FILE_WRITE);
+    if(!file)
+    {
+        return false;
+    }
+    status = file.write(content.data(), content.size()) == content.size();
+    file.close();
+
+    return status;
+}
+
+/** @brief Reads the header of the catalog file. */
+static bool ReadCatalogHeader(SImageCatalogHeader& rHeader)
+{
+    FsFile file;
+    bool   status;
+
+    file = Storage::GetInstance()->Open(IMAGE_CATALOG_FILE_PATH, FILE_READ);
+    if(!file)
+    {
+        return false;
+    }
+    status = file.read(&rHeader, sizeof(rHeader)) == (int)sizeof(rHeader);
+    file.close();
+
+    return status;
+}
+
+/** @brief Checks the catalog file is saved, clean and of a given size. */
+static void CheckSaved(const size_t kCount, const bool kIsDirty)
+{
+    SImageCatalogHeader header;
+
+    TEST_CHECK(ReadCatalogHeader(header));
+    TEST_CHECK(header.count == kCount);
+    TEST_CHECK(((header.flags & IMAGE_CATALOG_HEADER_FLAG_DIRTY) != 0) ==
+               kIsDirty);
+}
+
+/** @brief Gets an entry by name, its size is 0 when not cataloged. */
+static SImageCatalogEntry GetByName(const std::string& rkName)
+{
+    SImageCatalogEntry entry;
+    ssize_t            index;
+
+    memset(&entry, 0, sizeof(SImageCatalogEntry));
+    index = ImageCatalog::GetInstance()->Find(rkName);
+    if(index >= 0)
+    {
+        TEST_CHECK(ImageCatalog::GetInstance()->GetEntry(index, entry));
+    }
+
+    return entry;
+}
+
+/** @brief Checks the page cursors are stable and rejected once stale. */
+static void TestPageCursor(void)
+{
+    ImageCatalog* pCatalog;
+    TEntries      entries;
+    uint32_t      cursor;
+    uint32_t      staleCursor;
+
+    pCatalog = ImageCatalog::GetInstance();
+    TEST_CHECK(pCatalog->GetCount() == TEST_IMAGE_COUNT);
+
+    /* Walk the catalog two entries at a time */
+    TEST_CHECK(pCatalog->GetPage(0, 2, entries, cursor));
+    TEST_CHECK(entries.size() == 2);
+    TEST_CHECK(strcmp(entries[0].pName, "image_0.bin") == 0);
+    TEST_CHECK(cursor != FILES_CURSOR_END);
+
+    TEST_CHECK(pCatalog->GetPage(cursor, 2, entries, cursor));
+    TEST_CHECK(entries.size() == 2);
+    TEST_CHECK(strcmp(entries[0].pName, "image_2.bin") == 0);
+
+    TEST_CHECK(pCatalog->GetPage(cursor, 2, entries, staleCursor));
+    TEST_CHECK(entries.size() == 1);
+    TEST_CHECK(staleCursor == FILES_CURSOR_END);
+
+    /* A cursor past the catalog is rejected */
+    TEST_CHECK(!pCatalog->GetPage(cursor + 2, 2, entries, staleCursor));
+
+    /* An image added before the cursor shifts the positions */
+    TEST_CHECK(StoreImage("image_1a.bin", 64));
+    TEST_CHECK(pCatalog->Add("image_1a.bin", 0, IMAGE_ENCODING_RAW));
+    TEST_CHECK(!pCatalog->GetPage(cursor, 2, entries, staleCursor));
+    TEST_CHECK(entries.empty());
+
+    /* The listing restarts from the first page */
+    TEST_CHECK(pCatalog->GetPage(0, 2, entries, cursor));
+    TEST_CHECK(pCatalog->GetPage(cursor, 2, entries, cursor));
+    TEST_CHECK(strcmp(entries[0].pName, "image_1a.bin") == 0);
+
+    /* A removal also invalidates the cursors */
+    TEST_CHECK(Storage::GetInstance()->Remove(IMAGE_DIR_PATH
+                                              "/image_1a.bin"));
+    TEST_CHECK(pCatalog->Remove("image_1a.bin"));
+    TEST_CHECK(!pCatalog->GetPage(cursor, 2, entries, staleCursor));
+
+    /* A display count update does not move the positions */
+    TEST_CHECK(pCatalog->GetPage(0, 2, entries, cursor));
+    TEST_CHECK(pCatalog->RecordDisplay("image_0.bin", 0x1234));
+    TEST_CHECK(pCatalog->GetPage(cursor, 2, entries, cursor));
+    TEST_CHECK(strcmp(entries[0].pName, "image_2.bin") == 0);
+}
+
+/** @brief Checks a missing catalog is built from the image directory. */
+static void TestMissingCatalog(void)
+{
+    ImageCatalog*      pCatalog;
+    SImageCatalogEntry entry;
+
+    StoreImages(3);
+
+    pCatalog = ImageCatalog::GetInstance();
+    TEST_CHECK(pCatalog->GetCount() == 3);
+    TEST_CHECK(pCatalog->GetEntry(2, entry));
+    TEST_CHECK(strcmp(entry.pName, "image_2.bin") == 0);
+    TEST_CHECK(entry.size == 66);
+    TEST_CHECK(entry.encoding == IMAGE_ENCODING_RAW);
+    TEST_CHECK((entry.flags & IMAGE_CATALOG_FLAG_HASHED) == 0);
+
+    CheckSaved(3, false);
+    TEST_CHECK(!Storage::GetInstance()->FileExists(
+        TEST_CATALOG_TMP_FILE_PATH
+    ));
+}
+
+/** @brief Checks a torn catalog is rebuilt and keeps its complete entries. */
+static void TestTornEntry(void)
+{
+    ImageCatalog* pCatalog;
+    TEntries      entries;
+
+    StoreImages(3);
+    entries.push_back(MakeEntry("image_0.bin", 64, 7));
+    entries.push_back(MakeEntry("image_1.bin", 65, 3));
+    entries.push_back(MakeEntry("image_2.bin", 66, 5));
+    TEST_CHECK(WriteCatalog(entries, 0, 5));
+
+    /* The torn entry is read again from its image */
+    pCatalog = ImageCatalog::GetInstance();
+    TEST_CHECK(pCatalog->GetCount() == 3);
+    TEST_CHECK(GetByName("image_0.bin").displayCount == 7);
+    TEST_CHECK(GetByName("image_1.bin").displayCount == 3);
+    TEST_CHECK(GetByName("image_2.bin").size == 66);
+    TEST_CHECK(GetByName("image_2.bin").displayCount == 0);
+
+    CheckSaved(3, false);
+}
+
+/** @brief Checks a catalog marked dirty is rebuilt. */
+static void TestDirtyCatalog(void)
+{
+    ImageCatalog* pCatalog;
+    TEntries      entries;
+
+    /* The power was lost after image_2 was stored, before the catalog save */
+    StoreImages(3);
+    entries.push_back(MakeEntry("image_0.bin", 64, 7));
+    entries.push_back(MakeEntry("image_1.bin", 65, 3));
+    TEST_CHECK(WriteCatalog(entries, IMAGE_CATALOG_HEADER_FLAG_DIRTY, 0));
+
+    pCatalog = ImageCatalog::GetInstance();
+    TEST_CHECK(pCatalog->GetCount() == 3);
+    TEST_CHECK(GetByName("image_0.bin").displayCount == 7);
+    TEST_CHECK(GetByName("image_2.bin").size == 66);
+
+    CheckSaved(3, false);
+}
+
+/** @brief Checks a clean catalog is loaded without scanning the images. */
+static void TestCleanCatalog(void)
+{
+    ImageCatalog* pCatalog;
+    TEntries      entries;
+
+    /* An image missing from a clean catalog is not looked for */
+    StoreImages(3);
+    entries.push_back(MakeEntry("image_0.bin", 64, 7));
+    entries.push_back(MakeEntry("image_1.bin", 65, 3));
+    TEST_CHECK(WriteCatalog(entries, 0, 0));
+
+    pCatalog = ImageCatalog::GetInstance();
+    TEST_CHECK(pCatalog->GetCount() == 2);
+    TEST_CHECK(pCatalog->Find("image_2.bin") < 0);
+    TEST_CHECK(GetByName("image_1.bin").displayCount == 3);
+}
+
+/** @brief Checks the updates are saved and the failed saves rolled back. */
+static void TestUpdates(void)
+{
+    ImageCatalog* pCatalog;
+    SdFs          sdCard;
+
+    StoreImages(3);
+    pCatalog = ImageCatalog::GetInstance();
+    TEST_CHECK(pCatalog->GetCount() == 3);
+
+    /* Add, the mark is cleared by the save */
+    TEST_CHECK(pCatalog->MarkDirty());
+    CheckSaved(3, true);
+    TEST_CHECK(StoreImage("image_3.bin", 128));
+    TEST_CHECK(pCatalog->Add("image_3.bin", 0x1234, IMAGE_ENCODING_RAW));
+    TEST_CHECK(pCatalog->GetCount() == 4);
+    TEST_CHECK(GetByName("image_3.bin").size == 128);
+    TEST_CHECK(GetByName("image_3.bin").hash == 0x1234);
+    CheckSaved(4, false);
+
+    /* Replace */
+    TEST_CHECK(pCatalog->RecordDisplay("image_1.bin", 0x5678));
+    TEST_CHECK(StoreImage("image_1.bin", 256));
+    TEST_CHECK(pCatalog->Add("image_1.bin", 0x9ABC, IMAGE_ENCODING_RAW));
+    TEST_CHECK(pCatalog->GetCount() == 4);
+    TEST_CHECK(GetByName("image_1.bin").size == 256);
+    TEST_CHECK(GetByName("image_1.bin").hash == 0x9ABC);
+    TEST_CHECK(GetByName("image_1.bin").displayCount == 0);
+    CheckSaved(4, false);
+
+    /* Remove */
+    TEST_CHECK(Storage::GetInstance()->Remove(IMAGE_DIR_PATH "/image_0.bin"));
+    TEST_CHECK(pCatalog->Remove("image_0.bin"));
+    TEST_CHECK(!pCatalog->Remove("image_0.bin"));
+    TEST_CHECK(pCatalog->GetCount() == 3);
+    TEST_CHECK(pCatalog->Find("image_0.bin") < 0);
+    CheckSaved(3, false);
+
+    /* A directory in place of the temporary catalog fails the saves */
+    TEST_CHECK(pCatalog->MarkDirty());
+    TEST_CHECK(Storage::GetInstance()->CreateDirectory(
+        TEST_CATALOG_TMP_FILE_PATH
+    ));
+
+    /* The failed add and replace are rolled back */
+    TEST_CHECK(StoreImage("image_4.bin", 32));
+    TEST_CHECK(!pCatalog->Add("image_4.bin", 0, IMAGE_ENCODING_RAW));
+    TEST_CHECK(pCatalog->Find("image_4.bin") < 0);
+    TEST_CHECK(StoreImage("image_3.bin", 512));
+    TEST_CHECK(!pCatalog->Add("image_3.bin", 0, IMAGE_ENCODING_RAW));
+    TEST_CHECK(GetByName("image_3.bin").size == 128);
+    TEST_CHECK(GetByName("image_3.bin").hash == 0x1234);
+    TEST_CHECK(pCatalog->GetCount() == 3);
+
+    /* The removed image file is gone, its entry is not kept */
+    TEST_CHECK(!pCatalog->Remove("image_2.bin"));
+    TEST_CHECK(pCatalog->Find("image_2.bin") < 0);
+
+    /* The catalog file is left dirty, it is rebuilt at the next boot */
+    CheckSaved(3, true);
+
+    TEST_CHECK(sdCard.rmdir(TEST_CATALOG_TMP_FILE_PATH));
+    TEST_CHECK(pCatalog->Add("image_4.bin", 0, IMAGE_ENCODING_RAW));
+    CheckSaved(3, false);
+}
+
+int main(int argc, char** argv)
+{
+    INIT_LOGGER(ECB_LOG_LEVEL_ERROR);
+
+    if(argc < 2)
+    {
+        printf("Usage: %s <scenario>\n", argv[0]);
+        return 1;
+    }
+
+    if(strcmp(argv[1], "cursor") == 0)
+    {
+        /* No catalog yet, it is built from the directory */
+        StoreImages(TEST_IMAGE_COUNT);
+        TEST_RUN(TestPageCursor);
+    }
+    else if(strcmp(argv[1], "missing") == 0)
+    {
+        TEST_RUN(TestMissingCatalog);
+    }
+    else if(strcmp(argv[1], "torn") == 0)
+    {
+        TEST_RUN(TestTornEntry);
+    }
+    else if(strcmp(argv[1], "dirty") == 0)
+    {
+        TEST_RUN(TestDirtyCatalog);
+    }
+    else if(strcmp(argv[1], "clean") == 0)
+    {
+        TEST_RUN(TestCleanCatalog);
+    }
+    else if(strcmp(argv[1], "update") == 0)
+    {
+        TEST_RUN(TestUpdates);
+    }
+    else
+    {
+        printf("Unknown scenario %s\n", argv[1]);
+        return 1;
+    }
+
+    return TEST_RESULT();
+}
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+/* None */
@@ -0,0 +1,388 @@
+/*******************************************************************************
+ * @file ImageCodecTest.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file tests the compressed image codec.
+ *
+ * @details This file tests the compressed image codec. The images compressed
+ * by the image converter are decoded with random input and output chunk
+ * sizes and compared with the raw images produced by the converter. Edge
+ * cases are encoded with a reference encoder following the converter, the
+ * decoding throughput is reported.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <chrono>       /* std::chrono */
+#include <string>       /* std::string */
+#include <vector>       /* std::vector */
+#include <cstdio>       /* fopen */
+#include <cstdlib>      /* rand */
+#include <cstring>      /* memcpy */
+#include <Types.h>      /* Defined types */
+#include <HostTest.h>   /* Test checks */
+#include <ImageCodec.h> /* Compressed images codec */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Size of an EInk image in bytes. */
+#define IMAGE_SIZE 134400
+
+/** @brief Minimal repeat run used by the converter. */
+#define MIN_REPEAT 3
+
+/** @brief Number of decodes used to measure the throughput. */
+#define THROUGHPUT_ROUNDS 50
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/** @brief Byte buffer. */
+typedef std::vector<uint8_t> TBuffer;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+
+/** @brief Compressed image magic. */
+static const uint8_t skpMagic[IMAGE_CODEC_MAGIC_SIZE] = {
+    0xEC, 0xB1, 'R', 'L'
+};
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/** @brief Flushes the pending literal bytes in literal tokens. */
+static void FlushLiteral(TBuffer& rOutput, TBuffer& rLiteral)
+{
+    size_t size;
+
+    while(rLiteral.size() > 0)
+    {
+        size = MIN(rLiteral.size(), (size_t)IMAGE_CODEC_MAX_LITERAL);
+        rOutput.push_back(size - 1);
+        rOutput.insert(rOutput.end(),
+                       rLiteral.begin(),
+                       rLiteral.begin() + size);
+        rLiteral.erase(rLiteral.begin(), rLiteral.begin() + size);
+    }
+}
+
+/** @brief Reference encoder, follows CompressImage in ImageConverter.py. */
+static TBuffer Encode(const TBuffer& rkRaw)
+{
+    SImageCodecHeader header;
+    TBuffer           output(sizeof(SImageCodecHeader));
+    TBuffer           literal;
+    size_t            i;
+    size_t            run;
+
+    i = 0;
+    while(i < rkRaw.size())
+    {
+        run = 1;
+        while(i + run < rkRaw.size() &&
+              run < IMAGE_CODEC_MAX_REPEAT &&
+              rkRaw[i + run] == rkRaw[i])
+        {
+            ++run;
+        }
+
+        if(run >= MIN_REPEAT)
+        {
+            FlushLiteral(output, literal);
+            output.push_back(0x80 | ((run - 1) >> 8));
+            output.push_back((run - 1) & 0xFF);
+            output.push_back(rkRaw[i]);
+            i += run;
+        }
+        else
+        {
+            literal.push_back(rkRaw[i]);
+            ++i;
+        }
+    }
+    FlushLiteral(output, literal);
+
+    memcpy(header.pMagic, skpMagic, IMAGE_CODEC_MAGIC_SIZE);
+    header.rawSize  = rkRaw.size();
+    header.dataSize = output.size() - sizeof(SImageCodecHeader);
+    memcpy(output.data(), &header, sizeof(SImageCodecHeader));
+
+    return output;
+}
+
+/**
+ * @brief Decodes a compressed image with random chunk sizes.
+ *
+ * @param[in] rkStream The compressed image, with its header.
+ * @param[out] rRaw The decoded image.
+ * @param[in] kMaxChunk The maximal input and output chunk size.
+ *
+ * @return true is returned if the image was fully decoded, false otherwise.
+ */
+static bool Decode(const TBuffer& rkStream,
+                   TBuffer&       rRaw,
+                   const size_t   kMaxChunk)
+{
+    SImageCodecHeader header;
+    ImageDecoder      decoder;
+    TBuffer           output(kMaxChunk);
+    size_t            pos;
+    size_t            chunk;
+    size_t            consumed;
+    size_t            produced;
+
+    if(rkStream.size() < sizeof(SImageCodecHeader))
+    {
+        return false;
+    }
+    memcpy(&header, rkStream.data(), sizeof(SImageCodecHeader));
+    if(!ImageDecoder::IsValid(header, header.rawSize))
+    {
+        return false;
+    }
+
+    rRaw.clear();
+    decoder.Reset(header.rawSize);
+    pos = sizeof(SImageCodecHeader);
+    while(!decoder.IsDone() && !decoder.HasError())
+    {
+        chunk    = MIN(1 + (size_t)rand() % kMaxChunk,
+                       rkStream.size() - pos);
+        produced = decoder.Decode(rkStream.data() + pos,
+                                  chunk,
+                                  consumed,
+                                  output.data(),
+                                  1 + (size_t)rand() % kMaxChunk);
+        rRaw.insert(rRaw.end(), output.begin(), output.begin() + produced);
+        pos += consumed;
+
+        if(chunk == 0 && produced == 0)
+        {
+            break;
+        }
+    }
+
+    return decoder.IsDone() && pos == rkStream.size();
+}
+
+/** @brief Reads a file. */
+static bool ReadFile(const std::string& rkPath, TBuffer& rContent)
+{
+    FILE*  pFile;
+    size_t read;
+
+    pFile = fopen(rkPath.c_str(), "rb");
+    if(pFile == nullptr)
+    {
+        return false;
+    }
+    rContent.resize(2 * IMAGE_SIZE);
+    read = fread(rContent.data(), 1, rContent.size(), pFile);
+    rContent.resize(read);
+    fclose(pFile);
+
+    return true;
+}
+
+/** @brief Checks the round trip of a raw image with the reference encoder. */
+static void CheckRoundTrip(const TBuffer& rkRaw)
+{
+    TBuffer stream;
+    TBuffer decoded;
+
+    stream = Encode(rkRaw);
+    TEST_CHECK(stream.size() - sizeof(SImageCodecHeader) <=
+               IMAGE_CODEC_MAX_DATA_SIZE(rkRaw.size()));
+
+    TEST_CHECK(Decode(stream, decoded, 7));
+    TEST_CHECK(decoded == rkRaw);
+    TEST_CHECK(Decode(stream, decoded, 4096));
+    TEST_CHECK(decoded == rkRaw);
+}
+
+static void TestEdgeCases(void)
+{
+    TBuffer raw;
+    size_t  i;
+
+    /* Single value, split in maximal repeat runs */
+    CheckRoundTrip(TBuffer(IMAGE_SIZE, 0x11));
+
+    /* No repeat, split in maximal literals */
+    raw.resize(IMAGE_SIZE);
+    for(i = 0; i < raw.size(); ++i)
+    {
+        raw[i] = (uint8_t)(i * 131 + (i >> 8));
+    }
+    CheckRoundTrip(raw);
+
+    /* Runs around the literal and repeat limits */
+    raw.clear();
+    raw.insert(raw.end(), IMAGE_CODEC_MAX_REPEAT, 0x22);
+    raw.insert(raw.end(), IMAGE_CODEC_MAX_REPEAT + 1, 0x33);
+    raw.insert(raw.end(), 2, 0x44);
+    raw.insert(raw.end(), MIN_REPEAT, 0x55);
+    for(i = 0; i < IMAGE_CODEC_MAX_LITERAL + 1; ++i)
+    {
+        raw.push_back((uint8_t)i);
+    }
+    raw.resize(IMAGE_SIZE, 0x66);
+    CheckRoundTrip(raw);
+
+    /* Tiny image */
+    CheckRoundTrip(TBuffer(1, 0x77));
+}
+
+static void TestCorruptedStreams(void)
+{
+    SImageCodecHeader header;
+    ImageDecoder      decoder;
+    TBuffer           stream;
+    TBuffer           decoded;
+    uint8_t           pOutput[64];
+    uint8_t           pToken[3];
+    size_t            consumed;
+
+    stream = Encode(TBuffer(IMAGE_SIZE, 0x12));
+    memcpy(&header, stream.data(), sizeof(SImageCodecHeader));
+
+    /* Header checks */
+    TEST_CHECK(ImageDecoder::IsValid(header, IMAGE_SIZE));
+    TEST_CHECK(!ImageDecoder::IsValid(header, IMAGE_SIZE - 1));
+    header.pMagic[0] ^= 0xFF;
+    TEST_CHECK(!ImageDecoder::IsCompressed(header));
+    header.pMagic[0] ^= 0xFF;
+    header.dataSize = IMAGE_CODEC_MAX_DATA_SIZE(IMAGE_SIZE) + 1;
+    TEST_CHECK(!ImageDecoder::IsValid(header, IMAGE_SIZE));
+
+    /* Truncated stream */
+    stream.resize(stream.size() - 1);
+    TEST_CHECK(!Decode(stream, decoded, 64));
+
+    /* A run longer than the image is rejected */
+    pToken[0] = 0x80 | 0x7F;
+    pToken[1] = 0xFF;
+    pToken[2] = 0x00;
+    decoder.Reset(16);
+    decoder.Decode(pToken, sizeof(pToken), consumed, pOutput, 64);
+    TEST_CHECK(decoder.HasError());
+    TEST_CHECK(!decoder.IsDone());
+
+    pToken[0] = IMAGE_CODEC_MAX_LITERAL - 1;
+    decoder.Reset(16);
+    decoder.Decode(pToken, 1, consumed, pOutput, 64);
+    TEST_CHECK(decoder.HasError());
+}
+
+static void TestConvertedImages(const int kArgc, char** argv)
+{
+    std::string            path;
+    TBuffer                raw;
+    TBuffer                stream;
+    TBuffer                decoded;
+    SImageCodecHeader      header;
+    ImageDecoder           decoder;
+    size_t                 consumed;
+    int                    i;
+    int                    round;
+    uint64_t               elapsed;
+    std::chrono::steady_clock::time_point start;
+
+    if(kArgc < 3)
+    {
+        printf("No converted image, skipped\n");
+        return;
+    }
+
+    for(i = 2; i < kArgc; ++i)
+    {
+        path = std::string(argv[1]) + "/" + argv[i];
+        TEST_CHECK(ReadFile(path + ".raw", raw));
+        TEST_CHECK(ReadFile(path + ".rle", stream));
+        TEST_CHECK(raw.size() == IMAGE_SIZE);
+
+        /* Converter output decoded by the firmware */
+        TEST_CHECK(Decode(stream, decoded, 61));
+        TEST_CHECK(decoded == raw);
+
+        /* The reference encoder produces the converter stream */
+        TEST_CHECK(Encode(raw) == stream);
+
+        /* Throughput with the EInk manager line buffer size */
+        memcpy(&header, stream.data(), sizeof(SImageCodecHeader));
+        decoded.resize(IMAGE_SIZE);
+        start = std::chrono::steady_clock::now();
+        for(round = 0; round < THROUGHPUT_ROUNDS; ++round)
+        {
+            decoder.Reset(header.rawSize);
+            decoder.Decode(stream.data() + sizeof(SImageCodecHeader),
+                           header.dataSize,
+                           consumed,
+                           decoded.data(),
+                           decoded.size());
+            TEST_CHECK(decoder.IsDone());
+        }
+        elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start
+        ).count();
+
+        printf("%-8s %6u -> %6zu bytes (%5.1f%%), decode %7.1f MB/s\n",
+               argv[i],
+               header.rawSize,
+               stream.size(),
+               100.0 * stream.size() / header.rawSize,
+               (double)header.rawSize * THROUGHPUT_ROUNDS /
+               MAX(elapsed, (uint64_t)1));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    srand(1);
+
+    TEST_RUN(TestEdgeCases);
+    TEST_RUN(TestCorruptedStreams);
+    TestConvertedImages(argc, argv);
+
+    return TEST_RESULT();
+}
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+/* None */
@@ -0,0 +1,323 @@
+/*******************************************************************************
+ * @file LinkCodecTest.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file tests the link compression codec.
+ *
+ * @details This file tests the link compression codec. Streams are encoded
+ * block per block with random block sizes and decoded with random input and
+ * output chunk sizes, the decoded streams are compared with the input. Edge
+ * cases cover the literal and match length extensions, the matches across
+ * blocks and at the window limit, the converted images are round tripped as
+ * they are sent by the client. Corrupted streams must be rejected.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <string>      /* std::string */
+#include <vector>      /* std::vector */
+#include <cstdio>      /* fopen */
+#include <cstdlib>     /* rand */
+#include <Types.h>     /* Defined types */
+#include <HostTest.h>  /* Test checks */
+#include <LinkCodec.h> /* Link compression codec */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Size of the synthetic streams. */
+#define STREAM_SIZE 65536
+
+/** @brief Maximal size of a converted image file. */
+#define IMAGE_FILE_MAX_SIZE (2 * 134400)
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/** @brief Byte buffer. */
+typedef std::vector<uint8_t> TBuffer;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/**
+ * @brief Encodes a stream block per block.
+ *
+ * @param[in] rkRaw The stream to encode.
+ * @param[out] rEncoded The encoded stream.
+ * @param[in] kMaxBlock The maximal block size, random sizes are used below it.
+ *
+ * @return true is returned if all the blocks fit their maximal encoded size,
+ * false otherwise.
+ */
+static bool Encode(const TBuffer& rkRaw,
+                   TBuffer&       rEncoded,
+                   const size_t   kMaxBlock)
+{
+    LinkEncoder encoder;
+    TBuffer     block(LINK_CODEC_MAX_ENCODED_SIZE(LINK_CODEC_BLOCK));
+    size_t      pos;
+    size_t      size;
+    size_t      encoded;
+    bool        fits;
+
+    rEncoded.clear();
+    encoder.Reset();
+    fits = true;
+    for(pos = 0; pos < rkRaw.size(); pos += size)
+    {
+        /* MIN evaluates its arguments twice, draw the size first */
+        size    = 1 + (size_t)rand() % kMaxBlock;
+        size    = MIN(size, rkRaw.size() - pos);
+        encoded = encoder.Encode(rkRaw.data() + pos, size, block.data());
+        fits    = fits && encoded <= LINK_CODEC_MAX_ENCODED_SIZE(size);
+        rEncoded.insert(rEncoded.end(), block.begin(), block.begin() + encoded);
+    }
+
+    return fits;
+}
+
+/**
+ * @brief Decodes a stream with random chunk sizes.
+ *
+ * @param[in] rkEncoded The encoded stream.
+ * @param[out] rRaw The decoded stream.
+ * @param[in] kMaxChunk The maximal input and output chunk size.
+ *
+ * @return true is returned if the stream was decoded without error, false
+ * otherwise.
+ */
+static bool Decode(const TBuffer& rkEncoded,
+                   TBuffer&       rRaw,
+                   const size_t   kMaxChunk)
+{
+    LinkDecoder decoder;
+    TBuffer     output(kMaxChunk);
+    size_t      pos;
+    size_t      chunk;
+    size_t      consumed;
+    size_t      produced;
+
+    rRaw.clear();
+    decoder.Reset();
+    pos = 0;
+    do
+    {
+        chunk    = 1 + (size_t)rand() % kMaxChunk;
+        chunk    = MIN(chunk, rkEncoded.size() - pos);
+        produced = decoder.Decode(rkEncoded.data() + pos,
+                                  chunk,
+                                  consumed,
+                                  output.data(),
+                                  1 + (size_t)rand() % kMaxChunk);
+        rRaw.insert(rRaw.end(), output.begin(), output.begin() + produced);
+        pos += consumed;
+    } while((pos < rkEncoded.size() || produced > 0) && !decoder.HasError());
+
+    return !decoder.HasError();
+}
+
+/** @brief Checks the round trip of a stream with several chunk sizes. */
+static void CheckRoundTrip(const TBuffer& rkRaw)
+{
+    TBuffer encoded;
+    TBuffer decoded;
+
+    TEST_CHECK(Encode(rkRaw, encoded, LINK_CODEC_BLOCK));
+    TEST_CHECK(Decode(encoded, decoded, 7));
+    TEST_CHECK(decoded == rkRaw);
+    TEST_CHECK(Decode(encoded, decoded, 4096));
+    TEST_CHECK(decoded == rkRaw);
+
+    TEST_CHECK(Encode(rkRaw, encoded, 17));
+    TEST_CHECK(Decode(encoded, decoded, 61));
+    TEST_CHECK(decoded == rkRaw);
+}
+
+/** @brief Reads a file. */
+static bool ReadFile(const std::string& rkPath, TBuffer& rContent)
+{
+    FILE*  pFile;
+    size_t read;
+
+    pFile = fopen(rkPath.c_str(), "rb");
+    if(pFile == nullptr)
+    {
+        return false;
+    }
+    rContent.resize(IMAGE_FILE_MAX_SIZE);
+    read = fread(rContent.data(), 1, rContent.size(), pFile);
+    rContent.resize(read);
+    fclose(pFile);
+
+    return true;
+}
+
+static void TestEdgeCases(void)
+{
+    TBuffer raw;
+    TBuffer encoded;
+    TBuffer decoded;
+    size_t  i;
+
+    /* Single value, long matches with length extensions */
+    CheckRoundTrip(TBuffer(STREAM_SIZE, 0x11));
+
+    /* No match, long literal runs with count extensions */
+    raw.resize(STREAM_SIZE);
+    for(i = 0; i < raw.size(); ++i)
+    {
+        raw[i] = rand() >> 8;
+    }
+    CheckRoundTrip(raw);
+
+    /* Matches across the blocks and at the window limit */
+    for(i = 0; i < LINK_CODEC_WINDOW; ++i)
+    {
+        raw[i] = rand() >> 8;
+    }
+    for(i = LINK_CODEC_WINDOW; i < raw.size(); ++i)
+    {
+        raw[i] = raw[i - LINK_CODEC_WINDOW];
+    }
+    CheckRoundTrip(raw);
+
+    for(i = 700; i < raw.size(); ++i)
+    {
+        raw[i] = raw[i - 700];
+    }
+    CheckRoundTrip(raw);
+
+    /* Short matches around the minimal length */
+    for(i = 0; i < raw.size(); ++i)
+    {
+        raw[i] = (i % 5 < LINK_CODEC_MIN_MATCH) ? 0x22 : rand() >> 8;
+    }
+    CheckRoundTrip(raw);
+
+    /* Tiny streams */
+    CheckRoundTrip(TBuffer(1, 0x33));
+    CheckRoundTrip(TBuffer(LINK_CODEC_MIN_MATCH, 0x44));
+
+    /* A repetitive stream compresses */
+    TEST_CHECK(Encode(TBuffer(STREAM_SIZE, 0x55), encoded, LINK_CODEC_BLOCK));
+    TEST_CHECK(encoded.size() < STREAM_SIZE / 16);
+}
+
+static void TestCorruptedStreams(void)
+{
+    LinkDecoder decoder;
+    uint8_t     pOutput[64];
+    uint8_t     pStream[3];
+    size_t      consumed;
+
+    /* A match before any data */
+    pStream[0] = 0x01;
+    pStream[1] = 0x01;
+    pStream[2] = 0x00;
+    decoder.Reset();
+    decoder.Decode(pStream, sizeof(pStream), consumed, pOutput, 64);
+    TEST_CHECK(decoder.HasError());
+
+    /* A null offset */
+    pStream[0] = 0x11;
+    pStream[1] = 0xAA;
+    decoder.Reset();
+    decoder.Decode(pStream, 2, consumed, pOutput, 64);
+    TEST_CHECK(!decoder.HasError());
+    pStream[0] = 0x00;
+    pStream[1] = 0x00;
+    decoder.Decode(pStream, 2, consumed, pOutput, 64);
+    TEST_CHECK(decoder.HasError());
+
+    /* An empty sequence */
+    pStream[0] = 0x00;
+    decoder.Reset();
+    decoder.Decode(pStream, 1, consumed, pOutput, 64);
+    TEST_CHECK(decoder.HasError());
+
+    /* The error is cleared by a reset */
+    decoder.Reset();
+    TEST_CHECK(!decoder.HasError());
+}
+
+static void TestConvertedImages(const int kArgc, char** argv)
+{
+    std::string path;
+    TBuffer     image;
+    TBuffer     encoded;
+    TBuffer     decoded;
+    int         i;
+
+    if(kArgc < 3)
+    {
+        printf("No converted image, skipped\n");
+        return;
+    }
+
+    /* Raw and compressed images are both sent on the link */
+    for(i = 2; i < kArgc; ++i)
+    {
+        path = std::string(argv[1]) + "/" + argv[i];
+        TEST_CHECK(ReadFile(path + ".raw", image));
+        CheckRoundTrip(image);
+        TEST_CHECK(Encode(image, encoded, LINK_CODEC_BLOCK));
+        TEST_CHECK(encoded.size() < image.size());
+
+        TEST_CHECK(ReadFile(path + ".rle", image));
+        CheckRoundTrip(image);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    srand(1);
+
+    TEST_RUN(TestEdgeCases);
+    TEST_RUN(TestCorruptedStreams);
+    TestConvertedImages(argc, argv);
+
+    return TEST_RESULT();
+}
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+/* None */
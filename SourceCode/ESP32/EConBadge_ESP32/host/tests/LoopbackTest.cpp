@@ -0,0 +1,338 @@
+/*******************************************************************************
+ * @file LoopbackTest.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file tests the bluetooth manager over the loopback transport.
+ *
+ * @details This file tests the bluetooth manager over the loopback transport.
+ * The command checks, the raw and compressed image upload and download and
+ * the image listing are driven end to end on links with different MTU,
+ * latency, bandwidth and loss. On the lossy link, the lost bulk frames must
+ * be retransmitted.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <vector>              /* std::vector */
+#include <string>              /* std::string */
+#include <Types.h>             /* Defined types */
+#include <Logger.h>            /* Logger service */
+#include <Storage.h>           /* Files cursor */
+#include <HostTest.h>          /* Test checks */
+#include <BlueToothMgr.h>      /* Bluetooth manager */
+#include <LoopbackPeer.h>      /* Loopback peer */
+#include <LoopbackDevice.h>    /* Loopback device */
+#include <LoopbackTransport.h> /* Loopback transport */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Size of the transferred images. */
+#define TEST_IMAGE_SIZE 16384
+/** @brief Number of images reported by the listing. */
+#define TEST_IMAGE_COUNT 100
+/** @brief Number of entries requested per page. */
+#define TEST_PAGE_ENTRIES 32
+
+/** @brief Command and transfer timeout in milliseconds. */
+#define TEST_TIMEOUT 5000
+
+/** @brief Size of the chunks stored by the stalled device. */
+#define TEST_STALL_CHUNK 1024
+/** @brief Storage stall between two chunks in milliseconds. */
+#define TEST_STALL_TIME 20
+
+/** @brief Default communication token. */
+#define TEST_TOKEN "0000000000000000"
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/** @brief Byte buffer. */
+typedef std::vector<uint8_t> TBuffer;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+
+/** @brief Tested links: MTU, interval, latency, bandwidth, loss, depth. */
+static const SLoopbackConfig sksLinks[] = {
+    { BLE_PREFERRED_MTU, 6, 0, 0, 0, 8, 1 },
+    { 247, 6, 0, 0, 0, 8, 1 },
+    { 247, 6, 500, 400000, 0, 8, 1 },
+    { 185, 24, 100, 0, 0, 4, 1 },
+    { 247, 6, 500, 400000, 300, 8, 7 }
+};
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/** @brief Builds an image with compressible and random areas. */
+static void BuildImage(const uint32_t kSeed, TBuffer& rImage)
+{
+    uint32_t state;
+    size_t   i;
+
+    state = kSeed;
+    rImage.resize(TEST_IMAGE_SIZE);
+    for(i = 0; i < rImage.size(); ++i)
+    {
+        state = state * 1103515245 + 12345;
+        if((i / 1024) % 2 == 0)
+        {
+            rImage[i] = 0x11 * ((i / 97) % 8);
+        }
+        else
+        {
+            rImage[i] = state >> 24;
+        }
+    }
+}
+
+/** @brief Sets the compression of the next transfer. */
+static bool SetCompression(LoopbackPeer& rPeer, const bool kCompressed)
+{
+    SCommandResponse response;
+    uint8_t          mode;
+
+    mode = kCompressed ? BLE_COMPRESSION_LZ : BLE_COMPRESSION_NONE;
+    return rPeer.Command(CMD_SET_LINK_COMPRESSION,
+                         &mode,
+                         sizeof(mode),
+                         response,
+                         TEST_TIMEOUT);
+}
+
+/** @brief Checks the command token and size checks and a query. */
+static void TestCommands(LoopbackTransport& rTransport, LoopbackPeer& rPeer)
+{
+    LoopbackPeer     badPeer(&rTransport, "1111111111111111");
+    SCommandResponse response;
+    SBLELinkInfo     info;
+
+    TEST_CHECK(rPeer.Command(CMD_PING, nullptr, 0, response, TEST_TIMEOUT));
+
+    TEST_CHECK(!badPeer.Command(CMD_PING, nullptr, 0, response, TEST_TIMEOUT));
+    TEST_CHECK(response.header.errorCode == INVALID_TOKEN);
+
+    TEST_CHECK(rPeer.Command(CMD_LEDBORDER_GET_BRIGHTNESS,
+                             nullptr,
+                             0,
+                             response,
+                             TEST_TIMEOUT));
+    TEST_CHECK(response.header.size == 1);
+    TEST_CHECK(response.pResponse[0] == LOOPBACK_DEVICE_BRIGHTNESS);
+
+    /* The client chunks its writes by the granted segment size */
+    TEST_CHECK(rPeer.Command(CMD_GET_LINK_INFO,
+                             nullptr,
+                             0,
+                             response,
+                             TEST_TIMEOUT));
+    TEST_CHECK(response.header.size == sizeof(SBLELinkInfo));
+    memcpy(&info, response.pResponse, sizeof(SBLELinkInfo));
+    TEST_CHECK(info.segmentSize == rTransport.GetSegmentSize());
+    TEST_CHECK(info.segmentSize <= BLE_MESSAGE_MTU);
+}
+
+/** @brief Uploads an image and checks the device received it. */
+static void TestUpload(LoopbackDevice& rDevice,
+                       LoopbackPeer&   rPeer,
+                       const bool      kCompressed)
+{
+    SCommandResponse response;
+    TBuffer          image;
+    TBuffer          received;
+
+    BuildImage(kCompressed ? 2 : 1, image);
+
+    TEST_CHECK(SetCompression(rPeer, kCompressed));
+    TEST_CHECK(rPeer.Command(CMD_EINK_NEW_IMAGE,
+                             nullptr,
+                             0,
+                             response,
+                             TEST_TIMEOUT));
+    TEST_CHECK(rPeer.Upload(image.data(),
+                            image.size(),
+                            kCompressed,
+                            TEST_TIMEOUT));
+    TEST_CHECK(rPeer.WaitResponse(response, TEST_TIMEOUT));
+
+    rDevice.GetImage(received);
+    TEST_CHECK(received == image);
+}
+
+/** @brief Uploads an image faster than the device stores it. */
+static void TestStalledUpload(LoopbackDevice& rDevice, LoopbackPeer& rPeer)
+{
+    uint32_t retransmits;
+
+    /* The receive ring fills up, the dropped frames are sent again */
+    retransmits = rPeer.GetRetransmits();
+    rDevice.SetStorageStall(TEST_STALL_CHUNK, TEST_STALL_TIME);
+    TestUpload(rDevice, rPeer, false);
+    rDevice.SetStorageStall(0, 0);
+
+    TEST_CHECK(rPeer.GetRetransmits() > retransmits);
+}
+
+/** @brief Downloads the device image and checks its content. */
+static void TestDownload(LoopbackDevice& rDevice,
+                         LoopbackPeer&   rPeer,
+                         const bool      kCompressed)
+{
+    SCommandResponse response;
+    TBuffer          image;
+    TBuffer          received;
+
+    BuildImage(kCompressed ? 4 : 3, image);
+    rDevice.SetImage(image);
+
+    TEST_CHECK(SetCompression(rPeer, kCompressed));
+    TEST_CHECK(rPeer.Command(CMD_EINK_GET_IMAGE_DATA,
+                             nullptr,
+                             0,
+                             response,
+                             TEST_TIMEOUT));
+    TEST_CHECK(rPeer.Download(received,
+                              image.size(),
+                              true,
+                              kCompressed,
+                              TEST_TIMEOUT));
+    TEST_CHECK(rPeer.WaitResponse(response, TEST_TIMEOUT));
+    TEST_CHECK(received == image);
+}
+
+/** @brief Lists the device images page per page. */
+static void TestListing(LoopbackPeer& rPeer)
+{
+    SCommandResponse  response;
+    SImagePageRequest request;
+    SImagePageHeader  pageHeader;
+    TBuffer           page;
+    uint32_t          count;
+
+    request.cursor = 0;
+    request.count  = TEST_PAGE_ENTRIES;
+    request.flags  = IMAGE_PAGE_FLAG_RECORDS;
+    count          = 0;
+    while(request.cursor != FILES_CURSOR_END)
+    {
+        if(!rPeer.Command(CMD_EINK_GET_IMAGE_PAGE,
+                          &request,
+                          sizeof(SImagePageRequest),
+                          response,
+                          TEST_TIMEOUT))
+        {
+            TEST_CHECK(false);
+            return;
+        }
+        memcpy(&pageHeader, response.pResponse, sizeof(SImagePageHeader));
+        TEST_CHECK(rPeer.Download(page,
+                                  pageHeader.size,
+                                  false,
+                                  false,
+                                  TEST_TIMEOUT));
+        TEST_CHECK(page.size() == pageHeader.size);
+        TEST_CHECK(rPeer.WaitResponse(response, TEST_TIMEOUT));
+
+        count          += pageHeader.count;
+        request.cursor  = pageHeader.nextCursor;
+    }
+
+    TEST_CHECK(count == TEST_IMAGE_COUNT);
+}
+
+/** @brief Runs the tests on a link. */
+static void TestLink(const SLoopbackConfig& rkConfig)
+{
+    LoopbackTransport* pTransport;
+    BluetoothManager*  pBtMgr;
+    LoopbackDevice*    pDevice;
+    LoopbackPeer*      pPeer;
+    SLoopbackCounters  counters;
+
+    printf("[ RUN  ] Link MTU %u, latency %uus, bandwidth %uB/s, "
+           "loss %u/10000\n",
+           rkConfig.mtu,
+           rkConfig.latency,
+           rkConfig.bandwidth,
+           rkConfig.lossRate);
+
+    /* The tasks of the manager are not stopped, the link is left idle */
+    pTransport = new LoopbackTransport(rkConfig);
+    pBtMgr     = new BluetoothManager();
+    pDevice    = new LoopbackDevice(pBtMgr, TEST_IMAGE_SIZE, TEST_IMAGE_COUNT);
+    pPeer      = new LoopbackPeer(pTransport, TEST_TOKEN);
+    pBtMgr->Init(pDevice, pTransport);
+    pTransport->Connect();
+
+    TestCommands(*pTransport, *pPeer);
+    TestUpload(*pDevice, *pPeer, false);
+    TestUpload(*pDevice, *pPeer, true);
+    TestStalledUpload(*pDevice, *pPeer);
+    TestDownload(*pDevice, *pPeer, false);
+    TestDownload(*pDevice, *pPeer, true);
+    TestListing(*pPeer);
+
+    /* The lost bulk frames were recovered by the retransmits */
+    pTransport->GetCounters(counters);
+    if(rkConfig.lossRate != 0)
+    {
+        TEST_CHECK(counters.lostFrames > 0);
+        TEST_CHECK(pPeer->GetRetransmits() > 0);
+    }
+
+    pTransport->Disconnect();
+}
+
+int main(void)
+{
+    size_t i;
+
+    INIT_LOGGER(ECB_LOG_LEVEL_ERROR);
+
+    for(i = 0; i < sizeof(sksLinks) / sizeof(sksLinks[0]); ++i)
+    {
+        TestLink(sksLinks[i]);
+    }
+
+    return TEST_RESULT();
+}
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+/* None */
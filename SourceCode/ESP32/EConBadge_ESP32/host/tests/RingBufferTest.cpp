@@ -0,0 +1,243 @@
+/*******************************************************************************
+ * @file RingBufferTest.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file tests the ring buffer.
+ *
+ * @details This file tests the ring buffer. The contiguous runs, the wrap at
+ * the end of the ring and the overflow counters are checked, then a producer
+ * and a consumer thread stream frames through the ring with the flow control
+ * used by the bluetooth manager and the received stream is checked.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <thread>       /* std::thread */
+#include <vector>       /* std::vector */
+#include <cstring>      /* memset */
+#include <Types.h>      /* Defined types */
+#include <HostTest.h>   /* Test checks */
+#include <RingBuffer.h> /* Ring buffer */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Size of the small ring used by the unit checks. */
+#define SMALL_RING_SIZE 16
+
+/** @brief Size of the streamed ring, the manager receive ring size. */
+#define STREAM_RING_SIZE 8192
+/** @brief Number of bytes streamed through the ring. */
+#define STREAM_SIZE (4 * 1024 * 1024)
+/** @brief Maximal size of a streamed frame, the BLE message MTU. */
+#define STREAM_FRAME_MAX 512
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/** @brief Checks the runs returned by Peek, before and after the wrap. */
+static void TestRuns(void)
+{
+    RingBuffer     ring(SMALL_RING_SIZE);
+    uint8_t        pData[10];
+    const uint8_t* pkRun;
+    size_t         size;
+    size_t         i;
+
+    TEST_CHECK(ring.GetSize() == SMALL_RING_SIZE);
+    TEST_CHECK(ring.Peek(pkRun) == 0);
+
+    for(i = 0; i < sizeof(pData); ++i)
+    {
+        pData[i] = i;
+    }
+    TEST_CHECK(ring.Push(pData, sizeof(pData)));
+    TEST_CHECK(ring.GetUsed() == 10);
+    TEST_CHECK(ring.GetFree() == SMALL_RING_SIZE - 10);
+
+    size = ring.Peek(pkRun);
+    TEST_CHECK(size == 10);
+    TEST_CHECK(pkRun[0] == 0 && pkRun[9] == 9);
+    ring.Consume(size);
+    TEST_CHECK(ring.GetUsed() == 0);
+
+    /* The next push wraps at the end of the ring */
+    for(i = 0; i < sizeof(pData); ++i)
+    {
+        pData[i] = 10 + i;
+    }
+    TEST_CHECK(ring.Push(pData, sizeof(pData)));
+
+    size = ring.Peek(pkRun);
+    TEST_CHECK(size == SMALL_RING_SIZE - 10);
+    TEST_CHECK(pkRun[0] == 10 && pkRun[size - 1] == 15);
+    ring.Consume(2);
+
+    size = ring.Peek(pkRun);
+    TEST_CHECK(size == 4);
+    TEST_CHECK(pkRun[0] == 12);
+    ring.Consume(size);
+
+    size = ring.Peek(pkRun);
+    TEST_CHECK(size == 4);
+    TEST_CHECK(pkRun[0] == 16 && pkRun[3] == 19);
+    ring.Consume(size);
+    TEST_CHECK(ring.GetUsed() == 0);
+}
+
+/** @brief Checks the overflow counters and the high watermark. */
+static void TestOverflow(void)
+{
+    RingBuffer ring(SMALL_RING_SIZE);
+    uint8_t    pData[SMALL_RING_SIZE];
+
+    memset(pData, 0xA5, sizeof(pData));
+
+    TEST_CHECK(ring.Push(pData, 12));
+    TEST_CHECK(!ring.Push(pData, 8));
+    TEST_CHECK(ring.GetOverflowCount() == 1);
+    TEST_CHECK(ring.GetDroppedBytes() == 8);
+    TEST_CHECK(ring.GetUsed() == 12);
+    TEST_CHECK(ring.GetHighWatermark() == 12);
+
+    /* The ring can be filled entirely */
+    TEST_CHECK(ring.Push(pData, 4));
+    TEST_CHECK(ring.GetFree() == 0);
+    TEST_CHECK(ring.GetHighWatermark() == SMALL_RING_SIZE);
+
+    TEST_CHECK(!ring.Push(pData, 1));
+    TEST_CHECK(ring.GetOverflowCount() == 2);
+    TEST_CHECK(ring.GetDroppedBytes() == 9);
+
+    ring.Consume(SMALL_RING_SIZE);
+    TEST_CHECK(ring.Push(pData, SMALL_RING_SIZE));
+    TEST_CHECK(ring.GetOverflowCount() == 2);
+}
+
+/** @brief Pushes frames, waiting for space as the bluetooth manager does. */
+static void ProduceStream(RingBuffer* pRing)
+{
+    std::vector<uint8_t> frame(STREAM_FRAME_MAX);
+    uint32_t             state;
+    size_t               sent;
+    size_t               size;
+    size_t               i;
+
+    state = 1;
+    sent  = 0;
+    while(sent < STREAM_SIZE)
+    {
+        state = state * 1103515245 + 12345;
+        size  = MIN(1 + (state >> 16) % STREAM_FRAME_MAX, STREAM_SIZE - sent);
+        for(i = 0; i < size; ++i)
+        {
+            frame[i] = (sent + i) % 251;
+        }
+
+        while(pRing->GetFree() < size)
+        {
+            std::this_thread::yield();
+        }
+        if(!pRing->Push(frame.data(), size))
+        {
+            return;
+        }
+        sent += size;
+    }
+}
+
+/** @brief Streams frames between two threads and checks the stream. */
+static void TestStream(void)
+{
+    RingBuffer     ring(STREAM_RING_SIZE);
+    std::thread    producer(ProduceStream, &ring);
+    const uint8_t* pkRun;
+    size_t         received;
+    size_t         size;
+    size_t         errors;
+    size_t         i;
+
+    received = 0;
+    errors   = 0;
+    while(received < STREAM_SIZE)
+    {
+        size = ring.Peek(pkRun);
+        if(size == 0)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        for(i = 0; i < size; ++i)
+        {
+            if(pkRun[i] != (received + i) % 251)
+            {
+                ++errors;
+            }
+        }
+        ring.Consume(size);
+        received += size;
+    }
+    producer.join();
+
+    TEST_CHECK(errors == 0);
+    TEST_CHECK(received == STREAM_SIZE);
+    TEST_CHECK(ring.GetOverflowCount() == 0);
+    TEST_CHECK(ring.GetUsed() == 0);
+    TEST_CHECK(ring.GetHighWatermark() <= STREAM_RING_SIZE);
+}
+
+int main(void)
+{
+    TEST_RUN(TestRuns);
+    TEST_RUN(TestOverflow);
+    TEST_RUN(TestStream);
+
+    return TEST_RESULT();
+}
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+/* None */
@@ -0,0 +1,326 @@
+/*******************************************************************************
+ * @file SpiCaptureTest.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file tests the EInk driver SPI capture.
+ *
+ * @details This file tests the EInk driver SPI capture. A capture device
+ * attached to the host bus computes the frame CRC from the bytes actually
+ * sent on the wire with the DC line level. The CRC logged by the driver must
+ * match it, and the different ways of pushing the same frame (burst, fill,
+ * blit) must produce the same wire stream.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <string>          /* std::string */
+#include <vector>          /* std::vector */
+#include <Types.h>         /* Defined types */
+#include <Logger.h>        /* Logger service */
+#include <HostBus.h>       /* Host bus */
+#include <Arduino.h>       /* Arduino services */
+#include <HostTest.h>      /* Test checks */
+#include <esp_rom_crc.h>   /* CRC32 services */
+#include <WaveshareEInk.h> /* EInk driver */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Size in bytes of a full frame. */
+#define FRAME_SIZE ((EPD_WIDTH / 2) * EPD_HEIGHT)
+
+/** @brief Capture marker of a command, as used by the driver. */
+#define CAPTURE_CMD_MARKER 0xC0
+/** @brief Capture marker of a data sequence, as used by the driver. */
+#define CAPTURE_DATA_MARKER 0xDA
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/** @brief Frame capture, from the driver log or from the wire. */
+typedef struct
+{
+    /** @brief Stream CRC. */
+    uint32_t crc;
+    /** @brief Number of command bytes. */
+    uint32_t commandBytes;
+    /** @brief Number of data bytes. */
+    uint32_t dataBytes;
+} SFrameCapture;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+
+/** @brief The driver log. */
+static std::string sLog;
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/**
+ * @brief Wire capture device.
+ *
+ * @details Wire capture device. Captures the bytes sent while CS is low with
+ * the DC line level, a frame starts with the resolution command. The BUSY
+ * line is driven low after a power off and high after any other command.
+ */
+class WireCapture: public HostDevice
+{
+    public:
+        WireCapture(void)
+        {
+            dcLevel_  = HIGH;
+            csLevel_  = HIGH;
+            lastData_ = false;
+            memset(&frame_, 0, sizeof(SFrameCapture));
+            HostBus::DrivePin(GPIO_EINK_BUSY, HIGH);
+        }
+
+        virtual void OnPinWrite(const uint8_t kPin, const uint8_t kLevel)
+        {
+            if(kPin == GPIO_EINK_DC)
+            {
+                dcLevel_ = kLevel;
+            }
+            else if(kPin == GPIO_EINK_CS)
+            {
+                csLevel_ = kLevel;
+            }
+        }
+
+        virtual void OnSpiWrite(const uint8_t* pkData, const uint32_t kSize)
+        {
+            uint8_t marker;
+            bool    isData;
+
+            if(csLevel_ != LOW)
+            {
+                return;
+            }
+            isData = (dcLevel_ == HIGH);
+
+            if(!isData)
+            {
+                /* The driver starts its capture with the frame */
+                if(pkData[0] == 0x61)
+                {
+                    memset(&frame_, 0, sizeof(SFrameCapture));
+                }
+                HostBus::DrivePin(GPIO_EINK_BUSY,
+                                  pkData[kSize - 1] == 0x02 ? LOW : HIGH);
+            }
+
+            if(!isData || !lastData_)
+            {
+                marker = isData ? CAPTURE_DATA_MARKER : CAPTURE_CMD_MARKER;
+                frame_.crc = esp_rom_crc32_le(frame_.crc, &marker, 1);
+            }
+            lastData_ = isData;
+
+            frame_.crc = esp_rom_crc32_le(frame_.crc, pkData, kSize);
+            if(isData)
+            {
+                frame_.dataBytes += kSize;
+            }
+            else
+            {
+                frame_.commandBytes += kSize;
+            }
+        }
+
+        const SFrameCapture& GetFrame(void) const
+        {
+            return frame_;
+        }
+
+    private:
+        uint8_t       dcLevel_;
+        uint8_t       csLevel_;
+        bool          lastData_;
+        SFrameCapture frame_;
+};
+
+/** @brief Returns the last frame capture logged by the driver. */
+static bool GetLoggedFrame(SFrameCapture& rFrame)
+{
+    size_t pos;
+
+    pos = sLog.rfind("EInk frame: ");
+    if(pos == std::string::npos)
+    {
+        return false;
+    }
+
+    return sscanf(sLog.c_str() + pos,
+                  "EInk frame: CRC 0x%08X, %u cmd bytes, %u data bytes",
+                  &rFrame.crc,
+                  &rFrame.commandBytes,
+                  &rFrame.dataBytes) == 3;
+}
+
+/** @brief Checks that the driver capture matches the wire capture. */
+static SFrameCapture CheckFrame(const WireCapture& rkWire)
+{
+    SFrameCapture logged;
+
+    memset(&logged, 0, sizeof(SFrameCapture));
+    TEST_CHECK(GetLoggedFrame(logged));
+    TEST_CHECK(logged.crc == rkWire.GetFrame().crc);
+    TEST_CHECK(logged.commandBytes == rkWire.GetFrame().commandBytes);
+    TEST_CHECK(logged.dataBytes == rkWire.GetFrame().dataBytes);
+
+    /* Resolution, frame data, power on, refresh, power off */
+    TEST_CHECK(logged.commandBytes == 5);
+    TEST_CHECK(logged.dataBytes == 4 + FRAME_SIZE);
+
+    sLog.clear();
+
+    return logged;
+}
+
+static WaveshareDriver* spDriver;
+static WireCapture*     spWire;
+
+static void TestFillMatchesBurst(void)
+{
+    std::vector<uint8_t> frame(FRAME_SIZE,
+                               (EPD_5IN65F_WHITE << 4) | EPD_5IN65F_WHITE);
+    SFrameCapture        fill;
+    SFrameCapture        burst;
+
+    TEST_CHECK(spDriver->Clear(EPD_5IN65F_WHITE));
+    fill = CheckFrame(*spWire);
+
+    TEST_CHECK(spDriver->Display(frame.data()));
+    burst = CheckFrame(*spWire);
+
+    TEST_CHECK(fill.crc == burst.crc);
+}
+
+static void TestBlitMatchesBurst(void)
+{
+    std::vector<uint8_t> frame(FRAME_SIZE);
+    SEInkBlitRegion      region;
+    SFrameCapture        blit;
+    SFrameCapture        burst;
+    SFrameCapture        part;
+    size_t               i;
+
+    for(i = 0; i < frame.size(); ++i)
+    {
+        frame[i] = (uint8_t)(i * 7 + (i >> 9));
+    }
+
+    region.x              = 0;
+    region.y              = 0;
+    region.width          = EPD_WIDTH;
+    region.height         = EPD_HEIGHT;
+    region.source         = EINK_BLIT_BUFFER;
+    region.color          = EPD_5IN65F_WHITE;
+    region.pkBuffer       = frame.data();
+    region.reader         = nullptr;
+    region.pReaderContext = nullptr;
+
+    TEST_CHECK(spDriver->Blit(&region, 1, EPD_5IN65F_WHITE));
+    TEST_CHECK(spDriver->DisplayEndTrans());
+    blit = CheckFrame(*spWire);
+
+    TEST_CHECK(spDriver->Display(frame.data()));
+    burst = CheckFrame(*spWire);
+
+    TEST_CHECK(spDriver->DisplayPart(frame.data(), 0, 0,
+                                     EPD_WIDTH, EPD_HEIGHT));
+    part = CheckFrame(*spWire);
+
+    TEST_CHECK(blit.crc == burst.crc);
+    TEST_CHECK(part.crc == burst.crc);
+}
+
+static void TestFillBlitMatchesClear(void)
+{
+    SEInkBlitRegion region;
+    SFrameCapture   blit;
+    SFrameCapture   clear;
+
+    region.x              = 0;
+    region.y              = 0;
+    region.width          = EPD_WIDTH;
+    region.height         = EPD_HEIGHT;
+    region.source         = EINK_BLIT_FILL;
+    region.color          = EPD_5IN65F_RED;
+    region.pkBuffer       = nullptr;
+    region.reader         = nullptr;
+    region.pReaderContext = nullptr;
+
+    TEST_CHECK(spDriver->Blit(&region, 1, EPD_5IN65F_WHITE));
+    TEST_CHECK(spDriver->DisplayEndTrans());
+    blit = CheckFrame(*spWire);
+
+    TEST_CHECK(spDriver->Clear(EPD_5IN65F_RED));
+    clear = CheckFrame(*spWire);
+
+    TEST_CHECK(blit.crc == clear.crc);
+}
+
+int main(void)
+{
+    WireCapture     wire;
+    WaveshareDriver driver;
+
+    HostBus::Attach(&wire);
+    Serial.setCapture(&sLog);
+    INIT_LOGGER(ECB_LOG_LEVEL_INFO);
+
+    spDriver = &driver;
+    spWire   = &wire;
+
+    driver.Init();
+    sLog.clear();
+
+    TEST_RUN(TestFillMatchesBurst);
+    TEST_RUN(TestBlitMatchesBurst);
+    TEST_RUN(TestFillBlitMatchesClear);
+
+    Serial.setCapture(nullptr);
+    HostBus::Detach(&wire);
+
+    return TEST_RESULT();
+}
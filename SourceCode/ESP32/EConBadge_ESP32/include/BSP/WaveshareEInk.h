@@ -52,7 +52,8 @@
 /*******************************************************************************
  * INCLUDES
  ******************************************************************************/
-#include <cstdint> /* Generic types */
+#include <cstdint>   /* Generic types */
+#include <Arduino.h> /* Arduino services */
 
 /*******************************************************************************
  * CONSTANTS
@@ -80,6 +81,9 @@
 /** @brief EINK Color: Clean */
 #define EPD_5IN65F_CLEAN 0x7
 
+/** @brief Default timeout in milliseconds of the BUSY line waits. */
+#define EPD_BUSY_DEFAULT_TIMEOUT 60000
+
 /*******************************************************************************
  * MACROS
  ******************************************************************************/
@@ -89,7 +93,64 @@
  * STRUCTURES AND TYPES
  ******************************************************************************/
 
-/* None */
+/**
+ * @brief Blit region reader.
+ *
+ * @details Reads the start of a row of a region into a buffer. Used for
+ * regions whose content is not in memory (e.g. stored in a file). Less than
+ * a full row is requested when the region is clipped by the screen.
+ *
+ * @param[in] pContext The region reader context.
+ * @param[in] kRow The row to read, relative to the region.
+ * @param[out] pBuffer The buffer that receives the data.
+ * @param[in] kSize The number of bytes to read.
+ *
+ * @return true is returned on success, false otherwise.
+ */
+typedef bool (*TEInkBlitReader)(void*          pContext,
+                                const uint32_t kRow,
+                                uint8_t*       pBuffer,
+                                const uint32_t kSize);
+
+/** @brief Defines the source of a blit region. */
+typedef enum
+{
+    /** @brief The region is filled with a color. */
+    EINK_BLIT_FILL   = 0,
+    /** @brief The region content is a 4bpp buffer in memory. */
+    EINK_BLIT_BUFFER = 1,
+    /** @brief The region content is provided by a reader. */
+    EINK_BLIT_READER = 2
+} EEInkBlitSource;
+
+/**
+ * @brief Defines a blit region.
+ *
+ * @details Defines a blit region. Positions and widths are in pixels and
+ * rounded down to even values, two pixels are stored per byte. Regions are
+ * clipped to the screen.
+ */
+typedef struct
+{
+    /** @brief The region left position. */
+    uint32_t        x;
+    /** @brief The region top position. */
+    uint32_t        y;
+    /** @brief The region width. */
+    uint32_t        width;
+    /** @brief The region height. */
+    uint32_t        height;
+    /** @brief The region content source. */
+    EEInkBlitSource source;
+    /** @brief The fill color, used by EINK_BLIT_FILL. */
+    uint8_t         color;
+    /** @brief The region content, used by EINK_BLIT_BUFFER. */
+    const uint8_t*  pkBuffer;
+    /** @brief The region content reader, used by EINK_BLIT_READER. */
+    TEInkBlitReader reader;
+    /** @brief The region content reader context. */
+    void*           pReaderContext;
+} SEInkBlitRegion;
 
 /*******************************************************************************
  * GLOBAL VARIABLES
@@ -150,8 +211,10 @@ class WaveshareDriver
          * @details Sends the image buffer in RAM to e-Paper and displays.
          *
          * @param[in] pImage The buffer that contains the image to send.
+         *
+         * @return true is returned on success, false if the panel timed out.
          */
-        void Display(const uint8_t* pImage);
+        bool Display(const uint8_t* pImage);
 
         /**
          * @brief Init the transaction to send the image buffer in RAM to
@@ -170,8 +233,77 @@ class WaveshareDriver
         /**
          * @brief End the transaction to send the image buffer in RAM to e-Paper
          * and display.
+         *
+         * @details End the transaction and waits for the refresh to complete.
+         * This is equivalent to BeginRefresh followed by WaitRefresh.
+         *
+         * @return true is returned on success, false if the panel timed out.
+         */
+        bool DisplayEndTrans(void);
+
+        /**
+         * @brief Starts the panel refresh.
+         *
+         * @details Starts the refresh of the panel with the content of its RAM
+         * and returns without waiting for the refresh to complete. WaitRefresh
+         * must be called to end the refresh.
+         *
+         * @return true is returned on success, false if the panel timed out.
+         */
+        bool BeginRefresh(void);
+
+        /**
+         * @brief Tells if the panel refresh is done.
+         *
+         * @details Tells if the panel refresh is done. This function does not
+         * block.
+         *
+         * @return true is returned if no refresh is in progress or if the
+         * refresh is done, false otherwise.
+         */
+        bool IsRefreshDone(void) const;
+
+        /**
+         * @brief Waits for the panel refresh to complete.
+         *
+         * @details Waits for the panel refresh to complete and powers the
+         * panel off. If the panel does not complete the refresh in time, it
+         * is reset.
+         *
+         * @param[in] kTimeout The timeout in milliseconds.
+         *
+         * @return true is returned on success, false if the panel timed out.
+         */
+        bool WaitRefresh(const uint32_t kTimeout);
+
+        /**
+         * @brief Sets the timeout of the BUSY line waits.
+         *
+         * @param[in] kTimeout The timeout in milliseconds.
+         */
+        void SetBusyTimeout(const uint32_t kTimeout);
+
+        /**
+         * @brief Composes regions and sends the frame to the screen.
+         *
+         * @details Composes regions and sends the frame to the screen. Each
+         * line of the frame is built in a line buffer from the regions that
+         * cover it and sent in one burst. Regions are drawn in order, a region
+         * covers the previous ones. Pixels not covered by any region are set
+         * to the background color. The frame is displayed on the next
+         * refresh, see BeginRefresh.
+         *
+         * @param[in] pkRegions The regions to compose.
+         * @param[in] kRegionCount The number of regions.
+         * @param[in] kBackground The background color.
+         *
+         * @return true is returned on success, false if a region reader
+         * failed. In that case the frame is incomplete and shall not be
+         * displayed.
          */
-        void DisplayEndTrans(void);
+        bool Blit(const SEInkBlitRegion* pkRegions,
+                  const uint32_t         kRegionCount,
+                  const uint8_t          kBackground);
 
         /**
          * @brief Sends the part image buffer in RAM to e-Paper and displays.
@@ -181,8 +313,10 @@ class WaveshareDriver
          * @param[in] yStart The y position to start to send.
          * @param[in] imageWidth The width to send.
          * @param[in] imageHeigh The height to send.
+         *
+         * @return true is returned on success, false if the panel timed out.
          */
-        void DisplayPart(const uint8_t* pImage,
+        bool DisplayPart(const uint8_t* pImage,
                          uint32_t       xStart,
                          uint32_t       yStart,
                          uint32_t       imageWidth,
@@ -202,12 +336,38 @@ class WaveshareDriver
          */
         void SendData(const uint8_t kData);
 
+        /**
+         * @brief Sends a burst of data to the screen.
+         *
+         * @details The DC and CS lines are set once for the whole burst and
+         * the buffer is clocked out in bulk by the SPI controller. The
+         * resulting byte stream is identical to calling SendData for each
+         * byte of the buffer.
+         *
+         * @param[in] pkBuffer The buffer that contains the data to send.
+         * @param[in] kSize The size of the buffer.
+         */
+        void SendDataBurst(const uint8_t* pkBuffer, const uint32_t kSize);
+
+        /**
+         * @brief Sends the same data byte multiple times to the screen.
+         *
+         * @details The DC and CS lines are set once for the whole burst and
+         * the value is clocked out in bulk by the SPI controller.
+         *
+         * @param[in] kData The data byte to send.
+         * @param[in] kCount The number of times the byte is sent.
+         */
+        void SendDataFill(const uint8_t kData, const uint32_t kCount);
+
         /**
          * @brief Clear the screen with a given color.
          *
          * @param[in] kColor The color to use.
+         *
+         * @return true is returned on success, false if the panel timed out.
          */
-        void Clear(const uint8_t kColor);
+        bool Clear(const uint8_t kColor);
 
         /**
          * @brief Puts the screen to sleep.
@@ -227,7 +387,72 @@ class WaveshareDriver
 
     /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
     private:
-        /* None */
+        /**
+         * @brief Sends the resolution setting and starts a frame transfer.
+         */
+        void StartFrame(void);
+
+        /**
+         * @brief Ends the frame transfer, refreshes the screen and waits for
+         * the refresh to complete.
+         *
+         * @return true is returned on success, false if the panel timed out.
+         */
+        bool EndFrame(void);
+
+        /**
+         * @brief Waits for the BUSY line to reach a level.
+         *
+         * @details Waits for the BUSY line to reach a level. The wait is
+         * performed on the BUSY line edge interrupt, the CPU is released
+         * during the wait.
+         *
+         * @param[in] kLevel The level to wait for.
+         * @param[in] kTimeout The timeout in milliseconds.
+         *
+         * @return true is returned if the level was reached, false on timeout.
+         */
+        bool WaitBusy(const uint8_t kLevel, const uint32_t kTimeout);
+
+        /**
+         * @brief BUSY line edge interrupt handler.
+         */
+        static void BusyIsr(void);
+
+        /** @brief Released by the BUSY line edge interrupt. */
+        static SemaphoreHandle_t BUSY_LOCK_;
+
+        /** @brief Timeout in milliseconds of the BUSY line waits. */
+        uint32_t busyTimeout_;
+        /** @brief Tells if a refresh is in progress. */
+        bool     refreshing_;
+        /** @brief Buffer used to compose the lines of a blit. */
+        uint8_t  pLineBuffer_[EPD_WIDTH / 2];
+
+#if EINK_SPI_CAPTURE
+        /**
+         * @brief Feeds the SPI capture with a buffer sent on the bus.
+         *
+         * @param[in] kIsData Tells if the DC line was high (data) or low
+         * (command).
+         * @param[in] pkBuffer The buffer that was sent.
+         * @param[in] kSize The size of the buffer.
+         */
+        void CaptureBytes(const bool     kIsData,
+                          const uint8_t* pkBuffer,
+                          const uint32_t kSize);
+
+        /** @brief CRC of the command / data stream of the current frame. */
+        uint32_t captureCrc_;
+        /** @brief Number of command bytes sent in the current frame. */
+        uint32_t captureCommandBytes_;
+        /** @brief Number of data bytes sent in the current frame. */
+        uint32_t captureDataBytes_;
+        /** @brief DC line state of the last captured byte. */
+        bool     captureLastIsData_;
+        /** @brief Frame start time in microseconds. */
+        uint64_t captureStartTime_;
+#endif
 };
 
 #endif /* #ifndef __BSP_WAVESHAREEINK_H_ */
\ No newline at end of file
@@ -0,0 +1,269 @@
+/*******************************************************************************
+ * @file ContentCache.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file defines the bounded content cache.
+ *
+ * @details This file defines the bounded content cache. The cache keeps the
+ * content of the most recently used keys in a fixed pool of blocks, its memory
+ * is allocated once with the cache and never grows. The least recently used
+ * entry that is not pinned is evicted when the pool is full.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __COMMON_CONTENT_CACHE_H_
+#define __COMMON_CONTENT_CACHE_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <string>  /* std::string */
+#include <cstdint> /* Standard Int Types */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Number of entries of the cache. */
+#define CONTENT_CACHE_ENTRY_COUNT 16
+/** @brief Maximal key size, including the null terminator. */
+#define CONTENT_CACHE_KEY_SIZE 48
+/** @brief Size of a content block. */
+#define CONTENT_CACHE_BLOCK_SIZE 32
+/** @brief Number of content blocks, the cache byte budget is the pool size. */
+#define CONTENT_CACHE_BLOCK_COUNT 64
+/** @brief Invalid entry or block index. */
+#define CONTENT_CACHE_NONE 0xFF
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/** @brief Defines a cache entry. */
+typedef struct
+{
+    /** @brief Entry key, null terminated. */
+    char     pKey[CONTENT_CACHE_KEY_SIZE];
+    /** @brief Content size in bytes. */
+    uint16_t size;
+    /** @brief First content block, CONTENT_CACHE_NONE when empty. */
+    uint8_t  firstBlock;
+    /** @brief Previous entry in the LRU list, towards the most recent. */
+    uint8_t  prev;
+    /** @brief Next entry in the LRU list, towards the least recent. */
+    uint8_t  next;
+    /** @brief Tells if the entry is used. */
+    bool     used;
+    /** @brief Tells if the entry is never evicted. */
+    bool     pinned;
+} SContentCacheEntry;
+
+/** @brief Defines the cache statistics. */
+typedef struct
+{
+    /** @brief Number of lookups that found the key. */
+    uint32_t hits;
+    /** @brief Number of lookups that did not find the key. */
+    uint32_t misses;
+    /** @brief Number of entries evicted to make room. */
+    uint32_t evictions;
+    /** @brief Number of contents that could not be cached. */
+    uint32_t rejects;
+    /** @brief Number of content bytes in the cache. */
+    uint16_t usedBytes;
+    /** @brief Byte budget of the cache. */
+    uint16_t budget;
+    /** @brief Number of used entries. */
+    uint8_t  entries;
+    /** @brief Number of pinned entries. */
+    uint8_t  pinned;
+} SContentCacheStats;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/**
+ * @brief Bounded LRU content cache.
+ *
+ * @details Bounded LRU content cache. The contents are stored in chains of
+ * fixed size blocks taken from a preallocated pool, the entries are linked
+ * from the most to the least recently used. The cache is not thread safe, its
+ * owner serializes the accesses.
+ */
+class ContentCache
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        /**
+         * @brief Construct a new Content Cache object.
+         */
+        ContentCache(void);
+
+        /**
+         * @brief Gets the content of a key.
+         *
+         * @details Gets the content of a key, the entry becomes the most
+         * recently used.
+         *
+         * @param[in] rkKey The key to look up.
+         * @param[out] rContent The buffer that receives the content.
+         *
+         * @return true is returned on hit, false on miss.
+         */
+        bool Get(const std::string& rkKey, std::string& rContent);
+
+        /**
+         * @brief Sets the content of a key.
+         *
+         * @details Sets the content of a key, the least recently used entries
+         * that are not pinned are evicted to make room. A pinned entry stays
+         * pinned. When the content cannot be cached, the key is removed from
+         * the cache.
+         *
+         * @param[in] rkKey The key to set.
+         * @param[in] rkContent The content to cache.
+         *
+         * @return true is returned if the content was cached, false otherwise.
+         */
+        bool Set(const std::string& rkKey, const std::string& rkContent);
+
+        /**
+         * @brief Removes a key from the cache.
+         *
+         * @param[in] rkKey The key to remove.
+         */
+        void Remove(const std::string& rkKey);
+
+        /**
+         * @brief Pins or unpins a key.
+         *
+         * @details Pins or unpins a key, a pinned entry is never evicted.
+         *
+         * @param[in] rkKey The key to pin.
+         * @param[in] kPinned The pinned state to set.
+         *
+         * @return true is returned on success, false if the key is not in the
+         * cache.
+         */
+        bool SetPinned(const std::string& rkKey, const bool kPinned);
+
+        /**
+         * @brief Removes all the entries, pinned entries included.
+         */
+        void Clear(void);
+
+        /**
+         * @brief Gets the cache statistics.
+         *
+         * @param[out] rStats The statistics to fill.
+         */
+        void GetStats(SContentCacheStats& rStats) const;
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+        /* None */
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        /**
+         * @brief Finds the entry of a key.
+         *
+         * @param[in] rkKey The key to find.
+         *
+         * @return The entry index is returned, CONTENT_CACHE_NONE if the key
+         * is not in the cache.
+         */
+        uint8_t Find(const std::string& rkKey) const;
+
+        /**
+         * @brief Links an entry at the head of the LRU list.
+         *
+         * @param[in] kEntry The entry to link.
+         */
+        void LinkFront(const uint8_t kEntry);
+
+        /**
+         * @brief Unlinks an entry from the LRU list.
+         *
+         * @param[in] kEntry The entry to unlink.
+         */
+        void Unlink(const uint8_t kEntry);
+
+        /**
+         * @brief Releases the content blocks of an entry.
+         *
+         * @param[in] kEntry The entry to release the blocks of.
+         */
+        void ReleaseBlocks(const uint8_t kEntry);
+
+        /**
+         * @brief Unlinks and frees an entry.
+         *
+         * @param[in] kEntry The entry to free.
+         */
+        void FreeEntry(const uint8_t kEntry);
+
+        /**
+         * @brief Evicts the least recently used entry that is not pinned.
+         *
+         * @return true is returned if an entry was evicted, false otherwise.
+         */
+        bool EvictOne(void);
+
+        /** @brief Stores the entries. */
+        SContentCacheEntry pEntries_[CONTENT_CACHE_ENTRY_COUNT];
+        /** @brief Stores the content blocks. */
+        uint8_t pBlocks_[CONTENT_CACHE_BLOCK_COUNT][CONTENT_CACHE_BLOCK_SIZE];
+        /** @brief Stores the next block of each block chain. */
+        uint8_t pNextBlock_[CONTENT_CACHE_BLOCK_COUNT];
+        /** @brief Stores the head of the free blocks chain. */
+        uint8_t freeBlock_;
+        /** @brief Stores the number of free blocks. */
+        uint8_t freeBlockCount_;
+        /** @brief Stores the most recently used entry. */
+        uint8_t mru_;
+        /** @brief Stores the least recently used entry. */
+        uint8_t lru_;
+        /** @brief Stores the statistics. */
+        SContentCacheStats stats_;
+};
+
+#endif /* #ifndef __COMMON_CONTENT_CACHE_H_ */
@@ -0,0 +1,223 @@
+/*******************************************************************************
+ * @file ImageCodec.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file defines the compressed image codec.
+ *
+ * @details This file defines the compressed image codec. Compressed images
+ * start with a header followed by a run-length encoded stream of the raw 4bpp
+ * image bytes. Runs are encoded on bytes (pixel pairs), which match the flat
+ * color regions of the 7-color images.
+ *
+ * Stream tokens:
+ *  - 0x00 to 0x7F: literal, (token + 1) raw bytes follow.
+ *  - 0x80 to 0xFF: repeat, the 15-bit count is the token low 7 bits followed
+ *    by the next byte, the value byte follows. The value is repeated
+ *    (count + 1) times.
+ *
+ * The first magic byte has both nibbles above the last valid color, raw images
+ * can therefore never be mistaken for compressed ones.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __COMMON_IMAGE_CODEC_H_
+#define __COMMON_IMAGE_CODEC_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint> /* Standard Int Types */
+#include <cstddef> /* Standard size types */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Size of the compressed image magic. */
+#define IMAGE_CODEC_MAGIC_SIZE 4
+
+/** @brief Maximal number of bytes in a literal token. */
+#define IMAGE_CODEC_MAX_LITERAL 128
+
+/** @brief Maximal number of bytes in a repeat token. */
+#define IMAGE_CODEC_MAX_REPEAT 32768
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/**
+ * @brief Gets the maximal size of an encoded stream for a raw size.
+ *
+ * @param[in] RAW_SIZE The raw data size.
+ */
+#define IMAGE_CODEC_MAX_DATA_SIZE(RAW_SIZE) \
+    ((RAW_SIZE) + ((RAW_SIZE) + IMAGE_CODEC_MAX_LITERAL - 1) / \
+     IMAGE_CODEC_MAX_LITERAL)
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/** @brief Compressed image header. */
+typedef struct __attribute__((packed))
+{
+    /** @brief Compressed image magic. */
+    uint8_t  pMagic[IMAGE_CODEC_MAGIC_SIZE];
+    /** @brief Size of the decoded image in bytes. */
+    uint32_t rawSize;
+    /** @brief Size of the encoded stream following the header. */
+    uint32_t dataSize;
+} SImageCodecHeader;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/**
+ * @brief Streaming compressed image decoder.
+ *
+ * @details Streaming compressed image decoder. The decoder keeps its state
+ * between calls, the encoded stream can be fed in chunks of any size and the
+ * decoded data retrieved in buffers of any size.
+ */
+class ImageDecoder
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        /**
+         * @brief Construct a new Image Decoder object.
+         */
+        ImageDecoder(void);
+
+        /**
+         * @brief Tells if a header describes a compressed image.
+         *
+         * @param[in] rkHeader The header to check.
+         *
+         * @return true is returned if the header magic is the compressed image
+         * magic, false otherwise.
+         */
+        static bool IsCompressed(const SImageCodecHeader& rkHeader);
+
+        /**
+         * @brief Tells if a compressed image header is valid for an image
+         * size.
+         *
+         * @param[in] rkHeader The header to check.
+         * @param[in] kRawSize The expected decoded image size.
+         *
+         * @return true is returned if the header is valid, false otherwise.
+         */
+        static bool IsValid(const SImageCodecHeader& rkHeader,
+                            const uint32_t           kRawSize);
+
+        /**
+         * @brief Resets the decoder for a new stream.
+         *
+         * @param[in] kRawSize The size of the decoded data.
+         */
+        void Reset(const uint32_t kRawSize);
+
+        /**
+         * @brief Decodes part of the stream.
+         *
+         * @details Decodes part of the stream. Decoding stops when the input is
+         * consumed, the output buffer is full or the image is fully decoded.
+         *
+         * @param[in] pkInput The encoded data.
+         * @param[in] kInputSize The size of the encoded data.
+         * @param[out] rConsumed The number of input bytes consumed.
+         * @param[out] pOutput The buffer that receives the decoded data.
+         * @param[in] kOutputSize The size of the output buffer.
+         *
+         * @return The number of decoded bytes written in the output buffer is
+         * returned.
+         */
+        size_t Decode(const uint8_t* pkInput,
+                      const size_t   kInputSize,
+                      size_t&        rConsumed,
+                      uint8_t*       pOutput,
+                      const size_t   kOutputSize);
+
+        /**
+         * @brief Tells if the image was fully decoded.
+         *
+         * @return true is returned if the image was fully decoded, false
+         * otherwise.
+         */
+        bool IsDone(void) const;
+
+        /**
+         * @brief Tells if the stream was corrupted.
+         *
+         * @return true is returned if the stream was corrupted, false
+         * otherwise.
+         */
+        bool HasError(void) const;
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+        /* None */
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        /** @brief Defines the decoder states. */
+        typedef enum
+        {
+            /** @brief Waiting for a token. */
+            DECODE_TOKEN        = 0,
+            /** @brief Waiting for the repeat count low byte. */
+            DECODE_REPEAT_COUNT = 1,
+            /** @brief Waiting for the repeat value. */
+            DECODE_REPEAT_VALUE = 2,
+            /** @brief Outputing a repeat run. */
+            DECODE_REPEAT       = 3,
+            /** @brief Copying a literal run. */
+            DECODE_LITERAL      = 4
+        } EDecodeState;
+
+        /** @brief Current decoder state. */
+        EDecodeState state_;
+        /** @brief Number of bytes left in the current run. */
+        uint32_t     runLeft_;
+        /** @brief Value of the current repeat run. */
+        uint8_t      runValue_;
+        /** @brief Number of decoded bytes left to produce. */
+        uint32_t     rawLeft_;
+        /** @brief Tells if the stream was corrupted. */
+        bool         error_;
+};
+
+#endif /* #ifndef __COMMON_IMAGE_CODEC_H_ */
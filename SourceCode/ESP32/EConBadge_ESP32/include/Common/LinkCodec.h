@@ -0,0 +1,258 @@
+/*******************************************************************************
+ * @file LinkCodec.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file defines the link compression codec.
+ *
+ * @details This file defines the link compression codec used on the BLE data
+ * channel. The codec is a small window LZ77 working on blocks of at most
+ * LINK_CODEC_BLOCK bytes, matches can reference the previous blocks up to
+ * LINK_CODEC_WINDOW bytes back. Each block ends on a sequence boundary, a
+ * stream can therefore be cut after any block.
+ *
+ * Stream sequences:
+ *  - Token: the high nibble is the literal count, the low nibble is the match
+ *    code.
+ *  - Literal count 15: extension bytes follow and are added to the count, a
+ *    255 byte is followed by another extension byte.
+ *  - Literal count bytes follow.
+ *  - Match code 0: the sequence has no match.
+ *  - Match code 1 to 15: the 16-bit little-endian match offset follows. The
+ *    match length is (code + LINK_CODEC_MIN_MATCH - 1), code 15 is followed by
+ *    extension bytes as for the literal count.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __COMMON_LINK_CODEC_H_
+#define __COMMON_LINK_CODEC_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint> /* Standard Int Types */
+#include <cstddef> /* Standard size types */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Size of the match window in bytes, must be a power of two. */
+#define LINK_CODEC_WINDOW 1024
+
+/** @brief Maximal number of bytes encoded at once. */
+#define LINK_CODEC_BLOCK 1024
+
+/** @brief Minimal match length. */
+#define LINK_CODEC_MIN_MATCH 3
+
+/** @brief Number of bits of the match finder hash. */
+#define LINK_CODEC_HASH_BITS 10
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/**
+ * @brief Gets the maximal size of an encoded block for a raw size.
+ *
+ * @param[in] RAW_SIZE The raw data size.
+ */
+#define LINK_CODEC_MAX_ENCODED_SIZE(RAW_SIZE) \
+    ((RAW_SIZE) + (RAW_SIZE) / 255 + 16)
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/**
+ * @brief Streaming link encoder.
+ *
+ * @details Streaming link encoder. The encoder keeps the last window of data
+ * between calls, the stream is encoded block by block without staging the
+ * whole payload.
+ */
+class LinkEncoder
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        /**
+         * @brief Construct a new Link Encoder object.
+         */
+        LinkEncoder(void);
+
+        /**
+         * @brief Resets the encoder for a new stream.
+         */
+        void Reset(void);
+
+        /**
+         * @brief Encodes a block of the stream.
+         *
+         * @param[in] pkInput The raw data.
+         * @param[in] kInputSize The size of the raw data, at most
+         * LINK_CODEC_BLOCK.
+         * @param[out] pOutput The buffer that receives the encoded data, at
+         * least LINK_CODEC_MAX_ENCODED_SIZE(kInputSize) bytes.
+         *
+         * @return The number of encoded bytes written in the output buffer is
+         * returned.
+         */
+        size_t Encode(const uint8_t* pkInput,
+                      const size_t   kInputSize,
+                      uint8_t*       pOutput);
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+        /* None */
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        /** @brief History followed by the block being encoded. */
+        uint8_t  pBuffer_[LINK_CODEC_WINDOW + LINK_CODEC_BLOCK];
+        /** @brief Last position + 1 of each hash in the buffer, 0 if none. */
+        uint16_t pHead_[1 << LINK_CODEC_HASH_BITS];
+        /** @brief Size of the history in the buffer. */
+        size_t   historySize_;
+};
+
+/**
+ * @brief Streaming link decoder.
+ *
+ * @details Streaming link decoder. The decoder keeps its state between calls,
+ * the encoded stream can be fed in chunks of any size and the decoded data
+ * retrieved in buffers of any size.
+ */
+class LinkDecoder
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        /**
+         * @brief Construct a new Link Decoder object.
+         */
+        LinkDecoder(void);
+
+        /**
+         * @brief Resets the decoder for a new stream.
+         */
+        void Reset(void);
+
+        /**
+         * @brief Decodes part of the stream.
+         *
+         * @details Decodes part of the stream. Decoding stops when the input is
+         * consumed or the output buffer is full.
+         *
+         * @param[in] pkInput The encoded data.
+         * @param[in] kInputSize The size of the encoded data.
+         * @param[out] rConsumed The number of input bytes consumed.
+         * @param[out] pOutput The buffer that receives the decoded data.
+         * @param[in] kOutputSize The size of the output buffer.
+         *
+         * @return The number of decoded bytes written in the output buffer is
+         * returned.
+         */
+        size_t Decode(const uint8_t* pkInput,
+                      const size_t   kInputSize,
+                      size_t&        rConsumed,
+                      uint8_t*       pOutput,
+                      const size_t   kOutputSize);
+
+        /**
+         * @brief Tells if the stream was corrupted.
+         *
+         * @return true is returned if the stream was corrupted, false
+         * otherwise.
+         */
+        bool HasError(void) const;
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+        /* None */
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        /** @brief Defines the decoder states. */
+        typedef enum
+        {
+            /** @brief Waiting for a token. */
+            DECODE_TOKEN          = 0,
+            /** @brief Waiting for a literal count extension byte. */
+            DECODE_LITERAL_LENGTH = 1,
+            /** @brief Copying the literals. */
+            DECODE_LITERAL        = 2,
+            /** @brief Waiting for the match offset low byte. */
+            DECODE_OFFSET_LOW     = 3,
+            /** @brief Waiting for the match offset high byte. */
+            DECODE_OFFSET_HIGH    = 4,
+            /** @brief Waiting for a match length extension byte. */
+            DECODE_MATCH_LENGTH   = 5,
+            /** @brief Outputing a match. */
+            DECODE_MATCH          = 6
+        } EDecodeState;
+
+        /**
+         * @brief Adds decoded data to the window.
+         *
+         * @param[in] pkData The decoded data.
+         * @param[in] kSize The size of the decoded data.
+         */
+        void AddToWindow(const uint8_t* pkData, const size_t kSize);
+
+        /** @brief Current decoder state. */
+        EDecodeState state_;
+        /** @brief Number of literals left in the current sequence. */
+        uint32_t     literalLeft_;
+        /** @brief Match code of the current sequence. */
+        uint8_t      matchCode_;
+        /** @brief Offset of the current match. */
+        uint16_t     offset_;
+        /** @brief Number of bytes left in the current match. */
+        uint32_t     matchLeft_;
+        /** @brief Window of the last decoded bytes. */
+        uint8_t      pWindow_[LINK_CODEC_WINDOW];
+        /** @brief Next write position in the window. */
+        size_t       windowPos_;
+        /** @brief Number of valid bytes in the window. */
+        size_t       windowFill_;
+        /** @brief Tells if the stream was corrupted. */
+        bool         error_;
+};
+
+#endif /* #ifndef __COMMON_LINK_CODEC_H_ */
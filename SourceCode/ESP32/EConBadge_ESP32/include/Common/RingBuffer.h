@@ -0,0 +1,201 @@
+/*******************************************************************************
+ * @file RingBuffer.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file defines the single producer single consumer ring buffer.
+ *
+ * @details This file defines the single producer single consumer ring buffer.
+ * The producer and the consumer can run concurrently on different tasks
+ * without lock, the producer never blocks. Data that does not fit in the ring
+ * is dropped and accounted.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __COMMON_RING_BUFFER_H_
+#define __COMMON_RING_BUFFER_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <atomic>  /* std::atomic */
+#include <cstdint> /* Standard Int Types */
+#include <cstddef> /* Standard size types */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/**
+ * @brief Single producer single consumer byte ring buffer.
+ *
+ * @details Single producer single consumer byte ring buffer. Push is only
+ * called by the producer, Peek and Consume are only called by the consumer.
+ * The consumer reads runs of contiguous bytes directly from the ring.
+ */
+class RingBuffer
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        /**
+         * @brief Construct a new Ring Buffer object.
+         *
+         * @param[in] kSize The size of the ring in bytes, must be a power of
+         * two.
+         */
+        explicit RingBuffer(const size_t kSize);
+
+        /**
+         * @brief Destroy the Ring Buffer object.
+         */
+        ~RingBuffer(void);
+
+        /**
+         * @brief Pushes data in the ring.
+         *
+         * @details Pushes data in the ring. The data is pushed entirely or not
+         * at all. When the data does not fit, it is dropped and accounted in
+         * the overflow counters.
+         *
+         * @param[in] pkData The data to push.
+         * @param[in] kSize The size of the data.
+         *
+         * @return true is returned if the data was pushed, false otherwise.
+         */
+        bool Push(const uint8_t* pkData, const size_t kSize);
+
+        /**
+         * @brief Gets the next run of contiguous bytes to read.
+         *
+         * @param[out] rpkData The pointer that receives the run start.
+         *
+         * @return The size of the run is returned, 0 if the ring is empty.
+         */
+        size_t Peek(const uint8_t*& rpkData) const;
+
+        /**
+         * @brief Releases bytes read from the ring.
+         *
+         * @param[in] kSize The number of bytes to release, at most the size of
+         * the last run returned by Peek.
+         */
+        void Consume(const size_t kSize);
+
+        /**
+         * @brief Gets the number of bytes in the ring.
+         *
+         * @return The number of bytes in the ring is returned.
+         */
+        size_t GetUsed(void) const;
+
+        /**
+         * @brief Gets the number of free bytes in the ring.
+         *
+         * @details Gets the number of free bytes in the ring. The value can
+         * only grow until the next Push, the producer can use it to check
+         * that data fits without accounting an overflow.
+         *
+         * @return The number of free bytes in the ring is returned.
+         */
+        size_t GetFree(void) const;
+
+        /**
+         * @brief Gets the size of the ring.
+         *
+         * @return The size of the ring is returned.
+         */
+        size_t GetSize(void) const;
+
+        /**
+         * @brief Gets the number of pushes dropped because the ring was full.
+         *
+         * @return The number of dropped pushes is returned.
+         */
+        uint32_t GetOverflowCount(void) const;
+
+        /**
+         * @brief Gets the number of bytes dropped because the ring was full.
+         *
+         * @return The number of dropped bytes is returned.
+         */
+        uint32_t GetDroppedBytes(void) const;
+
+        /**
+         * @brief Gets the maximal number of bytes that were in the ring.
+         *
+         * @return The maximal number of bytes that were in the ring is
+         * returned.
+         */
+        size_t GetHighWatermark(void) const;
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+        /* None */
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        /** @brief The ring storage. */
+        uint8_t*              pBuffer_;
+        /** @brief The ring size, a power of two. */
+        size_t                size_;
+        /** @brief Total number of bytes pushed, written by the producer. */
+        std::atomic<size_t>   head_;
+        /** @brief Total number of bytes consumed, written by the consumer. */
+        std::atomic<size_t>   tail_;
+        /** @brief Number of dropped pushes, written by the producer. */
+        std::atomic<uint32_t> overflowCount_;
+        /** @brief Number of dropped bytes, written by the producer. */
+        std::atomic<uint32_t> droppedBytes_;
+        /** @brief Maximal number of bytes in the ring. */
+        size_t                highWatermark_;
+};
+
+#endif /* #ifndef __COMMON_RING_BUFFER_H_ */
@@ -40,6 +40,18 @@
 /** @brief Size of the communication token */
 #define COMM_TOKEN_SIZE 16
 
+/** @brief Maximal number of sub-commands in a batch, one status each. */
+#define BATCH_MAX_COMMANDS COMMAND_RESPONSE_LENGTH
+/** @brief Batch flag: skip the remaining sub-commands after a failure. */
+#define BATCH_FLAG_STOP_ON_ERROR 0x01
+
+/** @brief Maximal number of entries in an image list page. */
+#define IMAGE_PAGE_MAX_ENTRIES 64
+/** @brief Image page flag: send a binary record per entry. */
+#define IMAGE_PAGE_FLAG_RECORDS 0x01
+
+#define CONFIG_JOURNAL_FILE_PATH   "/config"
+
 #define OWNER_FILE_PATH            "/owner"
 #define CONTACT_FILE_PATH          "/contact"
 #define BLUETOOTH_TOKEN_FILE_PATH  "/bttoken"
@@ -55,7 +67,9 @@
 #define LEDBORDER_PATTERN_TMP_FILE     TMP_DIR_PATH "/tmp_pattern"
 #define LEDBORDER_ANIM_TMP_FILE        TMP_DIR_PATH "/tmp_anim"
 
-#define IMAGE_DIR_PATH "/images"
+#define IMAGE_DIR_PATH          "/images"
+#define IMAGE_TMP_FILE_PATH     TMP_DIR_PATH "/tmp_image"
+#define IMAGE_CATALOG_FILE_PATH "/imgcat"
 
 /*******************************************************************************
  * MACROS
@@ -289,7 +303,16 @@ typedef enum
    CMD_LEDBORDER_CLEAR_ANIMATIONS = 28,
    CMD_LEDBORDER_GET_ANIMATIONS   = 29,
 
-   MAX_COMMAND_TYPE               = 30,
+   CMD_GET_LINK_INFO              = 30,
+   CMD_RESUME_TRANSFER            = 31,
+
+   CMD_BATCH                      = 32,
+   CMD_GET_PIPELINE_INFO          = 33,
+   CMD_GET_BLE_STATS              = 34,
+   CMD_SET_LINK_COMPRESSION       = 35,
+   CMD_EINK_GET_IMAGE_PAGE        = 36,
+
+   MAX_COMMAND_TYPE               = 37,
 } ECommandType;
 
 /** @brief Defines the command header */
@@ -334,6 +357,74 @@ typedef struct __attribute__((packed))
     uint8_t pResponse[COMMAND_RESPONSE_LENGTH];
 } SCommandResponse;
 
+/** @brief Defines the batch request parameters, sent in the command data. */
+typedef struct __attribute__((packed))
+{
+    /** @brief Size of the sub-commands stream sent on the data channel */
+    uint16_t size;
+
+    /** @brief Number of sub-commands in the stream */
+    uint8_t count;
+
+    /** @brief Batch flags, see BATCH_FLAG_* */
+    uint8_t flags;
+} SBatchHeader;
+
+/** @brief Defines the header of a sub-command in the batch stream. */
+typedef struct __attribute__((packed))
+{
+    /** @brief Sub-command type */
+    uint8_t type;
+
+    /** @brief Sub-command data size, followed by the data */
+    uint8_t size;
+} SBatchCommandHeader;
+
+/** @brief Defines the image page request, sent in the command data. */
+typedef struct __attribute__((packed))
+{
+    /**
+     * @brief Cursor of the page, 0 for the first page. A cursor returned
+     * before an image was added or removed is rejected with INVALID_PARAM.
+     */
+    uint32_t cursor;
+
+    /** @brief Maximal number of entries, up to IMAGE_PAGE_MAX_ENTRIES */
+    uint16_t count;
+
+    /** @brief Page flags, see IMAGE_PAGE_FLAG_* */
+    uint8_t flags;
+} SImagePageRequest;
+
+/** @brief Defines the image page header, sent in the command ack. */
+typedef struct __attribute__((packed))
+{
+    /** @brief Cursor of the next page, 0xFFFFFFFF after the last page */
+    uint32_t nextCursor;
+
+    /** @brief Number of entries in the page */
+    uint16_t count;
+
+    /** @brief Size of the entries sent on the data channel */
+    uint32_t size;
+} SImagePageHeader;
+
+/** @brief Defines an image page binary record, followed by the name. */
+typedef struct __attribute__((packed))
+{
+    /** @brief Image file size in bytes */
+    uint32_t size;
+
+    /** @brief Last modification date, FAT format */
+    uint16_t modifyDate;
+
+    /** @brief Last modification time, FAT format */
+    uint16_t modifyTime;
+
+    /** @brief Name length, the name is not nul-terminated */
+    uint8_t nameLength;
+} SImageRecord;
+
 /*******************************************************************************
  * GLOBAL VARIABLES
  ******************************************************************************/
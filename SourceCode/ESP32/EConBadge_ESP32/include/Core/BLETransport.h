@@ -0,0 +1,262 @@
+/*******************************************************************************
+ * @file BLETransport.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file defines the BLE transport interface.
+ *
+ * @details This file defines the BLE transport interface. The transport
+ * carries the frames of the command, data and bulk channels between the
+ * bluetooth manager and the client. The bluetooth manager implements the
+ * protocol on top of any transport: the NimBLE one on the badge, a loopback one
+ * to exercise the protocol without a radio.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __CORE_BLE_TRANSPORT_H_
+#define __CORE_BLE_TRANSPORT_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstdint> /* Standard Int Types */
+#include <cstddef> /* Standard size types */
+#include <Types.h> /* Defined types */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief ATT MTU before the exchange with the central. */
+#define BLE_DEFAULT_MTU 23
+/** @brief ATT MTU requested to the central. */
+#define BLE_PREFERRED_MTU 517
+/** @brief Size of the ATT notification and write headers. */
+#define BLE_ATT_HEADER_SIZE 3
+
+/** @brief Defines the message length, the payload of the preferred MTU. */
+#define BLE_MESSAGE_MTU (BLE_PREFERRED_MTU - BLE_ATT_HEADER_SIZE)
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/**
+ * @brief Gets the data segment size for an ATT MTU.
+ *
+ * @param[in] MTU The ATT MTU.
+ */
+#define BLE_SEGMENT_SIZE(MTU) MIN((MTU) - BLE_ATT_HEADER_SIZE, BLE_MESSAGE_MTU)
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/** @brief Defines the transport channels. */
+typedef enum
+{
+    /** @brief Command requests and responses. */
+    TRANSPORT_CHANNEL_COMMAND = 0,
+    /** @brief Data transfers. */
+    TRANSPORT_CHANNEL_DATA    = 1,
+    /** @brief Bulk upload frames and acknowledges. */
+    TRANSPORT_CHANNEL_BULK    = 2,
+    /** @brief Number of channels. */
+    TRANSPORT_CHANNEL_COUNT   = 3,
+} ETransportChannel;
+
+/** @brief Defines the transport send statuses. */
+typedef enum
+{
+    /** @brief The frame was accepted by the transport. */
+    TRANSPORT_OK        = 0,
+    /** @brief The transport has no room, the frame can be sent again. */
+    TRANSPORT_CONGESTED = 1,
+    /** @brief The frame cannot be sent. */
+    TRANSPORT_FAILED    = 2,
+} ETransportStatus;
+
+/**
+ * @brief Defines the link information sent to the client.
+ *
+ * @details Defines the link information sent to the client. The values are the
+ * ones granted by the central, the throughputs are measured on the data
+ * transfers since the connection.
+ */
+typedef struct __attribute__((packed))
+{
+    /** @brief Negotiated ATT MTU. */
+    uint16_t mtu;
+    /** @brief Size of the data segments sent and received. */
+    uint16_t segmentSize;
+    /** @brief Requested LE data length TX octets. */
+    uint16_t dataLength;
+    /** @brief TX PHY, 1: 1M, 2: 2M, 3: Coded. */
+    uint8_t  txPhy;
+    /** @brief RX PHY, 1: 1M, 2: 2M, 3: Coded. */
+    uint8_t  rxPhy;
+    /** @brief Connection interval in 1.25ms units. */
+    uint16_t connInterval;
+    /** @brief Connection latency in intervals. */
+    uint16_t connLatency;
+    /** @brief Supervision timeout in 10ms units. */
+    uint16_t supervisionTimeout;
+    /** @brief Measured receive throughput in bytes per second. */
+    uint32_t rxThroughput;
+    /** @brief Measured send throughput in bytes per second. */
+    uint32_t txThroughput;
+} SBLELinkInfo;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/**
+ * @brief Transport handler interface.
+ *
+ * @details The transport handler interface receives the link events and the
+ * frames written by the client. The handler is called from the transport
+ * context and shall not block.
+ */
+class TransportHandler
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        /**
+         * @brief Destroy the Transport Handler object
+         */
+        virtual ~TransportHandler(void){}
+
+        /**
+         * @brief Called when a client connects.
+         *
+         * @param[in] rkInfo The link information granted at connection.
+         */
+        virtual void OnConnect(const SBLELinkInfo& rkInfo) = 0;
+
+        /**
+         * @brief Called when the link parameters are updated.
+         *
+         * @param[in] rkInfo The updated link information.
+         */
+        virtual void OnLinkUpdate(const SBLELinkInfo& rkInfo) = 0;
+
+        /**
+         * @brief Called when the client disconnects.
+         */
+        virtual void OnDisconnect(void) = 0;
+
+        /**
+         * @brief Called when the client writes a frame.
+         *
+         * @param[in] kChannel The channel the frame was written on.
+         * @param[in] pkData The frame data.
+         * @param[in] kSize The frame size.
+         */
+        virtual void OnReceive(const ETransportChannel kChannel,
+                               const uint8_t*          pkData,
+                               const size_t            kSize) = 0;
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+        /* None */
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        /* None */
+};
+
+/**
+ * @brief BLE transport interface.
+ *
+ * @details The BLE transport interface sends the frames of the channels to the
+ * client. Frames are notified in order on each channel.
+ */
+class BLETransport
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        /**
+         * @brief Destroy the BLE Transport object
+         */
+        virtual ~BLETransport(void){}
+
+        /**
+         * @brief Starts the transport.
+         *
+         * @details Starts the transport, the handler receives the link events
+         * and frames from this call.
+         *
+         * @param[in] pHandler The transport handler.
+         *
+         * @return true is returned on success, false otherwise.
+         */
+        virtual bool Start(TransportHandler* pHandler) = 0;
+
+        /**
+         * @brief Tells if a client is connected.
+         *
+         * @return true is returned if a client is connected, false otherwise.
+         */
+        virtual bool IsConnected(void) const = 0;
+
+        /**
+         * @brief Sends a frame to the client.
+         *
+         * @param[in] kChannel The channel to send the frame on.
+         * @param[in] pkData The frame data.
+         * @param[in] kSize The frame size.
+         *
+         * @return The send status is returned.
+         */
+        virtual ETransportStatus Send(const ETransportChannel kChannel,
+                                      const uint8_t*          pkData,
+                                      const size_t            kSize) = 0;
+
+        /**
+         * @brief Gets the transport specific status of the last send.
+         *
+         * @return The status code of the last send is returned, 0 on success.
+         */
+        virtual int GetLastStatus(void) const = 0;
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+        /* None */
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        /* None */
+};
+
+#endif /* #ifndef __CORE_BLE_TRANSPORT_H_ */
@@ -23,15 +23,29 @@
  ******************************************************************************/
 #include <string>         /* std::string */
 #include <Types.h>        /* Custom defined types */
-#include <Storage.h>      /* Storage service */
-#include <NimBLEDevice.h> /* BLE Services */
+#include <ConfigStore.h>  /* Configuration store */
+#include <LinkCodec.h>    /* Link compression */
+#include <RingBuffer.h>   /* Receive ring buffer */
+#include <BLETransport.h> /* BLE transport interface */
 
 /*******************************************************************************
  * CONSTANTS
  ******************************************************************************/
 
-/** @brief Defines the message length. */
-#define BLE_MESSAGE_MTU 503
+/** @brief Size of the data receive ring in bytes, must be a power of two. */
+#define BLE_RECEIVE_RING_SIZE 8192
+
+/** @brief Number of frames in the bulk upload reorder window, at most 32. */
+#define BLE_BULK_WINDOW 16
+/** @brief Number of delivered bulk frames between two acknowledges. */
+#define BLE_BULK_ACK_INTERVAL 8
+/** @brief Bulk frame flag, the sender requests an acknowledge. */
+#define BLE_BULK_FLAG_ACK_REQ 0x01
+/** @brief Bulk acknowledge flag, the frames not received were dropped. */
+#define BLE_BULK_ACK_FLAG_RESUME 0x01
+
+/** @brief Number of buckets of the command response latency histogram. */
+#define BLE_LATENCY_BUCKETS 12
 
 /*******************************************************************************
  * MACROS
@@ -43,25 +57,244 @@
  * STRUCTURES AND TYPES
  ******************************************************************************/
 
-/** @brief Define a data buffer for BLE communication. */
+/** @brief Define the data receive buffer for BLE communication. */
 typedef struct
 {
-    /** @brief Buffer reader lock. */
-    SemaphoreHandle_t rlock;
+    /** @brief Ring filled by the transport only, drained by the receiver. */
+    RingBuffer*       pRing;
+    /** @brief Signaled each time data is pushed in the ring. */
+    SemaphoreHandle_t dataSignal;
+    /** @brief Ring overflow count already reported to the receiver. */
+    uint32_t          reportedOverflows;
+} SBLEReceiveBuffer;
+
+/** @brief Defines the data channel compression modes. */
+typedef enum
+{
+    /** @brief Raw data. */
+    BLE_COMPRESSION_NONE = 0,
+    /** @brief Link codec stream, see LinkCodec.h. */
+    BLE_COMPRESSION_LZ   = 1,
+} EBLECompression;
+
+/** @brief Defines the statistics pages sent to the client. */
+typedef enum
+{
+    /** @brief Data transfer statistics since the connection. */
+    BLE_STATS_CONNECTION = 0,
+    /** @brief Data transfer statistics of the current or last transfer. */
+    BLE_STATS_TRANSFER   = 1,
+    /** @brief Command response statistics since the connection. */
+    BLE_STATS_RESPONSES  = 2,
+} EBLEStatsPage;
+
+/** @brief Defines the data transfer statistics sent to the client. */
+typedef struct __attribute__((packed))
+{
+    /** @brief Bytes sent. */
+    uint32_t txBytes;
+    /** @brief Bytes received. */
+    uint32_t rxBytes;
+    /** @brief Achieved send throughput in bytes per second. */
+    uint32_t txThroughput;
+    /** @brief Achieved receive throughput in bytes per second. */
+    uint32_t rxThroughput;
+    /** @brief Time blocked on the notification statuses in milliseconds. */
+    uint32_t txBlockedTime;
+    /** @brief Time blocked waiting for data in milliseconds. */
+    uint32_t rxBlockedTime;
+    /** @brief Number of data notifications retried. */
+    uint32_t notifyRetries;
+    /** @brief Number of data notifications with an error status. */
+    uint32_t statusErrors;
+    /** @brief Last error status code. */
+    int32_t  lastStatusError;
+    /** @brief Duration covered by the statistics in milliseconds. */
+    uint32_t duration;
+} SBLETransferStats;
 
-    /** @brief Buffer writer lock. */
-    SemaphoreHandle_t wlock;
+/**
+ * @brief Defines the command response statistics sent to the client.
+ *
+ * @details Defines the command response statistics sent to the client. Bucket
+ * 0 counts the responses sent in less than 1024us, bucket i the ones sent in
+ * [2^(9 + i), 2^(10 + i))us. The last bucket counts all the slower responses.
+ */
+typedef struct __attribute__((packed))
+{
+    /** @brief Latency histogram. */
+    uint32_t pBuckets[BLE_LATENCY_BUCKETS];
+    /** @brief Mean latency in microseconds. */
+    uint32_t meanLatency;
+    /** @brief Maximal latency in microseconds. */
+    uint32_t maxLatency;
+    /** @brief Number of response notifications retried. */
+    uint16_t notifyRetries;
+    /** @brief Number of response notifications with an error status. */
+    uint16_t statusErrors;
+} SBLEResponseStats;
+
+/** @brief Defines the data transfer counters. */
+typedef struct
+{
+    /** @brief Bytes sent. */
+    uint64_t txBytes;
+    /** @brief Time spent sending in microseconds. */
+    uint64_t txTime;
+    /** @brief Time blocked on the notification statuses in microseconds. */
+    uint64_t txBlockedTime;
+    /** @brief Bytes received. */
+    uint64_t rxBytes;
+    /** @brief Time spent receiving in microseconds. */
+    uint64_t rxTime;
+    /** @brief Time blocked waiting for data in microseconds. */
+    uint64_t rxBlockedTime;
+    /** @brief Number of data notifications retried. */
+    uint32_t notifyRetries;
+    /** @brief Number of data notifications with an error status. */
+    uint32_t statusErrors;
+    /** @brief Last error status code. */
+    int32_t  lastStatusError;
+    /** @brief Time at which the counting started. */
+    uint64_t startTime;
+    /** @brief Time at which the counting stopped, 0 while counting. */
+    uint64_t endTime;
+} SBLETransferCounters;
+
+/** @brief Defines the link state, updated by the BLE callbacks. */
+typedef struct
+{
+    /** @brief Link information granted by the central. */
+    SBLELinkInfo         info;
+    /** @brief Data transfer counters since the connection. */
+    SBLETransferCounters counters;
+    /** @brief Command response statistics since the connection. */
+    SBLEResponseStats    responses;
+    /** @brief Total command response latency in microseconds. */
+    uint64_t             responseTime;
+} SBLELinkState;
+
+/** @brief Defines a data frame kept until it is delivered. */
+typedef struct
+{
+    /** @brief Buffer that stores the notification. */
+    uint8_t pBuffer[BLE_MESSAGE_MTU];
+    /** @brief Size of the notification. */
+    size_t  size;
+} SBLESegment;
+
+/**
+ * @brief Defines the bulk upload frame header.
+ *
+ * @details Defines the bulk upload frame header. Bulk frames are written
+ * without response on the bulk characteristic, the payload follows the header.
+ * The CRC is the CRC32 of the session, flags, sequence and payload. A new
+ * session value restarts the sequence at 0.
+ */
+typedef struct __attribute__((packed))
+{
+    /** @brief Transfer session. */
+    uint8_t  session;
+    /** @brief Frame flags. */
+    uint8_t  flags;
+    /** @brief Frame sequence number. */
+    uint16_t sequence;
+    /** @brief Frame CRC32. */
+    uint32_t crc;
+} SBLEBulkFrameHeader;
+
+/**
+ * @brief Defines the bulk upload acknowledge.
+ *
+ * @details Defines the bulk upload acknowledge, notified on the bulk
+ * characteristic. All the frames before nextSequence were received. Bit i of
+ * the bitmap is set when frame nextSequence + i was received, the sender only
+ * retransmits the missing frames. With BLE_BULK_ACK_FLAG_RESUME, the frames
+ * of the window not in the bitmap were dropped on a full receive ring and are
+ * sent again at once.
+ */
+typedef struct __attribute__((packed))
+{
+    /** @brief Transfer session. */
+    uint8_t  session;
+    /** @brief Acknowledge flags, see BLE_BULK_ACK_FLAG_*. */
+    uint8_t  flags;
+    /** @brief Sequence of the first missing frame. */
+    uint16_t nextSequence;
+    /** @brief Bitmap of the frames received after the missing one. */
+    uint32_t bitmap;
+} SBLEBulkAck;
 
-    /** @brief Retry command */
-    bool retry;
+/**
+ * @brief Defines the bulk upload receive state.
+ *
+ * @details Defines the bulk upload receive state. The state is only updated by
+ * the transport on each frame. A frame that does not fit in the receive ring
+ * is dropped and the acknowledges stop, the sender window holds back the
+ * upload. The receiver sends the stall acknowledge once it drained the ring.
+ */
+typedef struct
+{
+    /** @brief Tells if a session was started. */
+    bool              started;
+    /** @brief Current transfer session. */
+    uint8_t           session;
+    /** @brief Sequence of the next frame to deliver. */
+    uint16_t          nextSequence;
+    /** @brief Held frames, bit i is frame nextSequence + i. */
+    uint32_t          held;
+    /** @brief Number of frames delivered since the last acknowledge. */
+    uint32_t          unacked;
+    /** @brief Tells if frames were dropped on a full receive ring. */
+    bool              stalled;
+    /** @brief Acknowledge of the stall, sent by the receiver. */
+    QueueHandle_t     stallAck;
+    /** @brief Frames received ahead of a missing one. */
+    SBLESegment       pSlots[BLE_BULK_WINDOW];
+    /** @brief Number of frames dropped on CRC mismatch. */
+    uint32_t          corruptFrames;
+    /** @brief Number of frames dropped out of window or on full ring. */
+    uint32_t          droppedFrames;
+    /** @brief Number of frames received more than once. */
+    uint32_t          duplicateFrames;
+} SBLEBulkReceive;
+
+/** @brief Defines the transmit priorities, lower values are sent first. */
+typedef enum
+{
+    /** @brief Command responses. */
+    BLE_TX_CONTROL        = 0,
+    /** @brief Data channel notifications. */
+    BLE_TX_BULK           = 1,
+    /** @brief Number of transmit priorities. */
+    BLE_TX_PRIORITY_COUNT = 2,
+} EBLETxPriority;
 
-    /** @brief Buffer that stores the message. */
-    uint8_t           pBuffer[BLE_MESSAGE_MTU];
-    /** @brief Cursor in the buffer. */
-    size_t            cursor;
-    /** @brief Size of the data in the buffer. */
-    size_t            messageSize;
-} SBLEBuffer;
+/**
+ * @brief Defines a notification submitted to the transmit scheduler.
+ *
+ * @details Defines a notification submitted to the transmit scheduler. The
+ * request lives on the stack of the submitter, which waits for its completion
+ * notification. The scheduler always completes a request, at the latest when
+ * its deadline is reached.
+ */
+typedef struct
+{
+    /** @brief Channel to notify. */
+    ETransportChannel channel;
+    /** @brief Notification data. */
+    const uint8_t*    pkBuffer;
+    /** @brief Notification size. */
+    size_t            size;
+    /** @brief Time after which the request fails, in microseconds. */
+    uint64_t          deadline;
+    /** @brief Task notified on completion. */
+    TaskHandle_t      owner;
+    /** @brief Number of congestion retries. */
+    uint32_t          retries;
+    /** @brief Tells if the notification was accepted by the transport. */
+    bool              success;
+} SBLETxRequest;
 
 /*******************************************************************************
  * GLOBAL VARIABLES
@@ -131,9 +364,10 @@ class CommandHandler
  * @brief The bluetooth manager class.
  *
  * @details The bluetooth manager class provides the functionalities used to
- * create and use a bluetooth connection.
+ * create and use a bluetooth connection. The protocol is implemented on top of
+ * a BLE transport.
  */
-class BluetoothManager
+class BluetoothManager: public TransportHandler
 {
     /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
     public:
@@ -148,12 +382,13 @@ class BluetoothManager
          * @brief Initialize the BLE manager with a command handler.
          *
          * @details Initialize the BLE manager with a command handler. This
-         * function starts the BLE services and finish the initialization
+         * function starts the transport and finish the initialization
          * started in the constructor.
          *
          * @param[in] pHandler The command handler.
+         * @param[in] pTransport The transport carrying the protocol.
          */
-        void Init(CommandHandler* pHandler);
+        void Init(CommandHandler* pHandler, BLETransport* pTransport);
 
         /**
          * @brief Set the BLE communication token.
@@ -217,6 +452,76 @@ class BluetoothManager
                          size_t         size,
                          const uint64_t kTimeout);
 
+        /**
+         * @brief Gets the link information.
+         *
+         * @details Gets the link information negotiated with the central and
+         * the measured throughputs. The information is stored in the command
+         * response.
+         *
+         * @param[out] rResponse The command response to fill.
+         */
+        void GetLinkInfo(SCommandResponse& rResponse) const;
+
+        /**
+         * @brief Sets the data channel compression of the next transfer.
+         *
+         * @details Sets the data channel compression of the next transfer, see
+         * EBLECompression. The mode applies in both directions from the first
+         * data of the next transfer until its end.
+         *
+         * @param[in] kMode The compression mode.
+         * @param[out] rResponse The command response to fill.
+         */
+        void SetCompression(const uint8_t     kMode,
+                            SCommandResponse& rResponse);
+
+        /**
+         * @brief Starts a data transfer.
+         *
+         * @details Starts a data transfer. The transfer statistics are reset
+         * and the requested compression applied on the first data sent or
+         * received after this call. A transfer without data keeps the
+         * previous statistics record and the requested compression.
+         */
+        void BeginTransfer(void);
+
+        /**
+         * @brief Ends the current data transfer.
+         *
+         * @details Ends the current data transfer, the data channel goes back
+         * to raw data.
+         */
+        void EndTransfer(void);
+
+        /**
+         * @brief Gets the data transfer statistics.
+         *
+         * @param[in] kConnection Gets the statistics since the connection when
+         * true, of the current or last transfer otherwise.
+         * @param[out] rStats The statistics to fill.
+         */
+        void GetTransferStats(const bool         kConnection,
+                              SBLETransferStats& rStats) const;
+
+        /**
+         * @brief Gets the command response statistics.
+         *
+         * @param[out] rStats The statistics to fill.
+         */
+        void GetResponseStats(SBLEResponseStats& rStats) const;
+
+        /**
+         * @brief Gets a statistics page.
+         *
+         * @details Gets a statistics page, see EBLEStatsPage. The page is
+         * stored in the command response.
+         *
+         * @param[in] kPage The page to get.
+         * @param[out] rResponse The command response to fill.
+         */
+        void GetStats(const uint8_t kPage, SCommandResponse& rResponse) const;
+
         /**
          * @brief Executes a command received by the BLE callbacks.
          *
@@ -229,6 +534,36 @@ class BluetoothManager
         void ExecuteCommand(const uint8_t* kpCommandData,
                             const size_t   kCommandLength);
 
+        /**
+         * @brief Called by the transport when a client connects.
+         *
+         * @param[in] rkInfo The link information granted at connection.
+         */
+        virtual void OnConnect(const SBLELinkInfo& rkInfo);
+
+        /**
+         * @brief Called by the transport when the link is updated.
+         *
+         * @param[in] rkInfo The updated link information.
+         */
+        virtual void OnLinkUpdate(const SBLELinkInfo& rkInfo);
+
+        /**
+         * @brief Called by the transport when the client disconnects.
+         */
+        virtual void OnDisconnect(void);
+
+        /**
+         * @brief Called by the transport when the client writes a frame.
+         *
+         * @param[in] kChannel The channel the frame was written on.
+         * @param[in] pkData The frame data.
+         * @param[in] kSize The frame size.
+         */
+        virtual void OnReceive(const ETransportChannel kChannel,
+                               const uint8_t*          pkData,
+                               const size_t            kSize);
+
         /**
          * @brief Sends the data end buffer to the client.
          *
@@ -243,34 +578,279 @@ class BluetoothManager
 
     /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
     private:
+        /**
+         * @brief Submits a notification to the transmit scheduler.
+         *
+         * @details Submits a notification to the transmit scheduler and waits
+         * for its completion. Control notifications are sent before the
+         * queued bulk ones.
+         *
+         * @param[in] kPriority The notification priority.
+         * @param[in] kChannel The channel to notify.
+         * @param[in] pkBuffer The notification data.
+         * @param[in] kSize The notification size.
+         * @param[in] kTimeout The timeout in milliseconds.
+         * @param[out] pRetries The number of congestion retries, can be
+         * nullptr.
+         *
+         * @return true is returned on success, false otherwise.
+         */
+        bool Transmit(const EBLETxPriority    kPriority,
+                      const ETransportChannel kChannel,
+                      const uint8_t*          pkBuffer,
+                      const size_t            kSize,
+                      const uint64_t          kTimeout,
+                      uint32_t*               pRetries);
+
+        /**
+         * @brief Tries to send a request of the transmit scheduler.
+         *
+         * @details Tries to send a request of the transmit scheduler. When the
+         * stack is congested, the scheduler backs off before returning, the
+         * backoff starts at one connection interval and doubles while the
+         * congestion lasts.
+         *
+         * @param[in, out] rRequest The request to send.
+         * @param[in] kPriority The request priority.
+         *
+         * @return true is returned when the request is completed, false when
+         * it must be tried again.
+         */
+        bool TransmitRequest(SBLETxRequest&       rRequest,
+                             const EBLETxPriority kPriority);
+
+        /**
+         * @brief Sends a bulk acknowledge from the transmit scheduler.
+         *
+         * @details Sends a bulk acknowledge from the transmit scheduler, with
+         * the control priority. A congested acknowledge is dropped when a
+         * newer one is queued.
+         *
+         * @param[in] rkAck The acknowledge to send.
+         */
+        void TransmitBulkAck(const SBLEBulkAck& rkAck);
+
+        /**
+         * @brief Transmit scheduler routine.
+         *
+         * @param[in] pManagerParam The bluetooth manager.
+         */
+        static void TransmitRoutine(void* pManagerParam);
+
+        /**
+         * @brief Tells if a client is connected.
+         *
+         * @return true is returned if a client is connected, false otherwise.
+         */
+        bool IsConnected(void) const;
+
+        /**
+         * @brief Receives a frame written on the data channel.
+         *
+         * @details Receives a frame written on the data channel, the frame is
+         * pushed in the receive ring.
+         *
+         * @param[in] pkData The frame data.
+         * @param[in] kSize The frame size.
+         */
+        void ReceiveDataFrame(const uint8_t* pkData, const size_t kSize);
+
+        /**
+         * @brief Receives a frame written on the bulk channel.
+         *
+         * @details Receives a frame written on the bulk channel. Frames are
+         * checked and delivered in order to the receive ring. Frames received
+         * ahead of a missing one are held in the reorder window until the
+         * missing frame is retransmitted. Frames that cannot be stored are
+         * dropped without acknowledge, the sender retransmits them.
+         *
+         * @param[in] pkData The frame data.
+         * @param[in] kSize The frame size.
+         */
+        void ReceiveBulkFrame(const uint8_t* pkData, const size_t kSize);
+
+        /**
+         * @brief Delivers a bulk frame payload to the receive ring.
+         *
+         * @param[in] pkPayload The frame payload.
+         * @param[in] kSize The frame payload size.
+         *
+         * @return true is returned if the payload was delivered, false if the
+         * ring is full.
+         */
+        bool DeliverBulkFrame(const uint8_t* pkPayload, const size_t kSize);
+
+        /**
+         * @brief Delivers the held bulk frames at the head of the window.
+         *
+         * @details Delivers the held bulk frames at the head of the window.
+         * When the ring is full, the delivery is stalled.
+         */
+        void DeliverHeldBulkFrames(void);
+
+        /**
+         * @brief Stalls the bulk frames delivery on a full receive ring.
+         *
+         * @details Stalls the bulk frames delivery on a full receive ring. The
+         * held frames are dropped, the sender sends them again. The stall
+         * acknowledge is handed to the receiver.
+         */
+        void StallBulkDelivery(void);
+
+        /**
+         * @brief Resumes the stalled bulk frames delivery.
+         *
+         * @details Resumes the stalled bulk frames delivery, called by the
+         * receiver once the receive ring has space. The stall acknowledge is
+         * sent, the sender sends the dropped frames again.
+         */
+        void ResumeBulkDelivery(void);
+
+        /**
+         * @brief Holds a bulk frame received ahead of a missing one.
+         *
+         * @param[in] kSequence The frame sequence.
+         * @param[in] pkPayload The frame payload.
+         * @param[in] kSize The frame payload size.
+         */
+        void HoldBulkFrame(const uint16_t kSequence,
+                           const uint8_t* pkPayload,
+                           const size_t   kSize);
+
+        /**
+         * @brief Queues the current bulk acknowledge for the sender.
+         *
+         * @details Queues the current bulk acknowledge for the transmit
+         * scheduler, replacing the acknowledge not sent yet.
+         */
+        void SendBulkAck(void);
+
+        /**
+         * @brief Sends a data notification.
+         *
+         * @details Sends a data notification through the transmit scheduler,
+         * with the bulk priority. The call returns when the notification was
+         * accepted by the transport or failed.
+         *
+         * @param[in] pkBuffer The notification data.
+         * @param[in] kSize The notification size.
+         * @param[in] kTimeout The timeout in milliseconds.
+         *
+         * @return true is returned on success, false otherwise.
+         */
+        bool SendSegment(const uint8_t* pkBuffer,
+                         const size_t   kSize,
+                         const uint64_t kTimeout);
+
+        /**
+         * @brief Sends a buffer as data notifications.
+         *
+         * @param[in] pkBuffer The data to send.
+         * @param[in] size The size of the data to send.
+         * @param[in] kTimeout The timeout in milliseconds.
+         *
+         * @return true is returned on success, false otherwise.
+         */
+        bool SendSegments(const uint8_t* pkBuffer,
+                          size_t         size,
+                          const uint64_t kTimeout);
+
+        /**
+         * @brief Starts the armed transfer on its first data.
+         */
+        void StartTransferData(void);
+
+        /**
+         * @brief Gets the transfer counters to update.
+         *
+         * @details Gets the transfer counters to update: the connection ones
+         * and the current transfer ones when a transfer is recorded. The
+         * statistics lock is held.
+         *
+         * @param[out] pCounters The counters to update.
+         *
+         * @return The number of counters to update.
+         */
+        uint8_t GetActiveCounters(SBLETransferCounters* pCounters[2]);
+
+        /**
+         * @brief Records a data notification retry.
+         */
+        void RecordNotifyRetry(void);
+
+        /**
+         * @brief Records a data notification error status.
+         *
+         * @param[in] kCode The status code.
+         */
+        void RecordStatusError(const int kCode);
+
+        /**
+         * @brief Records the time blocked during a data transfer.
+         *
+         * @param[in] kSend Tells if the time was blocked sending or receiving.
+         * @param[in] kTime The blocked time in microseconds.
+         */
+        void RecordBlockedTime(const bool kSend, const uint64_t kTime);
+
+        /**
+         * @brief Records the data sent or received.
+         *
+         * @param[in] kSend Tells if the data was sent or received.
+         * @param[in] kBytes The number of bytes transfered.
+         * @param[in] kTime The transfer time in microseconds.
+         */
+        void RecordTraffic(const bool     kSend,
+                           const uint64_t kBytes,
+                           const uint64_t kTime);
+
         /** @brief Stores the BLE communication token */
-        std::string        token_;
-        /** @brief Stores the storage singleton. */
-        Storage*           pStorage_;
+        std::string          token_;
+        /** @brief Stores the configuration store singleton. */
+        ConfigStore*         pConfig_;
         /** @brief Stores the command handler. */
-        CommandHandler*    pHandler_;
-
-        /** @brief Stores the BLE server instance. */
-        BLEServer*         pServer_;
-        /** @brief Stores the BLE main service instance. */
-        BLEService*        pMainService_;
-        /** @brief Stores the BLE advertising instance. */
-        BLEAdvertising*    pAdvertising_;
-        /** @brief Stores the BLE command characteristic instance. */
-        BLECharacteristic* pCommandCharacteristic_;
-        /** @brief Stores the BLE data characteristic instance. */
-        BLECharacteristic* pDataCharacteristic_;
-
-        /** @brief Command notification lock. */
-        SemaphoreHandle_t  commandNotifyLock_;
-
-        /** @brief Stores the current Nimble connection */
-        NimBLEConnInfo*    pBleConnetion_;
-
-        /** @brief Stores the send buffer used for raw data tranfers */
-        SBLEBuffer         sendBuffer_;
+        CommandHandler*      pHandler_;
+
+        /** @brief Stores the transport carrying the protocol. */
+        BLETransport*        pTransport_;
+
+        /** @brief Stores the transmit queues, one per priority. */
+        QueueHandle_t        pTxQueues_[BLE_TX_PRIORITY_COUNT];
+        /** @brief Stores the latest bulk acknowledge to send. */
+        QueueHandle_t        ackQueue_;
+        /** @brief Signaled each time a request is submitted. */
+        SemaphoreHandle_t    txSignal_;
+        /** @brief Stores the transmit scheduler task. */
+        TaskHandle_t         txThread_;
+        /** @brief Stores the current congestion backoff in microseconds. */
+        uint64_t             txBackoff_;
+
+        /** @brief Stores the link state of the current connection */
+        SBLELinkState        linkState_;
+        /** @brief Protects the link state and the transfer counters */
+        SemaphoreHandle_t    statsLock_;
+        /** @brief Stores the counters of the current or last transfer */
+        SBLETransferCounters transferCounters_;
+        /** @brief Tells if the next data starts a transfer record */
+        bool                 transferArmed_;
+        /** @brief Tells if a transfer is being recorded */
+        bool                 transferActive_;
+
+        /** @brief Stores the compression requested for the next transfer */
+        EBLECompression      requestedCompression_;
+        /** @brief Stores the compression of the current transfer */
+        EBLECompression      compression_;
+        /** @brief Stores the link encoder */
+        LinkEncoder*         pEncoder_;
+        /** @brief Stores the link decoder */
+        LinkDecoder*         pDecoder_;
+        /** @brief Stores the encoded block buffer */
+        uint8_t*             pEncodeBuffer_;
+
         /** @brief Stores the receive buffer used for raw data tranfers */
-        SBLEBuffer         receiveBuffer_;
+        SBLEReceiveBuffer    receiveBuffer_;
+        /** @brief Stores the bulk upload receive state */
+        SBLEBulkReceive      bulkReceive_;
 };
 
 #endif /* #ifndef __CORE_BLUETOOTH_MGR_H_ */
\ No newline at end of file
@@ -0,0 +1,386 @@
+/*******************************************************************************
+ * @file ConfigStore.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file defines the configuration store.
+ *
+ * @details This file defines the configuration store. The settings of the ECB
+ * are stored in a single journal on the SD card. Each change appends a CRC
+ * protected record to the journal, the journal is compacted to one record per
+ * setting when it grows too large. The whole journal is read once at boot.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __CORE_CONFIG_STORE_H_
+#define __CORE_CONFIG_STORE_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <string>         /* std::string */
+#include <cstdint>        /* Generic Int types */
+#include <Types.h>        /* ECB Types */
+#include <Storage.h>      /* Storage service */
+#include <ContentCache.h> /* Content cache */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Journal magic value, "ECBC". */
+#define CONFIG_JOURNAL_MAGIC 0x43424345
+/** @brief Journal format version. */
+#define CONFIG_JOURNAL_VERSION 1
+/** @brief Journal size that triggers a compaction. */
+#define CONFIG_JOURNAL_MAX_SIZE 4096
+/** @brief Maximal size of a setting value. */
+#define CONFIG_VALUE_MAX_SIZE 128
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/** @brief Defines the settings keys. */
+typedef enum
+{
+    /** @brief Owner name, string. */
+    CONFIG_KEY_OWNER          = 0,
+    /** @brief Owner contact, string. */
+    CONFIG_KEY_CONTACT        = 1,
+    /** @brief Bluetooth token, string. */
+    CONFIG_KEY_BT_TOKEN       = 2,
+    /** @brief Name of the displayed image, string. */
+    CONFIG_KEY_CURRENT_IMAGE  = 3,
+    /** @brief LED border state, integer. */
+    CONFIG_KEY_LED_ENABLED    = 4,
+    /** @brief LED border brightness, integer. */
+    CONFIG_KEY_LED_BRIGHTNESS = 5,
+    /** @brief Number of settings keys. */
+    CONFIG_KEY_COUNT          = 6,
+} EConfigKey;
+
+/** @brief Defines the settings value types. */
+typedef enum
+{
+    /** @brief String value. */
+    CONFIG_TYPE_STRING  = 0,
+    /** @brief Signed 32 bits integer value. */
+    CONFIG_TYPE_INTEGER = 1,
+} EConfigType;
+
+/** @brief Defines the journal header. */
+typedef struct __attribute__((packed))
+{
+    /** @brief Journal magic, CONFIG_JOURNAL_MAGIC. */
+    uint32_t magic;
+    /** @brief Journal format version. */
+    uint16_t version;
+    /** @brief Reserved, set to 0. */
+    uint16_t reserved;
+} SConfigJournalHeader;
+
+/**
+ * @brief Defines a journal record header.
+ *
+ * @details Defines a journal record header, the value follows the header. The
+ * CRC is the CRC32 of the key, type, size and value. The last record of a key
+ * holds its value.
+ */
+typedef struct __attribute__((packed))
+{
+    /** @brief Setting key. */
+    uint8_t  key;
+    /** @brief Setting value type. */
+    uint8_t  type;
+    /** @brief Value size. */
+    uint16_t size;
+    /** @brief Record CRC32. */
+    uint32_t crc;
+} SConfigRecordHeader;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/**
+ * @brief Configuration store class.
+ *
+ * @details The configuration store class persists the settings in the
+ * configuration journal and keeps their values in a content cache. The
+ * bluetooth token is pinned in the cache, it is checked on every command. An
+ * evicted value is read back from its last journal record. When no journal
+ * exists, the settings are imported from the legacy one-file-per-setting
+ * layout. This is a singleton class.
+ */
+class ConfigStore
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        /**
+         * @brief Get the ConfigStore instance object.
+         *
+         * @details Get the ConfigStore instance object. The singleton is
+         * created on the first call, the journal is loaded at creation.
+         *
+         * @return The function returns the ConfigStore singleton.
+         */
+        static ConfigStore* GetInstance(void);
+
+        /**
+         * @brief Gets a string setting.
+         *
+         * @param[in] kKey The setting key.
+         * @param[out] rValue The buffer that receives the value, the default
+         * value when the setting was never set.
+         *
+         * @return true is returned on success, false if the key is not a
+         * string setting.
+         */
+        bool GetString(const EConfigKey kKey, std::string& rValue) const;
+
+        /**
+         * @brief Gets an integer setting.
+         *
+         * @param[in] kKey The setting key.
+         *
+         * @return The value is returned, the default value when the setting was
+         * never set or if the key is not an integer setting.
+         */
+        int32_t GetInteger(const EConfigKey kKey) const;
+
+        /**
+         * @brief Sets a string setting.
+         *
+         * @details Sets a string setting and appends it to the journal. An
+         * unchanged value is not written.
+         *
+         * @param[in] kKey The setting key.
+         * @param[in] rkValue The value to set.
+         *
+         * @return true is returned on success, false otherwise.
+         */
+        bool SetString(const EConfigKey kKey, const std::string& rkValue);
+
+        /**
+         * @brief Sets an integer setting.
+         *
+         * @details Sets an integer setting and appends it to the journal. An
+         * unchanged value is not written.
+         *
+         * @param[in] kKey The setting key.
+         * @param[in] kValue The value to set.
+         *
+         * @return true is returned on success, false otherwise.
+         */
+        bool SetInteger(const EConfigKey kKey, const int32_t kValue);
+
+        /**
+         * @brief Resets the settings to their default values.
+         *
+         * @details Resets the settings to their default values. The journal
+         * is not removed, this is called after the SD card was formatted.
+         */
+        void Reset(void);
+
+        /**
+         * @brief Gets the settings cache statistics.
+         *
+         * @param[out] rStats The statistics to fill.
+         */
+        void GetCacheStats(SContentCacheStats& rStats) const;
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+        /* None */
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        /**
+         * @brief Construct a new ConfigStore object.
+         */
+        ConfigStore(void);
+
+        /**
+         * @brief Gets the serialized value of a setting.
+         *
+         * @details Gets the serialized value of a setting from the cache. On
+         * a miss, the value is read back from the journal under the storage
+         * lock and cached again.
+         *
+         * @param[in] kKey The setting key.
+         * @param[out] rValue The buffer that receives the value.
+         *
+         * @return true is returned if the setting is set, false if it was
+         * never set or cannot be read.
+         */
+        bool GetValue(const EConfigKey kKey, std::string& rValue) const;
+
+        /**
+         * @brief Reads the last record of a setting from the journal.
+         *
+         * @details Reads the last record of a setting from the journal, the
+         * storage lock is held.
+         *
+         * @param[in] kKey The setting key.
+         * @param[out] rValue The buffer that receives the value.
+         *
+         * @return true is returned on success, false otherwise.
+         */
+        bool ReadRecord(const EConfigKey kKey, std::string& rValue) const;
+
+        /**
+         * @brief Caches the value of a setting, the settings lock is held.
+         *
+         * @param[in] kKey The setting key.
+         * @param[in] rkValue The serialized value.
+         */
+        void CacheValue(const EConfigKey kKey, const std::string& rkValue)
+            const;
+
+        /**
+         * @brief Loads the journal.
+         *
+         * @details Loads the journal in one read, replays its records and
+         * caches the values. A torn record at the end of the journal is
+         * truncated.
+         *
+         * @return true is returned if the journal was loaded, false if it
+         * does not exist or is invalid.
+         */
+        bool Load(void);
+
+        /**
+         * @brief Imports the legacy settings files.
+         *
+         * @param[out] pValues The imported serialized values.
+         * @param[out] pIsSet Tells which settings were imported.
+         */
+        void ImportLegacy(std::string pValues[], bool pIsSet[]);
+
+        /**
+         * @brief Sets a setting value.
+         *
+         * @param[in] kKey The setting key.
+         * @param[in] kType The value type.
+         * @param[in] rkValue The serialized value.
+         *
+         * @return true is returned on success, false otherwise.
+         */
+        bool SetValue(const EConfigKey   kKey,
+                      const EConfigType  kType,
+                      const std::string& rkValue);
+
+        /**
+         * @brief Appends a setting value to the journal.
+         *
+         * @details Appends a setting value to the journal, the journal is
+         * compacted when it is full. The storage lock is held.
+         *
+         * @param[in] kKey The setting key.
+         * @param[in] rkValue The serialized value.
+         *
+         * @return true is returned on success, false otherwise.
+         */
+        bool Append(const EConfigKey kKey, const std::string& rkValue);
+
+        /**
+         * @brief Rewrites the journal with a new setting value.
+         *
+         * @details Rewrites the journal with the current values and a new
+         * value of a setting. The storage lock is held.
+         *
+         * @param[in] kKey The setting key.
+         * @param[in] rkValue The serialized value.
+         *
+         * @return true is returned on success, false otherwise.
+         */
+        bool Rewrite(const EConfigKey kKey, const std::string& rkValue);
+
+        /**
+         * @brief Rewrites the journal with one record per set setting.
+         *
+         * @details Rewrites the journal in a temporary file that replaces the
+         * journal once written. A compaction interrupted after the removal of
+         * the journal is completed at the next boot. The storage lock is
+         * held.
+         *
+         * @param[in] pkValues The serialized values.
+         * @param[in] pkIsSet Tells which settings are set.
+         *
+         * @return true is returned on success, false otherwise.
+         */
+        bool Compact(const std::string pkValues[], const bool pkIsSet[]);
+
+        /**
+         * @brief Writes a record to a file.
+         *
+         * @param[in, out] rFile The file to write to.
+         * @param[in] kKey The setting key.
+         * @param[in] rkValue The serialized value.
+         *
+         * @return The number of bytes written is returned, 0 on error.
+         */
+        size_t WriteRecord(FsFile&            rFile,
+                           const EConfigKey   kKey,
+                           const std::string& rkValue);
+
+        /** @brief Stores the storage instance. */
+        Storage* pStore_;
+
+        /** @brief Protects the settings cache and the set flags. */
+        SemaphoreHandle_t lock_;
+
+        /** @brief Caches the serialized values. */
+        mutable ContentCache cache_;
+
+        /** @brief Tells which settings were set. */
+        bool pIsSet_[CONFIG_KEY_COUNT];
+
+        /** @brief Stores the journal offset of the last record of a key. */
+        size_t pOffsets_[CONFIG_KEY_COUNT];
+
+        /** @brief Stores the size of the journal. */
+        size_t journalSize_;
+
+        /** @brief Stores the singleton instance. */
+        static ConfigStore* PINSTANCE_;
+};
+
+#endif /* #ifndef __CORE_CONFIG_STORE_H_ */
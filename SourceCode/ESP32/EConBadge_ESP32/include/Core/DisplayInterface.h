@@ -25,6 +25,7 @@
 #include <vector>          /* std::vector */
 #include <Menu.h>          /* Menu manager */
 #include <BatteryMgr.h>    /* Battery manager */
+#include <BlueToothMgr.h>  /* Bluetooth statistics */
 #include <OLEDScreenMgr.h> /* OLED screen manager */
 
 /*******************************************************************************
@@ -49,6 +50,8 @@ typedef struct
     uint8_t buttonsState[BUTTON_MAX_ID];
     uint64_t buttonsKeepTime[BUTTON_MAX_ID];
     uint32_t batteryState;
+    SBLETransferStats bleStats;
+    SBLEResponseStats bleResponses;
 } SDebugInfo_t;
 
 /*******************************************************************************
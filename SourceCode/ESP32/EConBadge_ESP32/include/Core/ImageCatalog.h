@@ -0,0 +1,408 @@
+/*******************************************************************************
+ * @file ImageCatalog.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file defines the image catalog.
+ *
+ * @details This file defines the image catalog. The catalog indexes the images
+ * of the image directory with their metadata. It is stored on the SD card as a
+ * sorted array of fixed size entries and kept in memory, the images are
+ * listed, counted and looked up without scanning the directory.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __CORE_IMAGE_CATALOG_H_
+#define __CORE_IMAGE_CATALOG_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <string>    /* std::string */
+#include <vector>    /* std::vector */
+#include <cstdint>   /* Generic Int types */
+#include <Types.h>   /* ECB Types */
+#include <Storage.h> /* Storage service */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Catalog magic value, "ECBI". */
+#define IMAGE_CATALOG_MAGIC 0x49424345
+/** @brief Catalog format version. */
+#define IMAGE_CATALOG_VERSION 1
+/** @brief Size of an image name, including the null terminator. */
+#define IMAGE_CATALOG_NAME_SIZE COMMAND_DATA_SIZE
+/** @brief Entry flag: the content hash is known. */
+#define IMAGE_CATALOG_FLAG_HASHED 0x01
+/** @brief Header flag: the image directory changed after the last save. */
+#define IMAGE_CATALOG_HEADER_FLAG_DIRTY 0x0001
+/** @brief Page cursor: shift of the catalog generation. */
+#define IMAGE_CATALOG_CURSOR_GEN_SHIFT 16
+/** @brief Page cursor: mask of the position. */
+#define IMAGE_CATALOG_CURSOR_POS_MASK 0xFFFF
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/** @brief Defines the image encodings. */
+typedef enum
+{
+    /** @brief Raw panel data. */
+    IMAGE_ENCODING_RAW        = 0,
+    /** @brief Image codec stream. */
+    IMAGE_ENCODING_COMPRESSED = 1,
+} EImageEncoding;
+
+/** @brief Defines the catalog header. */
+typedef struct __attribute__((packed))
+{
+    /** @brief Catalog magic, IMAGE_CATALOG_MAGIC. */
+    uint32_t magic;
+    /** @brief Catalog format version. */
+    uint16_t version;
+    /** @brief Header flags, see IMAGE_CATALOG_HEADER_FLAG_*. */
+    uint16_t flags;
+    /** @brief Number of entries following the header. */
+    uint32_t count;
+    /** @brief CRC32 of the previous fields. */
+    uint32_t crc;
+} SImageCatalogHeader;
+
+/** @brief Defines a catalog entry. */
+typedef struct __attribute__((packed))
+{
+    /** @brief Image name, null terminated. */
+    char     pName[IMAGE_CATALOG_NAME_SIZE];
+    /** @brief Image file size in bytes. */
+    uint32_t size;
+    /** @brief CRC32 of the image data, the codec header excluded. */
+    uint32_t hash;
+    /** @brief Upload date, FAT format. */
+    uint16_t uploadDate;
+    /** @brief Upload time, FAT format. */
+    uint16_t uploadTime;
+    /** @brief Number of times the image was displayed. */
+    uint32_t displayCount;
+    /** @brief Image encoding, see EImageEncoding. */
+    uint8_t  encoding;
+    /** @brief Entry flags, see IMAGE_CATALOG_FLAG_*. */
+    uint8_t  flags;
+    /** @brief Reserved, set to 0. */
+    uint16_t reserved;
+    /** @brief CRC32 of the previous fields. */
+    uint32_t crc;
+} SImageCatalogEntry;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/**
+ * @brief Image catalog class.
+ *
+ * @details The image catalog class keeps the entries sorted by name and a hash
+ * table from the names to the entries. Adding or removing an image rewrites
+ * the catalog in a temporary file that replaces it, the display counters are
+ * updated in place. The catalog is marked dirty before the image directory
+ * changes, the next save clears the mark. The catalog is rebuilt from the image
+ * directory when it is missing, invalid or still marked dirty at boot, the
+ * directory is not scanned otherwise. The entries are read
+ * under the catalog lock, the writers also hold the storage lock for the
+ * catalog file writes. This is a singleton class.
+ */
+class ImageCatalog
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        /**
+         * @brief Get the ImageCatalog instance object.
+         *
+         * @details Get the ImageCatalog instance object. The singleton is
+         * created on the first call, the catalog is loaded or rebuilt at
+         * creation. The image directory must exist.
+         *
+         * @return The function returns the ImageCatalog singleton.
+         */
+        static ImageCatalog* GetInstance(void);
+
+        /**
+         * @brief Gets the number of images.
+         *
+         * @return The number of images is returned.
+         */
+        size_t GetCount(void) const;
+
+        /**
+         * @brief Gets an entry by its position in the catalog.
+         *
+         * @param[in] kIndex The position of the entry, in name order.
+         * @param[out] rEntry The entry to fill.
+         *
+         * @return true is returned on success, false if the position is out
+         * of the catalog.
+         */
+        bool GetEntry(const size_t kIndex, SImageCatalogEntry& rEntry) const;
+
+        /**
+         * @brief Finds the position of an image.
+         *
+         * @param[in] rkName The image name.
+         *
+         * @return The position of the image is returned, -1 if the image is
+         * not in the catalog.
+         */
+        ssize_t Find(const std::string& rkName) const;
+
+        /**
+         * @brief Gets the names of the images around an image.
+         *
+         * @details Gets kCount names starting kPrev images before an image,
+         * the list wraps around the catalog. The first image is used when the
+         * start image is empty or not in the catalog. The names are copied in
+         * the caller buffer under the catalog lock, nothing is allocated.
+         *
+         * @param[in] pkStartName The image to start from.
+         * @param[in] kPrev The number of images to get before the start
+         * image.
+         * @param[in] kCount The maximal number of names to get, the size of
+         * the names buffer.
+         * @param[out] pNames The names buffer.
+         *
+         * @return The number of names copied is returned.
+         */
+        size_t GetNamesFrom(const char*  pkStartName,
+                            const size_t kPrev,
+                            const size_t kCount,
+                            char         pNames[][IMAGE_CATALOG_NAME_SIZE])
+                            const;
+
+        /**
+         * @brief Gets a page of entries.
+         *
+         * @details Gets a page of entries under the catalog lock. The cursor
+         * holds the catalog generation in its high half and the position in
+         * its low half. The generation changes when an image is added or
+         * removed, the cursors of a previous generation are rejected since
+         * the positions moved. A cursor at position 0 starts a listing.
+         *
+         * @param[in] kCursor The cursor of the page.
+         * @param[in] kCount The maximal number of entries to get.
+         * @param[out] rEntries The entries of the page.
+         * @param[out] rNextCursor The cursor of the next page,
+         * FILES_CURSOR_END after the last page.
+         *
+         * @return true is returned on success, false if the cursor is stale
+         * or out of the catalog.
+         */
+        bool GetPage(const uint32_t                   kCursor,
+                     const size_t                     kCount,
+                     std::vector<SImageCatalogEntry>& rEntries,
+                     uint32_t&                        rNextCursor) const;
+
+        /**
+         * @brief Adds a stored image to the catalog.
+         *
+         * @details Adds a stored image to the catalog, an image with the same
+         * name is replaced. The size and upload time are read from the image
+         * file.
+         *
+         * @param[in] rkName The image name.
+         * @param[in] kHash The CRC32 of the image data.
+         * @param[in] kEncoding The image encoding.
+         *
+         * @return true is returned on success, false otherwise.
+         */
+        bool Add(const std::string&   rkName,
+                 const uint32_t       kHash,
+                 const EImageEncoding kEncoding);
+
+        /**
+         * @brief Removes an image from the catalog.
+         *
+         * @param[in] rkName The image name.
+         *
+         * @return true is returned on success, false otherwise.
+         */
+        bool Remove(const std::string& rkName);
+
+        /**
+         * @brief Records that an image was displayed.
+         *
+         * @details Increments the display counter of an image and stores the
+         * hash of its data when it was not known.
+         *
+         * @param[in] rkName The image name.
+         * @param[in] kHash The CRC32 of the image data.
+         *
+         * @return true is returned on success, false otherwise.
+         */
+        bool RecordDisplay(const std::string& rkName, const uint32_t kHash);
+
+        /**
+         * @brief Marks the catalog dirty before the image directory changes.
+         *
+         * @details Marks the catalog dirty in its header before an image is
+         * stored or removed. Adding or removing the image saves the catalog
+         * and clears the mark, a catalog still marked at boot is rebuilt.
+         *
+         * @return true is returned on success or when there is no catalog
+         * file to mark, false otherwise.
+         */
+        bool MarkDirty(void);
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+        /* None */
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        /**
+         * @brief Construct a new ImageCatalog object.
+         */
+        ImageCatalog(void);
+
+        /**
+         * @brief Loads the catalog.
+         *
+         * @details Loads the catalog in one read. The valid entries are kept
+         * even when the catalog must be rebuilt.
+         *
+         * @return true is returned if the catalog is valid and not marked
+         * dirty, false otherwise.
+         */
+        bool Load(void);
+
+        /**
+         * @brief Rebuilds the catalog from the image directory.
+         *
+         * @details Rebuilds the catalog from the image directory. The metadata
+         * of the loaded entries that match an image are kept, the other images
+         * are added with an unknown hash.
+         */
+        void Rebuild(void);
+
+        /**
+         * @brief Writes the catalog.
+         *
+         * @details Writes the catalog in a temporary file that replaces the
+         * catalog once written.
+         *
+         * @return true is returned on success, false otherwise.
+         */
+        bool Save(void);
+
+        /**
+         * @brief Writes the catalog header at the current file position.
+         *
+         * @param[in, out] rFile The catalog file.
+         * @param[in] kFlags The header flags.
+         *
+         * @return true is returned on success, false otherwise.
+         */
+        bool WriteHeader(FsFile& rFile, const uint16_t kFlags);
+
+        /**
+         * @brief Writes an entry in place in the catalog.
+         *
+         * @param[in] kIndex The position of the entry.
+         *
+         * @return true is returned on success, false otherwise.
+         */
+        bool WriteEntry(const size_t kIndex);
+
+        /**
+         * @brief Fills an entry from its image file.
+         *
+         * @param[in, out] rEntry The entry to fill, its name is set.
+         *
+         * @return true is returned on success, false otherwise.
+         */
+        bool ReadImageInfo(SImageCatalogEntry& rEntry);
+
+        /**
+         * @brief Rebuilds the hash table of the names.
+         *
+         * @details Rebuilds the hash table of the names after the positions
+         * changed, the catalog generation is incremented.
+         */
+        void IndexNames(void);
+
+        /**
+         * @brief Finds the position of an image, the catalog lock is held.
+         *
+         * @param[in] pkName The image name.
+         *
+         * @return The position of the image is returned, -1 if the image is
+         * not in the catalog.
+         */
+        ssize_t FindIndex(const char* pkName) const;
+
+        /**
+         * @brief Gets the position where a name is or would be inserted.
+         *
+         * @param[in] pkName The image name.
+         *
+         * @return The position of the first entry not before the name is
+         * returned.
+         */
+        size_t LowerBound(const char* pkName) const;
+
+        /** @brief Stores the storage instance. */
+        Storage* pStore_;
+
+        /** @brief Protects the entries and the hash table. */
+        SemaphoreHandle_t lock_;
+
+        /** @brief Stores the entries, sorted by name. */
+        std::vector<SImageCatalogEntry> entries_;
+
+        /** @brief Stores the hash table, positions of the entries. */
+        std::vector<uint16_t> slots_;
+
+        /** @brief Stores the generation of the positions. */
+        uint16_t generation_;
+
+        /** @brief Stores the singleton instance. */
+        static ImageCatalog* PINSTANCE_;
+};
+
+#endif /* #ifndef __CORE_IMAGE_CATALOG_H_ */
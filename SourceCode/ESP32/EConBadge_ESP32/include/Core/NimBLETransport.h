@@ -0,0 +1,182 @@
+/*******************************************************************************
+ * @file NimBLETransport.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file defines the NimBLE transport.
+ *
+ * @details This file defines the NimBLE transport. The transport exposes the
+ * badge GATT service, each channel is a characteristic of the main service.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __CORE_NIMBLE_TRANSPORT_H_
+#define __CORE_NIMBLE_TRANSPORT_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <BLETransport.h> /* BLE transport interface */
+#include <NimBLEDevice.h> /* BLE Services */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief LE data length extension TX octets requested to the controller. */
+#define BLE_PREFERRED_DATA_LENGTH 251
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/**
+ * @brief The NimBLE transport class.
+ *
+ * @details The NimBLE transport class creates the BLE server and the badge
+ * service and advertises it. The frames are notified on the channel
+ * characteristics.
+ */
+class NimBLETransport: public BLETransport
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        /**
+         * @brief Construct a new NimBLE Transport object.
+         */
+        NimBLETransport(void);
+
+        /**
+         * @brief Starts the transport.
+         *
+         * @details Starts the BLE services and the advertising.
+         *
+         * @param[in] pHandler The transport handler.
+         *
+         * @return true is returned on success, false otherwise.
+         */
+        virtual bool Start(TransportHandler* pHandler);
+
+        /**
+         * @brief Tells if a client is connected.
+         *
+         * @return true is returned if a client is connected, false otherwise.
+         */
+        virtual bool IsConnected(void) const;
+
+        /**
+         * @brief Notifies a frame on a channel characteristic.
+         *
+         * @param[in] kChannel The channel to send the frame on.
+         * @param[in] pkData The frame data.
+         * @param[in] kSize The frame size.
+         *
+         * @return The send status is returned.
+         */
+        virtual ETransportStatus Send(const ETransportChannel kChannel,
+                                      const uint8_t*          pkData,
+                                      const size_t            kSize);
+
+        /**
+         * @brief Gets the NimBLE status of the last notification.
+         *
+         * @return The NimBLE status of the last notification is returned.
+         */
+        virtual int GetLastStatus(void) const;
+
+        /**
+         * @brief Sets the connection state.
+         *
+         * @details Sets the connection state. Only a BLE callback should call
+         * this function.
+         *
+         * @param[in] kConnected The connection state.
+         */
+        void SetConnected(const bool kConnected);
+
+        /**
+         * @brief Sets the status of the last notification.
+         *
+         * @details Sets the status of the last notification. Only a BLE
+         * callback should call this function.
+         *
+         * @param[in] kStatus The NimBLE status.
+         */
+        void SetLastStatus(const int kStatus);
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+        /* None */
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        /**
+         * @brief Creates a channel characteristic.
+         *
+         * @param[in] kpUUID The characteristic UUID.
+         * @param[in] kProperties The characteristic properties.
+         * @param[in] kChannel The channel carried by the characteristic.
+         */
+        void CreateChannel(const char*             kpUUID,
+                           const uint32_t          kProperties,
+                           const ETransportChannel kChannel);
+
+        /** @brief Stores the transport handler. */
+        TransportHandler*  pHandler_;
+        /** @brief Stores the BLE server instance. */
+        BLEServer*         pServer_;
+        /** @brief Stores the BLE main service instance. */
+        BLEService*        pMainService_;
+        /** @brief Stores the BLE advertising instance. */
+        BLEAdvertising*    pAdvertising_;
+        /** @brief Stores the channel characteristics. */
+        BLECharacteristic* pChannels_[TRANSPORT_CHANNEL_COUNT];
+        /** @brief Tells if a client is connected. */
+        volatile bool      connected_;
+        /** @brief Stores the status of the last notification. */
+        int                lastStatus_;
+};
+
+#endif /* #ifndef __CORE_NIMBLE_TRANSPORT_H_ */
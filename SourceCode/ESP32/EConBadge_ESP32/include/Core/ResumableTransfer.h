@@ -0,0 +1,267 @@
+/*******************************************************************************
+ * @file ResumableTransfer.h
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file defines the resumable transfer service.
+ *
+ * @details This file defines the resumable transfer service. A resumable
+ * transfer is prepared with CMD_RESUME_TRANSFER right before the upload
+ * command. The received data is stored in a partial file under the temporary
+ * directory and the received byte count is checkpointed next to it. When the
+ * link drops, the partial file is kept and the next CMD_RESUME_TRANSFER with
+ * the same descriptor returns the offset to continue from. The partial file is
+ * only committed once its SHA-256 matches the descriptor.
+ *
+ * Only one resumable transfer is kept, preparing a different transfer drops
+ * the previous one.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+#ifndef __CORE_RESUMABLE_TRANSFER_H_
+#define __CORE_RESUMABLE_TRANSFER_H_
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <string>    /* std::string */
+#include <cstdint>   /* Generic Types */
+#include <SdFat.h>   /* SD Card driver */
+#include <Types.h>   /* Defined types */
+#include <Storage.h> /* Storage service */
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Size of the transfer SHA-256 hash. */
+#define TRANSFER_HASH_SIZE 32
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/** @brief Defines the resumable transfer descriptor sent by the client. */
+typedef struct __attribute__((packed))
+{
+    /** @brief Transfer identifier chosen by the client. */
+    uint32_t transferId;
+    /** @brief Size of the transfered data in bytes. */
+    uint32_t totalSize;
+    /** @brief SHA-256 of the transfered data. */
+    uint8_t  pHash[TRANSFER_HASH_SIZE];
+} STransferDescriptor;
+
+/** @brief Defines the resumable transfer checkpoint stored on the SD card. */
+typedef struct __attribute__((packed))
+{
+    /** @brief Checkpoint magic. */
+    uint32_t            magic;
+    /** @brief Descriptor of the transfer. */
+    STransferDescriptor descriptor;
+    /** @brief Number of bytes received and synced in the partial file. */
+    uint32_t            received;
+} STransferCheckpoint;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASSES
+ ******************************************************************************/
+
+/**
+ * @brief Resumable transfer class.
+ *
+ * @details Resumable transfer class. An upload creates an instance and calls
+ * Begin to take the transfer prepared by CMD_RESUME_TRANSFER. When no transfer
+ * was prepared, the upload uses its regular non resumable path.
+ */
+class ResumableTransfer
+{
+    /********************* PUBLIC METHODS AND ATTRIBUTES **********************/
+    public:
+        /**
+         * @brief Construct a new Resumable Transfer object.
+         */
+        ResumableTransfer(void);
+
+        /**
+         * @brief Prepares a resumable transfer.
+         *
+         * @details Prepares a resumable transfer. When a checkpoint exists
+         * for the same descriptor, the transfer continues from it. Otherwise
+         * a new transfer is started. The offset to continue from is stored in
+         * the command response.
+         *
+         * @param[in] pkData The command data, a transfer descriptor.
+         * @param[out] rResponse The command response to fill.
+         */
+        static void Prepare(const uint8_t* pkData, SCommandResponse& rResponse);
+
+        /**
+         * @brief Takes the prepared transfer.
+         *
+         * @return true is returned if a transfer was prepared, false
+         * otherwise.
+         */
+        bool Begin(void);
+
+        /**
+         * @brief Opens the partial file.
+         *
+         * @details Opens the partial file. The data after the checkpoint is
+         * dropped and the file position is set at the checkpoint offset.
+         *
+         * @param[out] rFile The file that receives the partial file.
+         *
+         * @return true is returned on success, false otherwise.
+         */
+        bool Open(FsFile& rFile);
+
+        /**
+         * @brief Gets the offset to continue the transfer from.
+         *
+         * @return The offset to continue the transfer from is returned.
+         */
+        uint32_t GetOffset(void) const;
+
+        /**
+         * @brief Gets the size of the transfered data.
+         *
+         * @return The size of the transfered data is returned.
+         */
+        uint32_t GetTotalSize(void) const;
+
+        /**
+         * @brief Accounts data written to the partial file.
+         *
+         * @details Accounts data written to the partial file. The checkpoint
+         * is updated every TRANSFER_CHECKPOINT_INTERVAL bytes.
+         *
+         * @param[in, out] rFile The partial file.
+         * @param[in] kSize The number of bytes written.
+         */
+        void Advance(FsFile& rFile, const uint32_t kSize);
+
+        /**
+         * @brief Suspends the transfer.
+         *
+         * @details Suspends the transfer. The partial file is synced, the
+         * checkpoint updated and the file closed. The transfer can be resumed
+         * later.
+         *
+         * @param[in, out] rFile The partial file.
+         */
+        void Suspend(FsFile& rFile);
+
+        /**
+         * @brief Commits the transfer.
+         *
+         * @details Commits the transfer. The partial file is closed and
+         * renamed to its final path once its size and hash match the
+         * descriptor. On failure the transfer is aborted.
+         *
+         * @param[in, out] rFile The partial file.
+         * @param[in] rkPath The final path of the file.
+         *
+         * @return NO_ERROR is returned on success, an error code otherwise.
+         */
+        EErrorCode Commit(FsFile& rFile, const std::string& rkPath);
+
+        /**
+         * @brief Aborts the transfer.
+         *
+         * @details Aborts the transfer. The partial file is closed, the
+         * partial file and the checkpoint are removed.
+         *
+         * @param[in, out] rFile The partial file.
+         */
+        void Abort(FsFile& rFile);
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+        /* None */
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        /**
+         * @brief Loads the checkpoint.
+         *
+         * @param[in] pStore The storage service.
+         * @param[out] rCheckpoint The checkpoint to fill.
+         *
+         * @return true is returned if a valid checkpoint was loaded, false
+         * otherwise.
+         */
+        static bool LoadCheckpoint(Storage*             pStore,
+                                   STransferCheckpoint& rCheckpoint);
+
+        /**
+         * @brief Saves the checkpoint.
+         *
+         * @param[in] pStore The storage service.
+         * @param[in] rkCheckpoint The checkpoint to save.
+         *
+         * @return true is returned on success, false otherwise.
+         */
+        static bool SaveCheckpoint(Storage*                   pStore,
+                                   const STransferCheckpoint& rkCheckpoint);
+
+        /**
+         * @brief Checks the SHA-256 of a file.
+         *
+         * @param[in, out] rFile The file to check.
+         * @param[in] pkHash The expected hash.
+         *
+         * @return true is returned if the hash matches, false otherwise.
+         */
+        static bool CheckHash(FsFile& rFile, const uint8_t* pkHash);
+
+        /** @brief Tells if a transfer was prepared. */
+        static bool                IS_PREPARED_;
+        /** @brief Descriptor of the prepared transfer. */
+        static STransferDescriptor PREPARED_;
+
+        /** @brief Stores the storage singleton. */
+        Storage*            pStore_;
+        /** @brief Checkpoint of the transfer. */
+        STransferCheckpoint checkpoint_;
+        /** @brief Received byte count at the last saved checkpoint. */
+        uint32_t            savedReceived_;
+};
+
+#endif /* #ifndef __CORE_RESUMABLE_TRANSFER_H_ */
@@ -21,18 +21,20 @@
 /*******************************************************************************
  * INCLUDES
  ******************************************************************************/
-#include <map>      /* std::map */
-#include <vector>   /* std::vector */
-#include <SdFat.h>  /* SD Card driver */
-#include <cstdint>  /* Generic Int types */
-#include <Types.h>  /* ECB Types */
-#include <Logger.h> /* Logger service */
+#include <string>    /* std::string */
+#include <vector>    /* std::vector */
+#include <SdFat.h>   /* SD Card driver */
+#include <cstdint>   /* Generic Int types */
+#include <Types.h>   /* ECB Types */
+#include <Logger.h>  /* Logger service */
+#include <Arduino.h> /* Arduino framework */
 
 /*******************************************************************************
  * CONSTANTS
  ******************************************************************************/
 
-/* None */
+/** @brief Directory listing cursor returned after the last entry. */
+#define FILES_CURSOR_END 0xFFFFFFFF
 
 /*******************************************************************************
  * MACROS
@@ -43,7 +45,19 @@
 /*******************************************************************************
  * STRUCTURES AND TYPES
  ******************************************************************************/
-/* None */
+
+/** @brief Defines a directory listing entry. */
+typedef struct
+{
+    /** @brief File name. */
+    std::string name;
+    /** @brief File size in bytes. */
+    uint32_t    size;
+    /** @brief Last modification date, FAT format. */
+    uint16_t    modifyDate;
+    /** @brief Last modification time, FAT format. */
+    uint16_t    modifyTime;
+} SFileEntry;
 
 /*******************************************************************************
  * GLOBAL VARIABLES
@@ -93,6 +107,22 @@ class Storage
          */
         static Storage* GetInstance(void);
 
+        /**
+         * @brief Locks the storage.
+         *
+         * @details Locks the storage. The lock is recursive and taken by all
+         * the storage methods. Users that access opened files directly shall
+         * hold the lock for the duration of the access.
+         */
+        void Lock(void);
+
+        /**
+         * @brief Unlocks the storage.
+         *
+         * @details Unlocks the storage, releasing one level of Lock.
+         */
+        void Unlock(void);
+
         /**
          * @brief Get the Sd Card Type.
          *
@@ -146,6 +176,19 @@ class Storage
          */
         bool Remove(const std::string& rkFilename);
 
+        /**
+         * @brief Renames a file in the SD card.
+         *
+         * @details Renames a file in the SD card. If the destination file
+         * exists, it is replaced.
+         *
+         * @param[in] rkOldName The path to the file to rename.
+         * @param[in] rkNewName The new path of the file.
+         *
+         * @return true on success, false otherwise.
+         */
+        bool Rename(const std::string& rkOldName, const std::string& rkNewName);
+
         /**
          * @brief Checks if a file exists.
          *
@@ -162,37 +205,31 @@ class Storage
          *
          * @details Gets the full content of a file and stores it in the string
          * buffer. If the file does not exists it will be created and the
-         * default content stored. The function provides a caching function to
-         * avoid mutiple reads to the SD card.
+         * default content stored.
          *
          * @param[in] rkFilename The file to get the content from.
          * @param[in] pkDefaultContent The default content to store if the file
          * does not exists.
          * @param[out] rContent The buffer that receives the content of the
          * file.
-         * @param[in] kCacheable Defines if the content shall be cached.
          */
         void GetContent(const std::string& rkFilename,
                         const char*        pkDefaultContent,
-                        std::string&       rContent,
-                        const bool         kCacheable);
+                        std::string&       rContent);
 
         /**
          * @brief Sets the content of a file.
          *
          * @details Sets the full content of a file and stores it in the file,
          * If the file does not exists it will be created and the content
-         * stored. The function provides a caching function to
-         * avoid mutiple writes to the SD card.
+         * stored.
          *
          * @param[in] rkFilename The file to write the content to.
          * @param[out] rkContent The buffer that contains the content to store
          * to the file.
-         * @param[in] kCacheable Defines if the content shall be cached.
          */
         bool SetContent(const std::string& rkFilename,
-                        const std::string& rkContent,
-                        const bool         kCacheable);
+                        const std::string& rkContent);
 
         /**
          * @brief Formats the SD card.
@@ -202,14 +239,42 @@ class Storage
          */
         void Format(void);
 
-        void GetFilesListFrom(const std::string&        krDirectory,
-                              std::vector<std::string>& rList,
-                              const std::string&        rkStartName,
-                              const size_t              kPrev,
-                              const size_t              kCount);
-
+        /**
+         * @brief Gets the number of files of a directory.
+         *
+         * @details Gets the number of files of a directory, the
+         * sub-directories are skipped. The directory is scanned, the names
+         * are not kept.
+         *
+         * @param[in] krDirectory The directory to count the files of.
+         *
+         * @return The number of files is returned, 0 on error.
+         */
         size_t GetFilesCount(const std::string& krDirectory);
 
+        /**
+         * @brief Gets a page of the files of a directory.
+         *
+         * @details Gets the files following a cursor in a directory. The
+         * cursor is the position in the directory, the listing resumes where
+         * the previous page stopped without scanning the previous entries.
+         * The sub-directories are skipped.
+         *
+         * @param[in] rkDirectory The directory to list.
+         * @param[in] kCursor The cursor to start from, 0 for the first page.
+         * @param[in] kCount The maximal number of entries to get.
+         * @param[out] rEntries The entries of the page.
+         * @param[out] rNextCursor The cursor of the next page,
+         * FILES_CURSOR_END after the last entry.
+         *
+         * @return true is returned on success, false otherwise.
+         */
+        bool GetFilesPage(const std::string&       rkDirectory,
+                          const uint32_t           kCursor,
+                          const size_t             kCount,
+                          std::vector<SFileEntry>& rEntries,
+                          uint32_t&                rNextCursor);
+
     /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
     protected:
         /* None */
@@ -225,11 +290,8 @@ class Storage
         /** @brief Stores the initialization state. */
         bool init_;
 
-        /** @brief Cache map for cached content. */
-        std::map<std::string, std::string> cache_;
-
-        /** @brief Cache the file lists. */
-        std::map<std::string, std::vector<std::string>> fileLists_;
+        /** @brief Serializes the SD card accesses between tasks. */
+        SemaphoreHandle_t lock_;
 
         /** @brief Stores the singleton instance. */
         static Storage* PINSTANCE_;
@@ -22,9 +22,11 @@
  * INCLUDES
  ******************************************************************************/
 #include <queue>              /* std:: queue */
+#include <atomic>             /* std::atomic */
 #include <Menu.h>             /* Menu manager */
 #include <Types.h>            /* Defined types */
 #include <Storage.h>          /* Storage manager */
+#include <ConfigStore.h>      /* Configuration store */
 #include <LEDBorder.h>        /* LED border manager */
 #include <BatteryMgr.h>       /* Battery manager */
 #include <IOButtonMgr.h>      /* Button manager */
@@ -62,6 +64,30 @@ typedef enum
 /** @brief Command queue definition */
 typedef std::queue<std::pair<SCommandRequest, bool>> TCommandQueue;
 
+/** @brief Defines the command pipeline information. */
+typedef struct __attribute__((packed))
+{
+    /** @brief Maximal number of commands waiting for their response */
+    uint8_t maxInFlight;
+    /** @brief Number of commands waiting for their response */
+    uint8_t inFlight;
+    /** @brief Number of commands waiting for the EInk worker to be idle */
+    uint8_t deferred;
+    /** @brief Number of jobs queued to the EInk worker */
+    uint8_t workerJobs;
+} SPipelineInfo;
+
+/** @brief Defines a job executed by the EInk worker, which serializes the
+ * data channel users.
+ */
+typedef struct
+{
+    /** @brief The command to execute */
+    SCommandRequest request;
+    /** @brief Tells if a response shall be sent when the job is done */
+    bool            respond;
+} SEInkJob;
+
 /*******************************************************************************
  * GLOBAL VARIABLES
  ******************************************************************************/
@@ -117,6 +143,21 @@ class SystemState: public CommandHandler
         void SetSystemState(const ESystemState kState);
         void UpdateButtonsState(void);
         void ExecuteCommands(void);
+        void ExecuteDeferredCommands(void);
+        void ExecuteCommand(const std::pair<SCommandRequest, bool>& rkRequest);
+        void SendResponse(const SCommandRequest& rkRequest,
+                          SCommandResponse&      rResponse);
+        void DispatchCommand(const SCommandRequest& rkRequest,
+                             bool&                  rSendResponse,
+                             SCommandResponse&      rResponse);
+        void ExecuteBatch(const SCommandRequest& rkRequest,
+                          SCommandResponse&      rResponse);
+
+        void GetPipelineInfo(SCommandResponse& rResponse);
+
+        static bool IsBatchable(const ECommandType kType);
+        static bool IsWorkerCommand(const uint8_t kType);
+        static bool NeedsWorkerIdle(const uint8_t kType);
 
         void ManageDebugState(void);
         void ManageIdleState(void);
@@ -129,11 +170,25 @@ class SystemState: public CommandHandler
 
         void PerformUpdate(const uint8_t* kpData, SCommandResponse& rReponse);
 
+        EErrorCode EnqueueEInkJob(const SCommandRequest& rkRequest,
+                                  const bool             kRespond);
+        void ExecuteEInkJob(const SEInkJob& rkJob);
+        void WaitEInkIdle(void);
+
+        static void EInkJobRoutine(void* pStateParam);
+
         TCommandQueue commandsQueue_;
+        TCommandQueue deferredCommands_;
+
+        QueueHandle_t               eInkJobsQueue_;
+        TaskHandle_t                eInkThread_;
+        std::atomic<uint32_t>       eInkPendingJobs_;
+        std::atomic<uint32_t>       inFlightCommands_;
 
         SemaphoreHandle_t           commandsQueueLock_;
         Menu*                       pMenu_;
         Storage*                    pStore_;
+        ConfigStore*                pConfig_;
         LEDBorder*                  pLEDBorder_;
         BatteryManager*             pBatteryMgr_;
         IOButtonMgr*                pButtonMgr_;
@@ -27,6 +27,7 @@
 #include <cstdint>        /* Generic Types */
 #include <Types.h>        /* Custom types */
 #include <Storage.h>      /* Storage manager */
+#include <ConfigStore.h>  /* Configuration store */
 #include <FastLED.h>      /* Fast LED Service */
 #include <BlueToothMgr.h> /* Bleutooth services */
 
@@ -187,6 +188,7 @@ class LEDBorder
         std::vector<SLEDBorderPattern>   patterns_;
 
         Storage*                      pStore_;
+        ConfigStore*                  pConfig_;
         TaskHandle_t                  workerThread_;
         SemaphoreHandle_t             lock_;
 
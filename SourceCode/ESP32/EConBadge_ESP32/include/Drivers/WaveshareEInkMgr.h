@@ -21,11 +21,15 @@
 /*******************************************************************************
  * INCLUDES
  ******************************************************************************/
-#include <string>          /* std::string */
-#include <Types.h>         /* Defined Types */
-#include <Storage.h>       /* Storage service */
-#include <BlueToothMgr.h>  /* Bluetooth Manager */
-#include <WaveshareEInk.h> /* EInk Driver */
+#include <string>              /* std::string */
+#include <Types.h>             /* Defined Types */
+#include <Storage.h>           /* Storage service */
+#include <ConfigStore.h>       /* Configuration store */
+#include <ImageCatalog.h>      /* Image catalog */
+#include <ImageCodec.h>        /* Compressed images codec */
+#include <BlueToothMgr.h>      /* Bluetooth Manager */
+#include <WaveshareEInk.h>     /* EInk Driver */
+#include <ResumableTransfer.h> /* Resumable transfers */
 
 /*******************************************************************************
  * CONSTANTS
@@ -43,7 +47,44 @@
  * STRUCTURES AND TYPES
  ******************************************************************************/
 
-/* None */
+/** @brief Defines a chunk of image data exchanged in the display pipeline. */
+typedef struct
+{
+    /** @brief Buffer that contains the chunk data. */
+    uint8_t* pBuffer;
+    /** @brief Size of the data in the buffer, 0 or less ends the pipeline. */
+    ssize_t  size;
+} SImageChunk;
+
+/** @brief Defines the context of the image reader task. */
+typedef struct
+{
+    /** @brief The image file to read. */
+    FsFile*           pFile;
+    /** @brief Number of bytes left to read from the file. */
+    uint32_t          leftToRead;
+    /** @brief Queue of the buffers available to the reader. */
+    QueueHandle_t     freeQueue;
+    /** @brief Queue of the buffers filled by the reader. */
+    QueueHandle_t     fullQueue;
+    /** @brief Released when the reader task has ended. */
+    SemaphoreHandle_t doneLock;
+    /** @brief Time in microseconds the reader waited for a free buffer. */
+    uint64_t          blockedTime;
+    /** @brief Time in microseconds the reader spent reading the file. */
+    uint64_t          readTime;
+} SImageReader;
+
+/** @brief Defines the context of a file backed blit region. */
+typedef struct
+{
+    /** @brief The file that contains the region content. */
+    FsFile*  pFile;
+    /** @brief Offset in the file of the region first row. */
+    uint32_t dataOffset;
+    /** @brief Size in bytes of a row of the region in the file. */
+    uint32_t rowSize;
+} SEInkFileRegion;
 
 /*******************************************************************************
  * GLOBAL VARIABLES
@@ -138,7 +179,9 @@ class EInkDisplayManager
          * @brief Downloads and displays a new image.
          *
          * @details Downloads and displays a new image. The image will be
-         * stored in the SD card.
+         * stored in the SD card. Each received chunk is written to the SD card
+         * and sent to the panel in the same pass. On failure, the stored image
+         * and the displayed image are left untouched.
          *
          * @param[in] rkFilename The name of the image to display.
          * @param[out] rResponse The result of the action to be sent to the
@@ -160,6 +203,75 @@ class EInkDisplayManager
         void SendImageData(const std::string& rkFilename,
                            SCommandResponse&  rResponse) const;
 
+        /**
+         * @brief Starts the refresh of the EInk display.
+         *
+         * @details Starts the refresh of the EInk display with the image data
+         * sent to the panel and returns without waiting for the refresh to
+         * complete. WaitRefresh must be called to end the refresh.
+         *
+         * @return true is returned on success, false otherwise.
+         */
+        bool BeginRefresh(void);
+
+        /**
+         * @brief Tells if the EInk display refresh is done.
+         *
+         * @details Tells if the EInk display refresh is done. This function
+         * does not block.
+         *
+         * @return true is returned if the refresh is done, false otherwise.
+         */
+        bool IsRefreshDone(void) const;
+
+        /**
+         * @brief Waits for the EInk display refresh to complete.
+         *
+         * @details Waits for the EInk display refresh to complete and puts the
+         * display to sleep. The display is reset if the refresh times out.
+         *
+         * @param[in] kTimeout The timeout in milliseconds.
+         *
+         * @return true is returned on success, false on timeout.
+         */
+        bool WaitRefresh(const uint32_t kTimeout);
+
+        /**
+         * @brief Composes regions on the EInk display.
+         *
+         * @details Composes regions on the EInk display and refreshes it. The
+         * storage is held while the frame is sent, file backed regions can
+         * use ReadFileRegion as reader with a SEInkFileRegion context. The
+         * current image name is not modified.
+         *
+         * @param[in] pkRegions The regions to compose.
+         * @param[in] kRegionCount The number of regions.
+         * @param[in] kBackground The background color.
+         *
+         * @return true is returned on success, false otherwise.
+         */
+        bool DisplayRegions(const SEInkBlitRegion* pkRegions,
+                            const uint32_t         kRegionCount,
+                            const uint8_t          kBackground);
+
+        /**
+         * @brief Reads a row of a file backed blit region.
+         *
+         * @details Reads a row of a file backed blit region, see
+         * TEInkBlitReader.
+         *
+         * @param[in, out] pContext The region context, SEInkFileRegion.
+         * @param[in] kRow The row to read.
+         * @param[out] pBuffer The buffer that receives the row.
+         * @param[in] kSize The number of bytes to read.
+         *
+         * @return true is returned on success, false otherwise.
+         */
+        static bool ReadFileRegion(void*          pContext,
+                                   const uint32_t kRow,
+                                   uint8_t*       pBuffer,
+                                   const uint32_t kSize);
+
         /**
          * @brief Gets the currently displayed image name.
          *
@@ -180,16 +292,116 @@ class EInkDisplayManager
          */
         void SendImageList(SCommandResponse& rResponse) const;
 
+        /**
+         * @brief Sends a page of the list of stored images.
+         *
+         * @details Sends a page of the list of stored images. The page header
+         * is sent in the ack and the entries on the data channel, either as
+         * nul-terminated names or as SImageRecord records. The listing
+         * resumes at the request cursor, its cost depends on the page size
+         * only.
+         *
+         * @param[in] pkData The SImagePageRequest.
+         * @param[out] rResponse The result of the action to be sent to the
+         * client that requested the action.
+         */
+        void SendImagePage(const uint8_t*    pkData,
+                           SCommandResponse& rResponse) const;
+
     /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
     protected:
         /* None */
 
     /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
     private:
+        /**
+         * @brief Image reader routine.
+         *
+         * @details Image reader routine. The routine fills the free buffers
+         * with the image file content and sends them to the panel through the
+         * full buffers queue. A chunk of size 0 or less ends the pipeline.
+         *
+         * @param[in, out] pReaderParam The reader context, SImageReader.
+         */
+        static void ImageReaderRoutine(void* pReaderParam);
+
+        /**
+         * @brief Sets and saves the currently displayed image name.
+         *
+         * @param[in] rkFilename The name of the displayed image.
+         * @param[out] rResponse The result of the action to be sent to the
+         * client that requested the action.
+         */
+        void SetCurrentImageName(const std::string& rkFilename,
+                                 SCommandResponse&  rResponse);
+
+        /**
+         * @brief Opens a stored image.
+         *
+         * @details Opens a stored image and detects its encoding. On success,
+         * the file is positioned at the start of the image data.
+         *
+         * @param[in] rkFilename The name of the image to open.
+         * @param[out] rFile The opened file.
+         * @param[out] rDataSize The size of the image data in the file.
+         * @param[out] rIsCompressed Tells if the image data is compressed.
+         *
+         * @return The error code of the operation is returned.
+         */
+        EErrorCode OpenImage(const std::string& rkFilename,
+                             FsFile&            rFile,
+                             uint32_t&          rDataSize,
+                             bool&              rIsCompressed) const;
+
+        /**
+         * @brief Sends image data to the panel.
+         *
+         * @details Sends image data to the panel. When a decoder is provided,
+         * the data is decoded in the decode buffer before being sent.
+         *
+         * @param[in] pkData The image data.
+         * @param[in] kSize The size of the image data.
+         * @param[in, out] pDecoder The decoder to use, nullptr for raw data.
+         * @param[out] pDecodeBuffer The decode buffer, IMAGE_DECODE_BUFFER_SIZE
+         * bytes.
+         *
+         * @return The number of raw image bytes sent to the panel is returned.
+         */
+        uint32_t DisplayImageData(const uint8_t* pkData,
+                                  const size_t   kSize,
+                                  ImageDecoder*  pDecoder,
+                                  uint8_t*       pDecodeBuffer);
+
+        /**
+         * @brief Receives new image data.
+         *
+         * @details Receives new image data. The data stored before a resumed
+         * transfer was suspended is replayed from the file first, then the
+         * data is received and appended to the file.
+         *
+         * @param[in, out] rFile The image file.
+         * @param[out] pBuffer The buffer that receives the data.
+         * @param[in] kSize The size of the data to receive.
+         * @param[in, out] rReplayLeft The number of bytes left to replay.
+         * @param[in, out] pTransfer The resumed transfer, nullptr when the
+         * transfer is not resumable.
+         *
+         * @return NO_ERROR is returned on success, an error code otherwise.
+         */
+        EErrorCode ReceiveImageData(FsFile&            rFile,
+                                    uint8_t*           pBuffer,
+                                    const size_t       kSize,
+                                    uint32_t&          rReplayLeft,
+                                    ResumableTransfer* pTransfer);
+
         /** @brief Stores the name of the currently displayed image. */
         std::string       currentImageName_;
         /** @brief Stores the storage singleton. */
         Storage*          pStore_;
+        /** @brief Stores the configuration store singleton. */
+        ConfigStore*      pConfig_;
+        /** @brief Stores the image catalog singleton. */
+        ImageCatalog*     pCatalog_;
         /** @brief Stores the EInk driver. */
         WaveshareDriver   eInkDriver_;
         /** @brief Stores the bluetooth manager. */
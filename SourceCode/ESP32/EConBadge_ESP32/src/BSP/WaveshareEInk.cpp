@@ -53,6 +53,11 @@
 #include <Types.h>   /* Custom types */
 #include <HWMgr.h>   /* Hardware manager */
 #include <Arduino.h> /* Arduino services */
+#include <Logger.h>  /* Logger service */
+
+#if EINK_SPI_CAPTURE
+#include <esp_rom_crc.h> /* CRC32 services */
+#endif
 
 /* Header File */
 #include <WaveshareEInk.h>
@@ -61,20 +66,25 @@
  * CONSTANTS
  ******************************************************************************/
 
-/* None */
+/** @brief SPI clock used to communicate with the panel. */
+#define EINK_SPI_CLOCK 10000000
+
+/** @brief Size of the buffer used when sending fill bursts. */
+#define EINK_FILL_BUFFER_SIZE 64
+
+/** @brief Size in bytes of a full frame. */
+#define EINK_FRAME_SIZE ((EPD_WIDTH / 2) * EPD_HEIGHT)
+
+/** @brief Capture marker inserted when the DC line switches to command. */
+#define EINK_CAPTURE_CMD_MARKER 0xC0
+/** @brief Capture marker inserted when the DC line switches to data. */
+#define EINK_CAPTURE_DATA_MARKER 0xDA
 
 /*******************************************************************************
  * MACROS
  ******************************************************************************/
 
-/**
- * @brief Waits on the BUSY line until it is high.
- */
-#define BUSY_HIGH_WAIT() while(!digitalRead(GPIO_EINK_BUSY)){}
-/**
- * @brief Waits on the BUSY line until it is low.
- */
-#define BUSY_LOW_WAIT() while(digitalRead(GPIO_EINK_BUSY)){}
+/* None */
 
 /*******************************************************************************
  * STRUCTURES AND TYPES
@@ -90,7 +100,8 @@
 /* None */
 
 /************************* Exported global variables **************************/
-/* None */
+/** @brief See WaveshareEInk.h */
+SemaphoreHandle_t WaveshareDriver::BUSY_LOCK_ = nullptr;
 
 /************************** Static global variables ***************************/
 /* None */
@@ -113,6 +124,20 @@
 
 WaveshareDriver::WaveshareDriver(void)
 {
+    busyTimeout_ = EPD_BUSY_DEFAULT_TIMEOUT;
+    refreshing_  = false;
+    if(BUSY_LOCK_ == nullptr)
+    {
+        BUSY_LOCK_ = xSemaphoreCreateBinary();
+    }
+
+#if EINK_SPI_CAPTURE
+    captureCrc_          = 0;
+    captureCommandBytes_ = 0;
+    captureDataBytes_    = 0;
+    captureLastIsData_   = false;
+    captureStartTime_    = 0;
+#endif
 }
 
 void WaveshareDriver::Init(void)
@@ -122,11 +147,15 @@ void WaveshareDriver::Init(void)
     pinMode(GPIO_EINK_RESET, OUTPUT);
     pinMode(GPIO_EINK_DC, OUTPUT);
     pinMode(GPIO_EINK_BUSY, INPUT);
-    EINK_SPI.beginTransaction(SPISettings(2000000, MSBFIRST, SPI_MODE0));
+    attachInterrupt(digitalPinToInterrupt(GPIO_EINK_BUSY), BusyIsr, CHANGE);
+    EINK_SPI.beginTransaction(SPISettings(EINK_SPI_CLOCK, MSBFIRST, SPI_MODE0));
 
     /* Initialization sequence */
     Reset();
-    BUSY_HIGH_WAIT();
+    if(!WaitBusy(HIGH, busyTimeout_))
+    {
+        LOG_ERROR("EInk panel did not come out of reset.\n");
+    }
     SendCommand(0x00);
     SendData(0xEF);
     SendData(0x08);
@@ -168,6 +197,10 @@ void WaveshareDriver::SendCommand(const uint8_t kCommand)
     digitalWrite(GPIO_EINK_CS, LOW);
     EINK_SPI.transfer(kCommand);
     digitalWrite(GPIO_EINK_CS, HIGH);
+
+#if EINK_SPI_CAPTURE
+    CaptureBytes(false, &kCommand, 1);
+#endif
 }
 
 void WaveshareDriver::SendData(const uint8_t kData)
@@ -176,6 +209,57 @@ void WaveshareDriver::SendData(const uint8_t kData)
     digitalWrite(GPIO_EINK_CS, LOW);
     EINK_SPI.transfer(kData);
     digitalWrite(GPIO_EINK_CS, HIGH);
+
+#if EINK_SPI_CAPTURE
+    CaptureBytes(true, &kData, 1);
+#endif
+}
+
+void WaveshareDriver::SendDataBurst(const uint8_t* pkBuffer,
+                                    const uint32_t kSize)
+{
+    if(kSize == 0)
+    {
+        return;
+    }
+
+    digitalWrite(GPIO_EINK_DC, HIGH);
+    digitalWrite(GPIO_EINK_CS, LOW);
+    EINK_SPI.writeBytes(pkBuffer, kSize);
+    digitalWrite(GPIO_EINK_CS, HIGH);
+
+#if EINK_SPI_CAPTURE
+    CaptureBytes(true, pkBuffer, kSize);
+#endif
+}
+
+void WaveshareDriver::SendDataFill(const uint8_t kData, const uint32_t kCount)
+{
+    uint8_t  pFillBuffer[EINK_FILL_BUFFER_SIZE];
+    uint32_t toSend;
+    uint32_t left;
+
+    if(kCount == 0)
+    {
+        return;
+    }
+
+    memset(pFillBuffer, kData, MIN(kCount, EINK_FILL_BUFFER_SIZE));
+
+    digitalWrite(GPIO_EINK_DC, HIGH);
+    digitalWrite(GPIO_EINK_CS, LOW);
+    left = kCount;
+    while(left > 0)
+    {
+        toSend = MIN(left, EINK_FILL_BUFFER_SIZE);
+        EINK_SPI.writeBytes(pFillBuffer, toSend);
+        left -= toSend;
+
+#if EINK_SPI_CAPTURE
+        CaptureBytes(true, pFillBuffer, toSend);
+#endif
+    }
+    digitalWrite(GPIO_EINK_CS, HIGH);
 }
 
 void WaveshareDriver::Reset(void)
@@ -186,155 +270,312 @@ void WaveshareDriver::Reset(void)
     HWManager::DelayExecUs(500000);
 }
 
-void WaveshareDriver::Display(const uint8_t* pImage)
+bool WaveshareDriver::Display(const uint8_t* pImage)
 {
-    uint32_t i;
-    uint32_t j;
-
-    /* Set Resolution setting */
-    SendCommand(0x61);
-    SendData(0x02);
-    SendData(0x58);
-    SendData(0x01);
-    SendData(0xC0);
-    SendCommand(0x10);
+    StartFrame();
 
     /* Send the image */
-    for(i = 0; i < EPD_HEIGHT; ++i)
-    {
-        for(j = 0; j < EPD_WIDTH / 2; ++j)
-        {
-            SendData(pImage[j + ((EPD_WIDTH / 2) * i)]);
-        }
-    }
+    SendDataBurst(pImage, EINK_FRAME_SIZE);
 
-    SendCommand(0x04);
-    BUSY_HIGH_WAIT();
-    SendCommand(0x12);
-    BUSY_HIGH_WAIT();
-    SendCommand(0x02);
-    BUSY_LOW_WAIT();
-    HWManager::DelayExecUs(500000);
+    return EndFrame();
 }
 
 void WaveshareDriver::DisplayInitTrans(void)
 {
-    /* Set the resolution setting */
-    SendCommand(0x61);
-    SendData(0x02);
-    SendData(0x58);
-    SendData(0x01);
-    SendData(0xC0);
-    SendCommand(0x10);
+    StartFrame();
 }
 
 void WaveshareDriver::DisplayPerformTrans(const uint8_t* pkBuffer,
                                           const uint32_t kSize)
 {
-    uint32_t i;
+    SendDataBurst(pkBuffer, kSize);
+}
 
-    for(i = 0; i < kSize; ++i)
-    {
-        SendData(pkBuffer[i]);
-    }
+bool WaveshareDriver::DisplayEndTrans(void)
+{
+    return EndFrame();
 }
 
-void WaveshareDriver::DisplayEndTrans(void)
+bool WaveshareDriver::BeginRefresh(void)
 {
+    /* Power on */
     SendCommand(0x04);
-    BUSY_HIGH_WAIT();
+    if(!WaitBusy(HIGH, busyTimeout_))
+    {
+        LOG_ERROR("EInk panel power on timed out.\n");
+        Reset();
+        return false;
+    }
+
+    /* Start the refresh */
     SendCommand(0x12);
-    BUSY_HIGH_WAIT();
+    refreshing_ = true;
+
+    return true;
+}
+
+bool WaveshareDriver::IsRefreshDone(void) const
+{
+    return !refreshing_ || digitalRead(GPIO_EINK_BUSY) == HIGH;
+}
+
+bool WaveshareDriver::WaitRefresh(const uint32_t kTimeout)
+{
+    if(!refreshing_)
+    {
+        return true;
+    }
+    refreshing_ = false;
+
+    if(!WaitBusy(HIGH, kTimeout))
+    {
+        LOG_ERROR("EInk panel refresh timed out.\n");
+        Reset();
+        return false;
+    }
+
+    /* Power off */
     SendCommand(0x02);
-    BUSY_LOW_WAIT();
+    if(!WaitBusy(LOW, busyTimeout_))
+    {
+        LOG_ERROR("EInk panel power off timed out.\n");
+        Reset();
+        return false;
+    }
     HWManager::DelayExecUs(500000);
+
+    return true;
 }
 
-void WaveshareDriver::DisplayPart(const uint8_t* pImage,
-                                  uint32_t       xStart,
-                                  uint32_t       yStart,
-                                  uint32_t       imageWidth,
-                                  uint32_t       imageHeigh)
+void WaveshareDriver::SetBusyTimeout(const uint32_t kTimeout)
 {
-    uint32_t i;
-    uint32_t j;
-
-    /* Set Resolution setting */
-    SendCommand(0x61);
-    SendData(0x02);
-    SendData(0x58);
-    SendData(0x01);
-    SendData(0xC0);
-    SendCommand(0x10);
+    busyTimeout_ = kTimeout;
+}
 
-    for(i = 0; i < EPD_HEIGHT; ++i)
+bool WaveshareDriver::Blit(const SEInkBlitRegion* pkRegions,
+                           const uint32_t         kRegionCount,
+                           const uint8_t          kBackground)
+{
+    uint32_t               i;
+    uint32_t               line;
+    uint32_t               row;
+    uint32_t               start;
+    uint32_t               end;
+    bool                   status;
+    const SEInkBlitRegion* pkRegion;
+
+    StartFrame();
+
+    status = true;
+    for(line = 0; line < EPD_HEIGHT; ++line)
     {
-        for(j = 0; j < EPD_WIDTH / 2; ++j)
+        memset(pLineBuffer_,
+               (kBackground << 4) | kBackground,
+               sizeof(pLineBuffer_));
+
+        /* Compose the line, runs are computed in bytes */
+        for(i = 0; i < kRegionCount && status; ++i)
         {
-            if(i < imageHeigh + yStart &&
-               i >= yStart &&
-               j < (imageWidth + xStart) / 2 &&
-               j >= xStart / 2)
+            pkRegion = &pkRegions[i];
+            if(line < pkRegion->y ||
+               line - pkRegion->y >= pkRegion->height)
             {
-                SendData(
-                    pgm_read_byte(&pImage[(j - xStart / 2) +
-                                          (imageWidth / 2 * (i - yStart))])
-                );
+                continue;
             }
-            else
+
+            start = MIN(pkRegion->x / 2, EPD_WIDTH / 2);
+            end   = MIN((pkRegion->x + pkRegion->width) / 2, EPD_WIDTH / 2);
+            if(end <= start)
+            {
+                continue;
+            }
+            row = line - pkRegion->y;
+
+            switch(pkRegion->source)
             {
-                SendData(0x11);
+                case EINK_BLIT_FILL:
+                    memset(pLineBuffer_ + start,
+                           (pkRegion->color << 4) | pkRegion->color,
+                           end - start);
+                    break;
+                case EINK_BLIT_BUFFER:
+                    memcpy(pLineBuffer_ + start,
+                           pkRegion->pkBuffer + row * (pkRegion->width / 2),
+                           end - start);
+                    break;
+                case EINK_BLIT_READER:
+                    status = pkRegion->reader(pkRegion->pReaderContext,
+                                              row,
+                                              pLineBuffer_ + start,
+                                              end - start);
+                    break;
+                default:
+                    break;
             }
         }
+
+        if(!status)
+        {
+            LOG_ERROR("Failed to read blit region %d.\n", i - 1);
+            return false;
+        }
+
+        SendDataBurst(pLineBuffer_, sizeof(pLineBuffer_));
     }
-    SendCommand(0x04);
-    BUSY_HIGH_WAIT();
-    SendCommand(0x12);
-    BUSY_HIGH_WAIT();
-    SendCommand(0x02);
-    BUSY_LOW_WAIT();
-    HWManager::DelayExecUs(500000);
+
+    return true;
+}
+
+bool WaveshareDriver::DisplayPart(const uint8_t* pImage,
+                                  uint32_t       xStart,
+                                  uint32_t       yStart,
+                                  uint32_t       imageWidth,
+                                  uint32_t       imageHeigh)
+{
+    SEInkBlitRegion region;
+
+    region.x              = xStart;
+    region.y              = yStart;
+    region.width          = imageWidth;
+    region.height         = imageHeigh;
+    region.source         = EINK_BLIT_BUFFER;
+    region.color          = EPD_5IN65F_WHITE;
+    region.pkBuffer       = pImage;
+    region.reader         = nullptr;
+    region.pReaderContext = nullptr;
+
+    return Blit(&region, 1, EPD_5IN65F_WHITE) && EndFrame();
+}
+
+bool WaveshareDriver::Clear(const uint8_t kColor)
+{
+    StartFrame();
+
+    SendDataFill((kColor << 4) | kColor, EINK_FRAME_SIZE);
+
+    return EndFrame();
+}
+
+void WaveshareDriver::Sleep(void)
+{
+    HWManager::DelayExecUs(100000);
+    SendCommand(0x07);
+    SendData(0xA5);
+    HWManager::DelayExecUs(100000);
+    digitalWrite(GPIO_EINK_RESET, 0);
+    HWManager::DelayExecUs(50000);
+
+    /* End the SPI transation */
+    EINK_SPI.endTransaction();
 }
 
-void WaveshareDriver::Clear(const uint8_t kColor)
+void WaveshareDriver::StartFrame(void)
 {
-    uint32_t i;
-    uint32_t j;
+#if EINK_SPI_CAPTURE
+    captureCrc_          = 0;
+    captureCommandBytes_ = 0;
+    captureDataBytes_    = 0;
+    captureLastIsData_   = false;
+    captureStartTime_    = HWManager::GetTime();
+#endif
 
-    /* Set Resolution setting */
+    /* Set the resolution setting */
     SendCommand(0x61);
     SendData(0x02);
     SendData(0x58);
     SendData(0x01);
     SendData(0xC0);
     SendCommand(0x10);
+}
 
-    for(i = 0; i < EPD_WIDTH / 2; ++i)
+bool WaveshareDriver::EndFrame(void)
+{
+    bool status;
+#if EINK_SPI_CAPTURE
+    uint64_t refreshStartTime;
+
+    refreshStartTime = HWManager::GetTime();
+#endif
+
+    status = BeginRefresh() && WaitRefresh(busyTimeout_);
+
+#if EINK_SPI_CAPTURE
+    LOG_INFO(
+        "EInk frame: CRC 0x%08X, %u cmd bytes, %u data bytes, "
+        "push %lluus, refresh %lluus\n",
+        captureCrc_,
+        captureCommandBytes_,
+        captureDataBytes_,
+        refreshStartTime - captureStartTime_,
+        HWManager::GetTime() - refreshStartTime
+    );
+#endif
+
+    return status;
+}
+
+bool WaveshareDriver::WaitBusy(const uint8_t kLevel, const uint32_t kTimeout)
+{
+    uint64_t startTime;
+    uint64_t elapsed;
+
+    /* Drop stale edges, then wait for edges until the level is reached */
+    xSemaphoreTake(BUSY_LOCK_, 0);
+    startTime = HWManager::GetTime();
+    while(digitalRead(GPIO_EINK_BUSY) != kLevel)
     {
-        for(j = 0; j < EPD_HEIGHT; ++j)
+        elapsed = (HWManager::GetTime() - startTime) / 1000;
+        if(elapsed >= kTimeout)
         {
-            SendData((kColor << 4) | kColor);
+            return false;
         }
+        xSemaphoreTake(
+            BUSY_LOCK_,
+            (kTimeout - elapsed) / portTICK_PERIOD_MS + 1
+        );
     }
 
-    SendCommand(0x04);
-    BUSY_HIGH_WAIT();
-    SendCommand(0x12);
-    BUSY_HIGH_WAIT();
-    SendCommand(0x02);
-    BUSY_LOW_WAIT();
-    HWManager::DelayExecUs(500000);
+    return true;
 }
 
-void WaveshareDriver::Sleep(void)
+void IRAM_ATTR WaveshareDriver::BusyIsr(void)
 {
-    HWManager::DelayExecUs(100000);
-    SendCommand(0x07);
-    SendData(0xA5);
-    HWManager::DelayExecUs(100000);
-    digitalWrite(GPIO_EINK_RESET, 0);
-    HWManager::DelayExecUs(50000);
+    BaseType_t higherPriorityTaskWoken;
 
-    /* End the SPI transation */
-    EINK_SPI.endTransaction();
-}
\ No newline at end of file
+    higherPriorityTaskWoken = pdFALSE;
+    xSemaphoreGiveFromISR(BUSY_LOCK_, &higherPriorityTaskWoken);
+    if(higherPriorityTaskWoken == pdTRUE)
+    {
+        portYIELD_FROM_ISR();
+    }
+}
+
+#if EINK_SPI_CAPTURE
+void WaveshareDriver::CaptureBytes(const bool     kIsData,
+                                   const uint8_t* pkBuffer,
+                                   const uint32_t kSize)
+{
+    uint8_t marker;
+
+    /* Mark each command and the start of each data sequence so that the CRC
+     * covers the command / data layout regardless of how the data bytes were
+     * split in bursts.
+     */
+    if(!kIsData || !captureLastIsData_)
+    {
+        marker = kIsData ? EINK_CAPTURE_DATA_MARKER : EINK_CAPTURE_CMD_MARKER;
+        captureCrc_ = esp_rom_crc32_le(captureCrc_, &marker, 1);
+    }
+    captureLastIsData_ = kIsData;
+
+    captureCrc_ = esp_rom_crc32_le(captureCrc_, pkBuffer, kSize);
+    if(kIsData)
+    {
+        captureDataBytes_ += kSize;
+    }
+    else
+    {
+        captureCommandBytes_ += kSize;
+    }
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,373 @@
+/*******************************************************************************
+ * @file ContentCache.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file implements the bounded content cache.
+ *
+ * @details This file implements the bounded content cache. The free blocks are
+ * chained in a free list, an entry owns a chain of blocks sized to its
+ * content. The cache lookups are linear, the cache holds few entries.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstring> /* memcpy, strcmp */
+#include <Types.h> /* Defined types */
+
+/* Header file */
+#include <ContentCache.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+ContentCache::ContentCache(void)
+{
+    memset(&stats_, 0, sizeof(SContentCacheStats));
+    stats_.budget = CONTENT_CACHE_BLOCK_COUNT * CONTENT_CACHE_BLOCK_SIZE;
+
+    Clear();
+}
+
+bool ContentCache::Get(const std::string& rkKey, std::string& rContent)
+{
+    uint8_t  entry;
+    uint8_t  block;
+    uint16_t left;
+    uint16_t chunk;
+
+    entry = Find(rkKey);
+    if(entry == CONTENT_CACHE_NONE)
+    {
+        ++stats_.misses;
+        return false;
+    }
+
+    rContent.clear();
+    rContent.reserve(pEntries_[entry].size);
+
+    left  = pEntries_[entry].size;
+    block = pEntries_[entry].firstBlock;
+    while(left != 0)
+    {
+        chunk = MIN(left, (uint16_t)CONTENT_CACHE_BLOCK_SIZE);
+        rContent.append((const char*)pBlocks_[block], chunk);
+        left -= chunk;
+        block = pNextBlock_[block];
+    }
+
+    Unlink(entry);
+    LinkFront(entry);
+
+    ++stats_.hits;
+    return true;
+}
+
+bool ContentCache::Set(const std::string& rkKey, const std::string& rkContent)
+{
+    uint8_t entry;
+    uint8_t block;
+    uint8_t i;
+    size_t  neededBlocks;
+    size_t  offset;
+    size_t  chunk;
+    bool    isPinned;
+
+    neededBlocks = (rkContent.size() + CONTENT_CACHE_BLOCK_SIZE - 1) /
+                   CONTENT_CACHE_BLOCK_SIZE;
+
+    /* Do not keep a stale content of the key */
+    entry    = Find(rkKey);
+    isPinned = false;
+    if(entry != CONTENT_CACHE_NONE)
+    {
+        isPinned = pEntries_[entry].pinned;
+        FreeEntry(entry);
+    }
+
+    if(rkKey.size() >= CONTENT_CACHE_KEY_SIZE ||
+       neededBlocks > CONTENT_CACHE_BLOCK_COUNT)
+    {
+        ++stats_.rejects;
+        return false;
+    }
+
+    /* Make room, the pinned entries are kept */
+    while(freeBlockCount_ < neededBlocks ||
+          stats_.entries == CONTENT_CACHE_ENTRY_COUNT)
+    {
+        if(!EvictOne())
+        {
+            ++stats_.rejects;
+            return false;
+        }
+    }
+
+    entry = 0;
+    for(i = 0; i < CONTENT_CACHE_ENTRY_COUNT; ++i)
+    {
+        if(!pEntries_[i].used)
+        {
+            entry = i;
+            break;
+        }
+    }
+
+    memcpy(pEntries_[entry].pKey, rkKey.c_str(), rkKey.size() + 1);
+    pEntries_[entry].size       = rkContent.size();
+    pEntries_[entry].firstBlock = CONTENT_CACHE_NONE;
+    pEntries_[entry].used       = true;
+    pEntries_[entry].pinned     = isPinned;
+
+    /* Copy the content, the chain is built backwards */
+    offset = neededBlocks * CONTENT_CACHE_BLOCK_SIZE;
+    while(neededBlocks != 0)
+    {
+        --neededBlocks;
+        offset -= CONTENT_CACHE_BLOCK_SIZE;
+        chunk   = MIN(rkContent.size() - offset,
+                      (size_t)CONTENT_CACHE_BLOCK_SIZE);
+
+        block       = freeBlock_;
+        freeBlock_  = pNextBlock_[block];
+        --freeBlockCount_;
+
+        memcpy(pBlocks_[block], rkContent.data() + offset, chunk);
+        pNextBlock_[block]          = pEntries_[entry].firstBlock;
+        pEntries_[entry].firstBlock = block;
+    }
+
+    LinkFront(entry);
+
+    ++stats_.entries;
+    stats_.usedBytes += rkContent.size();
+    if(isPinned)
+    {
+        ++stats_.pinned;
+    }
+
+    return true;
+}
+
+void ContentCache::Remove(const std::string& rkKey)
+{
+    uint8_t entry;
+
+    entry = Find(rkKey);
+    if(entry != CONTENT_CACHE_NONE)
+    {
+        FreeEntry(entry);
+    }
+}
+
+bool ContentCache::SetPinned(const std::string& rkKey, const bool kPinned)
+{
+    uint8_t entry;
+
+    entry = Find(rkKey);
+    if(entry == CONTENT_CACHE_NONE)
+    {
+        return false;
+    }
+
+    if(pEntries_[entry].pinned != kPinned)
+    {
+        pEntries_[entry].pinned = kPinned;
+        if(kPinned)
+        {
+            ++stats_.pinned;
+        }
+        else
+        {
+            --stats_.pinned;
+        }
+    }
+
+    return true;
+}
+
+void ContentCache::Clear(void)
+{
+    uint8_t i;
+
+    for(i = 0; i < CONTENT_CACHE_ENTRY_COUNT; ++i)
+    {
+        pEntries_[i].used   = false;
+        pEntries_[i].pinned = false;
+    }
+
+    for(i = 0; i < CONTENT_CACHE_BLOCK_COUNT - 1; ++i)
+    {
+        pNextBlock_[i] = i + 1;
+    }
+    pNextBlock_[CONTENT_CACHE_BLOCK_COUNT - 1] = CONTENT_CACHE_NONE;
+
+    freeBlock_       = 0;
+    freeBlockCount_  = CONTENT_CACHE_BLOCK_COUNT;
+    mru_             = CONTENT_CACHE_NONE;
+    lru_             = CONTENT_CACHE_NONE;
+    stats_.usedBytes = 0;
+    stats_.entries   = 0;
+    stats_.pinned    = 0;
+}
+
+void ContentCache::GetStats(SContentCacheStats& rStats) const
+{
+    rStats = stats_;
+}
+
+uint8_t ContentCache::Find(const std::string& rkKey) const
+{
+    uint8_t i;
+
+    for(i = 0; i < CONTENT_CACHE_ENTRY_COUNT; ++i)
+    {
+        if(pEntries_[i].used && strcmp(pEntries_[i].pKey, rkKey.c_str()) == 0)
+        {
+            return i;
+        }
+    }
+
+    return CONTENT_CACHE_NONE;
+}
+
+void ContentCache::LinkFront(const uint8_t kEntry)
+{
+    pEntries_[kEntry].prev = CONTENT_CACHE_NONE;
+    pEntries_[kEntry].next = mru_;
+    if(mru_ != CONTENT_CACHE_NONE)
+    {
+        pEntries_[mru_].prev = kEntry;
+    }
+    else
+    {
+        lru_ = kEntry;
+    }
+    mru_ = kEntry;
+}
+
+void ContentCache::Unlink(const uint8_t kEntry)
+{
+    if(pEntries_[kEntry].prev != CONTENT_CACHE_NONE)
+    {
+        pEntries_[pEntries_[kEntry].prev].next = pEntries_[kEntry].next;
+    }
+    else
+    {
+        mru_ = pEntries_[kEntry].next;
+    }
+
+    if(pEntries_[kEntry].next != CONTENT_CACHE_NONE)
+    {
+        pEntries_[pEntries_[kEntry].next].prev = pEntries_[kEntry].prev;
+    }
+    else
+    {
+        lru_ = pEntries_[kEntry].prev;
+    }
+}
+
+void ContentCache::ReleaseBlocks(const uint8_t kEntry)
+{
+    uint8_t block;
+    uint8_t next;
+
+    block = pEntries_[kEntry].firstBlock;
+    while(block != CONTENT_CACHE_NONE)
+    {
+        next               = pNextBlock_[block];
+        pNextBlock_[block] = freeBlock_;
+        freeBlock_         = block;
+        ++freeBlockCount_;
+        block = next;
+    }
+    pEntries_[kEntry].firstBlock = CONTENT_CACHE_NONE;
+}
+
+void ContentCache::FreeEntry(const uint8_t kEntry)
+{
+    ReleaseBlocks(kEntry);
+    Unlink(kEntry);
+
+    --stats_.entries;
+    stats_.usedBytes -= pEntries_[kEntry].size;
+    if(pEntries_[kEntry].pinned)
+    {
+        --stats_.pinned;
+    }
+
+    pEntries_[kEntry].used   = false;
+    pEntries_[kEntry].pinned = false;
+}
+
+bool ContentCache::EvictOne(void)
+{
+    uint8_t entry;
+
+    entry = lru_;
+    while(entry != CONTENT_CACHE_NONE && pEntries_[entry].pinned)
+    {
+        entry = pEntries_[entry].prev;
+    }
+
+    if(entry == CONTENT_CACHE_NONE)
+    {
+        return false;
+    }
+
+    FreeEntry(entry);
+    ++stats_.evictions;
+
+    return true;
+}
@@ -0,0 +1,195 @@
+/*******************************************************************************
+ * @file ImageCodec.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file implements the compressed image codec.
+ *
+ * @details This file implements the compressed image codec. See ImageCodec.h
+ * for the format description.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstring> /* memcpy, memset */
+#include <Types.h> /* Defined types */
+
+/* Header file */
+#include <ImageCodec.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Repeat token flag. */
+#define IMAGE_CODEC_REPEAT_FLAG 0x80
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+
+/** @brief Compressed image magic. */
+static const uint8_t skpImageMagic[IMAGE_CODEC_MAGIC_SIZE] = {
+    0xEC, 0xB1, 'R', 'L'
+};
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+ImageDecoder::ImageDecoder(void)
+{
+    Reset(0);
+}
+
+bool ImageDecoder::IsCompressed(const SImageCodecHeader& rkHeader)
+{
+    return memcmp(rkHeader.pMagic, skpImageMagic, IMAGE_CODEC_MAGIC_SIZE) == 0;
+}
+
+bool ImageDecoder::IsValid(const SImageCodecHeader& rkHeader,
+                           const uint32_t           kRawSize)
+{
+    return IsCompressed(rkHeader) &&
+           rkHeader.rawSize == kRawSize &&
+           rkHeader.dataSize > 0 &&
+           rkHeader.dataSize <= IMAGE_CODEC_MAX_DATA_SIZE(kRawSize);
+}
+
+void ImageDecoder::Reset(const uint32_t kRawSize)
+{
+    state_    = DECODE_TOKEN;
+    runLeft_  = 0;
+    runValue_ = 0;
+    rawLeft_  = kRawSize;
+    error_    = false;
+}
+
+size_t ImageDecoder::Decode(const uint8_t* pkInput,
+                            const size_t   kInputSize,
+                            size_t&        rConsumed,
+                            uint8_t*       pOutput,
+                            const size_t   kOutputSize)
+{
+    size_t  produced;
+    size_t  toCopy;
+    uint8_t token;
+
+    rConsumed = 0;
+    produced  = 0;
+
+    while(!error_ && rawLeft_ > 0 && produced < kOutputSize)
+    {
+        if(state_ == DECODE_REPEAT)
+        {
+            toCopy = MIN(runLeft_, kOutputSize - produced);
+            memset(pOutput + produced, runValue_, toCopy);
+        }
+        else if(rConsumed == kInputSize)
+        {
+            /* Need more input */
+            break;
+        }
+        else if(state_ == DECODE_LITERAL)
+        {
+            toCopy = MIN(runLeft_, kOutputSize - produced);
+            toCopy = MIN(toCopy, kInputSize - rConsumed);
+            memcpy(pOutput + produced, pkInput + rConsumed, toCopy);
+            rConsumed += toCopy;
+        }
+        else
+        {
+            token = pkInput[rConsumed++];
+            if(state_ == DECODE_TOKEN)
+            {
+                if((token & IMAGE_CODEC_REPEAT_FLAG) != 0)
+                {
+                    runLeft_ = (uint32_t)(token & 0x7F) << 8;
+                    state_   = DECODE_REPEAT_COUNT;
+                }
+                else
+                {
+                    runLeft_ = (uint32_t)token + 1;
+                    state_   = DECODE_LITERAL;
+                }
+            }
+            else if(state_ == DECODE_REPEAT_COUNT)
+            {
+                runLeft_ = (runLeft_ | token) + 1;
+                state_   = DECODE_REPEAT_VALUE;
+            }
+            else
+            {
+                runValue_ = token;
+                state_    = DECODE_REPEAT;
+            }
+
+            /* A run cannot overflow the image */
+            if((state_ == DECODE_LITERAL || state_ == DECODE_REPEAT) &&
+               runLeft_ > rawLeft_)
+            {
+                error_ = true;
+            }
+            continue;
+        }
+
+        produced += toCopy;
+        runLeft_ -= toCopy;
+        rawLeft_ -= toCopy;
+        if(runLeft_ == 0)
+        {
+            state_ = DECODE_TOKEN;
+        }
+    }
+
+    return produced;
+}
+
+bool ImageDecoder::IsDone(void) const
+{
+    return !error_ && rawLeft_ == 0;
+}
+
+bool ImageDecoder::HasError(void) const
+{
+    return error_;
+}
@@ -0,0 +1,454 @@
+/*******************************************************************************
+ * @file LinkCodec.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file implements the link compression codec.
+ *
+ * @details This file implements the link compression codec. See LinkCodec.h
+ * for the format description.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstring> /* memcpy, memset */
+#include <Types.h> /* Defined types */
+
+/* Header file */
+#include <LinkCodec.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Token nibble value announcing extension bytes. */
+#define LINK_CODEC_EXTENDED 15
+
+/** @brief Number of entries in the match finder hash table. */
+#define LINK_CODEC_HASH_SIZE (1 << LINK_CODEC_HASH_BITS)
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/**
+ * @brief Hashes the first LINK_CODEC_MIN_MATCH bytes of a buffer.
+ *
+ * @param[in] pkData The data to hash.
+ *
+ * @return The hash table index is returned.
+ */
+static inline uint32_t Hash(const uint8_t* pkData);
+
+/**
+ * @brief Writes a length extension.
+ *
+ * @param[out] pOutput The buffer that receives the extension bytes.
+ * @param[in] kValue The value to write.
+ *
+ * @return The number of bytes written is returned.
+ */
+static size_t WriteLength(uint8_t* pOutput, size_t kValue);
+
+/**
+ * @brief Writes a sequence.
+ *
+ * @param[out] pOutput The buffer that receives the sequence.
+ * @param[in] pkLiterals The sequence literals.
+ * @param[in] kLiteralCount The number of literals.
+ * @param[in] kOffset The match offset.
+ * @param[in] kMatchLength The match length, 0 if the sequence has no match.
+ *
+ * @return The number of bytes written is returned.
+ */
+static size_t WriteSequence(uint8_t*       pOutput,
+                            const uint8_t* pkLiterals,
+                            const size_t   kLiteralCount,
+                            const size_t   kOffset,
+                            const size_t   kMatchLength);
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+static inline uint32_t Hash(const uint8_t* pkData)
+{
+    uint32_t value;
+
+    value = pkData[0] | (pkData[1] << 8) | (pkData[2] << 16);
+
+    return (value * 2654435761U) >> (32 - LINK_CODEC_HASH_BITS);
+}
+
+static size_t WriteLength(uint8_t* pOutput, size_t kValue)
+{
+    size_t size;
+
+    size = 0;
+    while(kValue >= 255)
+    {
+        pOutput[size++] = 255;
+        kValue -= 255;
+    }
+    pOutput[size++] = kValue;
+
+    return size;
+}
+
+static size_t WriteSequence(uint8_t*       pOutput,
+                            const uint8_t* pkLiterals,
+                            const size_t   kLiteralCount,
+                            const size_t   kOffset,
+                            const size_t   kMatchLength)
+{
+    size_t  size;
+    uint8_t literalCode;
+    uint8_t matchCode;
+
+    literalCode = MIN(kLiteralCount, LINK_CODEC_EXTENDED);
+    matchCode   = 0;
+    if(kMatchLength != 0)
+    {
+        matchCode = MIN(kMatchLength - LINK_CODEC_MIN_MATCH + 1,
+                        LINK_CODEC_EXTENDED);
+    }
+
+    size = 0;
+    pOutput[size++] = (literalCode << 4) | matchCode;
+    if(literalCode == LINK_CODEC_EXTENDED)
+    {
+        size += WriteLength(pOutput + size,
+                            kLiteralCount - LINK_CODEC_EXTENDED);
+    }
+    memcpy(pOutput + size, pkLiterals, kLiteralCount);
+    size += kLiteralCount;
+
+    if(matchCode != 0)
+    {
+        pOutput[size++] = kOffset & 0xFF;
+        pOutput[size++] = (kOffset >> 8) & 0xFF;
+        if(matchCode == LINK_CODEC_EXTENDED)
+        {
+            size += WriteLength(
+                pOutput + size,
+                kMatchLength - LINK_CODEC_MIN_MATCH + 1 - LINK_CODEC_EXTENDED
+            );
+        }
+    }
+
+    return size;
+}
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+LinkEncoder::LinkEncoder(void)
+{
+    Reset();
+}
+
+void LinkEncoder::Reset(void)
+{
+    memset(pHead_, 0, sizeof(pHead_));
+    historySize_ = 0;
+}
+
+size_t LinkEncoder::Encode(const uint8_t* pkInput,
+                           const size_t   kInputSize,
+                           uint8_t*       pOutput)
+{
+    size_t   i;
+    size_t   pos;
+    size_t   end;
+    size_t   literalStart;
+    size_t   candidate;
+    size_t   length;
+    size_t   encoded;
+    size_t   shift;
+    uint32_t hash;
+
+    if(kInputSize == 0 || kInputSize > LINK_CODEC_BLOCK)
+    {
+        return 0;
+    }
+
+    memcpy(pBuffer_ + historySize_, pkInput, kInputSize);
+    end          = historySize_ + kInputSize;
+    pos          = historySize_;
+    literalStart = pos;
+    encoded      = 0;
+
+    /* Greedy parsing, one candidate per hash */
+    while(pos + LINK_CODEC_MIN_MATCH <= end)
+    {
+        hash      = Hash(pBuffer_ + pos);
+        candidate = pHead_[hash];
+        pHead_[hash] = pos + 1;
+
+        if(candidate == 0 || pos - (candidate - 1) > LINK_CODEC_WINDOW ||
+           memcmp(pBuffer_ + candidate - 1,
+                  pBuffer_ + pos,
+                  LINK_CODEC_MIN_MATCH) != 0)
+        {
+            ++pos;
+            continue;
+        }
+        --candidate;
+
+        length = LINK_CODEC_MIN_MATCH;
+        while(pos + length < end &&
+              pBuffer_[candidate + length] == pBuffer_[pos + length])
+        {
+            ++length;
+        }
+
+        encoded += WriteSequence(pOutput + encoded,
+                                 pBuffer_ + literalStart,
+                                 pos - literalStart,
+                                 pos - candidate,
+                                 length);
+
+        /* Index the matched positions */
+        for(i = pos + 1;
+            i < pos + length && i + LINK_CODEC_MIN_MATCH <= end;
+            ++i)
+        {
+            pHead_[Hash(pBuffer_ + i)] = i + 1;
+        }
+
+        pos += length;
+        literalStart = pos;
+    }
+
+    /* The block ends on a sequence boundary */
+    if(literalStart < end)
+    {
+        encoded += WriteSequence(pOutput + encoded,
+                                 pBuffer_ + literalStart,
+                                 end - literalStart,
+                                 0,
+                                 0);
+    }
+
+    /* Keep the last window as history */
+    if(end > LINK_CODEC_WINDOW)
+    {
+        shift = end - LINK_CODEC_WINDOW;
+        memmove(pBuffer_, pBuffer_ + shift, LINK_CODEC_WINDOW);
+        for(i = 0; i < LINK_CODEC_HASH_SIZE; ++i)
+        {
+            if(pHead_[i] > shift)
+            {
+                pHead_[i] -= shift;
+            }
+            else
+            {
+                pHead_[i] = 0;
+            }
+        }
+        historySize_ = LINK_CODEC_WINDOW;
+    }
+    else
+    {
+        historySize_ = end;
+    }
+
+    return encoded;
+}
+
+LinkDecoder::LinkDecoder(void)
+{
+    Reset();
+}
+
+void LinkDecoder::Reset(void)
+{
+    state_       = DECODE_TOKEN;
+    literalLeft_ = 0;
+    matchCode_   = 0;
+    offset_      = 0;
+    matchLeft_   = 0;
+    windowPos_   = 0;
+    windowFill_  = 0;
+    error_       = false;
+}
+
+size_t LinkDecoder::Decode(const uint8_t* pkInput,
+                           const size_t   kInputSize,
+                           size_t&        rConsumed,
+                           uint8_t*       pOutput,
+                           const size_t   kOutputSize)
+{
+    size_t  i;
+    size_t  produced;
+    size_t  toCopy;
+    uint8_t value;
+
+    rConsumed = 0;
+    produced  = 0;
+
+    while(!error_ && produced < kOutputSize)
+    {
+        if(state_ == DECODE_MATCH)
+        {
+            /* Byte per byte, a match can overlap its own output */
+            toCopy = MIN(matchLeft_, kOutputSize - produced);
+            for(i = 0; i < toCopy; ++i)
+            {
+                value = pWindow_[(windowPos_ - offset_) &
+                                 (LINK_CODEC_WINDOW - 1)];
+                pOutput[produced + i] = value;
+                AddToWindow(&value, 1);
+            }
+
+            produced   += toCopy;
+            matchLeft_ -= toCopy;
+            if(matchLeft_ == 0)
+            {
+                state_ = DECODE_TOKEN;
+            }
+            continue;
+        }
+        else if(rConsumed == kInputSize)
+        {
+            /* Need more input */
+            break;
+        }
+        else if(state_ == DECODE_LITERAL)
+        {
+            toCopy = MIN(literalLeft_, kOutputSize - produced);
+            toCopy = MIN(toCopy, kInputSize - rConsumed);
+            memcpy(pOutput + produced, pkInput + rConsumed, toCopy);
+            AddToWindow(pkInput + rConsumed, toCopy);
+
+            rConsumed    += toCopy;
+            produced     += toCopy;
+            literalLeft_ -= toCopy;
+            if(literalLeft_ == 0)
+            {
+                state_ = (matchCode_ == 0) ? DECODE_TOKEN : DECODE_OFFSET_LOW;
+            }
+            continue;
+        }
+
+        value = pkInput[rConsumed++];
+        switch(state_)
+        {
+            case DECODE_TOKEN:
+                literalLeft_ = value >> 4;
+                matchCode_   = value & 0x0F;
+                matchLeft_   = matchCode_ + LINK_CODEC_MIN_MATCH - 1;
+                if(literalLeft_ == LINK_CODEC_EXTENDED)
+                {
+                    state_ = DECODE_LITERAL_LENGTH;
+                }
+                else if(literalLeft_ != 0)
+                {
+                    state_ = DECODE_LITERAL;
+                }
+                else if(matchCode_ != 0)
+                {
+                    state_ = DECODE_OFFSET_LOW;
+                }
+                else
+                {
+                    /* Empty sequences are never encoded */
+                    error_ = true;
+                }
+                break;
+            case DECODE_LITERAL_LENGTH:
+                literalLeft_ += value;
+                if(value != 255)
+                {
+                    state_ = DECODE_LITERAL;
+                }
+                break;
+            case DECODE_OFFSET_LOW:
+                offset_ = value;
+                state_  = DECODE_OFFSET_HIGH;
+                break;
+            case DECODE_OFFSET_HIGH:
+                offset_ |= (uint16_t)value << 8;
+                if(offset_ == 0 || offset_ > windowFill_)
+                {
+                    error_ = true;
+                }
+                else if(matchCode_ == LINK_CODEC_EXTENDED)
+                {
+                    state_ = DECODE_MATCH_LENGTH;
+                }
+                else
+                {
+                    state_ = DECODE_MATCH;
+                }
+                break;
+            case DECODE_MATCH_LENGTH:
+                matchLeft_ += value;
+                if(value != 255)
+                {
+                    state_ = DECODE_MATCH;
+                }
+                break;
+            default:
+                error_ = true;
+        }
+
+        /* Sequences never span more than a block */
+        if(literalLeft_ > LINK_CODEC_BLOCK || matchLeft_ > LINK_CODEC_BLOCK)
+        {
+            error_ = true;
+        }
+    }
+
+    return produced;
+}
+
+bool LinkDecoder::HasError(void) const
+{
+    return error_;
+}
+
+void LinkDecoder::AddToWindow(const uint8_t* pkData, const size_t kSize)
+{
+    size_t i;
+
+    for(i = 0; i < kSize; ++i)
+    {
+        pWindow_[windowPos_] = pkData[i];
+        windowPos_ = (windowPos_ + 1) & (LINK_CODEC_WINDOW - 1);
+    }
+    windowFill_ = MIN(windowFill_ + kSize, LINK_CODEC_WINDOW);
+}
@@ -0,0 +1,176 @@
+/*******************************************************************************
+ * @file RingBuffer.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file implements the single producer single consumer ring buffer.
+ *
+ * @details This file implements the single producer single consumer ring
+ * buffer. The head and tail are free running counters, their difference is
+ * the number of bytes in the ring.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <cstring> /* memcpy */
+#include <Types.h> /* Defined types */
+
+/* Header file */
+#include <RingBuffer.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+RingBuffer::RingBuffer(const size_t kSize)
+{
+    pBuffer_       = new uint8_t[kSize];
+    size_          = (pBuffer_ != nullptr) ? kSize : 0;
+    head_          = 0;
+    tail_          = 0;
+    overflowCount_ = 0;
+    droppedBytes_  = 0;
+    highWatermark_ = 0;
+}
+
+RingBuffer::~RingBuffer(void)
+{
+    delete[] pBuffer_;
+}
+
+bool RingBuffer::Push(const uint8_t* pkData, const size_t kSize)
+{
+    size_t head;
+    size_t used;
+    size_t offset;
+    size_t firstPart;
+
+    head = head_.load(std::memory_order_relaxed);
+    used = head - tail_.load(std::memory_order_acquire);
+
+    if(kSize > size_ - used)
+    {
+        ++overflowCount_;
+        droppedBytes_ += kSize;
+        return false;
+    }
+
+    /* Copy, wrapping at the end of the ring */
+    offset    = head & (size_ - 1);
+    firstPart = MIN(kSize, size_ - offset);
+    memcpy(pBuffer_ + offset, pkData, firstPart);
+    memcpy(pBuffer_, pkData + firstPart, kSize - firstPart);
+
+    /* Publish the data to the consumer */
+    head_.store(head + kSize, std::memory_order_release);
+
+    if(used + kSize > highWatermark_)
+    {
+        highWatermark_ = used + kSize;
+    }
+
+    return true;
+}
+
+size_t RingBuffer::Peek(const uint8_t*& rpkData) const
+{
+    size_t tail;
+    size_t used;
+    size_t offset;
+
+    tail = tail_.load(std::memory_order_relaxed);
+    used = head_.load(std::memory_order_acquire) - tail;
+
+    offset  = tail & (size_ - 1);
+    rpkData = pBuffer_ + offset;
+
+    return MIN(used, size_ - offset);
+}
+
+void RingBuffer::Consume(const size_t kSize)
+{
+    /* Release the space to the producer */
+    tail_.store(tail_.load(std::memory_order_relaxed) + kSize,
+                std::memory_order_release);
+}
+
+size_t RingBuffer::GetUsed(void) const
+{
+    return head_.load(std::memory_order_acquire) -
+           tail_.load(std::memory_order_acquire);
+}
+
+size_t RingBuffer::GetFree(void) const
+{
+    return size_ - GetUsed();
+}
+
+size_t RingBuffer::GetSize(void) const
+{
+    return size_;
+}
+
+uint32_t RingBuffer::GetOverflowCount(void) const
+{
+    return overflowCount_;
+}
+
+uint32_t RingBuffer::GetDroppedBytes(void) const
+{
+    return droppedBytes_;
+}
+
+size_t RingBuffer::GetHighWatermark(void) const
+{
+    return highWatermark_;
+}
@@ -19,12 +19,14 @@
  * INCLUDES
  ******************************************************************************/
 #include <string>         /* std::string */
+#include <cstddef>        /* offsetof */
 #include <Types.h>        /* Custom defined types */
 #include <HWMgr.h>        /* HW layer component*/
 #include <Logger.h>       /* System logger */
-#include <version.h>      /* ECB versioning */
-#include <Storage.h>      /* Storage service */
-#include <NimBLEDevice.h> /* BLE Services */
+#include <ConfigStore.h>  /* Configuration store */
+#include <LinkCodec.h>    /* Link compression */
+#include <esp_rom_crc.h>  /* CRC32 services */
+#include <BLETransport.h> /* BLE transport interface */
 
 /* Header File */
 #include <BlueToothMgr.h>
@@ -33,27 +35,30 @@
  * CONSTANTS
  ******************************************************************************/
 
-/** @brief Defines the default bluetooth token */
-#define DEFAULT_BT_TOKEN "0000000000000000"
-
-/** @brief Defines the token path in the flash. */
-#define BLUETOOTH_TOKEN_FILE_PATH "/bttoken"
-
-/** @brief Main BLE service UUID */
-#define MAIN_SERVICE_UUID "d3e63261-0000-1000-8000-00805f9b34fb"
-
-/** @brief Hardware version characteristic UUID */
-#define HW_VERSION_CHARACTERISTIC_UUID    "997ca8f9-0000-1000-8000-00805f9b34fb"
-/** @brief Software version characteristic UUID */
-#define SW_VERSION_CHARACTERISTIC_UUID    "20a14f57-0000-1000-8000-00805f9b34fb"
-/** @brief Command manager characteristic UUID */
-#define COMMAND_CHARACTERISTIC_UUID       "2d3a8ac3-0000-1000-8000-00805f9b34fb"
-/** @brief Data transfer characteristic UUID */
-#define DATA_CHARACTERISTIC_UUID          "83670c18-0000-1000-8000-00805f9b34fb"
-
 /** @brief Defines the data send end nimble size. */
 #define DATA_END_NIMBLE_SIZE 16
 
+/** @brief Transmit scheduler stack size. */
+#define TX_SCHEDULER_STACK_SIZE 4096
+/** @brief Transmit scheduler priority, above the data producers. */
+#define TX_SCHEDULER_PRIORITY   6
+/** @brief Depth of each transmit queue. */
+#define TX_QUEUE_DEPTH 8
+
+/** @brief Command response transmit timeout in milliseconds. */
+#define TX_RESPONSE_TIMEOUT 500
+/** @brief Bulk acknowledge transmit timeout in milliseconds. */
+#define TX_ACK_TIMEOUT 100
+/** @brief Maximal congestion backoff in microseconds. */
+#define TX_BACKOFF_MAX 100000
+/** @brief Connection interval unit in microseconds. */
+#define CONN_INTERVAL_UNIT 1250
+/** @brief Connection interval used before the link is set up, in units. */
+#define CONN_INTERVAL_DEFAULT 6
+
+/** @brief Free space in the receive ring to resume a stalled bulk upload. */
+#define RX_RESUME_FREE (BLE_RECEIVE_RING_SIZE / 2)
+
 /*******************************************************************************
  * MACROS
  ******************************************************************************/
@@ -64,199 +69,7 @@
  * STRUCTURES AND TYPES
  ******************************************************************************/
 
-/** @brief BLE server callback */
-class ServerCallback: public BLEServerCallbacks
-{
-    /******************** PUBLIC METHODS AND ATTRIBUTES ***********************/
-    public:
-        explicit ServerCallback(NimBLEConnInfo** pBleConnection)
-        {
-            pBleConnection_ = pBleConnection;
-            *pBleConnection = nullptr;
-        }
-
-        /**
-         * @brief Disconnect callback.
-         *
-         * @details Disconnect callback for the BLE server. Called when the
-         * current pair has disconnected.
-         *
-         * @param[in, out] pServer The BLE server that got its pair disconnected.
-         */
-        void onDisconnect(NimBLEServer* pServer,
-                          NimBLEConnInfo& connInfo,
-                          int reason)
-        {
-            *pBleConnection_ = nullptr;
-            /* On disconnect, start advertising */
-            pServer->startAdvertising();
-        }
-
-        void onConnect(NimBLEServer* pServer, NimBLEConnInfo& connInfo)
-        {
-            /**
-             *  We can use the connection handle here to ask for different connection parameters.
-             *  Args: connection handle, min connection interval, max connection interval
-             *  latency, supervision timeout.
-             *  Units; Min/Max Intervals: 1.25 millisecond increments.
-             *  Latency: number of intervals allowed to skip.
-             *  Timeout: 10 millisecond increments.
-             */
-            pServer->updateConnParams(connInfo.getConnHandle(), 6, 8, 0, 180);
-            *pBleConnection_ = &connInfo;
-        }
-
-    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
-    protected:
-        /* None */
-
-    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
-    private:
-        NimBLEConnInfo** pBleConnection_;
-        /* None */
-};
-
-/**
- * @brief Command request characteristic callback class.
- */
-class CommandRequestCallback: public BLECharacteristicCallbacks
-{
-    /******************** PUBLIC METHODS AND ATTRIBUTES ***********************/
-    public:
-        /**
-         * @brief Construct a new Command Request Callback object.
-         *
-         * @param[in, out] pBTManager The bluetooth manager used with this
-         * callback.
-         */
-        explicit CommandRequestCallback(BluetoothManager*  pBTManager,
-                                        SemaphoreHandle_t* pLock)
-        {
-            pBTManager_ = pBTManager;
-            pLock_      = pLock;
-        }
-
-        /**
-         * @brief Callback when a write is detected on the characteristic.
-         *
-         * @param[in, out] pCharacteristic The characteristic that was written.
-         */
-        virtual void onWrite(BLECharacteristic* pCharacteristic,
-                             NimBLEConnInfo&    rConnInfo)
-        {
-            /* Execute the command that was received. */
-            pBTManager_->ExecuteCommand(
-                pCharacteristic->getValue().data(),
-                pCharacteristic->getLength()
-            );
-        }
-
-        virtual void onStatus(BLECharacteristic* pCharacteristic, int code)
-        {
-            LOG_DEBUG("On status Comm %d\n", code);
-
-            xSemaphoreGive(*pLock_);
-        }
-
-    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
-    protected:
-        /* None */
-
-    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
-    private:
-        /** @brief Stores the bluetooth manager associated to this callback. */
-        BluetoothManager* pBTManager_;
-        /** @brief Stores the notification lock. */
-        SemaphoreHandle_t* pLock_;
-};
-
-/**
- * @brief Data tranfer characteristic callback class.
- */
-class DataTransferRequestCallback: public BLECharacteristicCallbacks
-{
-    /******************** PUBLIC METHODS AND ATTRIBUTES ***********************/
-    public:
-        /**
-         * @brief Construct a new Data Transfer Request Callback object.
-         *
-         * @param[in, out] pSendBuffer The send buffer used for the transfer.
-         * @param[in, out] pReceiveBuffer The receive buffer used for the
-         * transfer.
-         */
-        explicit DataTransferRequestCallback(SBLEBuffer* pSendBuffer,
-                                             SBLEBuffer* pReceiveBuffer)
-        {
-            pSendBuffer_ = pSendBuffer;
-            pReceiveBuffer_ = pReceiveBuffer;
-        }
-
-        /**
-         * @brief Callback when a write is detected on the characteristic.
-         *
-         * @param[in, out] pCharacteristic The characteristic that was written.
-         */
-        virtual void onWrite(BLECharacteristic* pCharacteristic,
-                             NimBLEConnInfo&    rConnInfo)
-        {
-            size_t msgLength;
-
-            msgLength = pCharacteristic->getLength();
-            if(msgLength > BLE_MESSAGE_MTU)
-            {
-                LOG_ERROR("Received too long message, discarding.\n");
-                return;
-            }
-
-            /* Wait for the receive buffer to be empty */
-            xSemaphoreTake(pReceiveBuffer_->wlock, portMAX_DELAY);
-
-            pReceiveBuffer_->cursor = 0;
-            pReceiveBuffer_->messageSize = msgLength;
-            memcpy(
-                pReceiveBuffer_->pBuffer,
-                pCharacteristic->getValue().data(),
-                msgLength
-            );
-
-            /* Release the reader */
-            xSemaphoreGive(pReceiveBuffer_->rlock);
-        }
-
-        /**
-         * @brief Callback when a status is updated on the characteristic.
-         *
-         * @param[in, out] pCharacteristic The characteristic that was updated.
-         * @param[in] code And additional code for the status.
-         */
-        virtual void onStatus(BLECharacteristic* pCharacteristic, int code)
-        {
-            LOG_DEBUG("On status %d\n", code);
-
-            /* Check if the action succeded or is a retry shall be done. */
-            if(code == 0)
-            {
-                pSendBuffer_->retry = false;
-            }
-            else
-            {
-                pSendBuffer_->retry = true;
-            }
-            xSemaphoreGive(pSendBuffer_->wlock);
-        }
-
-    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
-    protected:
-        /* None */
-
-    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
-    private:
-        /** @brief Stores the send buffer. */
-        SBLEBuffer* pSendBuffer_;
-        /** @brief Stores the receive buffer. */
-        SBLEBuffer* pReceiveBuffer_;
-};
-
+/* None */
 
 /*******************************************************************************
  * GLOBAL VARIABLES
@@ -295,106 +108,88 @@ static const uint8_t skpDataEndNimble[DATA_END_NIMBLE_SIZE] = {
 BluetoothManager::BluetoothManager(void)
 {
     pHandler_ = nullptr;
-    pStorage_ = Storage::GetInstance();
+    pTransport_ = nullptr;
+    pConfig_ = ConfigStore::GetInstance();
 
     /* Prepare the buffers */
 
-    sendBuffer_.rlock = xSemaphoreCreateBinary();
-    sendBuffer_.wlock = xSemaphoreCreateBinary();
-    sendBuffer_.cursor = 0;
-    sendBuffer_.retry = false;
-    sendBuffer_.messageSize = 0;
-    /* Since the receiving buffer is empty, give the semaphore */
-    xSemaphoreGive(sendBuffer_.wlock);
-
-    receiveBuffer_.rlock = xSemaphoreCreateBinary();
-    receiveBuffer_.wlock = xSemaphoreCreateBinary();
-    receiveBuffer_.cursor = 0;
-    receiveBuffer_.retry = false;
-    receiveBuffer_.messageSize = 0;
-    /* Since the receiving buffer is empty, give the semaphore */
-    xSemaphoreGive(receiveBuffer_.wlock);
-
-    /* Create and initialize the notification lock */
-    commandNotifyLock_ = xSemaphoreCreateBinary();
-    xSemaphoreGive(commandNotifyLock_);
+    receiveBuffer_.pRing = new RingBuffer(BLE_RECEIVE_RING_SIZE);
+    receiveBuffer_.dataSignal = xSemaphoreCreateBinary();
+    receiveBuffer_.reportedOverflows = 0;
+
+    memset(&linkState_, 0, sizeof(SBLELinkState));
+    statsLock_ = xSemaphoreCreateMutex();
+    linkState_.info.mtu = BLE_DEFAULT_MTU;
+    linkState_.info.segmentSize = BLE_DEFAULT_MTU - BLE_ATT_HEADER_SIZE;
+
+    memset(&transferCounters_, 0, sizeof(SBLETransferCounters));
+    transferArmed_ = false;
+    transferActive_ = false;
+
+    pEncoder_ = new LinkEncoder();
+    pDecoder_ = new LinkDecoder();
+    pEncodeBuffer_ = new uint8_t[LINK_CODEC_MAX_ENCODED_SIZE(LINK_CODEC_BLOCK)];
+    requestedCompression_ = BLE_COMPRESSION_NONE;
+    compression_ = BLE_COMPRESSION_NONE;
+
+    bulkReceive_.started = false;
+    bulkReceive_.session = 0;
+    bulkReceive_.nextSequence = 0;
+    bulkReceive_.held = 0;
+    bulkReceive_.unacked = 0;
+    bulkReceive_.stalled = false;
+    bulkReceive_.stallAck = xQueueCreate(1, sizeof(SBLEBulkAck));
+    bulkReceive_.corruptFrames = 0;
+    bulkReceive_.droppedFrames = 0;
+    bulkReceive_.duplicateFrames = 0;
+
+    /* Create the transmit scheduler queues, the task starts with the BLE */
+    pTxQueues_[BLE_TX_CONTROL] = xQueueCreate(
+        TX_QUEUE_DEPTH,
+        sizeof(SBLETxRequest*)
+    );
+    pTxQueues_[BLE_TX_BULK] = xQueueCreate(
+        TX_QUEUE_DEPTH,
+        sizeof(SBLETxRequest*)
+    );
+    ackQueue_ = xQueueCreate(1, sizeof(SBLEBulkAck));
+    txSignal_ = xSemaphoreCreateBinary();
+    txThread_ = nullptr;
+    txBackoff_ = 0;
 }
 
-void BluetoothManager::Init(CommandHandler* pHandler)
+void BluetoothManager::Init(CommandHandler* pHandler,
+                            BLETransport*   pTransport)
 {
-    BLECharacteristic* pNewCharacteristic;
-
     /* Setup the command handler */
     pHandler_ = pHandler;
+    pTransport_ = pTransport;
 
     /* Get the bluetooth token */
-    pStorage_->GetContent(
-        BLUETOOTH_TOKEN_FILE_PATH,
-        DEFAULT_BT_TOKEN,
-        token_,
-        true
+    pConfig_->GetString(CONFIG_KEY_BT_TOKEN, token_);
+
+    /* Start the transmit scheduler, it owns the command and data
+     * notifications.
+     */
+    xTaskCreatePinnedToCore(
+        TransmitRoutine,
+        "BLETxThread",
+        TX_SCHEDULER_STACK_SIZE,
+        this,
+        TX_SCHEDULER_PRIORITY,
+        &txThread_,
+        tskNO_AFFINITY
     );
-
-    /* Initialize the server and services */
-    if(!BLEDevice::init(HWManager::GetHWUID()))
+    if(txThread_ == nullptr)
     {
-        LOG_ERROR("Failed to initialize BLE device\n");
-        return;
+        LOG_ERROR("Failed to start the BLE transmit scheduler\n");
     }
 
-    pServer_ = BLEDevice::createServer();
-    pMainService_ = pServer_->createService(MAIN_SERVICE_UUID);
-
-    /* Setup server callback */
-    pServer_->setCallbacks(new ServerCallback(&pBleConnetion_));
-
-    /* Setup the VERSION characteristics */
-    pNewCharacteristic = pMainService_->createCharacteristic(
-        HW_VERSION_CHARACTERISTIC_UUID,
-        NIMBLE_PROPERTY::READ
-    );
-    pNewCharacteristic->setValue(PROTO_REV);
-    pNewCharacteristic = pMainService_->createCharacteristic(
-        SW_VERSION_CHARACTERISTIC_UUID,
-        NIMBLE_PROPERTY::READ
-    );
-    pNewCharacteristic->setValue(VERSION);
-
-    /* Setup the COMMAND characteristics */
-    pCommandCharacteristic_ = pMainService_->createCharacteristic(
-        COMMAND_CHARACTERISTIC_UUID,
-        NIMBLE_PROPERTY::WRITE  |
-        NIMBLE_PROPERTY::READ   |
-        NIMBLE_PROPERTY::NOTIFY
-    );
-    pCommandCharacteristic_->setCallbacks(
-        new CommandRequestCallback(this, &this->commandNotifyLock_)
-    );
-
-    /* Setup the DATA TRANSFER characteristics */
-    pDataCharacteristic_ = pMainService_->createCharacteristic(
-        DATA_CHARACTERISTIC_UUID,
-        NIMBLE_PROPERTY::WRITE  |
-        NIMBLE_PROPERTY::READ   |
-        NIMBLE_PROPERTY::NOTIFY
-    );
-    pDataCharacteristic_->setCallbacks(
-        new DataTransferRequestCallback(
-            &this->sendBuffer_,
-            &this->receiveBuffer_
-        )
-    );
-
-    /* Start the services */
-    pMainService_->start();
-
-    /* Start advertising */
-    pAdvertising_ = BLEDevice::getAdvertising();
-
-    pAdvertising_->setName(HWManager::GetHWUID());
-    pAdvertising_->addServiceUUID(pMainService_->getUUID());
-    pAdvertising_->enableScanResponse(true);
-    pAdvertising_->start();
+    /* Start the transport, the frames are received from now */
+    if(!pTransport_->Start(this))
+    {
+        LOG_ERROR("Failed to start the BLE transport\n");
+    }
 }
 
 bool BluetoothManager::SetToken(const std::string& pkNewToken)
@@ -406,11 +201,7 @@ bool BluetoothManager::SetToken(const std::string& pkNewToken)
         return false;
     }
 
-    success = pStorage_->SetContent(
-        BLUETOOTH_TOKEN_FILE_PATH,
-        pkNewToken,
-        true
-    );
+    success = pConfig_->SetString(CONFIG_KEY_BT_TOKEN, pkNewToken);
     if(!success)
     {
         LOG_ERROR("Failed to save the bluetooth token\n");
@@ -484,12 +275,59 @@ void BluetoothManager::ExecuteCommand(const uint8_t* kpCommandData,
     }
 }
 
-void BluetoothManager::SendCommandResponse(SCommandResponse& rResponse)
+void BluetoothManager::OnConnect(const SBLELinkInfo& rkInfo)
+{
+    xSemaphoreTake(statsLock_, portMAX_DELAY);
+    memset(&linkState_, 0, sizeof(SBLELinkState));
+    linkState_.counters.startTime = HWManager::GetTime();
+    linkState_.info = rkInfo;
+    xSemaphoreGive(statsLock_);
+}
+
+void BluetoothManager::OnLinkUpdate(const SBLELinkInfo& rkInfo)
 {
-    bool    sendSuccess;
-    uint8_t retry;
+    xSemaphoreTake(statsLock_, portMAX_DELAY);
+    linkState_.info = rkInfo;
+    xSemaphoreGive(statsLock_);
+}
 
-    if(pBleConnetion_ == nullptr)
+void BluetoothManager::OnDisconnect(void)
+{
+    /* The pending notifications fail with the connection */
+    LOG_INFO("BLE client disconnected\n");
+}
+
+void BluetoothManager::OnReceive(const ETransportChannel kChannel,
+                                 const uint8_t*          pkData,
+                                 const size_t            kSize)
+{
+    switch(kChannel)
+    {
+        case TRANSPORT_CHANNEL_COMMAND:
+            /* Execute the command that was received. */
+            ExecuteCommand(pkData, kSize);
+            break;
+        case TRANSPORT_CHANNEL_DATA:
+            ReceiveDataFrame(pkData, kSize);
+            break;
+        case TRANSPORT_CHANNEL_BULK:
+            ReceiveBulkFrame(pkData, kSize);
+            break;
+        default:
+            LOG_ERROR("Frame received on unknown channel %d\n", kChannel);
+    }
+}
+
+void BluetoothManager::SendCommandResponse(SCommandResponse& rResponse)
+{
+    bool     sendSuccess;
+    uint32_t retry;
+    uint8_t  bucket;
+    uint64_t startTime;
+    uint64_t latency;
+    uint64_t scaled;
+
+    if(!IsConnected())
     {
         return;
     }
@@ -500,194 +338,948 @@ void BluetoothManager::SendCommandResponse(SCommandResponse& rResponse)
         rResponse.header.size = COMMAND_RESPONSE_LENGTH;
     }
 
-    xSemaphoreTake(commandNotifyLock_, portMAX_DELAY);
+    startTime = HWManager::GetTime();
+    retry = 0;
 
     LOG_DEBUG("SENDING RESPONSE of size %d\n", rResponse.header.size + sizeof(SCommandHeader));
 
-    retry = 0;
-    do
+    /* Responses are sent before the queued data notifications */
+    sendSuccess = Transmit(
+        BLE_TX_CONTROL,
+        TRANSPORT_CHANNEL_COMMAND,
+        (uint8_t*)&rResponse,
+        rResponse.header.size + sizeof(SCommandHeader),
+        TX_RESPONSE_TIMEOUT,
+        &retry
+    );
+    if(!sendSuccess)
     {
-        sendSuccess = pCommandCharacteristic_->notify(
-            (uint8_t*)&rResponse,
-            rResponse.header.size + sizeof(SCommandHeader),
-            BLE_HS_CONN_HANDLE_NONE
-        );
-        if(!sendSuccess)
-        {
-            LOG_DEBUG("Retry send %d\n", retry);
-            HWManager::DelayExecUs(50000);
-            ++retry;
-        }
+        LOG_ERROR("Failed to send the command response.\n");
+    }
+
+    latency = HWManager::GetTime() - startTime;
+    bucket = 0;
+    for(scaled = latency >> 10;
+        scaled > 0 && bucket < BLE_LATENCY_BUCKETS - 1;
+        scaled >>= 1)
+    {
+        ++bucket;
+    }
 
-    } while(!sendSuccess && retry < 10);
+    /* The responses are sent by several tasks */
+    xSemaphoreTake(statsLock_, portMAX_DELAY);
+    ++linkState_.responses.pBuckets[bucket];
+    linkState_.responses.notifyRetries += retry;
+    linkState_.responses.maxLatency = MAX(
+        linkState_.responses.maxLatency,
+        latency
+    );
+    linkState_.responseTime += latency;
+    xSemaphoreGive(statsLock_);
 }
 
 ssize_t BluetoothManager::ReceiveData(uint8_t*       pBuffer,
                                       size_t         size,
                                       const uint64_t kTimeout)
 {
-    ssize_t toRead;
-    ssize_t readBytes;
-
-    if(pBleConnetion_ == nullptr)
+    size_t         toRead;
+    size_t         consumed;
+    ssize_t        readBytes;
+    uint32_t       overflows;
+    uint64_t       startTime;
+    uint64_t       waitTime;
+    RingBuffer*    pRing;
+    const uint8_t* pkData;
+
+    if(!IsConnected())
     {
         return -1;
     }
 
+    StartTransferData();
+    startTime = HWManager::GetTime();
+
+    pRing = receiveBuffer_.pRing;
     readBytes = 0;
     while(size > 0)
     {
-        /* Wait for the receive buffer to be populated */
-        if(xSemaphoreTake(receiveBuffer_.rlock,
-                          kTimeout / portTICK_PERIOD_MS) != pdTRUE)
+        /* Data was lost, the stream cannot be trusted anymore */
+        overflows = pRing->GetOverflowCount();
+        if(overflows != receiveBuffer_.reportedOverflows)
         {
-            LOG_DEBUG("TIMEOUT\n");
+            LOG_ERROR(
+                "Receive ring overflowed (%d, %d bytes dropped).\n",
+                overflows,
+                pRing->GetDroppedBytes()
+            );
+            receiveBuffer_.reportedOverflows = overflows;
+
+            /* Discard the rest of the broken stream */
+            pRing->Consume(pRing->GetUsed());
             return -1;
         }
 
-        /* Read what we can */
-        toRead = MIN(size, receiveBuffer_.messageSize - receiveBuffer_.cursor);
-        memcpy(
-            pBuffer + readBytes,
-            receiveBuffer_.pBuffer + receiveBuffer_.cursor,
-            toRead
-        );
-
-        receiveBuffer_.cursor += toRead;
-
-        if(receiveBuffer_.cursor == receiveBuffer_.messageSize)
+        /* Read the contiguous run */
+        toRead = pRing->Peek(pkData);
+        if(compression_ == BLE_COMPRESSION_LZ)
         {
-            /* When the whole message is read, release the writer */
-            xSemaphoreGive(receiveBuffer_.wlock);
+            toRead = pDecoder_->Decode(
+                pkData,
+                toRead,
+                consumed,
+                pBuffer + readBytes,
+                size
+            );
+            pRing->Consume(consumed);
+            if(pDecoder_->HasError())
+            {
+                LOG_ERROR("Corrupted compressed stream.\n");
+                pRing->Consume(pRing->GetUsed());
+                return -1;
+            }
         }
         else
         {
-            /* When there is still left in the buffer, release for a future
-             * read
-             */
-            xSemaphoreGive(receiveBuffer_.rlock);
+            toRead = MIN(size, toRead);
+            memcpy(pBuffer + readBytes, pkData, toRead);
+            pRing->Consume(toRead);
+        }
+
+        /* Restart the bulk upload stalled on a full ring */
+        if(pRing->GetFree() >= RX_RESUME_FREE)
+        {
+            ResumeBulkDelivery();
+        }
+
+        /* Wait for the receive ring to be populated */
+        if(toRead == 0 && pRing->GetUsed() == 0)
+        {
+            waitTime = HWManager::GetTime();
+            if(xSemaphoreTake(receiveBuffer_.dataSignal,
+                              kTimeout / portTICK_PERIOD_MS) != pdTRUE)
+            {
+                RecordBlockedTime(false, HWManager::GetTime() - waitTime);
+                LOG_DEBUG("TIMEOUT\n");
+                return -1;
+            }
+            RecordBlockedTime(false, HWManager::GetTime() - waitTime);
+            continue;
         }
 
         readBytes += toRead;
         size -= toRead;
     }
 
+    RecordTraffic(false, readBytes, HWManager::GetTime() - startTime);
+
     return readBytes;
 }
+
 ssize_t BluetoothManager::SendData(const uint8_t* pBuffer,
                                    size_t         size,
                                    const uint64_t kTimeout)
 {
-    ssize_t toWrite;
-    ssize_t wroteBytes;
-    bool    first;
-    bool    sendSuccess;
-    uint8_t retry;
+    bool     success;
+    size_t   encoded;
+    ssize_t  toWrite;
+    ssize_t  wroteBytes;
+    uint64_t startTime;
 
-    if(pBleConnetion_ == nullptr)
+    if(!IsConnected())
     {
         return -1;
     }
 
+    StartTransferData();
+    startTime = HWManager::GetTime();
+
+    /* Compressed transfers are encoded block per block */
     wroteBytes = 0;
-    first      = true;
     while(size > 0)
     {
-        if(first)
+        if(compression_ == BLE_COMPRESSION_LZ)
         {
-            /* Wait for the send buffer to be empty and add rate limiting */
-            if(xSemaphoreTake(sendBuffer_.wlock,
-                              kTimeout / portTICK_PERIOD_MS) != pdTRUE)
-            {
-                return -1;
-            }
+            toWrite = MIN(size, LINK_CODEC_BLOCK);
+            encoded = pEncoder_->Encode(
+                pBuffer + wroteBytes,
+                toWrite,
+                pEncodeBuffer_
+            );
+            success = SendSegments(pEncodeBuffer_, encoded, kTimeout);
+        }
+        else
+        {
+            toWrite = size;
+            success = SendSegments(pBuffer + wroteBytes, toWrite, kTimeout);
+        }
+        if(!success)
+        {
+            return -1;
+        }
 
-            first = false;
+        size -= toWrite;
+        wroteBytes += toWrite;
+    }
+
+    RecordTraffic(true, wroteBytes, HWManager::GetTime() - startTime);
+
+    return wroteBytes;
+}
+
+bool BluetoothManager::SendSegments(const uint8_t* pkBuffer,
+                                    size_t         size,
+                                    const uint64_t kTimeout)
+{
+    size_t toWrite;
+    size_t segmentSize;
+
+    xSemaphoreTake(statsLock_, portMAX_DELAY);
+    segmentSize = linkState_.info.segmentSize;
+    xSemaphoreGive(statsLock_);
+
+    while(size > 0)
+    {
+        toWrite = MIN(size, segmentSize);
+        if(!SendSegment(pkBuffer, toWrite, kTimeout))
+        {
+            return false;
         }
 
-        /* Manage buffer */
-        toWrite = MIN(size, BLE_MESSAGE_MTU);
-        memcpy(sendBuffer_.pBuffer, pBuffer + wroteBytes, toWrite);
-        sendBuffer_.cursor = 0;
-        sendBuffer_.messageSize = toWrite;
+        size -= toWrite;
+        pkBuffer += toWrite;
+    }
 
-        /* Send the message */
-        retry = 0;
-        do
+    return true;
+}
+
+void BluetoothManager::SendDataEnd(void)
+{
+    if(!IsConnected())
+    {
+        return;
+    }
+
+    if(!SendSegment(skpDataEndNimble, sizeof(skpDataEndNimble), 10000))
+    {
+        LOG_ERROR("Failed to send data end.\n");
+    }
+}
+
+void BluetoothManager::GetLinkInfo(SCommandResponse& rResponse) const
+{
+    SBLELinkInfo         info;
+    SBLETransferCounters counters;
+
+    xSemaphoreTake(statsLock_, portMAX_DELAY);
+    info     = linkState_.info;
+    counters = linkState_.counters;
+    xSemaphoreGive(statsLock_);
+
+    info.rxThroughput = 0;
+    info.txThroughput = 0;
+    if(counters.rxTime != 0)
+    {
+        info.rxThroughput = counters.rxBytes * 1000000ULL / counters.rxTime;
+    }
+    if(counters.txTime != 0)
+    {
+        info.txThroughput = counters.txBytes * 1000000ULL / counters.txTime;
+    }
+
+    memcpy(rResponse.pResponse, &info, sizeof(SBLELinkInfo));
+    rResponse.header.errorCode = NO_ERROR;
+    rResponse.header.size = sizeof(SBLELinkInfo);
+}
+
+void BluetoothManager::SetCompression(const uint8_t     kMode,
+                                      SCommandResponse& rResponse)
+{
+    if(kMode != BLE_COMPRESSION_NONE && kMode != BLE_COMPRESSION_LZ)
+    {
+        rResponse.header.errorCode = INVALID_PARAM;
+        rResponse.header.size = 0;
+        return;
+    }
+
+    /* Applied to the next transfer */
+    requestedCompression_ = (EBLECompression)kMode;
+
+    rResponse.header.errorCode = NO_ERROR;
+    rResponse.header.size = 0;
+}
+
+void BluetoothManager::BeginTransfer(void)
+{
+    transferArmed_ = true;
+}
+
+void BluetoothManager::EndTransfer(void)
+{
+    xSemaphoreTake(statsLock_, portMAX_DELAY);
+    if(transferActive_)
+    {
+        transferCounters_.endTime = HWManager::GetTime();
+        transferActive_ = false;
+    }
+    xSemaphoreGive(statsLock_);
+    transferArmed_ = false;
+    compression_ = BLE_COMPRESSION_NONE;
+}
+
+void BluetoothManager::GetTransferStats(const bool         kConnection,
+                                        SBLETransferStats& rStats) const
+{
+    SBLETransferCounters        counters;
+    const SBLETransferCounters* kpCounters;
+    uint64_t                    endTime;
+
+    /* The counters are updated by the transport and transfer tasks */
+    xSemaphoreTake(statsLock_, portMAX_DELAY);
+    if(kConnection)
+    {
+        counters = linkState_.counters;
+    }
+    else
+    {
+        counters = transferCounters_;
+    }
+    xSemaphoreGive(statsLock_);
+    kpCounters = &counters;
+
+    rStats.txBytes         = kpCounters->txBytes;
+    rStats.rxBytes         = kpCounters->rxBytes;
+    rStats.txThroughput    = 0;
+    rStats.rxThroughput    = 0;
+    rStats.txBlockedTime   = kpCounters->txBlockedTime / 1000;
+    rStats.rxBlockedTime   = kpCounters->rxBlockedTime / 1000;
+    rStats.notifyRetries   = kpCounters->notifyRetries;
+    rStats.statusErrors    = kpCounters->statusErrors;
+    rStats.lastStatusError = kpCounters->lastStatusError;
+
+    if(kpCounters->txTime != 0)
+    {
+        rStats.txThroughput = kpCounters->txBytes * 1000000ULL /
+                              kpCounters->txTime;
+    }
+    if(kpCounters->rxTime != 0)
+    {
+        rStats.rxThroughput = kpCounters->rxBytes * 1000000ULL /
+                              kpCounters->rxTime;
+    }
+
+    endTime = kpCounters->endTime;
+    if(endTime == 0)
+    {
+        endTime = HWManager::GetTime();
+    }
+    rStats.duration = 0;
+    if(kpCounters->startTime != 0)
+    {
+        rStats.duration = (endTime - kpCounters->startTime) / 1000;
+    }
+}
+
+void BluetoothManager::GetResponseStats(SBLEResponseStats& rStats) const
+{
+    uint8_t  i;
+    uint32_t count;
+    uint64_t responseTime;
+
+    xSemaphoreTake(statsLock_, portMAX_DELAY);
+    rStats = linkState_.responses;
+    responseTime = linkState_.responseTime;
+    xSemaphoreGive(statsLock_);
+
+    count = 0;
+    for(i = 0; i < BLE_LATENCY_BUCKETS; ++i)
+    {
+        count += rStats.pBuckets[i];
+    }
+    if(count != 0)
+    {
+        rStats.meanLatency = responseTime / count;
+    }
+}
+
+void BluetoothManager::GetStats(const uint8_t     kPage,
+                                SCommandResponse& rResponse) const
+{
+    SBLETransferStats transferStats;
+    SBLEResponseStats responseStats;
+
+    switch(kPage)
+    {
+        case BLE_STATS_CONNECTION:
+        case BLE_STATS_TRANSFER:
+            GetTransferStats(kPage == BLE_STATS_CONNECTION, transferStats);
+            memcpy(rResponse.pResponse,
+                   &transferStats,
+                   sizeof(SBLETransferStats));
+            rResponse.header.size = sizeof(SBLETransferStats);
+            break;
+        case BLE_STATS_RESPONSES:
+            GetResponseStats(responseStats);
+            memcpy(rResponse.pResponse,
+                   &responseStats,
+                   sizeof(SBLEResponseStats));
+            rResponse.header.size = sizeof(SBLEResponseStats);
+            break;
+        default:
+            rResponse.header.errorCode = INVALID_PARAM;
+            rResponse.header.size = 0;
+            return;
+    }
+
+    rResponse.header.errorCode = NO_ERROR;
+}
+
+bool BluetoothManager::IsConnected(void) const
+{
+    return pTransport_ != nullptr && pTransport_->IsConnected();
+}
+
+void BluetoothManager::ReceiveDataFrame(const uint8_t* pkData,
+                                        const size_t   kSize)
+{
+    /* Longer than the payload of the preferred MTU, never granted */
+    if(kSize > BLE_MESSAGE_MTU)
+    {
+        LOG_ERROR("Received too long message (%d bytes), discarding.\n",
+                  kSize);
+        return;
+    }
+
+    /* The transport is never blocked: on a full ring the message is dropped,
+     * the ring accounts the overflow and the receiver fails the transfer.
+     * Uploads that must not fail use the bulk channel.
+     */
+    if(!receiveBuffer_.pRing->Push(pkData, kSize))
+    {
+        LOG_ERROR("Receive ring overflow, dropped %d bytes.\n", kSize);
+        return;
+    }
+
+    /* Wake up the reader */
+    xSemaphoreGive(receiveBuffer_.dataSignal);
+}
+
+void BluetoothManager::ReceiveBulkFrame(const uint8_t* pkData,
+                                        const size_t   kSize)
+{
+    const SBLEBulkFrameHeader* pkHeader;
+    const uint8_t*             pkPayload;
+    size_t                     payloadSize;
+    uint32_t                   crc;
+    uint16_t                   distance;
+    bool                       sendAck;
+
+    if(kSize < sizeof(SBLEBulkFrameHeader) || kSize > BLE_MESSAGE_MTU)
+    {
+        LOG_ERROR("Invalid bulk frame size %d.\n", kSize);
+        return;
+    }
+
+    pkHeader    = (const SBLEBulkFrameHeader*)pkData;
+    pkPayload   = pkData + sizeof(SBLEBulkFrameHeader);
+    payloadSize = kSize - sizeof(SBLEBulkFrameHeader);
+
+    /* A new session restarts the sequence */
+    if(!bulkReceive_.started || pkHeader->session != bulkReceive_.session)
+    {
+        bulkReceive_.started      = true;
+        bulkReceive_.session      = pkHeader->session;
+        bulkReceive_.nextSequence = 0;
+        bulkReceive_.held         = 0;
+        bulkReceive_.unacked      = 0;
+        bulkReceive_.stalled      = false;
+        xQueueReset(bulkReceive_.stallAck);
+    }
+
+    sendAck = (pkHeader->flags & BLE_BULK_FLAG_ACK_REQ) != 0;
+
+    crc = esp_rom_crc32_le(0, pkData, offsetof(SBLEBulkFrameHeader, crc));
+    crc = esp_rom_crc32_le(crc, pkPayload, payloadSize);
+
+    distance = pkHeader->sequence - bulkReceive_.nextSequence;
+    if(crc != pkHeader->crc)
+    {
+        LOG_ERROR("Bulk frame %d corrupted.\n", pkHeader->sequence);
+        ++bulkReceive_.corruptFrames;
+        sendAck = true;
+    }
+    else if(distance == 0)
+    {
+        if(DeliverBulkFrame(pkPayload, payloadSize))
         {
-            sendSuccess = pDataCharacteristic_->notify(
-                sendBuffer_.pBuffer,
-                toWrite,
-                BLE_HS_CONN_HANDLE_NONE
-            );
-            if(!sendSuccess)
+            /* The stall acknowledge is outdated */
+            if(bulkReceive_.stalled)
             {
-                LOG_DEBUG("Retry send %d\n", retry);
-                HWManager::DelayExecUs(50000);
-                ++retry;
+                bulkReceive_.stalled = false;
+                xQueueReset(bulkReceive_.stallAck);
             }
 
-        } while(!sendSuccess && retry < 10);
-        if(!sendSuccess)
+            /* Deliver the frames that were waiting for this one */
+            DeliverHeldBulkFrames();
+        }
+        else
         {
-            return -1;
+            ++bulkReceive_.droppedFrames;
+            StallBulkDelivery();
         }
+    }
+    else if(distance < BLE_BULK_WINDOW)
+    {
+        if((bulkReceive_.held & (1UL << distance)) != 0)
+        {
+            ++bulkReceive_.duplicateFrames;
+        }
+        else
+        {
+            /* First frame after a gap, report the gap at once */
+            if(bulkReceive_.held == 0)
+            {
+                sendAck = true;
+            }
+            HoldBulkFrame(pkHeader->sequence, pkPayload, payloadSize);
+            bulkReceive_.held |= 1UL << distance;
+        }
+    }
+    else if(distance >= 0x8000)
+    {
+        /* Already delivered, the acknowledge was lost */
+        ++bulkReceive_.duplicateFrames;
+        sendAck = true;
+    }
+    else
+    {
+        ++bulkReceive_.droppedFrames;
+        sendAck = true;
+    }
 
-        /* Wait for the send buffer to be empty and add rate limiting */
-        if(xSemaphoreTake(sendBuffer_.wlock,
-                          kTimeout / portTICK_PERIOD_MS) != pdTRUE)
+    /* While stalled, the sender waits for the receiver to drain the ring */
+    if(!bulkReceive_.stalled &&
+       (sendAck || bulkReceive_.unacked >= BLE_BULK_ACK_INTERVAL))
+    {
+        SendBulkAck();
+    }
+}
+
+bool BluetoothManager::DeliverBulkFrame(const uint8_t* pkPayload,
+                                        const size_t   kSize)
+{
+    /* Do not account an overflow, the sender retransmits the frame */
+    if(receiveBuffer_.pRing->GetFree() < kSize)
+    {
+        return false;
+    }
+
+    receiveBuffer_.pRing->Push(pkPayload, kSize);
+    xSemaphoreGive(receiveBuffer_.dataSignal);
+
+    ++bulkReceive_.nextSequence;
+    ++bulkReceive_.unacked;
+    bulkReceive_.held >>= 1;
+
+    return true;
+}
+
+void BluetoothManager::DeliverHeldBulkFrames(void)
+{
+    SBLESegment* pSlot;
+
+    while((bulkReceive_.held & 1) != 0)
+    {
+        pSlot = &bulkReceive_.pSlots[
+            bulkReceive_.nextSequence % BLE_BULK_WINDOW
+        ];
+
+        if(!DeliverBulkFrame(pSlot->pBuffer, pSlot->size))
         {
-            return -1;
+            StallBulkDelivery();
+            return;
         }
+    }
+}
+
+void BluetoothManager::StallBulkDelivery(void)
+{
+    SBLEBulkAck ack;
+
+    /* The held frames were reported received, the stall acknowledge tells
+     * the sender to send them again.
+     */
+    bulkReceive_.droppedFrames += __builtin_popcount(bulkReceive_.held);
+    bulkReceive_.held           = 0;
+    bulkReceive_.stalled        = true;
+
+    ack.session      = bulkReceive_.session;
+    ack.flags        = BLE_BULK_ACK_FLAG_RESUME;
+    ack.nextSequence = bulkReceive_.nextSequence;
+    ack.bitmap       = 0;
+
+    /* The receiver only gets the acknowledge, the ring keeps one producer */
+    xQueueOverwrite(bulkReceive_.stallAck, &ack);
+}
+
+void BluetoothManager::ResumeBulkDelivery(void)
+{
+    SBLEBulkAck ack;
+
+    if(xQueueReceive(bulkReceive_.stallAck, &ack, 0) == pdTRUE)
+    {
+        xQueueOverwrite(ackQueue_, &ack);
+        xSemaphoreGive(txSignal_);
+    }
+}
+
+void BluetoothManager::HoldBulkFrame(const uint16_t kSequence,
+                                     const uint8_t* pkPayload,
+                                     const size_t   kSize)
+{
+    SBLESegment* pSlot;
+
+    pSlot = &bulkReceive_.pSlots[kSequence % BLE_BULK_WINDOW];
+    memcpy(pSlot->pBuffer, pkPayload, kSize);
+    pSlot->size = kSize;
+}
+
+void BluetoothManager::SendBulkAck(void)
+{
+    SBLEBulkAck ack;
+
+    ack.session      = bulkReceive_.session;
+    ack.flags        = 0;
+    ack.nextSequence = bulkReceive_.nextSequence;
+    ack.bitmap       = bulkReceive_.held;
+
+    /* Acknowledges are idempotent, a lost one is recovered by the next one.
+     * Only the latest one is kept for the transmit scheduler, the transport
+     * is never blocked.
+     */
+    xQueueOverwrite(ackQueue_, &ack);
+    xSemaphoreGive(txSignal_);
+    bulkReceive_.unacked = 0;
+}
+
+bool BluetoothManager::SendSegment(const uint8_t* pkBuffer,
+                                   const size_t   kSize,
+                                   const uint64_t kTimeout)
+{
+    /* The scheduler completes the notification before returning */
+    return Transmit(
+        BLE_TX_BULK,
+        TRANSPORT_CHANNEL_DATA,
+        pkBuffer,
+        kSize,
+        kTimeout,
+        nullptr
+    );
+}
+
+bool BluetoothManager::Transmit(const EBLETxPriority    kPriority,
+                                const ETransportChannel kChannel,
+                                const uint8_t*          pkBuffer,
+                                const size_t            kSize,
+                                const uint64_t          kTimeout,
+                                uint32_t*               pRetries)
+{
+    SBLETxRequest  request;
+    SBLETxRequest* pRequest;
+
+    if(txThread_ == nullptr)
+    {
+        return false;
+    }
+
+    request.channel         = kChannel;
+    request.pkBuffer        = pkBuffer;
+    request.size            = kSize;
+    request.deadline        = HWManager::GetTime() + kTimeout * 1000;
+    request.owner           = xTaskGetCurrentTaskHandle();
+    request.retries         = 0;
+    request.success         = false;
+
+    pRequest = &request;
+    if(xQueueSend(pTxQueues_[kPriority],
+                  &pRequest,
+                  kTimeout / portTICK_PERIOD_MS) != pdTRUE)
+    {
+        LOG_ERROR("Transmit queue %d full.\n", kPriority);
+        return false;
+    }
+    xSemaphoreGive(txSignal_);
+
+    /* The scheduler completes the request at the latest on its deadline */
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    if(pRetries != nullptr)
+    {
+        *pRetries = request.retries;
+    }
+
+    return request.success;
+}
+
+bool BluetoothManager::TransmitRequest(SBLETxRequest&       rRequest,
+                                       const EBLETxPriority kPriority)
+{
+    int              code;
+    uint64_t         time;
+    uint64_t         backoff;
+    ETransportStatus status;
+
+    time = HWManager::GetTime();
+    if(!IsConnected() || time >= rRequest.deadline)
+    {
+        rRequest.success = false;
+        return true;
+    }
+
+    status = pTransport_->Send(
+        rRequest.channel,
+        rRequest.pkBuffer,
+        rRequest.size
+    );
+    if(status == TRANSPORT_OK)
+    {
+        txBackoff_ = 0;
+        rRequest.success = true;
+        return true;
+    }
+
+    code = pTransport_->GetLastStatus();
+    if(rRequest.channel == TRANSPORT_CHANNEL_DATA)
+    {
+        RecordStatusError(code);
+    }
+    else if(rRequest.channel == TRANSPORT_CHANNEL_COMMAND)
+    {
+        xSemaphoreTake(statsLock_, portMAX_DELAY);
+        ++linkState_.responses.statusErrors;
+        xSemaphoreGive(statsLock_);
+    }
+
+    /* Only the congestion is worth retrying */
+    if(status != TRANSPORT_CONGESTED)
+    {
+        LOG_ERROR("Notification failed (%d).\n", code);
+        rRequest.success = false;
+        return true;
+    }
 
-        /* Check for retry */
-        if(!sendBuffer_.retry)
+    /* The stack frees its buffers on the connection events: start from one
+     * connection interval and double while the congestion lasts.
+     */
+    if(txBackoff_ == 0)
+    {
+        xSemaphoreTake(statsLock_, portMAX_DELAY);
+        txBackoff_ = linkState_.info.connInterval;
+        xSemaphoreGive(statsLock_);
+        if(txBackoff_ == 0)
         {
-            size -= toWrite;
-            wroteBytes += toWrite;
+            txBackoff_ = CONN_INTERVAL_DEFAULT;
         }
+        txBackoff_ *= CONN_INTERVAL_UNIT;
+    }
+    else
+    {
+        txBackoff_ = MIN(txBackoff_ * 2, TX_BACKOFF_MAX);
     }
+    backoff = MIN(txBackoff_, rRequest.deadline - time);
 
-    /* Release the last semaphore take */
-    xSemaphoreGive(sendBuffer_.wlock);
+    LOG_DEBUG("TX congested (%d), backoff %dus\n", code, (uint32_t)backoff);
+    ++rRequest.retries;
+    if(kPriority == BLE_TX_BULK)
+    {
+        RecordNotifyRetry();
+        RecordBlockedTime(true, backoff);
+    }
+    HWManager::DelayExecUs(backoff);
 
-    return wroteBytes;
+    return false;
 }
 
-void BluetoothManager::SendDataEnd(void)
+void BluetoothManager::TransmitBulkAck(const SBLEBulkAck& rkAck)
 {
-    bool    sendSuccess;
-    uint8_t retry;
+    SBLETxRequest request;
+    bool          done;
 
-    if(pBleConnetion_ == nullptr)
+    request.channel  = TRANSPORT_CHANNEL_BULK;
+    request.pkBuffer = (const uint8_t*)&rkAck;
+    request.size     = sizeof(SBLEBulkAck);
+    request.deadline = HWManager::GetTime() + TX_ACK_TIMEOUT * 1000;
+    request.owner    = nullptr;
+    request.retries  = 0;
+    request.success  = false;
+
+    do
     {
-        return;
+        done = TransmitRequest(request, BLE_TX_CONTROL);
+    } while(!done && uxQueueMessagesWaiting(ackQueue_) == 0);
+}
+
+void BluetoothManager::TransmitRoutine(void* pManagerParam)
+{
+    uint8_t           i;
+    BluetoothManager* pManager;
+    SBLETxRequest*    pRequests[BLE_TX_PRIORITY_COUNT];
+    SBLEBulkAck       ack;
+
+    pManager = (BluetoothManager*)pManagerParam;
+    memset(pRequests, 0, sizeof(pRequests));
+
+    while(true)
+    {
+        /* The bulk acknowledges go first, the sender waits for them */
+        if(xQueueReceive(pManager->ackQueue_, &ack, 0) == pdTRUE)
+        {
+            pManager->TransmitBulkAck(ack);
+            continue;
+        }
+
+        /* Get the most urgent request, a pending control request goes before
+         * a congested bulk one.
+         */
+        for(i = 0; i < BLE_TX_PRIORITY_COUNT; ++i)
+        {
+            if(pRequests[i] == nullptr &&
+               xQueueReceive(pManager->pTxQueues_[i], &pRequests[i], 0) !=
+               pdTRUE)
+            {
+                pRequests[i] = nullptr;
+            }
+            if(pRequests[i] != nullptr)
+            {
+                break;
+            }
+        }
+
+        if(i == BLE_TX_PRIORITY_COUNT)
+        {
+            xSemaphoreTake(pManager->txSignal_, portMAX_DELAY);
+            continue;
+        }
+
+        if(pManager->TransmitRequest(*pRequests[i], (EBLETxPriority)i))
+        {
+            xTaskNotifyGive(pRequests[i]->owner);
+            pRequests[i] = nullptr;
+        }
     }
+}
 
-    /* Wait for the send buffer to be empty and add rate limiting */
-    if(xSemaphoreTake(sendBuffer_.wlock, 10000 / portTICK_PERIOD_MS) != pdTRUE)
+void BluetoothManager::StartTransferData(void)
+{
+    /* The transfer starts with its first data */
+    if(!transferArmed_)
     {
         return;
     }
 
-    /* Send the message */
-    retry = 0;
-    do
+    xSemaphoreTake(statsLock_, portMAX_DELAY);
+    memset(&transferCounters_, 0, sizeof(SBLETransferCounters));
+    transferCounters_.startTime = HWManager::GetTime();
+    transferActive_ = true;
+    xSemaphoreGive(statsLock_);
+    transferArmed_ = false;
+
+    /* Both directions use the compression requested for the transfer */
+    compression_ = requestedCompression_;
+    requestedCompression_ = BLE_COMPRESSION_NONE;
+    if(compression_ == BLE_COMPRESSION_LZ)
+    {
+        pEncoder_->Reset();
+        pDecoder_->Reset();
+    }
+}
+
+uint8_t BluetoothManager::GetActiveCounters(SBLETransferCounters* pCounters[2])
+{
+    pCounters[0] = &linkState_.counters;
+    if(transferActive_)
     {
-        sendSuccess = pDataCharacteristic_->notify(
-            skpDataEndNimble,
-            sizeof(skpDataEndNimble),
-            BLE_HS_CONN_HANDLE_NONE
-        );
-        if(!sendSuccess)
+        pCounters[1] = &transferCounters_;
+        return 2;
+    }
+
+    return 1;
+}
+
+void BluetoothManager::RecordNotifyRetry(void)
+{
+    uint8_t               i;
+    uint8_t               count;
+    SBLETransferCounters* pCounters[2];
+
+    xSemaphoreTake(statsLock_, portMAX_DELAY);
+    count = GetActiveCounters(pCounters);
+    for(i = 0; i < count; ++i)
+    {
+        ++pCounters[i]->notifyRetries;
+    }
+    xSemaphoreGive(statsLock_);
+}
+
+void BluetoothManager::RecordStatusError(const int kCode)
+{
+    uint8_t               i;
+    uint8_t               count;
+    SBLETransferCounters* pCounters[2];
+
+    xSemaphoreTake(statsLock_, portMAX_DELAY);
+    count = GetActiveCounters(pCounters);
+    for(i = 0; i < count; ++i)
+    {
+        ++pCounters[i]->statusErrors;
+        pCounters[i]->lastStatusError = kCode;
+    }
+    xSemaphoreGive(statsLock_);
+}
+
+void BluetoothManager::RecordBlockedTime(const bool kSend, const uint64_t kTime)
+{
+    uint8_t               i;
+    uint8_t               count;
+    SBLETransferCounters* pCounters[2];
+
+    xSemaphoreTake(statsLock_, portMAX_DELAY);
+    count = GetActiveCounters(pCounters);
+    for(i = 0; i < count; ++i)
+    {
+        if(kSend)
         {
-            LOG_DEBUG("Retry send %d\n", retry);
-            HWManager::DelayExecUs(50000);
-            ++retry;
+            pCounters[i]->txBlockedTime += kTime;
         }
+        else
+        {
+            pCounters[i]->rxBlockedTime += kTime;
+        }
+    }
+    xSemaphoreGive(statsLock_);
+}
 
-    } while(!sendSuccess && retry < 10);
+void BluetoothManager::RecordTraffic(const bool     kSend,
+                                     const uint64_t kBytes,
+                                     const uint64_t kTime)
+{
+    uint8_t               i;
+    uint8_t               count;
+    SBLETransferCounters* pCounters[2];
 
-    /* Release the last semaphore take */
-    xSemaphoreGive(sendBuffer_.wlock);
+    xSemaphoreTake(statsLock_, portMAX_DELAY);
+    count = GetActiveCounters(pCounters);
+    for(i = 0; i < count; ++i)
+    {
+        if(kSend)
+        {
+            pCounters[i]->txBytes += kBytes;
+            pCounters[i]->txTime += kTime;
+        }
+        else
+        {
+            pCounters[i]->rxBytes += kBytes;
+            pCounters[i]->rxTime += kTime;
+        }
+    }
+    xSemaphoreGive(statsLock_);
 }
\ No newline at end of file
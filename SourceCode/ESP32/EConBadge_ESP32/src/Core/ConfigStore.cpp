@@ -0,0 +1,720 @@
+/*******************************************************************************
+ * @file ConfigStore.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file contains the configuration store implementation.
+ *
+ * @details This file contains the configuration store implementation. The
+ * journal starts with a header followed by the records. Records are only
+ * appended, the journal is rewritten when it reaches CONFIG_JOURNAL_MAX_SIZE.
+ * The values are cached, the journal is written before the cache is updated
+ * so the last record of a key always holds its cached value.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <string>        /* std::string */
+#include <cstddef>       /* offsetof */
+#include <cstdlib>       /* strtol */
+#include <cstring>       /* memcpy */
+#include <Types.h>       /* Defined types */
+#include <Logger.h>      /* System logger */
+#include <Storage.h>     /* Storage service */
+#include <esp_rom_crc.h> /* CRC32 services */
+
+/* Header File */
+#include <ConfigStore.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Temporary journal written by the compaction. */
+#define CONFIG_JOURNAL_TMP_FILE_PATH CONFIG_JOURNAL_FILE_PATH ".tmp"
+
+/** @brief Default bluetooth token. */
+#define CONFIG_DEFAULT_BT_TOKEN "0000000000000000"
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/** @brief Defines the description of a setting. */
+typedef struct
+{
+    /** @brief Value type. */
+    EConfigType type;
+    /** @brief Cache key of the setting. */
+    const char* pkName;
+    /** @brief Tells if the value is never evicted from the cache. */
+    bool        pinned;
+    /** @brief Legacy file of the setting. */
+    const char* pkLegacyPath;
+    /** @brief Default value of a string setting. */
+    const char* pkDefaultString;
+    /** @brief Default value of an integer setting. */
+    int32_t     defaultInteger;
+} SConfigKeyInfo;
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/** @brief The configuration store singleton instance. */
+ConfigStore* ConfigStore::PINSTANCE_ = nullptr;
+
+/************************** Static global variables ***************************/
+
+/** @brief Settings descriptions, indexed by key. */
+static const SConfigKeyInfo skpKeysInfo[CONFIG_KEY_COUNT] = {
+    {CONFIG_TYPE_STRING,  "owner",   false, OWNER_FILE_PATH,   "", 0},
+    {CONFIG_TYPE_STRING,  "contact", false, CONTACT_FILE_PATH, "", 0},
+    {
+        CONFIG_TYPE_STRING,
+        "bt_token",
+        true,
+        BLUETOOTH_TOKEN_FILE_PATH,
+        CONFIG_DEFAULT_BT_TOKEN,
+        0
+    },
+    {CONFIG_TYPE_STRING,  "image",   false, CURRENT_IMG_NAME_FILE_PATH, "", 0},
+    {
+        CONFIG_TYPE_INTEGER,
+        "led_on",
+        false,
+        LEDBORDER_ENABLED_FILE_PATH,
+        "",
+        0
+    },
+    {
+        CONFIG_TYPE_INTEGER,
+        "led_level",
+        false,
+        LEDBORDER_BRIGHTNESS_FILE_PATH,
+        "",
+        0
+    }
+};
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+ConfigStore* ConfigStore::GetInstance(void)
+{
+    if(ConfigStore::PINSTANCE_ == nullptr)
+    {
+        ConfigStore::PINSTANCE_ = new ConfigStore();
+    }
+
+    return ConfigStore::PINSTANCE_;
+}
+
+bool ConfigStore::GetString(const EConfigKey kKey, std::string& rValue) const
+{
+    if(kKey >= CONFIG_KEY_COUNT ||
+       skpKeysInfo[kKey].type != CONFIG_TYPE_STRING)
+    {
+        LOG_ERROR("Invalid string setting %d\n", kKey);
+        return false;
+    }
+
+    if(!GetValue(kKey, rValue))
+    {
+        rValue = skpKeysInfo[kKey].pkDefaultString;
+    }
+
+    return true;
+}
+
+int32_t ConfigStore::GetInteger(const EConfigKey kKey) const
+{
+    int32_t     value;
+    std::string content;
+
+    if(kKey >= CONFIG_KEY_COUNT ||
+       skpKeysInfo[kKey].type != CONFIG_TYPE_INTEGER)
+    {
+        LOG_ERROR("Invalid integer setting %d\n", kKey);
+        return 0;
+    }
+
+    if(GetValue(kKey, content))
+    {
+        memcpy(&value, content.data(), sizeof(int32_t));
+    }
+    else
+    {
+        value = skpKeysInfo[kKey].defaultInteger;
+    }
+
+    return value;
+}
+
+bool ConfigStore::SetString(const EConfigKey kKey, const std::string& rkValue)
+{
+    return SetValue(kKey, CONFIG_TYPE_STRING, rkValue);
+}
+
+bool ConfigStore::SetInteger(const EConfigKey kKey, const int32_t kValue)
+{
+    return SetValue(
+        kKey,
+        CONFIG_TYPE_INTEGER,
+        std::string((const char*)&kValue, sizeof(int32_t))
+    );
+}
+
+void ConfigStore::Reset(void)
+{
+    uint8_t i;
+
+    /* The storage lock protects the journal, it is taken first */
+    pStore_->Lock();
+    xSemaphoreTake(lock_, portMAX_DELAY);
+
+    cache_.Clear();
+    for(i = 0; i < CONFIG_KEY_COUNT; ++i)
+    {
+        pIsSet_[i]   = false;
+        pOffsets_[i] = 0;
+    }
+
+    /* The next change rewrites the journal */
+    journalSize_ = 0;
+
+    xSemaphoreGive(lock_);
+    pStore_->Unlock();
+}
+
+void ConfigStore::GetCacheStats(SContentCacheStats& rStats) const
+{
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    cache_.GetStats(rStats);
+    xSemaphoreGive(lock_);
+}
+
+ConfigStore::ConfigStore(void)
+{
+    uint8_t     i;
+    std::string pValues[CONFIG_KEY_COUNT];
+    bool        pIsSet[CONFIG_KEY_COUNT];
+
+    pStore_ = Storage::GetInstance();
+    lock_   = xSemaphoreCreateMutex();
+    Reset();
+
+    pStore_->Lock();
+
+    /* Complete an interrupted compaction */
+    if(pStore_->FileExists(CONFIG_JOURNAL_TMP_FILE_PATH))
+    {
+        if(pStore_->FileExists(CONFIG_JOURNAL_FILE_PATH))
+        {
+            pStore_->Remove(CONFIG_JOURNAL_TMP_FILE_PATH);
+        }
+        else
+        {
+            pStore_->Rename(
+                CONFIG_JOURNAL_TMP_FILE_PATH,
+                CONFIG_JOURNAL_FILE_PATH
+            );
+        }
+    }
+
+    if(!Load())
+    {
+        ImportLegacy(pValues, pIsSet);
+        if(!Compact(pValues, pIsSet))
+        {
+            LOG_ERROR("Failed to create the configuration journal\n");
+        }
+
+        xSemaphoreTake(lock_, portMAX_DELAY);
+        for(i = 0; i < CONFIG_KEY_COUNT; ++i)
+        {
+            if(pIsSet[i])
+            {
+                pIsSet_[i] = true;
+                CacheValue((EConfigKey)i, pValues[i]);
+            }
+        }
+        xSemaphoreGive(lock_);
+    }
+
+    pStore_->Unlock();
+}
+
+bool ConfigStore::GetValue(const EConfigKey kKey, std::string& rValue) const
+{
+    bool isSet;
+    bool isCached;
+
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    isSet    = pIsSet_[kKey];
+    isCached = isSet && cache_.Get(skpKeysInfo[kKey].pkName, rValue);
+    xSemaphoreGive(lock_);
+
+    if(!isSet || isCached)
+    {
+        return isSet;
+    }
+
+    /* The journal is written before the cache, under the storage lock its
+     * last record holds the latest value.
+     */
+    pStore_->Lock();
+    xSemaphoreTake(lock_, portMAX_DELAY);
+
+    isSet = pIsSet_[kKey] && ReadRecord(kKey, rValue);
+    if(isSet)
+    {
+        CacheValue(kKey, rValue);
+    }
+
+    xSemaphoreGive(lock_);
+    pStore_->Unlock();
+
+    return isSet;
+}
+
+bool ConfigStore::ReadRecord(const EConfigKey kKey, std::string& rValue) const
+{
+    FsFile              file;
+    SConfigRecordHeader record;
+    uint32_t            crc;
+    char                pBuffer[CONFIG_VALUE_MAX_SIZE];
+
+    file = pStore_->Open(CONFIG_JOURNAL_FILE_PATH, FILE_READ);
+    if(!file)
+    {
+        LOG_ERROR("Failed to open the configuration journal\n");
+        return false;
+    }
+
+    if(!file.seekSet(pOffsets_[kKey]) ||
+       file.read(&record, sizeof(SConfigRecordHeader)) !=
+       (int)sizeof(SConfigRecordHeader) ||
+       record.key != kKey ||
+       record.size > CONFIG_VALUE_MAX_SIZE ||
+       file.read(pBuffer, record.size) != (int)record.size)
+    {
+        LOG_ERROR("Failed to read setting %d\n", kKey);
+        file.close();
+        return false;
+    }
+    file.close();
+
+    crc = esp_rom_crc32_le(
+        0,
+        (const uint8_t*)&record,
+        offsetof(SConfigRecordHeader, crc)
+    );
+    crc = esp_rom_crc32_le(crc, (const uint8_t*)pBuffer, record.size);
+    if(crc != record.crc)
+    {
+        LOG_ERROR("Corrupted setting %d\n", kKey);
+        return false;
+    }
+
+    rValue.assign(pBuffer, record.size);
+
+    return true;
+}
+
+void ConfigStore::CacheValue(const EConfigKey   kKey,
+                             const std::string& rkValue) const
+{
+    /* A rejected value is read back from the journal when needed */
+    if(cache_.Set(skpKeysInfo[kKey].pkName, rkValue) &&
+       skpKeysInfo[kKey].pinned)
+    {
+        cache_.SetPinned(skpKeysInfo[kKey].pkName, true);
+    }
+}
+
+bool ConfigStore::Load(void)
+{
+    FsFile                     file;
+    uint8_t*                   pBuffer;
+    size_t                     size;
+    size_t                     fileSize;
+    size_t                     offset;
+    uint32_t                   crc;
+    SConfigJournalHeader       header;
+    const SConfigRecordHeader* pkRecord;
+
+    file = pStore_->Open(CONFIG_JOURNAL_FILE_PATH, FILE_READ);
+    if(!file)
+    {
+        return false;
+    }
+
+    /* The journal never outgrows the compaction size, read it at once */
+    fileSize = file.fileSize();
+    size = MIN(fileSize, CONFIG_JOURNAL_MAX_SIZE);
+    pBuffer = new uint8_t[size];
+    if(size < sizeof(SConfigJournalHeader) ||
+       file.read(pBuffer, size) != (int)size)
+    {
+        LOG_ERROR("Failed to read the configuration journal\n");
+        file.close();
+        delete[] pBuffer;
+        return false;
+    }
+    file.close();
+
+    memcpy(&header, pBuffer, sizeof(SConfigJournalHeader));
+    if(header.magic != CONFIG_JOURNAL_MAGIC ||
+       header.version != CONFIG_JOURNAL_VERSION)
+    {
+        LOG_ERROR("Invalid configuration journal\n");
+        delete[] pBuffer;
+        return false;
+    }
+
+    /* Replay the records, the last record of a key holds its value */
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    offset = sizeof(SConfigJournalHeader);
+    while(offset + sizeof(SConfigRecordHeader) <= size)
+    {
+        pkRecord = (const SConfigRecordHeader*)(pBuffer + offset);
+        if(pkRecord->key >= CONFIG_KEY_COUNT ||
+           pkRecord->type != skpKeysInfo[pkRecord->key].type ||
+           pkRecord->size > CONFIG_VALUE_MAX_SIZE ||
+           offset + sizeof(SConfigRecordHeader) + pkRecord->size > size)
+        {
+            break;
+        }
+        if(pkRecord->type == CONFIG_TYPE_INTEGER &&
+           pkRecord->size != sizeof(int32_t))
+        {
+            break;
+        }
+
+        crc = esp_rom_crc32_le(
+            0,
+            (const uint8_t*)pkRecord,
+            offsetof(SConfigRecordHeader, crc)
+        );
+        crc = esp_rom_crc32_le(
+            crc,
+            (const uint8_t*)(pkRecord + 1),
+            pkRecord->size
+        );
+        if(crc != pkRecord->crc)
+        {
+            break;
+        }
+
+        CacheValue(
+            (EConfigKey)pkRecord->key,
+            std::string((const char*)(pkRecord + 1), pkRecord->size)
+        );
+        pIsSet_[pkRecord->key]   = true;
+        pOffsets_[pkRecord->key] = offset;
+
+        offset += sizeof(SConfigRecordHeader) + pkRecord->size;
+    }
+    xSemaphoreGive(lock_);
+
+    delete[] pBuffer;
+
+    /* Drop the record torn by a power loss, the next ones append after */
+    if(offset != fileSize)
+    {
+        LOG_ERROR(
+            "Configuration journal truncated at %d (%d bytes)\n",
+            offset,
+            fileSize
+        );
+
+        file = pStore_->Open(CONFIG_JOURNAL_FILE_PATH, O_RDWR);
+        if(!file || !file.truncate(offset))
+        {
+            LOG_ERROR("Failed to truncate the configuration journal\n");
+            offset = 0;
+        }
+        file.close();
+    }
+
+    journalSize_ = offset;
+
+    LOG_DEBUG("Loaded the configuration journal (%d bytes)\n", offset);
+
+    return true;
+}
+
+void ConfigStore::ImportLegacy(std::string pValues[], bool pIsSet[])
+{
+    uint8_t     i;
+    int32_t     value;
+    std::string content;
+
+    for(i = 0; i < CONFIG_KEY_COUNT; ++i)
+    {
+        pIsSet[i] = false;
+        if(!pStore_->FileExists(skpKeysInfo[i].pkLegacyPath))
+        {
+            continue;
+        }
+
+        pStore_->GetContent(skpKeysInfo[i].pkLegacyPath, "", content);
+        if(content.size() > CONFIG_VALUE_MAX_SIZE)
+        {
+            LOG_ERROR("Legacy setting %d too long\n", i);
+            continue;
+        }
+
+        if(skpKeysInfo[i].type == CONFIG_TYPE_INTEGER)
+        {
+            value = strtol(content.c_str(), nullptr, 10);
+            pValues[i].assign((const char*)&value, sizeof(int32_t));
+        }
+        else
+        {
+            pValues[i] = content;
+        }
+        pIsSet[i] = true;
+
+        LOG_INFO("Imported legacy setting %s\n", skpKeysInfo[i].pkLegacyPath);
+    }
+}
+
+bool ConfigStore::SetValue(const EConfigKey   kKey,
+                           const EConfigType  kType,
+                           const std::string& rkValue)
+{
+    bool        success;
+    std::string value;
+
+    if(kKey >= CONFIG_KEY_COUNT || skpKeysInfo[kKey].type != kType)
+    {
+        LOG_ERROR("Invalid setting %d\n", kKey);
+        return false;
+    }
+    if(rkValue.size() > CONFIG_VALUE_MAX_SIZE)
+    {
+        LOG_ERROR("Setting %d too long\n", kKey);
+        return false;
+    }
+
+    /* The journal writes and the cache updates are ordered by the storage
+     * lock, the readers only wait for the cache update.
+     */
+    pStore_->Lock();
+
+    /* Do not wear the SD card with unchanged values */
+    if(GetValue(kKey, value) && value == rkValue)
+    {
+        pStore_->Unlock();
+        return true;
+    }
+
+    success = Append(kKey, rkValue);
+    if(success)
+    {
+        xSemaphoreTake(lock_, portMAX_DELAY);
+        pIsSet_[kKey] = true;
+        CacheValue(kKey, rkValue);
+        xSemaphoreGive(lock_);
+    }
+
+    pStore_->Unlock();
+
+    return success;
+}
+
+bool ConfigStore::Append(const EConfigKey kKey, const std::string& rkValue)
+{
+    FsFile file;
+    size_t recordSize;
+    size_t written;
+
+    /* The compaction writes the new value with the others */
+    recordSize = sizeof(SConfigRecordHeader) + rkValue.size();
+    if(journalSize_ == 0 ||
+       journalSize_ + recordSize > CONFIG_JOURNAL_MAX_SIZE)
+    {
+        return Rewrite(kKey, rkValue);
+    }
+
+    file = pStore_->Open(CONFIG_JOURNAL_FILE_PATH, FILE_WRITE);
+    if(!file)
+    {
+        LOG_ERROR("Failed to open the configuration journal\n");
+        return false;
+    }
+
+    written = WriteRecord(file, kKey, rkValue);
+    file.close();
+
+    if(written != recordSize)
+    {
+        LOG_ERROR("Failed to append setting %d\n", kKey);
+
+        /* Rewrite the journal, the partial record must not stay */
+        return Rewrite(kKey, rkValue);
+    }
+
+    pOffsets_[kKey] = journalSize_;
+    journalSize_   += written;
+
+    LOG_DEBUG("Appended setting %d (%d bytes)\n", kKey, written);
+
+    return true;
+}
+
+bool ConfigStore::Rewrite(const EConfigKey kKey, const std::string& rkValue)
+{
+    uint8_t     i;
+    std::string pValues[CONFIG_KEY_COUNT];
+    bool        pIsSet[CONFIG_KEY_COUNT];
+
+    /* The evicted values are read back before the journal is replaced */
+    for(i = 0; i < CONFIG_KEY_COUNT; ++i)
+    {
+        pIsSet[i] = GetValue((EConfigKey)i, pValues[i]);
+    }
+    pValues[kKey] = rkValue;
+    pIsSet[kKey]  = true;
+
+    return Compact(pValues, pIsSet);
+}
+
+bool ConfigStore::Compact(const std::string pkValues[], const bool pkIsSet[])
+{
+    FsFile               file;
+    uint8_t              i;
+    size_t               size;
+    size_t               written;
+    size_t               recordSize;
+    SConfigJournalHeader header;
+    size_t               pOffsets[CONFIG_KEY_COUNT];
+    bool                 success;
+
+    pStore_->Remove(CONFIG_JOURNAL_TMP_FILE_PATH);
+    file = pStore_->Open(CONFIG_JOURNAL_TMP_FILE_PATH, FILE_WRITE);
+    if(!file)
+    {
+        LOG_ERROR("Failed to open the temporary configuration journal\n");
+        return false;
+    }
+
+    header.magic    = CONFIG_JOURNAL_MAGIC;
+    header.version  = CONFIG_JOURNAL_VERSION;
+    header.reserved = 0;
+    size = file.write(&header, sizeof(SConfigJournalHeader));
+    written = sizeof(SConfigJournalHeader);
+
+    for(i = 0; i < CONFIG_KEY_COUNT; ++i)
+    {
+        if(pkIsSet[i])
+        {
+            recordSize  = sizeof(SConfigRecordHeader) + pkValues[i].size();
+            pOffsets[i] = written;
+            size       += WriteRecord(file, (EConfigKey)i, pkValues[i]);
+            written    += recordSize;
+        }
+    }
+    file.close();
+
+    success = false;
+    if(size != written)
+    {
+        LOG_ERROR("Failed to write the configuration journal\n");
+        pStore_->Remove(CONFIG_JOURNAL_TMP_FILE_PATH);
+    }
+    /* The temporary journal is complete, it replaces the journal */
+    else if(pStore_->FileExists(CONFIG_JOURNAL_FILE_PATH) &&
+            !pStore_->Remove(CONFIG_JOURNAL_FILE_PATH))
+    {
+        LOG_ERROR("Failed to remove the configuration journal\n");
+        pStore_->Remove(CONFIG_JOURNAL_TMP_FILE_PATH);
+    }
+    else if(!pStore_->Rename(CONFIG_JOURNAL_TMP_FILE_PATH,
+                             CONFIG_JOURNAL_FILE_PATH))
+    {
+        LOG_ERROR("Failed to replace the configuration journal\n");
+    }
+    else
+    {
+        /* A value that could not be read back is dropped with its record */
+        xSemaphoreTake(lock_, portMAX_DELAY);
+        for(i = 0; i < CONFIG_KEY_COUNT; ++i)
+        {
+            pIsSet_[i]   = pkIsSet[i];
+            pOffsets_[i] = pkIsSet[i] ? pOffsets[i] : 0;
+        }
+        xSemaphoreGive(lock_);
+        journalSize_ = size;
+        success = true;
+
+        LOG_DEBUG("Compacted the configuration journal (%d bytes)\n", size);
+    }
+
+    return success;
+}
+
+size_t ConfigStore::WriteRecord(FsFile&            rFile,
+                                const EConfigKey   kKey,
+                                const std::string& rkValue)
+{
+    uint8_t              pBuffer[sizeof(SConfigRecordHeader) +
+                                 CONFIG_VALUE_MAX_SIZE];
+    SConfigRecordHeader* pRecord;
+
+    pRecord = (SConfigRecordHeader*)pBuffer;
+    pRecord->key  = kKey;
+    pRecord->type = skpKeysInfo[kKey].type;
+    pRecord->size = rkValue.size();
+    memcpy(
+        pBuffer + sizeof(SConfigRecordHeader),
+        rkValue.data(),
+        pRecord->size
+    );
+
+    pRecord->crc = esp_rom_crc32_le(
+        0,
+        pBuffer,
+        offsetof(SConfigRecordHeader, crc)
+    );
+    pRecord->crc = esp_rom_crc32_le(
+        pRecord->crc,
+        pBuffer + sizeof(SConfigRecordHeader),
+        pRecord->size
+    );
+
+    /* One write per record, a power loss tears at most the last one */
+    return rFile.write(pBuffer, sizeof(SConfigRecordHeader) + pRecord->size);
+}
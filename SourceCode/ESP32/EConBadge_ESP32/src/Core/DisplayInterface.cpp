@@ -23,6 +23,7 @@
 #include <HWMgr.h>         /* Hardware manager */
 #include <Logger.h>        /* Logging service */
 #include <Storage.h>       /* Storage service */
+#include <ConfigStore.h>   /* Configuration store */
 #include <version.h>       /* ECB versionning */
 #include <BatteryMgr.h>    /* Battery manager */
 #include <OLEDScreenMgr.h> /* OLED screen manager */
@@ -315,8 +316,9 @@ void DisplayInterface::InternalDisplayPopup(void)
 
 void DisplayInterface::DisplayDebug(void)
 {
-    Adafruit_SSD1306* pDisplay;
-    Storage*          pStore;
+    Adafruit_SSD1306*  pDisplay;
+    Storage*           pStore;
+    SContentCacheStats cacheStats;
 
     pDisplay = pOLEDScreen_->GetDisplay();
     pStore = Storage::GetInstance();
@@ -357,8 +359,56 @@ void DisplayInterface::DisplayDebug(void)
     {
         pDisplay->printf("SDCard Type %d\n", pStore->GetSdCardType());
         pDisplay->printf("SDCard Size %llu\n", pStore->GetSdCardSize());
+
+        /* Settings cache statistics */
+        ConfigStore::GetInstance()->GetCacheStats(cacheStats);
+        pDisplay->printf(
+            "Cache %dB/%dB P%d\n",
+            cacheStats.usedBytes,
+            cacheStats.budget,
+            cacheStats.pinned
+        );
+        pDisplay->printf(
+            "H%d M%d\nE%d R%d\n",
+            cacheStats.hits,
+            cacheStats.misses,
+            cacheStats.evictions,
+            cacheStats.rejects
+        );
     }
     else if(debugInfo_.debugState == 4)
+    {
+        /* BLE statistics since the connection */
+        pDisplay->printf(
+            "TX %dB %dB/s\n",
+            debugInfo_.bleStats.txBytes,
+            debugInfo_.bleStats.txThroughput
+        );
+        pDisplay->printf(
+            "RX %dB %dB/s\n",
+            debugInfo_.bleStats.rxBytes,
+            debugInfo_.bleStats.rxThroughput
+        );
+        pDisplay->printf(
+            "Blocked T%dms R%dms\n",
+            debugInfo_.bleStats.txBlockedTime,
+            debugInfo_.bleStats.rxBlockedTime
+        );
+        pDisplay->printf(
+            "Retry %d Err %d (%d)\n",
+            debugInfo_.bleStats.notifyRetries +
+            debugInfo_.bleResponses.notifyRetries,
+            debugInfo_.bleStats.statusErrors +
+            debugInfo_.bleResponses.statusErrors,
+            debugInfo_.bleStats.lastStatusError
+        );
+        pDisplay->printf(
+            "Rsp %dus Max %dus\n",
+            debugInfo_.bleResponses.meanLatency,
+            debugInfo_.bleResponses.maxLatency
+        );
+    }
+    else if(debugInfo_.debugState == 5)
     {
         pDisplay->printf("\n\n\n     Exit Debug?");
     }
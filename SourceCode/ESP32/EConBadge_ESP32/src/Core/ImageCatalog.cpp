@@ -0,0 +1,845 @@
+/*******************************************************************************
+ * @file ImageCatalog.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file contains the image catalog implementation.
+ *
+ * @details This file contains the image catalog implementation. The catalog
+ * file is a header followed by the entries sorted by name. An image is stored
+ * before its entry is written, the catalog is checked against the image
+ * directory at boot to recover from a power loss in between.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <string>        /* std::string */
+#include <vector>        /* std::vector */
+#include <cstddef>       /* offsetof */
+#include <cstring>       /* memcpy, strcmp, strlen */
+#include <algorithm>     /* std::sort */
+#include <Types.h>       /* Defined types */
+#include <Logger.h>      /* System logger */
+#include <Storage.h>     /* Storage service */
+#include <ImageCodec.h>  /* Compressed images codec */
+#include <esp_rom_crc.h> /* CRC32 services */
+
+/* Header File */
+#include <ImageCatalog.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Temporary catalog written when the catalog is saved. */
+#define IMAGE_CATALOG_TMP_FILE_PATH IMAGE_CATALOG_FILE_PATH ".tmp"
+
+/** @brief Empty hash table slot. */
+#define IMAGE_CATALOG_SLOT_EMPTY 0xFFFF
+
+/** @brief Maximal number of entries, bounded by the hash table slots. */
+#define IMAGE_CATALOG_MAX_ENTRIES (IMAGE_CATALOG_SLOT_EMPTY - 1)
+
+/** @brief Minimal number of hash table slots, a power of two. */
+#define IMAGE_CATALOG_MIN_SLOTS 16
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/** @brief The image catalog singleton instance. */
+ImageCatalog* ImageCatalog::PINSTANCE_ = nullptr;
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/**
+ * @brief Hashes an image name, FNV-1a.
+ *
+ * @param[in] pkName The image name.
+ *
+ * @return The name hash is returned.
+ */
+static uint32_t HashName(const char* pkName);
+
+/**
+ * @brief Computes the CRC of an entry.
+ *
+ * @param[in, out] rEntry The entry to seal.
+ */
+static void SealEntry(SImageCatalogEntry& rEntry);
+
+/**
+ * @brief Tells if two entries are in name order.
+ *
+ * @param[in] rkFirst The first entry.
+ * @param[in] rkSecond The second entry.
+ *
+ * @return true is returned if the first entry is before the second entry.
+ */
+static bool IsBefore(const SImageCatalogEntry& rkFirst,
+                     const SImageCatalogEntry& rkSecond);
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+static uint32_t HashName(const char* pkName)
+{
+    uint32_t hash;
+
+    hash = 2166136261;
+    while(*pkName != 0)
+    {
+        hash ^= (uint8_t)*pkName;
+        hash *= 16777619;
+        ++pkName;
+    }
+
+    return hash;
+}
+
+static void SealEntry(SImageCatalogEntry& rEntry)
+{
+    rEntry.crc = esp_rom_crc32_le(
+        0,
+        (const uint8_t*)&rEntry,
+        offsetof(SImageCatalogEntry, crc)
+    );
+}
+
+static bool IsBefore(const SImageCatalogEntry& rkFirst,
+                     const SImageCatalogEntry& rkSecond)
+{
+    return strcmp(rkFirst.pName, rkSecond.pName) < 0;
+}
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+ImageCatalog* ImageCatalog::GetInstance(void)
+{
+    if(ImageCatalog::PINSTANCE_ == nullptr)
+    {
+        ImageCatalog::PINSTANCE_ = new ImageCatalog();
+    }
+
+    return ImageCatalog::PINSTANCE_;
+}
+
+size_t ImageCatalog::GetCount(void) const
+{
+    size_t count;
+
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    count = entries_.size();
+    xSemaphoreGive(lock_);
+
+    return count;
+}
+
+bool ImageCatalog::GetEntry(const size_t        kIndex,
+                            SImageCatalogEntry& rEntry) const
+{
+    bool status;
+
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    status = kIndex < entries_.size();
+    if(status)
+    {
+        rEntry = entries_[kIndex];
+    }
+    xSemaphoreGive(lock_);
+
+    return status;
+}
+
+ssize_t ImageCatalog::Find(const std::string& rkName) const
+{
+    ssize_t index;
+
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    index = FindIndex(rkName.c_str());
+    xSemaphoreGive(lock_);
+
+    return index;
+}
+
+bool ImageCatalog::GetPage(const uint32_t                   kCursor,
+                           const size_t                     kCount,
+                           std::vector<SImageCatalogEntry>& rEntries,
+                           uint32_t&                        rNextCursor) const
+{
+    size_t position;
+    size_t end;
+    bool   status;
+
+    rEntries.clear();
+    position = kCursor & IMAGE_CATALOG_CURSOR_POS_MASK;
+
+    xSemaphoreTake(lock_, portMAX_DELAY);
+
+    status = (position == 0 ||
+              (kCursor >> IMAGE_CATALOG_CURSOR_GEN_SHIFT) == generation_) &&
+             position <= entries_.size();
+    if(status)
+    {
+        end = MIN(position + kCount, entries_.size());
+        rEntries.assign(entries_.begin() + position, entries_.begin() + end);
+
+        rNextCursor = FILES_CURSOR_END;
+        if(end < entries_.size())
+        {
+            rNextCursor = ((uint32_t)generation_ <<
+                           IMAGE_CATALOG_CURSOR_GEN_SHIFT) | end;
+        }
+    }
+
+    xSemaphoreGive(lock_);
+
+    return status;
+}
+
+size_t ImageCatalog::GetNamesFrom(
+    const char*  pkStartName,
+    const size_t kPrev,
+    const size_t kCount,
+    char         pNames[][IMAGE_CATALOG_NAME_SIZE]) const
+{
+    size_t  i;
+    size_t  count;
+    size_t  index;
+    ssize_t start;
+
+    xSemaphoreTake(lock_, portMAX_DELAY);
+
+    count = entries_.size();
+    if(count == 0)
+    {
+        xSemaphoreGive(lock_);
+        return 0;
+    }
+
+    start = FindIndex(pkStartName);
+    if(start < 0)
+    {
+        start = 0;
+    }
+
+    /* The list wraps around the catalog, the names are null terminated */
+    index = (start + count - (kPrev % count)) % count;
+    count = MIN(kCount, count);
+    for(i = 0; i < count; ++i)
+    {
+        memcpy(pNames[i], entries_[index].pName, IMAGE_CATALOG_NAME_SIZE);
+        index = (index + 1) % entries_.size();
+    }
+
+    xSemaphoreGive(lock_);
+
+    return count;
+}
+
+bool ImageCatalog::Add(const std::string&   rkName,
+                       const uint32_t       kHash,
+                       const EImageEncoding kEncoding)
+{
+    bool               status;
+    bool               replaced;
+    size_t             index;
+    SImageCatalogEntry entry;
+    SImageCatalogEntry oldEntry;
+
+    if(rkName.size() == 0 || rkName.size() >= IMAGE_CATALOG_NAME_SIZE)
+    {
+        LOG_ERROR("Invalid catalog image name\n");
+        return false;
+    }
+
+    memset(&entry, 0, sizeof(SImageCatalogEntry));
+    memcpy(entry.pName, rkName.c_str(), rkName.size());
+
+    pStore_->Lock();
+
+    if(!ReadImageInfo(entry))
+    {
+        pStore_->Unlock();
+        return false;
+    }
+    entry.hash     = kHash;
+    entry.encoding = kEncoding;
+    entry.flags    = IMAGE_CATALOG_FLAG_HASHED;
+    SealEntry(entry);
+
+    /* A new upload with the same name replaces the image */
+    xSemaphoreTake(lock_, portMAX_DELAY);
+    index = LowerBound(entry.pName);
+    replaced = index < entries_.size() &&
+               strcmp(entries_[index].pName, entry.pName) == 0;
+    if(replaced)
+    {
+        oldEntry = entries_[index];
+        entries_[index] = entry;
+    }
+    else if(entries_.size() < IMAGE_CATALOG_MAX_ENTRIES)
+    {
+        entries_.insert(entries_.begin() + index, entry);
+        IndexNames();
+    }
+    else
+    {
+        LOG_ERROR("Image catalog full\n");
+        xSemaphoreGive(lock_);
+        pStore_->Unlock();
+        return false;
+    }
+    xSemaphoreGive(lock_);
+
+    /* The writers hold the storage lock, the entries do not change */
+    status = Save();
+    if(!status)
+    {
+        xSemaphoreTake(lock_, portMAX_DELAY);
+        if(replaced)
+        {
+            entries_[index] = oldEntry;
+        }
+        else
+        {
+            entries_.erase(entries_.begin() + index);
+            IndexNames();
+        }
+        xSemaphoreGive(lock_);
+    }
+
+    pStore_->Unlock();
+
+    return status;
+}
+
+bool ImageCatalog::Remove(const std::string& rkName)
+{
+    bool    status;
+    ssize_t index;
+
+    pStore_->Lock();
+    xSemaphoreTake(lock_, portMAX_DELAY);
+
+    index = FindIndex(rkName.c_str());
+    if(index < 0)
+    {
+        xSemaphoreGive(lock_);
+        pStore_->Unlock();
+        return false;
+    }
+
+    entries_.erase(entries_.begin() + index);
+    IndexNames();
+    xSemaphoreGive(lock_);
+
+    status = Save();
+
+    pStore_->Unlock();
+
+    return status;
+}
+
+bool ImageCatalog::RecordDisplay(const std::string& rkName,
+                                 const uint32_t     kHash)
+{
+    bool                status;
+    ssize_t             index;
+    SImageCatalogEntry* pEntry;
+
+    pStore_->Lock();
+    xSemaphoreTake(lock_, portMAX_DELAY);
+
+    index = FindIndex(rkName.c_str());
+    if(index < 0)
+    {
+        xSemaphoreGive(lock_);
+        pStore_->Unlock();
+        return false;
+    }
+
+    pEntry = &entries_[index];
+    ++pEntry->displayCount;
+    if((pEntry->flags & IMAGE_CATALOG_FLAG_HASHED) == 0)
+    {
+        pEntry->hash   = kHash;
+        pEntry->flags |= IMAGE_CATALOG_FLAG_HASHED;
+    }
+    else if(pEntry->hash != kHash)
+    {
+        LOG_ERROR("Image %s does not match its hash\n", rkName.c_str());
+    }
+    SealEntry(*pEntry);
+    xSemaphoreGive(lock_);
+
+    status = WriteEntry(index);
+
+    pStore_->Unlock();
+
+    return status;
+}
+
+bool ImageCatalog::MarkDirty(void)
+{
+    FsFile file;
+    bool   status;
+
+    pStore_->Lock();
+
+    /* A missing catalog is rebuilt at boot */
+    if(!pStore_->FileExists(IMAGE_CATALOG_FILE_PATH))
+    {
+        pStore_->Unlock();
+        return true;
+    }
+
+    file = pStore_->Open(IMAGE_CATALOG_FILE_PATH, O_RDWR);
+    status = file && WriteHeader(file, IMAGE_CATALOG_HEADER_FLAG_DIRTY);
+    file.close();
+
+    pStore_->Unlock();
+
+    if(!status)
+    {
+        LOG_ERROR("Failed to mark the image catalog dirty\n");
+    }
+
+    return status;
+}
+
+ImageCatalog::ImageCatalog(void)
+{
+    pStore_     = Storage::GetInstance();
+    lock_       = xSemaphoreCreateMutex();
+    generation_ = 0;
+
+    pStore_->Lock();
+
+    /* Complete an interrupted save */
+    if(pStore_->FileExists(IMAGE_CATALOG_TMP_FILE_PATH))
+    {
+        if(pStore_->FileExists(IMAGE_CATALOG_FILE_PATH))
+        {
+            pStore_->Remove(IMAGE_CATALOG_TMP_FILE_PATH);
+        }
+        else
+        {
+            pStore_->Rename(
+                IMAGE_CATALOG_TMP_FILE_PATH,
+                IMAGE_CATALOG_FILE_PATH
+            );
+        }
+    }
+
+    if(!Load())
+    {
+        Rebuild();
+    }
+
+    pStore_->Unlock();
+}
+
+bool ImageCatalog::Load(void)
+{
+    FsFile              file;
+    size_t              i;
+    size_t              count;
+    size_t              fileSize;
+    bool                isValid;
+    uint32_t            crc;
+    SImageCatalogHeader header;
+
+    entries_.clear();
+    IndexNames();
+
+    file = pStore_->Open(IMAGE_CATALOG_FILE_PATH, FILE_READ);
+    if(!file)
+    {
+        LOG_INFO("No image catalog\n");
+        return false;
+    }
+
+    fileSize = file.fileSize();
+    if(file.read(&header, sizeof(SImageCatalogHeader)) !=
+       (int)sizeof(SImageCatalogHeader))
+    {
+        LOG_ERROR("Failed to read the image catalog\n");
+        file.close();
+        return false;
+    }
+
+    crc = esp_rom_crc32_le(
+        0,
+        (const uint8_t*)&header,
+        offsetof(SImageCatalogHeader, crc)
+    );
+    if(header.magic != IMAGE_CATALOG_MAGIC ||
+       header.version != IMAGE_CATALOG_VERSION ||
+       header.crc != crc)
+    {
+        LOG_ERROR("Invalid image catalog\n");
+        file.close();
+        return false;
+    }
+
+    /* A torn catalog keeps its complete entries */
+    count = (fileSize - sizeof(SImageCatalogHeader)) /
+            sizeof(SImageCatalogEntry);
+    isValid = (count == header.count);
+    count = MIN(count, (size_t)header.count);
+    count = MIN(count, (size_t)IMAGE_CATALOG_MAX_ENTRIES);
+
+    entries_.resize(count);
+    if(count != 0 &&
+       file.read(entries_.data(), count * sizeof(SImageCatalogEntry)) !=
+       (int)(count * sizeof(SImageCatalogEntry)))
+    {
+        LOG_ERROR("Failed to read the image catalog\n");
+        entries_.clear();
+        file.close();
+        return false;
+    }
+    file.close();
+
+    /* Drop the entries torn by a power loss */
+    i = 0;
+    while(i < entries_.size())
+    {
+        crc = esp_rom_crc32_le(
+            0,
+            (const uint8_t*)&entries_[i],
+            offsetof(SImageCatalogEntry, crc)
+        );
+        if(crc != entries_[i].crc ||
+           entries_[i].pName[IMAGE_CATALOG_NAME_SIZE - 1] != 0 ||
+           (i != 0 && !IsBefore(entries_[i - 1], entries_[i])))
+        {
+            LOG_ERROR("Invalid image catalog entry %d\n", i);
+            entries_.erase(entries_.begin() + i);
+            isValid = false;
+        }
+        else
+        {
+            ++i;
+        }
+    }
+    IndexNames();
+
+    /* The image directory changed and the catalog was not saved after */
+    if(isValid && (header.flags & IMAGE_CATALOG_HEADER_FLAG_DIRTY) != 0)
+    {
+        LOG_ERROR("Image catalog marked dirty\n");
+        isValid = false;
+    }
+
+    LOG_DEBUG("Loaded the image catalog (%d images)\n", entries_.size());
+
+    return isValid;
+}
+
+void ImageCatalog::Rebuild(void)
+{
+    size_t             i;
+    ssize_t            index;
+    uint32_t           cursor;
+    SImageCatalogEntry entry;
+
+    std::vector<SFileEntry>         files;
+    std::vector<SImageCatalogEntry> entries;
+
+    LOG_INFO("Rebuilding the image catalog\n");
+
+    cursor = 0;
+    while(cursor != FILES_CURSOR_END)
+    {
+        if(!pStore_->GetFilesPage(IMAGE_DIR_PATH,
+                                  cursor,
+                                  IMAGE_PAGE_MAX_ENTRIES,
+                                  files,
+                                  cursor))
+        {
+            LOG_ERROR("Failed to list the images\n");
+            break;
+        }
+
+        for(i = 0; i < files.size(); ++i)
+        {
+            if(files[i].name.size() >= IMAGE_CATALOG_NAME_SIZE ||
+               entries.size() >= IMAGE_CATALOG_MAX_ENTRIES)
+            {
+                LOG_ERROR("Image %s not cataloged\n", files[i].name.c_str());
+                continue;
+            }
+
+            /* Keep the metadata of the images already known */
+            index = FindIndex(files[i].name.c_str());
+            if(index >= 0 && entries_[index].size == files[i].size)
+            {
+                entries.push_back(entries_[index]);
+                continue;
+            }
+
+            memset(&entry, 0, sizeof(SImageCatalogEntry));
+            memcpy(entry.pName, files[i].name.c_str(), files[i].name.size());
+            if(ReadImageInfo(entry))
+            {
+                SealEntry(entry);
+                entries.push_back(entry);
+            }
+        }
+    }
+
+    std::sort(entries.begin(), entries.end(), IsBefore);
+    entries_.swap(entries);
+    IndexNames();
+
+    if(!Save())
+    {
+        LOG_ERROR("Failed to save the image catalog\n");
+    }
+
+    LOG_INFO("Rebuilt the image catalog (%d images)\n", entries_.size());
+}
+
+bool ImageCatalog::Save(void)
+{
+    FsFile file;
+    size_t size;
+    size_t written;
+
+    pStore_->Remove(IMAGE_CATALOG_TMP_FILE_PATH);
+    file = pStore_->Open(IMAGE_CATALOG_TMP_FILE_PATH, FILE_WRITE);
+    if(!file)
+    {
+        LOG_ERROR("Failed to open the temporary image catalog\n");
+        return false;
+    }
+
+    /* The saved catalog matches the image directory, it is clean */
+    size = sizeof(SImageCatalogHeader) +
+           entries_.size() * sizeof(SImageCatalogEntry);
+    written = WriteHeader(file, 0) ? sizeof(SImageCatalogHeader) : 0;
+    if(!entries_.empty())
+    {
+        written += file.write(
+            entries_.data(),
+            entries_.size() * sizeof(SImageCatalogEntry)
+        );
+    }
+    file.close();
+
+    if(written != size)
+    {
+        LOG_ERROR("Failed to write the image catalog\n");
+        pStore_->Remove(IMAGE_CATALOG_TMP_FILE_PATH);
+        return false;
+    }
+
+    /* The temporary catalog is complete, it replaces the catalog */
+    if(!pStore_->Rename(IMAGE_CATALOG_TMP_FILE_PATH, IMAGE_CATALOG_FILE_PATH))
+    {
+        LOG_ERROR("Failed to replace the image catalog\n");
+        return false;
+    }
+
+    return true;
+}
+
+bool ImageCatalog::WriteHeader(FsFile& rFile, const uint16_t kFlags)
+{
+    SImageCatalogHeader header;
+
+    header.magic   = IMAGE_CATALOG_MAGIC;
+    header.version = IMAGE_CATALOG_VERSION;
+    header.flags   = kFlags;
+    header.count   = entries_.size();
+    header.crc     = esp_rom_crc32_le(
+        0,
+        (const uint8_t*)&header,
+        offsetof(SImageCatalogHeader, crc)
+    );
+
+    return rFile.write(&header, sizeof(SImageCatalogHeader)) ==
+           sizeof(SImageCatalogHeader);
+}
+
+bool ImageCatalog::WriteEntry(const size_t kIndex)
+{
+    FsFile file;
+    bool   status;
+
+    file = pStore_->Open(IMAGE_CATALOG_FILE_PATH, O_RDWR);
+    if(!file)
+    {
+        LOG_ERROR("Failed to open the image catalog\n");
+        return false;
+    }
+
+    status = file.seekSet(sizeof(SImageCatalogHeader) +
+                          kIndex * sizeof(SImageCatalogEntry)) &&
+             file.write(&entries_[kIndex], sizeof(SImageCatalogEntry)) ==
+             sizeof(SImageCatalogEntry);
+    file.close();
+
+    if(!status)
+    {
+        LOG_ERROR("Failed to write image catalog entry %d\n", kIndex);
+    }
+
+    return status;
+}
+
+bool ImageCatalog::ReadImageInfo(SImageCatalogEntry& rEntry)
+{
+    FsFile            file;
+    uint16_t          date;
+    uint16_t          time;
+    SImageCodecHeader header;
+
+    file = pStore_->Open(
+        IMAGE_DIR_PATH + std::string("/") + rEntry.pName,
+        FILE_READ
+    );
+    if(!file)
+    {
+        LOG_ERROR("Failed to open image %s\n", rEntry.pName);
+        return false;
+    }
+
+    rEntry.size = file.fileSize();
+    if(!file.getModifyDateTime(&date, &time))
+    {
+        date = 0;
+        time = 0;
+    }
+    rEntry.uploadDate = date;
+    rEntry.uploadTime = time;
+
+    /* Raw images have no header */
+    if(file.read(&header, sizeof(SImageCodecHeader)) ==
+       (int)sizeof(SImageCodecHeader) &&
+       ImageDecoder::IsCompressed(header))
+    {
+        rEntry.encoding = IMAGE_ENCODING_COMPRESSED;
+    }
+    else
+    {
+        rEntry.encoding = IMAGE_ENCODING_RAW;
+    }
+    file.close();
+
+    return true;
+}
+
+void ImageCatalog::IndexNames(void)
+{
+    size_t i;
+    size_t slotCount;
+    size_t slot;
+
+    /* The page cursors returned before are stale */
+    ++generation_;
+
+    slotCount = IMAGE_CATALOG_MIN_SLOTS;
+    while(slotCount < entries_.size() * 2)
+    {
+        slotCount <<= 1;
+    }
+
+    slots_.assign(slotCount, IMAGE_CATALOG_SLOT_EMPTY);
+    for(i = 0; i < entries_.size(); ++i)
+    {
+        slot = HashName(entries_[i].pName) & (slotCount - 1);
+        while(slots_[slot] != IMAGE_CATALOG_SLOT_EMPTY)
+        {
+            slot = (slot + 1) & (slotCount - 1);
+        }
+        slots_[slot] = i;
+    }
+}
+
+ssize_t ImageCatalog::FindIndex(const char* pkName) const
+{
+    size_t  mask;
+    size_t  slot;
+    ssize_t index;
+
+    if(strlen(pkName) >= IMAGE_CATALOG_NAME_SIZE)
+    {
+        return -1;
+    }
+
+    index = -1;
+    if(!slots_.empty())
+    {
+        mask = slots_.size() - 1;
+        slot = HashName(pkName) & mask;
+        while(slots_[slot] != IMAGE_CATALOG_SLOT_EMPTY)
+        {
+            if(strcmp(entries_[slots_[slot]].pName, pkName) == 0)
+            {
+                index = slots_[slot];
+                break;
+            }
+            slot = (slot + 1) & mask;
+        }
+    }
+
+    return index;
+}
+
+size_t ImageCatalog::LowerBound(const char* pkName) const
+{
+    size_t low;
+    size_t high;
+    size_t middle;
+
+    low  = 0;
+    high = entries_.size();
+    while(low < high)
+    {
+        middle = low + (high - low) / 2;
+        if(strcmp(entries_[middle].pName, pkName) < 0)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return low;
+}
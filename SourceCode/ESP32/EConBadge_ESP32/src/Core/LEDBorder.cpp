@@ -25,6 +25,7 @@
 #include <HWMgr.h>        /* HW manager */
 #include <Types.h>        /* Custom types */
 #include <Storage.h>      /* Storage manager */
+#include <ConfigStore.h>  /* Configuration store */
 #include <FastLED.h>      /* Fast LED Service */
 #include <BlueToothMgr.h> /* Bleutooth services */
 
@@ -123,6 +124,7 @@ LEDBorder::LEDBorder(BluetoothManager* pBtManager)
     isEnabled_  = false;
     brightness_ = 0;
     pStore_     = Storage::GetInstance();
+    pConfig_    = ConfigStore::GetInstance();
     pBtManager_ = pBtManager;
 
     memset(ledsColors_, 0, STRIP_LED_COUNT * sizeof(uint32_t));
@@ -192,11 +194,7 @@ void LEDBorder::Enable(const bool kEnabled)
     LOG_DEBUG("Enabling LED: ? %d\n", isEnabled_);
 
     /* Save new state */
-    pStore_->SetContent(
-        LEDBORDER_ENABLED_FILE_PATH,
-        std::to_string(isEnabled_),
-        true
-    );
+    pConfig_->SetInteger(CONFIG_KEY_LED_ENABLED, isEnabled_);
 }
 
 bool LEDBorder::IsEnabled(void) const
@@ -206,76 +204,88 @@ bool LEDBorder::IsEnabled(void) const
 
 void LEDBorder::IncreaseBrightness(SCommandResponse& rReponse)
 {
+    uint8_t brightness;
+    bool    changed;
+
     xSemaphoreTake(lock_, portMAX_DELAY);
 
     /* Setup new brightness */
-    if(brightness_ < MAX_BRIGHTNESS)
+    changed = brightness_ < MAX_BRIGHTNESS;
+    if(changed)
     {
         brightness_ = MIN(100, brightness_ + MIN_BRIGHTNESS);
-
-        /* Save new brightness */
-        pStore_->SetContent(
-            LEDBORDER_BRIGHTNESS_FILE_PATH,
-            std::to_string(brightness_),
-            true
-        );
     }
+    brightness = brightness_;
 
     xSemaphoreGive(lock_);
 
+    /* Save new brightness, the journal is not written under the lock */
+    if(changed)
+    {
+        pConfig_->SetInteger(CONFIG_KEY_LED_BRIGHTNESS, brightness);
+    }
+
     /* Set the return value to return the current brightness */
     rReponse.header.errorCode = NO_ERROR;
     rReponse.header.size = 1;
-    rReponse.pResponse[0] = brightness_;
+    rReponse.pResponse[0] = brightness;
 }
 
 void LEDBorder::ReduceBrightness(SCommandResponse& rReponse)
 {
+    uint8_t brightness;
+    bool    changed;
+
     xSemaphoreTake(lock_, portMAX_DELAY);
 
     /* Setup new brightness */
-    if(brightness_ > MIN_BRIGHTNESS)
+    changed = brightness_ > MIN_BRIGHTNESS;
+    if(changed)
     {
         brightness_ = MAX(MIN_BRIGHTNESS, brightness_ - MIN_BRIGHTNESS);
-
-        /* Save new brightness */
-        pStore_->SetContent(
-            LEDBORDER_BRIGHTNESS_FILE_PATH,
-            std::to_string(brightness_),
-            true
-        );
     }
+    brightness = brightness_;
 
     xSemaphoreGive(lock_);
 
+    /* Save new brightness, the journal is not written under the lock */
+    if(changed)
+    {
+        pConfig_->SetInteger(CONFIG_KEY_LED_BRIGHTNESS, brightness);
+    }
+
     /* Set the return value to return the current brightness */
     rReponse.header.errorCode = NO_ERROR;
     rReponse.header.size = 1;
-    rReponse.pResponse[0] = brightness_;
+    rReponse.pResponse[0] = brightness;
 }
 
 void LEDBorder::SetBrightness(const uint8_t* kpData, SCommandResponse& rReponse)
 {
+    uint8_t brightness;
+    bool    changed;
+
     xSemaphoreTake(lock_, portMAX_DELAY);
 
-    if(*kpData >= MIN_BRIGHTNESS && *kpData <= MAX_BRIGHTNESS)
+    changed = *kpData >= MIN_BRIGHTNESS && *kpData <= MAX_BRIGHTNESS;
+    if(changed)
     {
         brightness_ = *kpData;
-
-        /* Save new brightness */
-        pStore_->SetContent(
-            LEDBORDER_BRIGHTNESS_FILE_PATH,
-            std::to_string(brightness_),
-            true
-        );
     }
+    brightness = brightness_;
 
     xSemaphoreGive(lock_);
 
+    /* Save new brightness, the journal is not written under the lock */
+    if(changed)
+    {
+        pConfig_->SetInteger(CONFIG_KEY_LED_BRIGHTNESS, brightness);
+    }
+
     /* Set the return value to return the current brightness */
     rReponse.header.errorCode = NO_ERROR;
     rReponse.header.size = 1;
-    rReponse.pResponse[0] = brightness_;
+    rReponse.pResponse[0] = brightness;
 }
 
 uint8_t LEDBorder::GetBrightness(void) const
@@ -831,13 +841,15 @@ void LEDBorder::SavePatterns(void) const
     size_t  written;
     uint8_t buffer;
 
-    /* Open TMP file */
+    /* Open TMP file, the storage is held until the file is replaced */
+    pStore_->Lock();
     pStore_->Remove(LEDBORDER_PATTERN_TMP_FILE);
     file = pStore_->Open(LEDBORDER_PATTERN_TMP_FILE, FILE_WRITE);
 
     if(!file)
     {
         LOG_ERROR("Failed to open file to save patterns\n");
+        pStore_->Unlock();
         return;
     }
 
@@ -848,6 +860,7 @@ void LEDBorder::SavePatterns(void) const
     {
         LOG_ERROR("Failed to write patterns file\n");
         file.close();
+        pStore_->Unlock();
         return;
     }
 
@@ -859,6 +872,7 @@ void LEDBorder::SavePatterns(void) const
         {
             LOG_ERROR("Failed to write patterns file\n");
             file.close();
+            pStore_->Unlock();
             return;
         }
     }
@@ -869,6 +883,7 @@ void LEDBorder::SavePatterns(void) const
     {
         LOG_ERROR("Failed to open current patterns file\n");
         file.close();
+        pStore_->Unlock();
         return;
     }
 
@@ -876,6 +891,7 @@ void LEDBorder::SavePatterns(void) const
     {
         LOG_ERROR("Failed to rename current patterns file\n");
         file.close();
+        pStore_->Unlock();
         return;
     }
 
@@ -886,6 +902,7 @@ void LEDBorder::SavePatterns(void) const
     }
     replaceFile.remove();
     file.close();
+    pStore_->Unlock();
 }
 
 void LEDBorder::SaveAnimations(void) const
@@ -895,13 +912,15 @@ void LEDBorder::SaveAnimations(void) const
     size_t  written;
     uint8_t buffer;
 
-    /* Open TMP file */
+    /* Open TMP file, the storage is held until the file is replaced */
+    pStore_->Lock();
     pStore_->Remove(LEDBORDER_ANIM_TMP_FILE);
     file = pStore_->Open(LEDBORDER_ANIM_TMP_FILE, FILE_WRITE);
 
     if(!file)
     {
         LOG_ERROR("Failed to open file to save animations\n");
+        pStore_->Unlock();
         return;
     }
 
@@ -912,6 +931,7 @@ void LEDBorder::SaveAnimations(void) const
     {
         LOG_ERROR("Failed to write animations file\n");
         file.close();
+        pStore_->Unlock();
         return;
     }
 
@@ -923,6 +943,7 @@ void LEDBorder::SaveAnimations(void) const
         {
             LOG_ERROR("Failed to write animations file\n");
             file.close();
+            pStore_->Unlock();
             return;
         }
     }
@@ -933,6 +954,7 @@ void LEDBorder::SaveAnimations(void) const
     {
         LOG_ERROR("Failed to open current animations file\n");
         file.close();
+        pStore_->Unlock();
         return;
     }
 
@@ -940,6 +962,7 @@ void LEDBorder::SaveAnimations(void) const
     {
         LOG_ERROR("Failed to rename current animations file\n");
         file.close();
+        pStore_->Unlock();
         return;
     }
 
@@ -950,31 +973,36 @@ void LEDBorder::SaveAnimations(void) const
     }
     replaceFile.remove();
     file.close();
+    pStore_->Unlock();
 }
 
 void LEDBorder::LoadState(void)
 {
-    FsFile      file;
-    std::string content;
-    uint8_t     pBuffer[64];
-    uint8_t     counter;
-    uint8_t     i;
+    FsFile  file;
+    int32_t brightness;
+    uint8_t pBuffer[64];
+    uint8_t counter;
+    uint8_t i;
+
+    pStore_->Lock();
 
     /* Load the state */
-    pStore_->GetContent(LEDBORDER_ENABLED_FILE_PATH, "0", content, true);
-    isEnabled_ = (content != "0");
+    isEnabled_ = (pConfig_->GetInteger(CONFIG_KEY_LED_ENABLED) != 0);
 
     /* Load the brightness */
-    pStore_->GetContent(LEDBORDER_BRIGHTNESS_FILE_PATH, "0", content, true);
-    brightness_ = std::stoi(content);
-    if(brightness_ > MAX_BRIGHTNESS)
+    brightness = pConfig_->GetInteger(CONFIG_KEY_LED_BRIGHTNESS);
+    if(brightness > (int32_t)MAX_BRIGHTNESS)
     {
         brightness_ = MAX_BRIGHTNESS;
     }
-    else if(brightness_ < MIN_BRIGHTNESS)
+    else if(brightness < (int32_t)MIN_BRIGHTNESS)
     {
         brightness_ = MIN_BRIGHTNESS;
     }
+    else
+    {
+        brightness_ = brightness;
+    }
 
     /* Load the animations */
     file = pStore_->Open(LEDBORDER_ANIM_FILE_PATH, FILE_READ);
@@ -1042,6 +1070,8 @@ void LEDBorder::LoadState(void)
     {
         LOG_ERROR("Failed to load patterns\n");
     }
+
+    pStore_->Unlock();
 }
 
 void LEDBorder::ResetState(void)
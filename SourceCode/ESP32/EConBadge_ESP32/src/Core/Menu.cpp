@@ -23,6 +23,8 @@
 #include <cstdint>            /* Generic types */
 #include <HWMgr.h>            /* Hardware layer */
 #include <Storage.h>          /* Storage service */
+#include <ConfigStore.h>      /* Configuration store */
+#include <ImageCatalog.h>     /* Image catalog */
 #include <version.h>          /* System versionning */
 #include <DisplayInterface.h> /* Display interface */
 
@@ -33,7 +35,8 @@
  * CONSTANTS
  ******************************************************************************/
 
-/* None */
+/** @brief Number of images displayed by the image list page. */
+#define MENU_IMAGE_LIST_ITEMS 6
 
 /*******************************************************************************
  * MACROS
@@ -65,13 +68,56 @@
  * STATIC FUNCTIONS DECLARATIONS
  ******************************************************************************/
 
-/* None */
+/**
+ * @brief Sets the items of the image list page.
+ *
+ * @param[in, out] pPage The image list page.
+ * @param[in] pkImageList The image names.
+ * @param[in] kCount The number of image names.
+ */
+static void SetEInkImageListItems(
+    SMenuPage*    pPage,
+    const char    pkImageList[][IMAGE_CATALOG_NAME_SIZE],
+    const uint8_t kCount);
 
 /*******************************************************************************
  * FUNCTIONS
  ******************************************************************************/
 
-/* None */
+static void SetEInkImageListItems(
+    SMenuPage*    pPage,
+    const char    pkImageList[][IMAGE_CATALOG_NAME_SIZE],
+    const uint8_t kCount)
+{
+    uint8_t    i;
+    uint8_t    size;
+    SMenuItem* pTmpItem;
+
+    /* Keep the items of the previous list, scrolling does not allocate */
+    for(i = kCount; i < pPage->items.size(); ++i)
+    {
+        delete pPage->items[i];
+    }
+    if(pPage->items.size() > kCount)
+    {
+        pPage->items.resize(kCount);
+    }
+    while(pPage->items.size() < kCount)
+    {
+        pPage->items.push_back(new SMenuItem());
+    }
+
+    /* Set the items */
+    for(i = 0; i < kCount; ++i)
+    {
+        size = MIN(strlen(pkImageList[i]), LINE_SIZE_CHAR);
+        pTmpItem = pPage->items[i];
+        pTmpItem->actionParams = (void*)(uintptr_t)size;
+        pTmpItem->action = MENU_ACTION_SET_EINK_IMAGE;
+        memcpy(pTmpItem->pContent, pkImageList[i], size);
+        pTmpItem->pContent[size] = 0;
+    }
+}
 
 /*******************************************************************************
  * CLASS METHODS
@@ -530,21 +576,21 @@ void Menu::Reset(void)
 
 void Menu::UpdateMyInfoPage(SMenuPage* pPage)
 {
-    std::string contentStr;
-    Storage*    pStore;
-    size_t      toCopy;
+    std::string  contentStr;
+    ConfigStore* pConfig;
+    size_t       toCopy;
 
-    pStore = Storage::GetInstance();
+    pConfig = ConfigStore::GetInstance();
 
     /* Update the info name and contact */
-    pStore->GetContent(OWNER_FILE_PATH, "", contentStr, true);
+    pConfig->GetString(CONFIG_KEY_OWNER, contentStr);
     toCopy = MIN(LINE_SIZE_CHAR * 2 - 7, contentStr.size());
 
     memcpy(pPage->items[0]->pContent, "Owner: ", 7);
     memcpy(pPage->items[0]->pContent + 7, contentStr.c_str(), toCopy);
     pPage->items[0]->pContent[toCopy + 7] = 0;
 
-    pStore->GetContent(CONTACT_FILE_PATH, "", contentStr, true);
+    pConfig->GetString(CONFIG_KEY_CONTACT, contentStr);
     toCopy = MIN(LINE_SIZE_CHAR * 2 - 9, contentStr.size());
 
     memcpy(pPage->items[1]->pContent, contentStr.c_str(), toCopy);
@@ -553,41 +599,25 @@ void Menu::UpdateMyInfoPage(SMenuPage* pPage)
 
 void Menu::UpdateEInkImageListPage(SMenuPage* pPage)
 {
-    std::string contentStr;
-    Storage*    pStore;
-    uint8_t     i;
-    SMenuItem*  pTmpItem;
-    uint8_t     size;
+    std::string   contentStr;
+    ImageCatalog* pCatalog;
+    uint8_t       count;
 
-    std::vector<std::string> imageList;
+    char pImageList[MENU_IMAGE_LIST_ITEMS][IMAGE_CATALOG_NAME_SIZE];
 
-    pStore = Storage::GetInstance();
+    pCatalog = ImageCatalog::GetInstance();
 
     /* Get the current image */
-    pStore->GetContent(CURRENT_IMG_NAME_FILE_PATH, "", contentStr, true);
+    ConfigStore::GetInstance()->GetString(CONFIG_KEY_CURRENT_IMAGE, contentStr);
 
     /* Update the image list */
-    pStore->GetFilesListFrom(IMAGE_DIR_PATH, imageList, contentStr, 0, 6);
-
-    /* Clear old items */
-    for(i = 0; i < pPage->items.size(); ++i)
-    {
-        delete pPage->items[i];
-    }
-    pPage->items.clear();
-
-    /* Add the items */
-    for(i = 0; i < imageList.size(); ++i)
-    {
-        size = MIN(imageList[i].size(), LINE_SIZE_CHAR);
-        pTmpItem = new SMenuItem();
-        pTmpItem->actionParams = (void*)(uintptr_t)size;
-        pTmpItem->action = MENU_ACTION_SET_EINK_IMAGE;
-        memcpy(pTmpItem->pContent, imageList[i].c_str(), size);
-        pTmpItem->pContent[size + 1] = 0;
-
-        pPage->items.push_back(pTmpItem);
-    }
+    count = pCatalog->GetNamesFrom(
+        contentStr.c_str(),
+        0,
+        MENU_IMAGE_LIST_ITEMS,
+        pImageList
+    );
+    SetEInkImageListItems(pPage, pImageList, count);
 
     pPage->needsUpdate = false;
 }
@@ -595,17 +625,15 @@ void Menu::UpdateEInkImageListPage(SMenuPage* pPage)
 uint8_t Menu::ScrollEInkImageListPage(SMenuPage* pPage,
                                       const bool kDown)
 {
-    std::string contentStr;
-    Storage*    pStore;
-    uint8_t     i;
-    SMenuItem*  pTmpItem;
-    uint8_t     size;
-    uint8_t     nextItem;
-    uint8_t     prevItems;
+    ImageCatalog* pCatalog;
+    const char*   pkStartName;
+    uint8_t       count;
+    uint8_t       nextItem;
+    uint8_t       prevItems;
 
-    std::vector<std::string> imageList;
+    char pImageList[MENU_IMAGE_LIST_ITEMS][IMAGE_CATALOG_NAME_SIZE];
 
-    pStore = Storage::GetInstance();
+    pCatalog = ImageCatalog::GetInstance();
 
     if(kDown)
     {
@@ -621,41 +649,21 @@ uint8_t Menu::ScrollEInkImageListPage(SMenuPage* pPage,
     /* Get the current item image */
     if(pPage->items.size() > nextItem)
     {
-        contentStr = pPage->items[nextItem]->pContent;
+        pkStartName = pPage->items[nextItem]->pContent;
     }
     else
     {
-        contentStr = "";
+        pkStartName = "";
     }
 
     /* Update the image list */
-    pStore->GetFilesListFrom(
-        IMAGE_DIR_PATH,
-        imageList,
-        contentStr,
+    count = pCatalog->GetNamesFrom(
+        pkStartName,
         prevItems,
-        6
+        MENU_IMAGE_LIST_ITEMS,
+        pImageList
     );
-
-    /* Clear old items */
-    for(i = 0; i < pPage->items.size(); ++i)
-    {
-        delete pPage->items[i];
-    }
-    pPage->items.clear();
-
-    /* Add the items */
-    for(i = 0; i < imageList.size(); ++i)
-    {
-        size = MIN(imageList[i].size(), LINE_SIZE_CHAR);
-        pTmpItem = new SMenuItem();
-        pTmpItem->actionParams = (void*)(uintptr_t)size;
-        pTmpItem->action = MENU_ACTION_SET_EINK_IMAGE;
-        memcpy(pTmpItem->pContent, imageList[i].c_str(), size);
-        pTmpItem->pContent[size + 1] = 0;
-
-        pPage->items.push_back(pTmpItem);
-    }
+    SetEInkImageListItems(pPage, pImageList, count);
 
     return 0;
 }
@@ -663,16 +671,13 @@ uint8_t Menu::ScrollEInkImageListPage(SMenuPage* pPage,
 void Menu::UpdateBluetoothInfo(SMenuPage* pPage)
 {
     std::string contentStr;
-    Storage*    pStore;
-
-    pStore = Storage::GetInstance();
 
     /* Update the name and token */
     memcpy(pPage->items[0]->pContent, "Name: ", 6);
     memcpy(pPage->items[0]->pContent + 6, HWManager::GetHWUID(), HW_ID_LENGTH);
     pPage->items[0]->pContent[HW_ID_LENGTH + 6] = 0;
 
-    pStore->GetContent(BLUETOOTH_TOKEN_FILE_PATH, "Unknown", contentStr, true);
+    ConfigStore::GetInstance()->GetString(CONFIG_KEY_BT_TOKEN, contentStr);
     memcpy(pPage->items[1]->pContent, "\nToken:\n", 8);
     memcpy(pPage->items[1]->pContent + 8, contentStr.c_str(), COMM_TOKEN_SIZE);
     pPage->items[1]->pContent[COMM_TOKEN_SIZE + 8] = 0;
@@ -680,14 +685,13 @@ void Menu::UpdateBluetoothInfo(SMenuPage* pPage)
 
 void Menu::UpdateLEDSettings(SMenuPage* pPage)
 {
-    std::string contentStr;
-    Storage*    pStore;
+    std::string  contentStr;
+    ConfigStore* pConfig;
 
-    pStore = Storage::GetInstance();
+    pConfig = ConfigStore::GetInstance();
 
     /* Update the current state */
-    pStore->GetContent(LEDBORDER_ENABLED_FILE_PATH, "0", contentStr, true);
-    if(contentStr == "0")
+    if(pConfig->GetInteger(CONFIG_KEY_LED_ENABLED) == 0)
     {
         memcpy(pPage->items[0]->pContent, "Enable", 7);
         pPage->items[0]->actionParams = (void*)1;
@@ -699,7 +703,7 @@ void Menu::UpdateLEDSettings(SMenuPage* pPage)
     }
 
     /* Get the current brightness */
-    pStore->GetContent(LEDBORDER_BRIGHTNESS_FILE_PATH, "0", contentStr, true);
+    contentStr = std::to_string(pConfig->GetInteger(CONFIG_KEY_LED_BRIGHTNESS));
     memcpy(pPage->items[3]->pContent, "\n=> Brightness ", 16);
     memcpy(
         pPage->items[3]->pContent + 15,
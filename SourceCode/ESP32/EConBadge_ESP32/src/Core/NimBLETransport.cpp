@@ -0,0 +1,430 @@
+/*******************************************************************************
+ * @file NimBLETransport.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file implements the NimBLE transport.
+ *
+ * @details This file implements the NimBLE transport. The transport exposes the
+ * badge GATT service, each channel is a characteristic of the main service.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <Types.h>        /* Custom defined types */
+#include <HWMgr.h>        /* HW layer component*/
+#include <Logger.h>       /* System logger */
+#include <version.h>      /* ECB versioning */
+#include <BLETransport.h> /* BLE transport interface */
+#include <NimBLEDevice.h> /* BLE Services */
+
+/* Header File */
+#include <NimBLETransport.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Main BLE service UUID */
+#define MAIN_SERVICE_UUID "d3e63261-0000-1000-8000-00805f9b34fb"
+
+/** @brief Hardware version characteristic UUID */
+#define HW_VERSION_CHARACTERISTIC_UUID    "997ca8f9-0000-1000-8000-00805f9b34fb"
+/** @brief Software version characteristic UUID */
+#define SW_VERSION_CHARACTERISTIC_UUID    "20a14f57-0000-1000-8000-00805f9b34fb"
+/** @brief Command manager characteristic UUID */
+#define COMMAND_CHARACTERISTIC_UUID       "2d3a8ac3-0000-1000-8000-00805f9b34fb"
+/** @brief Data transfer characteristic UUID */
+#define DATA_CHARACTERISTIC_UUID          "83670c18-0000-1000-8000-00805f9b34fb"
+/** @brief Bulk upload characteristic UUID */
+#define BULK_CHARACTERISTIC_UUID          "5c7e0a41-0000-1000-8000-00805f9b34fb"
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/** @brief BLE server callback */
+class ServerCallback: public BLEServerCallbacks
+{
+    /******************** PUBLIC METHODS AND ATTRIBUTES ***********************/
+    public:
+        explicit ServerCallback(NimBLETransport*  pTransport,
+                                TransportHandler* pHandler)
+        {
+            pTransport_ = pTransport;
+            pHandler_   = pHandler;
+            memset(&info_, 0, sizeof(SBLELinkInfo));
+        }
+
+        /**
+         * @brief Disconnect callback.
+         *
+         * @details Disconnect callback for the BLE server. Called when the
+         * current pair has disconnected.
+         *
+         * @param[in, out] pServer The BLE server that got its pair disconnected.
+         */
+        void onDisconnect(NimBLEServer* pServer,
+                          NimBLEConnInfo& connInfo,
+                          int reason)
+        {
+            pTransport_->SetConnected(false);
+            pHandler_->OnDisconnect();
+
+            /* On disconnect, start advertising */
+            pServer->startAdvertising();
+        }
+
+        void onConnect(NimBLEServer* pServer, NimBLEConnInfo& connInfo)
+        {
+            /**
+             *  We can use the connection handle here to ask for different connection parameters.
+             *  Args: connection handle, min connection interval, max connection interval
+             *  latency, supervision timeout.
+             *  Units; Min/Max Intervals: 1.25 millisecond increments.
+             *  Latency: number of intervals allowed to skip.
+             *  Timeout: 10 millisecond increments.
+             */
+            pServer->updateConnParams(connInfo.getConnHandle(), 6, 8, 0, 180);
+
+            /* Link setup: request data length extension and 2M PHY. The MTU
+             * exchange is started by the central with our preferred MTU. The
+             * granted values are recorded by the update callbacks.
+             */
+            pServer->setDataLen(
+                connInfo.getConnHandle(),
+                BLE_PREFERRED_DATA_LENGTH
+            );
+            if(!pServer->updatePhy(connInfo.getConnHandle(),
+                                   BLE_GAP_LE_PHY_2M_MASK,
+                                   BLE_GAP_LE_PHY_2M_MASK,
+                                   0))
+            {
+                LOG_INFO("2M PHY request failed.\n");
+            }
+
+            memset(&info_, 0, sizeof(SBLELinkInfo));
+            info_.mtu                = connInfo.getMTU();
+            info_.segmentSize        = BLE_SEGMENT_SIZE(connInfo.getMTU());
+            info_.dataLength         = BLE_PREFERRED_DATA_LENGTH;
+            info_.txPhy              = 1;
+            info_.rxPhy              = 1;
+            info_.connInterval       = connInfo.getConnInterval();
+            info_.connLatency        = connInfo.getConnLatency();
+            info_.supervisionTimeout = connInfo.getConnTimeout();
+            pHandler_->OnConnect(info_);
+
+            pTransport_->SetConnected(true);
+        }
+
+        /**
+         * @brief MTU exchange callback.
+         *
+         * @param[in] MTU The negotiated ATT MTU.
+         * @param[in, out] connInfo The connection information.
+         */
+        void onMTUChange(uint16_t MTU, NimBLEConnInfo& connInfo)
+        {
+            info_.mtu         = MTU;
+            info_.segmentSize = BLE_SEGMENT_SIZE(MTU);
+            pHandler_->OnLinkUpdate(info_);
+            LOG_INFO("Negotiated MTU %d\n", MTU);
+        }
+
+        /**
+         * @brief Connection parameters update callback.
+         *
+         * @param[in, out] connInfo The connection information.
+         */
+        void onConnParamsUpdate(NimBLEConnInfo& connInfo)
+        {
+            info_.connInterval       = connInfo.getConnInterval();
+            info_.connLatency        = connInfo.getConnLatency();
+            info_.supervisionTimeout = connInfo.getConnTimeout();
+            pHandler_->OnLinkUpdate(info_);
+        }
+
+        /**
+         * @brief PHY update callback.
+         *
+         * @param[in, out] connInfo The connection information.
+         * @param[in] txPhy The granted TX PHY.
+         * @param[in] rxPhy The granted RX PHY.
+         */
+        void onPhyUpdate(NimBLEConnInfo& connInfo, uint8_t txPhy, uint8_t rxPhy)
+        {
+            info_.txPhy = txPhy;
+            info_.rxPhy = rxPhy;
+            pHandler_->OnLinkUpdate(info_);
+            LOG_INFO("Negotiated PHY TX %d RX %d\n", txPhy, rxPhy);
+        }
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+        /* None */
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        /** @brief Stores the transport. */
+        NimBLETransport*  pTransport_;
+        /** @brief Stores the transport handler. */
+        TransportHandler* pHandler_;
+        /** @brief Stores the link information of the current connection. */
+        SBLELinkInfo      info_;
+};
+
+/**
+ * @brief Channel characteristic callback class.
+ */
+class ChannelCallback: public BLECharacteristicCallbacks
+{
+    /******************** PUBLIC METHODS AND ATTRIBUTES ***********************/
+    public:
+        /**
+         * @brief Construct a new Channel Callback object.
+         *
+         * @param[in, out] pTransport The transport used with this callback.
+         * @param[in, out] pHandler The transport handler.
+         * @param[in] kChannel The channel carried by the characteristic.
+         */
+        explicit ChannelCallback(NimBLETransport*        pTransport,
+                                 TransportHandler*       pHandler,
+                                 const ETransportChannel kChannel)
+        {
+            pTransport_ = pTransport;
+            pHandler_   = pHandler;
+            channel_    = kChannel;
+        }
+
+        /**
+         * @brief Callback when a write is detected on the characteristic.
+         *
+         * @param[in, out] pCharacteristic The characteristic that was written.
+         */
+        virtual void onWrite(BLECharacteristic* pCharacteristic,
+                             NimBLEConnInfo&    rConnInfo)
+        {
+            NimBLEAttValue value;
+
+            value = pCharacteristic->getValue();
+            pHandler_->OnReceive(channel_, value.data(), value.size());
+        }
+
+        /**
+         * @brief Callback when a status is updated on the characteristic.
+         *
+         * @details Callback when a status is updated on the characteristic.
+         * The status of a notification is received within the notification.
+         *
+         * @param[in, out] pCharacteristic The characteristic that was updated.
+         * @param[in] code And additional code for the status.
+         */
+        virtual void onStatus(BLECharacteristic* pCharacteristic, int code)
+        {
+            LOG_DEBUG("On status %d: %d\n", channel_, code);
+
+            pTransport_->SetLastStatus(code);
+        }
+
+    /******************* PROTECTED METHODS AND ATTRIBUTES *********************/
+    protected:
+        /* None */
+
+    /********************* PRIVATE METHODS AND ATTRIBUTES *********************/
+    private:
+        /** @brief Stores the transport. */
+        NimBLETransport*  pTransport_;
+        /** @brief Stores the transport handler. */
+        TransportHandler* pHandler_;
+        /** @brief Stores the channel carried by the characteristic. */
+        ETransportChannel channel_;
+};
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/* None */
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+NimBLETransport::NimBLETransport(void)
+{
+    pHandler_ = nullptr;
+    pServer_ = nullptr;
+    pMainService_ = nullptr;
+    pAdvertising_ = nullptr;
+    memset(pChannels_, 0, sizeof(pChannels_));
+    connected_ = false;
+    lastStatus_ = 0;
+}
+
+bool NimBLETransport::Start(TransportHandler* pHandler)
+{
+    BLECharacteristic* pNewCharacteristic;
+
+    pHandler_ = pHandler;
+
+    /* Initialize the server and services */
+    if(!BLEDevice::init(HWManager::GetHWUID()))
+    {
+        LOG_ERROR("Failed to initialize BLE device\n");
+        return false;
+    }
+
+    pServer_ = BLEDevice::createServer();
+    pMainService_ = pServer_->createService(MAIN_SERVICE_UUID);
+
+    /* Setup server callback */
+    pServer_->setCallbacks(new ServerCallback(this, pHandler_));
+
+    /* Request the largest MTU, the data segments follow the negotiated one */
+    if(!BLEDevice::setMTU(BLE_PREFERRED_MTU))
+    {
+        LOG_ERROR("Failed to set the preferred MTU\n");
+    }
+
+    /* Setup the VERSION characteristics */
+    pNewCharacteristic = pMainService_->createCharacteristic(
+        HW_VERSION_CHARACTERISTIC_UUID,
+        NIMBLE_PROPERTY::READ
+    );
+    pNewCharacteristic->setValue(PROTO_REV);
+    pNewCharacteristic = pMainService_->createCharacteristic(
+        SW_VERSION_CHARACTERISTIC_UUID,
+        NIMBLE_PROPERTY::READ
+    );
+    pNewCharacteristic->setValue(VERSION);
+
+    /* Setup the COMMAND and DATA TRANSFER characteristics */
+    CreateChannel(
+        COMMAND_CHARACTERISTIC_UUID,
+        NIMBLE_PROPERTY::WRITE | NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::NOTIFY,
+        TRANSPORT_CHANNEL_COMMAND
+    );
+    CreateChannel(
+        DATA_CHARACTERISTIC_UUID,
+        NIMBLE_PROPERTY::WRITE | NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::NOTIFY,
+        TRANSPORT_CHANNEL_DATA
+    );
+
+    /* Setup the BULK UPLOAD characteristics, frames are written without
+     * response.
+     */
+    CreateChannel(
+        BULK_CHARACTERISTIC_UUID,
+        NIMBLE_PROPERTY::WRITE_NR | NIMBLE_PROPERTY::NOTIFY,
+        TRANSPORT_CHANNEL_BULK
+    );
+
+    /* Start the services */
+    pMainService_->start();
+
+    /* Start advertising */
+    pAdvertising_ = BLEDevice::getAdvertising();
+
+    pAdvertising_->setName(HWManager::GetHWUID());
+    pAdvertising_->addServiceUUID(pMainService_->getUUID());
+    pAdvertising_->enableScanResponse(true);
+    pAdvertising_->start();
+
+    return true;
+}
+
+bool NimBLETransport::IsConnected(void) const
+{
+    return connected_;
+}
+
+ETransportStatus NimBLETransport::Send(const ETransportChannel kChannel,
+                                       const uint8_t*          pkData,
+                                       const size_t            kSize)
+{
+    if(!connected_ || pChannels_[kChannel] == nullptr)
+    {
+        lastStatus_ = BLE_HS_ENOTCONN;
+        return TRANSPORT_FAILED;
+    }
+
+    /* The status callback runs within the notification, a buffer allocation
+     * failure returns before it.
+     */
+    lastStatus_ = BLE_HS_ENOMEM;
+    if(pChannels_[kChannel]->notify(pkData, kSize, BLE_HS_CONN_HANDLE_NONE))
+    {
+        lastStatus_ = 0;
+        return TRANSPORT_OK;
+    }
+
+    /* Only the congestion is worth retrying */
+    if(lastStatus_ == BLE_HS_ENOMEM ||
+       lastStatus_ == BLE_HS_EBUSY ||
+       lastStatus_ == BLE_HS_EAGAIN)
+    {
+        return TRANSPORT_CONGESTED;
+    }
+
+    return TRANSPORT_FAILED;
+}
+
+int NimBLETransport::GetLastStatus(void) const
+{
+    return lastStatus_;
+}
+
+void NimBLETransport::SetConnected(const bool kConnected)
+{
+    connected_ = kConnected;
+}
+
+void NimBLETransport::SetLastStatus(const int kStatus)
+{
+    lastStatus_ = kStatus;
+}
+
+void NimBLETransport::CreateChannel(const char*             kpUUID,
+                                    const uint32_t          kProperties,
+                                    const ETransportChannel kChannel)
+{
+    pChannels_[kChannel] = pMainService_->createCharacteristic(
+        kpUUID,
+        kProperties
+    );
+    pChannels_[kChannel]->setCallbacks(
+        new ChannelCallback(this, pHandler_, kChannel)
+    );
+}
@@ -0,0 +1,359 @@
+/*******************************************************************************
+ * @file ResumableTransfer.cpp
+ *
+ * @author Alexy Torres Aurora Dugo
+ *
+ * @date 16/10/2026
+ *
+ * @version 1.0
+ *
+ * @brief This file implements the resumable transfer service.
+ *
+ * @details This file implements the resumable transfer service. See
+ * ResumableTransfer.h for the transfer flow.
+ *
+ * @copyright Alexy Torres Aurora Dugo
+ ******************************************************************************/
+
+/*******************************************************************************
+ * INCLUDES
+ ******************************************************************************/
+#include <string>           /* std::string */
+#include <cstring>          /* memcpy, memcmp */
+#include <SdFat.h>          /* SD Card driver */
+#include <Types.h>          /* Defined types */
+#include <Logger.h>         /* System logger */
+#include <Storage.h>        /* Storage service */
+#include <mbedtls/sha256.h> /* Checksum functions */
+
+/* Header file */
+#include <ResumableTransfer.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/** @brief Resumable transfer checkpoint path. */
+#define TRANSFER_CHECKPOINT_PATH TMP_DIR_PATH "/transfer_ckp"
+/** @brief Resumable transfer partial file path. */
+#define TRANSFER_PART_PATH TMP_DIR_PATH "/transfer_part"
+
+/** @brief Resumable transfer checkpoint magic. */
+#define TRANSFER_CHECKPOINT_MAGIC 0x4543424B
+
+/** @brief Number of received bytes between two checkpoints. */
+#define TRANSFER_CHECKPOINT_INTERVAL 16384
+
+/** @brief Size of the buffer used to hash the partial file. */
+#define TRANSFER_HASH_BUFFER_SIZE 4096
+
+/*******************************************************************************
+ * MACROS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * STRUCTURES AND TYPES
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+
+/************************* Imported global variables **************************/
+/* None */
+
+/************************* Exported global variables **************************/
+/** @brief Tells if a transfer was prepared. */
+bool ResumableTransfer::IS_PREPARED_ = false;
+/** @brief Descriptor of the prepared transfer. */
+STransferDescriptor ResumableTransfer::PREPARED_;
+
+/************************** Static global variables ***************************/
+/* None */
+
+/*******************************************************************************
+ * STATIC FUNCTIONS DECLARATIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/* None */
+
+/*******************************************************************************
+ * CLASS METHODS
+ ******************************************************************************/
+
+ResumableTransfer::ResumableTransfer(void)
+{
+    pStore_ = Storage::GetInstance();
+    memset(&checkpoint_, 0, sizeof(STransferCheckpoint));
+    savedReceived_ = 0;
+}
+
+void ResumableTransfer::Prepare(const uint8_t*    pkData,
+                                SCommandResponse& rResponse)
+{
+    STransferDescriptor descriptor;
+    STransferCheckpoint checkpoint;
+    Storage*            pStore;
+    FsFile              file;
+    bool                resume;
+
+    memcpy(&descriptor, pkData, sizeof(STransferDescriptor));
+    if(descriptor.totalSize == 0)
+    {
+        rResponse.header.errorCode = INVALID_PARAM;
+        rResponse.header.size = 0;
+        return;
+    }
+
+    pStore = Storage::GetInstance();
+    pStore->Lock();
+
+    /* Continue the stored transfer if it is the same one */
+    resume = LoadCheckpoint(pStore, checkpoint) &&
+             memcmp(&checkpoint.descriptor,
+                    &descriptor,
+                    sizeof(STransferDescriptor)) == 0;
+    if(resume)
+    {
+        /* The partial file must hold the checkpointed data */
+        file = pStore->Open(TRANSFER_PART_PATH, FILE_READ);
+        resume = file && file.size() >= checkpoint.received;
+        file.close();
+    }
+
+    if(!resume)
+    {
+        /* A new transfer replaces the stored one */
+        pStore->Remove(TRANSFER_PART_PATH);
+        checkpoint.magic      = TRANSFER_CHECKPOINT_MAGIC;
+        checkpoint.descriptor = descriptor;
+        checkpoint.received   = 0;
+        if(!SaveCheckpoint(pStore, checkpoint))
+        {
+            pStore->Unlock();
+            rResponse.header.errorCode = WRITE_FILE_FAILED;
+            rResponse.header.size = 0;
+            return;
+        }
+    }
+
+    PREPARED_    = descriptor;
+    IS_PREPARED_ = true;
+
+    pStore->Unlock();
+
+    LOG_DEBUG(
+        "Transfer 0x%08X prepared, offset %d/%d\n",
+        descriptor.transferId,
+        checkpoint.received,
+        descriptor.totalSize
+    );
+
+    memcpy(rResponse.pResponse, &checkpoint.received, sizeof(uint32_t));
+    rResponse.header.errorCode = NO_ERROR;
+    rResponse.header.size = sizeof(uint32_t);
+}
+
+bool ResumableTransfer::Begin(void)
+{
+    bool prepared;
+
+    pStore_->Lock();
+
+    prepared     = IS_PREPARED_;
+    IS_PREPARED_ = false;
+    if(prepared)
+    {
+        /* The checkpoint was validated when the transfer was prepared */
+        prepared = LoadCheckpoint(pStore_, checkpoint_) &&
+                   memcmp(&checkpoint_.descriptor,
+                          &PREPARED_,
+                          sizeof(STransferDescriptor)) == 0;
+        savedReceived_ = checkpoint_.received;
+    }
+
+    pStore_->Unlock();
+
+    return prepared;
+}
+
+bool ResumableTransfer::Open(FsFile& rFile)
+{
+    rFile = pStore_->Open(TRANSFER_PART_PATH, FILE_WRITE);
+    if(!rFile)
+    {
+        return false;
+    }
+
+    /* Drop what was written after the last checkpoint */
+    if(!rFile.truncate(checkpoint_.received) ||
+       !rFile.seekSet(checkpoint_.received))
+    {
+        rFile.close();
+        return false;
+    }
+
+    return true;
+}
+
+uint32_t ResumableTransfer::GetOffset(void) const
+{
+    return checkpoint_.received;
+}
+
+uint32_t ResumableTransfer::GetTotalSize(void) const
+{
+    return checkpoint_.descriptor.totalSize;
+}
+
+void ResumableTransfer::Advance(FsFile& rFile, const uint32_t kSize)
+{
+    checkpoint_.received += kSize;
+
+    if(checkpoint_.received - savedReceived_ >= TRANSFER_CHECKPOINT_INTERVAL)
+    {
+        /* The data must be on the card before the checkpoint */
+        if(rFile.sync() && SaveCheckpoint(pStore_, checkpoint_))
+        {
+            savedReceived_ = checkpoint_.received;
+        }
+    }
+}
+
+void ResumableTransfer::Suspend(FsFile& rFile)
+{
+    if(rFile.sync() && SaveCheckpoint(pStore_, checkpoint_))
+    {
+        savedReceived_ = checkpoint_.received;
+    }
+    rFile.close();
+
+    LOG_INFO(
+        "Transfer 0x%08X suspended at %d/%d\n",
+        checkpoint_.descriptor.transferId,
+        savedReceived_,
+        checkpoint_.descriptor.totalSize
+    );
+}
+
+EErrorCode ResumableTransfer::Commit(FsFile& rFile, const std::string& rkPath)
+{
+    if(checkpoint_.received != checkpoint_.descriptor.totalSize ||
+       rFile.size() != checkpoint_.descriptor.totalSize)
+    {
+        LOG_ERROR("Incomplete transfer.\n");
+        Abort(rFile);
+        return CORRUPTED_DATA;
+    }
+
+    if(!CheckHash(rFile, checkpoint_.descriptor.pHash))
+    {
+        LOG_ERROR("Transfer hash mismatch.\n");
+        Abort(rFile);
+        return CORRUPTED_DATA;
+    }
+
+    rFile.close();
+    if(!pStore_->Rename(TRANSFER_PART_PATH, rkPath))
+    {
+        Abort(rFile);
+        return WRITE_FILE_FAILED;
+    }
+    pStore_->Remove(TRANSFER_CHECKPOINT_PATH);
+
+    return NO_ERROR;
+}
+
+void ResumableTransfer::Abort(FsFile& rFile)
+{
+    rFile.close();
+    pStore_->Remove(TRANSFER_PART_PATH);
+    pStore_->Remove(TRANSFER_CHECKPOINT_PATH);
+}
+
+bool ResumableTransfer::LoadCheckpoint(Storage*             pStore,
+                                       STransferCheckpoint& rCheckpoint)
+{
+    FsFile file;
+    int    readBytes;
+
+    file = pStore->Open(TRANSFER_CHECKPOINT_PATH, FILE_READ);
+    if(!file)
+    {
+        return false;
+    }
+
+    readBytes = file.read(&rCheckpoint, sizeof(STransferCheckpoint));
+    file.close();
+
+    return readBytes == sizeof(STransferCheckpoint) &&
+           rCheckpoint.magic == TRANSFER_CHECKPOINT_MAGIC &&
+           rCheckpoint.received <= rCheckpoint.descriptor.totalSize;
+}
+
+bool ResumableTransfer::SaveCheckpoint(Storage*                   pStore,
+                                       const STransferCheckpoint& rkCheckpoint)
+{
+    FsFile file;
+    bool   status;
+
+    file = pStore->Open(TRANSFER_CHECKPOINT_PATH, FILE_WRITE);
+    if(!file)
+    {
+        LOG_ERROR("Failed to open the transfer checkpoint.\n");
+        return false;
+    }
+
+    /* The checkpoint is overwritten in place */
+    status = file.seekSet(0) &&
+             file.write(&rkCheckpoint, sizeof(STransferCheckpoint)) ==
+                 sizeof(STransferCheckpoint) &&
+             file.sync();
+    file.close();
+
+    return status;
+}
+
+bool ResumableTransfer::CheckHash(FsFile& rFile, const uint8_t* pkHash)
+{
+    uint8_t* pBuffer;
+    uint8_t  digest[TRANSFER_HASH_SIZE];
+    int      readBytes;
+
+    mbedtls_sha256_context shaCtx;
+
+    pBuffer = new uint8_t[TRANSFER_HASH_BUFFER_SIZE];
+    if(pBuffer == nullptr || !rFile.seekSet(0))
+    {
+        delete[] pBuffer;
+        return false;
+    }
+
+    mbedtls_sha256_init(&shaCtx);
+    mbedtls_sha256_starts(&shaCtx, false);
+    do
+    {
+        readBytes = rFile.read(pBuffer, TRANSFER_HASH_BUFFER_SIZE);
+        if(readBytes > 0)
+        {
+            mbedtls_sha256_update(&shaCtx, pBuffer, readBytes);
+        }
+    } while(readBytes > 0);
+    mbedtls_sha256_finish(&shaCtx, digest);
+    mbedtls_sha256_free(&shaCtx);
+
+    delete[] pBuffer;
+
+    return readBytes == 0 &&
+           memcmp(digest, pkHash, TRANSFER_HASH_SIZE) == 0;
+}
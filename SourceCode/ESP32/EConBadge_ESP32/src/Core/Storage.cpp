@@ -18,7 +18,6 @@
 /*******************************************************************************
  * INCLUDES
  ******************************************************************************/
-#include <map>      /* std::map */
 #include <vector>   /* std::vector */
 #include <SdFat.h>  /* SD Card driver */
 #include <HWMgr.h>  /* Hardware manager */
@@ -42,7 +41,29 @@
  * STRUCTURES AND TYPES
  ******************************************************************************/
 
-/* None */
+/**
+ * @brief Holds the storage lock for the lifetime of the object.
+ *
+ * @details Holds the storage lock for the lifetime of the object. Used by the
+ * storage methods to release the lock on every return path.
+ */
+class StorageLockGuard
+{
+    public:
+        explicit StorageLockGuard(Storage* pStore)
+        {
+            pStore_ = pStore;
+            pStore_->Lock();
+        }
+
+        ~StorageLockGuard(void)
+        {
+            pStore_->Unlock();
+        }
+
+    private:
+        Storage* pStore_;
+};
 
 /*******************************************************************************
  * GLOBAL VARIABLES
@@ -84,6 +105,16 @@ Storage* Storage::GetInstance(void)
     return Storage::PINSTANCE_;
 }
 
+void Storage::Lock(void)
+{
+    xSemaphoreTakeRecursive(lock_, portMAX_DELAY);
+}
+
+void Storage::Unlock(void)
+{
+    xSemaphoreGiveRecursive(lock_);
+}
+
 uint8_t Storage::GetSdCardType(void)
 {
     const SdCard* pSdCard;
@@ -112,6 +143,8 @@ uint64_t Storage::GetSdCardSize(void) const
 
 bool Storage::CreateDirectory(const std::string& rkPath)
 {
+    StorageLockGuard guard(this);
+
     if(!init_)
     {
         LOG_ERROR("SD Card not initialized.\n");
@@ -129,22 +162,22 @@ FsFile Storage::Open(const std::string& rkFilename, const oflag_t kOpenMode)
 {
     FsFile file;
 
+    StorageLockGuard guard(this);
+
     if(!init_)
     {
         LOG_ERROR("SD Card not initialized.\n");
         return file;
     }
 
-    if(file.open(rkFilename.c_str(), kOpenMode))
-    {
-        /* Remove from file list */
-        fileLists_.clear();
-    }
+    file.open(rkFilename.c_str(), kOpenMode);
     return file;
 }
 
 bool Storage::Remove(const std::string& rkFilename)
 {
+    StorageLockGuard guard(this);
+
     if(!init_)
     {
         LOG_ERROR("SD Card not initialized.\n");
@@ -156,21 +189,41 @@ bool Storage::Remove(const std::string& rkFilename)
         return false;
     }
 
-    if(sdCard_.remove(rkFilename.c_str()))
-    {
-        /* Remove from file list */
-        fileLists_.clear();
+    return sdCard_.remove(rkFilename.c_str());
+}
 
-        return true;
+bool Storage::Rename(const std::string& rkOldName,
+                     const std::string& rkNewName)
+{
+    StorageLockGuard guard(this);
+
+    if(!init_)
+    {
+        LOG_ERROR("SD Card not initialized.\n");
+        return false;
     }
-    else
+
+    if(!sdCard_.exists(rkOldName.c_str()))
     {
         return false;
     }
+
+    /* Replace the destination */
+    if(sdCard_.exists(rkNewName.c_str()))
+    {
+        if(!sdCard_.remove(rkNewName.c_str()))
+        {
+            return false;
+        }
+    }
+
+    return sdCard_.rename(rkOldName.c_str(), rkNewName.c_str());
 }
 
 bool Storage::FileExists(const std::string& rkFilename)
 {
+    StorageLockGuard guard(this);
+
     if(!init_)
     {
         LOG_ERROR("SD Card not initialized.\n");
@@ -181,11 +234,12 @@ bool Storage::FileExists(const std::string& rkFilename)
 
 void Storage::GetContent(const std::string& rkFilename,
                          const char*        pkDefaultContent,
-                         std::string&       rContent,
-                         const bool         kCacheable)
+                         std::string&       rContent)
 {
     FsFile file;
 
+    StorageLockGuard guard(this);
+
     if(!init_)
     {
         LOG_ERROR("SD Card not initialized.\n");
@@ -193,13 +247,6 @@ void Storage::GetContent(const std::string& rkFilename,
         return;
     }
 
-    /* Check cache */
-    if(kCacheable && cache_.count(rkFilename) != 0)
-    {
-        rContent = cache_[rkFilename];
-        return;
-    }
-
     if(sdCard_.exists(rkFilename.c_str()))
     {
         if(file.open(rkFilename.c_str(), FILE_READ))
@@ -220,25 +267,21 @@ void Storage::GetContent(const std::string& rkFilename,
             LOG_ERROR("Failed to open file %s\n", rkFilename.c_str());
             rContent = "ERROR";
         }
-
-        if(kCacheable)
-        {
-            cache_[rkFilename] = rContent;
-        }
     }
     else
     {
         rContent = pkDefaultContent;
-        SetContent(rkFilename, pkDefaultContent, kCacheable);
+        SetContent(rkFilename, pkDefaultContent);
     }
 }
 
 bool Storage::SetContent(const std::string& rkFilename,
-                         const std::string& rkContent,
-                         const bool         kCacheable)
+                         const std::string& rkContent)
 {
     FsFile file;
 
+    StorageLockGuard guard(this);
+
     if(!init_)
     {
         LOG_ERROR("SD Card not initialized.\n");
@@ -262,11 +305,6 @@ bool Storage::SetContent(const std::string& rkFilename,
         file.print(rkContent.c_str());
         file.close();
 
-        if(kCacheable)
-        {
-            cache_[rkFilename] = rkContent;
-        }
-
         LOG_DEBUG("Wrote file %s\n", rkFilename.c_str());
     }
     else
@@ -280,154 +318,131 @@ bool Storage::SetContent(const std::string& rkFilename,
 
 void Storage::Format(void)
 {
+    StorageLockGuard guard(this);
+
     LOG_DEBUG("Format requested\n");
-    if(sdCard_.format())
-    {
-        /* Remove from file list */
-        fileLists_.clear();
-    }
+    sdCard_.format();
 }
 
-void Storage::GetFilesListFrom(const std::string&        krDirectory,
-                               std::vector<std::string>& rList,
-                               const std::string&        rkStartName,
-                               const size_t              kPrev,
-                               const size_t              kCount)
+size_t Storage::GetFilesCount(const std::string& krDirectory)
 {
-    FsFile                   file;
-    FsFile                   root;
-    size_t                   i;
-    size_t                   idxSinceFound;
-    size_t                   searchSize;
-    std::vector<std::string> files;
-    char                     baseName[128];
-    std::pair<std::map<std::string, std::vector<std::string>>::iterator, bool> it;
+    FsFile file;
+    FsFile root;
+    size_t count;
 
-    rList.clear();
+    StorageLockGuard guard(this);
 
     if(!init_)
     {
-        LOG_ERROR("Failed to get image list. SD card not initialized\n");
-        return;
-    }
-
-    /* Start caching if needed */
-    it.first = fileLists_.find(krDirectory);
-    if(it.first == fileLists_.end())
-    {
-        if(!root.open(krDirectory.c_str()))
-        {
-            LOG_ERROR("Failed to open %s\n", krDirectory.c_str());
-            return;
-        }
-        if(!root.isDirectory())
-        {
-            LOG_ERROR("Failed to open %s. Not a directory\n", krDirectory.c_str());
-            return;
-        }
-
-        /* List the files */
-        file = root.openNextFile();
-        while(file)
-        {
-            if(!file.isDirectory())
-            {
-                file.getName(baseName, 128);
-                files.push_back(baseName);
-            }
-            file.close();
-            file = root.openNextFile();
-        }
-
-        it = fileLists_.emplace(krDirectory, files);
-    }
-    else
-    {
-        it.second = true;
+        LOG_ERROR("Failed to count files. SD card not initialized\n");
+        return 0;
     }
 
-    /* Search in the list */
-    if(!it.second)
+    if(!root.open(krDirectory.c_str()))
     {
-        LOG_ERROR("Failed to load files list for %s.\n", krDirectory.c_str());
-        return;
+        LOG_ERROR("Failed to open %s\n", krDirectory.c_str());
+        return 0;
     }
-
-    /* Find the file */
-    searchSize = it.first->second.size();
-    if(searchSize == 0)
+    if(!root.isDirectory())
     {
-        return;
+        LOG_ERROR("Failed to open %s. Not a directory\n", krDirectory.c_str());
+        return 0;
     }
 
-    i = 0;
-    for(i = 0; i < it.first->second.size(); ++i)
+    /* Only count the files, the names are not kept */
+    count = 0;
+    file = root.openNextFile();
+    while(file)
     {
-        if(it.first->second[i] == rkStartName || rkStartName.size() == 0)
+        if(!file.isDirectory())
         {
-            break;
+            ++count;
         }
+        file.close();
+        file = root.openNextFile();
     }
 
-    /* Get the correct amount of items */
-    if(kPrev > i)
-    {
-        idxSinceFound = searchSize - (kPrev - i);
-    }
-    else
-    {
-        idxSinceFound = i - kPrev;
-    }
-
-    for(i = 0; i < kCount && i < searchSize; ++i)
-    {
-        rList.push_back(it.first->second[idxSinceFound]);
-        idxSinceFound = (idxSinceFound + 1) % searchSize;
-    }
+    return count;
 }
 
-size_t Storage::GetFilesCount(const std::string& krDirectory)
+bool Storage::GetFilesPage(const std::string&       rkDirectory,
+                           const uint32_t           kCursor,
+                           const size_t             kCount,
+                           std::vector<SFileEntry>& rEntries,
+                           uint32_t&                rNextCursor)
 {
-    size_t fileCount;
-    FsFile file;
-    FsFile root;
+    FsFile     file;
+    FsFile     root;
+    SFileEntry entry;
+    char       baseName[128];
+
+    StorageLockGuard guard(this);
+
+    rEntries.clear();
+    rNextCursor = FILES_CURSOR_END;
 
     if(!init_)
     {
-        LOG_ERROR("Failed to get image list. SD card not initialized\n");
-        return 0;
+        LOG_ERROR("Failed to get files page. SD card not initialized\n");
+        return false;
     }
 
-    if(!root.open(krDirectory.c_str()))
+    if(kCursor == FILES_CURSOR_END)
     {
-        LOG_ERROR("Failed to open %s\n", krDirectory.c_str());
-        return 0;
+        return true;
+    }
+
+    if(!root.open(rkDirectory.c_str()))
+    {
+        LOG_ERROR("Failed to open %s\n", rkDirectory.c_str());
+        return false;
     }
     if(!root.isDirectory())
     {
-        LOG_ERROR("Failed to open %s. Not a directory\n", krDirectory.c_str());
-        return 0;
+        LOG_ERROR("Failed to open %s. Not a directory\n", rkDirectory.c_str());
+        return false;
     }
 
-    fileCount = 0;
+    /* Resume where the previous page stopped */
+    if(!root.seekSet(kCursor))
+    {
+        LOG_ERROR("Invalid cursor %d for %s\n", kCursor, rkDirectory.c_str());
+        return false;
+    }
 
-    /* List the files */
-    file = root.openNextFile();
-    while(file)
+    while(rEntries.size() < kCount)
     {
+        file = root.openNextFile();
+        if(!file)
+        {
+            /* Last entry reached */
+            return true;
+        }
+
         if(!file.isDirectory())
         {
-            ++fileCount;
+            file.getName(baseName, 128);
+            entry.name = baseName;
+            entry.size = file.fileSize();
+            if(!file.getModifyDateTime(&entry.modifyDate, &entry.modifyTime))
+            {
+                entry.modifyDate = 0;
+                entry.modifyTime = 0;
+            }
+            rEntries.push_back(entry);
         }
         file.close();
-        file = root.openNextFile();
     }
 
-    return fileCount;
+    rNextCursor = root.curPosition();
+
+    return true;
 }
 
 Storage::Storage(void)
 {
+    lock_ = xSemaphoreCreateRecursiveMutex();
+
     pConfig_ = new SdSpiConfig(
         (uint8_t)GPIO_SD_CS,
         DEDICATED_SPI,
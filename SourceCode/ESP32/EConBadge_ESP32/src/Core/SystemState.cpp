@@ -18,19 +18,21 @@
 /*******************************************************************************
  * INCLUDES
  ******************************************************************************/
-#include <cstring>            /* String manipulation*/
-#include <HWMgr.h>            /* Hardware manager */
-#include <Types.h>            /* Defined Types */
-#include <Logger.h>           /* Logging service */
-#include <Arduino.h>          /* Arduino services */
-#include <Storage.h>          /* Storage service */
-#include <Updater.h>          /* Updater service */
-#include <LEDBorder.h>        /* LED border manager */
-#include <BatteryMgr.h>       /* Battery manager */
-#include <IOButtonMgr.h>      /* Wakeup PIN */
-#include <BlueToothMgr.h>     /* Bluetooth manager */
-#include <DisplayInterface.h> /* Display interface */
-#include <WaveshareEInkMgr.h> /* EInk display manager */
+#include <cstring>             /* String manipulation*/
+#include <HWMgr.h>             /* Hardware manager */
+#include <Types.h>             /* Defined Types */
+#include <Logger.h>            /* Logging service */
+#include <Arduino.h>           /* Arduino services */
+#include <Storage.h>           /* Storage service */
+#include <ConfigStore.h>       /* Configuration store */
+#include <Updater.h>           /* Updater service */
+#include <LEDBorder.h>         /* LED border manager */
+#include <BatteryMgr.h>        /* Battery manager */
+#include <IOButtonMgr.h>       /* Wakeup PIN */
+#include <BlueToothMgr.h>      /* Bluetooth manager */
+#include <DisplayInterface.h>  /* Display interface */
+#include <WaveshareEInkMgr.h>  /* EInk display manager */
+#include <ResumableTransfer.h> /* Resumable transfers */
 
 /* Header File */
 #include <SystemState.h>
@@ -40,6 +42,14 @@
  ******************************************************************************/
 
 #define MAX_COMMAND_WAIT 10
+/* Remote commands waiting for their response, below the EInk queue depth */
+#define MAX_COMMANDS_IN_FLIGHT 8
+
+#define EINK_WORKER_STACK_SIZE 8192
+#define EINK_WORKER_PRIORITY   5
+#define EINK_IDLE_POLL_PERIOD  10000 /* US : 10 ms */
+
+#define BATCH_REQUEST_TIMEOUT 10000 /* 10 seconds */
 
 #define DEBUG_BTN_PRESS_TIME       3000000
 #define MENU_BTN_PRESS_TIME        1000000
@@ -96,6 +106,7 @@ SystemState::SystemState(IOButtonMgr*        pButtonMgr,
                          BatteryManager*     pBatteryMgr)
 {
     pStore_            = Storage::GetInstance();
+    pConfig_           = ConfigStore::GetInstance();
     pBatteryMgr_       = pBatteryMgr;
     pButtonMgr_        = pButtonMgr;
     pEinkManager_      = pEinkManager;
@@ -118,6 +129,28 @@ SystemState::SystemState(IOButtonMgr*        pButtonMgr,
 
     /* Initialize command manager */
     commandsQueueLock_ = xSemaphoreCreateMutex();
+    inFlightCommands_  = 0;
+
+    /* Start the EInk worker, long EInk operations do not block the system */
+    eInkPendingJobs_ = 0;
+    eInkThread_      = nullptr;
+    eInkJobsQueue_   = xQueueCreate(MAX_COMMAND_WAIT, sizeof(SEInkJob));
+    if(eInkJobsQueue_ != nullptr)
+    {
+        xTaskCreatePinnedToCore(
+            EInkJobRoutine,
+            "EInkThread",
+            EINK_WORKER_STACK_SIZE,
+            this,
+            EINK_WORKER_PRIORITY,
+            &eInkThread_,
+            tskNO_AFFINITY
+        );
+    }
+    if(eInkThread_ == nullptr)
+    {
+        LOG_ERROR("Failed to start the EInk worker\n");
+    }
 
     currState_      = SYS_SPLASH;
     prevState_      = SYS_IDLE;
@@ -177,9 +210,11 @@ EErrorCode SystemState::EnqueueCommand(SCommandRequest& rCommand)
 
     /* Add the command to the queue */
     xSemaphoreTake(commandsQueueLock_, portMAX_DELAY);
-    if(commandsQueue_.size() < MAX_COMMAND_WAIT)
+    if(commandsQueue_.size() < MAX_COMMAND_WAIT &&
+       inFlightCommands_ < MAX_COMMANDS_IN_FLIGHT)
     {
         commandsQueue_.push(std::make_pair(rCommand, true));
+        ++inFlightCommands_;
         retCode = NO_ERROR;
     }
     else
@@ -252,8 +287,6 @@ void SystemState::UpdateButtonsState(void)
 void SystemState::ExecuteCommands(void)
 {
     std::pair<SCommandRequest, bool> request;
-    SCommandResponse                 response;
-    bool                             result;
 
     /* Add the command to the queue */
     xSemaphoreTake(commandsQueueLock_, portMAX_DELAY);
@@ -266,211 +299,641 @@ void SystemState::ExecuteCommands(void)
         commandsQueue_.pop();
         xSemaphoreGive(commandsQueueLock_);
 
-        /* Init response */
-        response.header.identifier = request.first.header.identifier;
-        memcpy(response.header.pToken,
-               request.first.header.pToken,
-               COMM_TOKEN_SIZE);
+        /* Independent commands complete right away, the data channel users
+         * keep their order behind the deferred commands.
+         */
+        if(NeedsWorkerIdle(request.first.header.type) ||
+           (IsWorkerCommand(request.first.header.type) &&
+            deferredCommands_.size() > 0))
+        {
+            deferredCommands_.push(request);
+        }
+        else
+        {
+            ExecuteCommand(request);
+        }
+
+        lastEventTime_ = HWManager::GetTime();
+
+        /* Take back the lock */
+        xSemaphoreTake(commandsQueueLock_, portMAX_DELAY);
+    }
+    xSemaphoreGive(commandsQueueLock_);
+
+    ExecuteDeferredCommands();
+}
+
+void SystemState::ExecuteDeferredCommands(void)
+{
+    std::pair<SCommandRequest, bool> request;
 
-        switch(request.first.header.type)
+    while(deferredCommands_.size() > 0)
+    {
+        /* Do not block the other commands while the worker is busy */
+        if(NeedsWorkerIdle(deferredCommands_.front().first.header.type) &&
+           eInkPendingJobs_ > 0)
         {
-            case CMD_PING:
-                response.header.errorCode = NO_ERROR;
-                response.header.size = 4;
-                memcpy(response.pResponse, "PONG", 4);
-                LOG_DEBUG("PONG\n");
-                break;
+            break;
+        }
 
-            case CMD_SET_BT_TOKEN:
-                result = pBlueToothManager_->SetToken(
-                    std::string((char*)request.first.pCommand)
-                );
-                if(result)
-                {
-                    response.header.errorCode = NO_ERROR;
-                }
-                else
-                {
-                    response.header.errorCode = INVALID_PARAM;
-                }
-                response.header.size = 0;
-                break;
+        request = deferredCommands_.front();
+        deferredCommands_.pop();
 
-            case CMD_EINK_CLEAR:
-                pDisplayInterface_->DisplayPopup(
-                    "EInk Update",
-                    "Clearing EInk display, please wait..."
-                );
-                pEinkManager_->Clear(response);
-                pDisplayInterface_->HidePopup();
-                break;
-            case CMD_EINK_NEW_IMAGE:
-                pDisplayInterface_->DisplayPopup(
-                    "EInk Update",
-                    "Updating new image, please wait..."
-                );
-                pEinkManager_->DisplayNewImage(
-                    std::string((char*)request.first.pCommand),
-                    response
-                );
-                pDisplayInterface_->HidePopup();
-                break;
-            case CMD_EINK_REMOVE_IMAGE:
-                pDisplayInterface_->DisplayPopup(
-                    "EInk Update",
-                    "Removing EInk image, please wait..."
-                );
-                pEinkManager_->RemoveImage(
-                    std::string((char*)request.first.pCommand),
-                    response
-                );
-                pDisplayInterface_->HidePopup();
-                break;
-            case CMD_EINK_SELECT_IMAGE:
-                pDisplayInterface_->DisplayPopup(
-                    "EInk Update",
-                    "Updating new image, please wait..."
-                );
-                pEinkManager_->SetDisplayedImage(
-                    std::string((char*)request.first.pCommand),
-                    response
-                );
-                pDisplayInterface_->HidePopup();
-                break;
-            case CMD_EINK_GET_CURRENT_IMG_NAME:
-                pEinkManager_->GetDisplayedImageName(response);
-                break;
-            case CMD_EINK_GET_IMAGE_DATA:
-                pDisplayInterface_->DisplayPopup(
-                    "EInk Update",
-                    "Uploading image, please wait..."
-                );
-                pEinkManager_->SendImageData(
-                    std::string((char*)request.first.pCommand),
-                    response
-                );
-                pDisplayInterface_->HidePopup();
-                break;
-            case CMD_EINK_GET_IMAGE_LIST:
-                pDisplayInterface_->DisplayPopup(
-                    "EInk Update",
-                    "Uploading image list, please wait..."
-                );
-                pEinkManager_->SendImageList(response);
-                pDisplayInterface_->HidePopup();
-                break;
-            case CMD_FACTORY_RESET:
-                pStore_->Format();
-                pMenu_->Reset();
-
-                /* Init response */
-                response.header.errorCode = NO_ERROR;
-                response.header.size = 0;
-                response.header.identifier = request.first.header.identifier;
-                memcpy(response.header.pToken,
-                       request.first.header.pToken,
-                       COMM_TOKEN_SIZE);
-
-                /* Send the bluetooth response */
-                pBlueToothManager_->SendCommandResponse(response);
-
-                HWManager::DelayExecUs(1000000);
-                ESP.restart();
-                break;
+        ExecuteCommand(request);
 
-            case CMD_SET_OWNER:
-                SetOwner((char*)request.first.pCommand, response);
-                break;
-            case CMD_SET_CONTACT:
-                SetContact((char*)request.first.pCommand, response);
-                break;
-            case CMD_GET_OWNER:
-                GetOwner(response);
-                break;
-            case CMD_GET_CONTACT:
-                GetContact(response);
-                break;
+        lastEventTime_ = HWManager::GetTime();
+    }
+}
 
-            case CMD_FIRMWARE_UPDATE:
-                PerformUpdate(request.first.pCommand, response);
-                break;
+void SystemState::ExecuteCommand(
+    const std::pair<SCommandRequest, bool>& rkRequest)
+{
+    SCommandResponse response;
+    bool             sendResponse;
 
-            case CMD_LEDBORDER_SET_ENABLE:
-                pLEDBorder_->Enable(request.first.pCommand[0]);
-                response.header.errorCode = NO_ERROR;
-                response.header.size = 0;
-                break;
-            case CMD_LEDBORDER_GET_ENABLE:
-                response.header.errorCode = NO_ERROR;
-                response.header.size = 1;
-                response.pResponse[0] = pLEDBorder_->IsEnabled();
-                break;
-            case CMD_LEDBORDER_INC_BRIGHTNESS:
-                pLEDBorder_->IncreaseBrightness(response);
-                break;
-            case CMD_LEDBORDER_DEC_BRIGHTNESS:
-                pLEDBorder_->ReduceBrightness(response);
-                break;
-            case CMD_LEDBORDER_SET_BRIGHTNESS:
-                pLEDBorder_->SetBrightness(request.first.pCommand, response);
-                break;
-            case CMD_LEDBORDER_GET_BRIGHTNESS:
-                response.header.errorCode = NO_ERROR;
-                response.header.size = 1;
-                response.pResponse[0] = pLEDBorder_->GetBrightness();
-                break;
-            case CMD_LEDBORDER_CLEAR:
-                pLEDBorder_->Clear(response);
-                break;
-            case CMD_LEDBORDER_ADD_PATTERN:
-                pLEDBorder_->AddPattern(request.first.pCommand, response);
-                break;
-            case CMD_LEDBORDER_REMOVE_PATTERN:
-                pLEDBorder_->RemovePattern(request.first.pCommand, response);
-                break;
-            case CMD_LEDBORDER_CLEAR_PATTERNS:
-                pLEDBorder_->ClearPatterns(response);
-                break;
-            case CMD_LEDBORDER_GET_PATTERNS:
-                pLEDBorder_->GetPatterns(response);
-                break;
-            case CMD_LEDBORDER_ADD_ANIMATION:
-                pLEDBorder_->AddAnimation(request.first.pCommand, response);
-                break;
-            case CMD_LEDBORDER_REMOVE_ANIMATION:
-                pLEDBorder_->RemoveAnimation(request.first.pCommand, response);
-                break;
-            case CMD_LEDBORDER_CLEAR_ANIMATIONS:
-                pLEDBorder_->ClearAnimation(response);
-                break;
-            case CMD_LEDBORDER_GET_ANIMATIONS:
-                pLEDBorder_->GetAnimations(response);
-                break;
+    sendResponse = rkRequest.second;
 
-            default:
-                response.header.errorCode = INVALID_COMMAND_REQ;
-                response.header.size = 0;
+    /* Init response */
+    response.header.identifier = rkRequest.first.header.identifier;
+    memcpy(response.header.pToken,
+           rkRequest.first.header.pToken,
+           COMM_TOKEN_SIZE);
+
+    DispatchCommand(rkRequest.first, sendResponse, response);
+
+    /* Check if a response shall be given */
+    if(sendResponse)
+    {
+        SendResponse(rkRequest.first, response);
+    }
+}
+
+void SystemState::SendResponse(const SCommandRequest& rkRequest,
+                               SCommandResponse&      rResponse)
+{
+    /* Init response */
+    rResponse.header.identifier = rkRequest.header.identifier;
+    memcpy(rResponse.header.pToken, rkRequest.header.pToken, COMM_TOKEN_SIZE);
+
+    /* Send the bluetooth response, the identifier tags it for the client */
+    pBlueToothManager_->SendCommandResponse(rResponse);
+
+    --inFlightCommands_;
+}
+
+void SystemState::DispatchCommand(const SCommandRequest& rkRequest,
+                                  bool&                  rSendResponse,
+                                  SCommandResponse&      rResponse)
+{
+    bool result;
+
+    switch(rkRequest.header.type)
+    {
+        case CMD_PING:
+            rResponse.header.errorCode = NO_ERROR;
+            rResponse.header.size = 4;
+            memcpy(rResponse.pResponse, "PONG", 4);
+            LOG_DEBUG("PONG\n");
+            break;
+
+        case CMD_SET_BT_TOKEN:
+            result = pBlueToothManager_->SetToken(
+                std::string((char*)rkRequest.pCommand)
+            );
+            if(result)
+            {
+                rResponse.header.errorCode = NO_ERROR;
+            }
+            else
+            {
+                rResponse.header.errorCode = INVALID_PARAM;
+            }
+            rResponse.header.size = 0;
+            break;
+
+        case CMD_EINK_CLEAR:
+        case CMD_EINK_NEW_IMAGE:
+        case CMD_EINK_REMOVE_IMAGE:
+        case CMD_EINK_SELECT_IMAGE:
+        case CMD_EINK_GET_CURRENT_IMG_NAME:
+        case CMD_EINK_GET_IMAGE_DATA:
+        case CMD_EINK_GET_IMAGE_LIST:
+        case CMD_EINK_GET_IMAGE_PAGE:
+        case CMD_LEDBORDER_GET_PATTERNS:
+        case CMD_LEDBORDER_GET_ANIMATIONS:
+        case CMD_SET_LINK_COMPRESSION:
+            /* The EInk worker sends the rResponse when the job is done, it
+             * serializes the data channel users.
+             */
+            rResponse.header.errorCode = EnqueueEInkJob(
+                rkRequest,
+                rSendResponse
+            );
+            rResponse.header.size = 0;
+            if(rResponse.header.errorCode == NO_ERROR)
+            {
+                rSendResponse = false;
+            }
+            break;
+        case CMD_FACTORY_RESET:
+            WaitEInkIdle();
+            pStore_->Format();
+            pConfig_->Reset();
+            pMenu_->Reset();
+
+            /* Init rResponse */
+            rResponse.header.errorCode = NO_ERROR;
+            rResponse.header.size = 0;
+            rResponse.header.identifier = rkRequest.header.identifier;
+            memcpy(rResponse.header.pToken,
+                   rkRequest.header.pToken,
+                   COMM_TOKEN_SIZE);
+
+            /* Send the bluetooth rResponse */
+            pBlueToothManager_->SendCommandResponse(rResponse);
+
+            HWManager::DelayExecUs(1000000);
+            ESP.restart();
+            break;
+
+        case CMD_SET_OWNER:
+            SetOwner((char*)rkRequest.pCommand, rResponse);
+            break;
+        case CMD_SET_CONTACT:
+            SetContact((char*)rkRequest.pCommand, rResponse);
+            break;
+        case CMD_GET_OWNER:
+            GetOwner(rResponse);
+            break;
+        case CMD_GET_CONTACT:
+            GetContact(rResponse);
+            break;
+
+        case CMD_FIRMWARE_UPDATE:
+            WaitEInkIdle();
+            pBlueToothManager_->BeginTransfer();
+            PerformUpdate(rkRequest.pCommand, rResponse);
+            pBlueToothManager_->EndTransfer();
+            break;
+
+        case CMD_LEDBORDER_SET_ENABLE:
+            pLEDBorder_->Enable(rkRequest.pCommand[0]);
+            rResponse.header.errorCode = NO_ERROR;
+            rResponse.header.size = 0;
+            break;
+        case CMD_LEDBORDER_GET_ENABLE:
+            rResponse.header.errorCode = NO_ERROR;
+            rResponse.header.size = 1;
+            rResponse.pResponse[0] = pLEDBorder_->IsEnabled();
+            break;
+        case CMD_LEDBORDER_INC_BRIGHTNESS:
+            pLEDBorder_->IncreaseBrightness(rResponse);
+            break;
+        case CMD_LEDBORDER_DEC_BRIGHTNESS:
+            pLEDBorder_->ReduceBrightness(rResponse);
+            break;
+        case CMD_LEDBORDER_SET_BRIGHTNESS:
+            pLEDBorder_->SetBrightness(rkRequest.pCommand, rResponse);
+            break;
+        case CMD_LEDBORDER_GET_BRIGHTNESS:
+            rResponse.header.errorCode = NO_ERROR;
+            rResponse.header.size = 1;
+            rResponse.pResponse[0] = pLEDBorder_->GetBrightness();
+            break;
+        case CMD_LEDBORDER_CLEAR:
+            pLEDBorder_->Clear(rResponse);
+            break;
+        case CMD_LEDBORDER_ADD_PATTERN:
+            pLEDBorder_->AddPattern(rkRequest.pCommand, rResponse);
+            break;
+        case CMD_LEDBORDER_REMOVE_PATTERN:
+            pLEDBorder_->RemovePattern(rkRequest.pCommand, rResponse);
+            break;
+        case CMD_LEDBORDER_CLEAR_PATTERNS:
+            pLEDBorder_->ClearPatterns(rResponse);
+            break;
+        case CMD_LEDBORDER_ADD_ANIMATION:
+            pLEDBorder_->AddAnimation(rkRequest.pCommand, rResponse);
+            break;
+        case CMD_LEDBORDER_REMOVE_ANIMATION:
+            pLEDBorder_->RemoveAnimation(rkRequest.pCommand, rResponse);
+            break;
+        case CMD_LEDBORDER_CLEAR_ANIMATIONS:
+            pLEDBorder_->ClearAnimation(rResponse);
+            break;
+
+        case CMD_GET_LINK_INFO:
+            pBlueToothManager_->GetLinkInfo(rResponse);
+            break;
+        case CMD_GET_PIPELINE_INFO:
+            GetPipelineInfo(rResponse);
+            break;
+        case CMD_GET_BLE_STATS:
+            pBlueToothManager_->GetStats(rkRequest.pCommand[0], rResponse);
+            break;
+
+        case CMD_RESUME_TRANSFER:
+            /* A suspended upload checkpoints when its job ends */
+            WaitEInkIdle();
+            ResumableTransfer::Prepare(rkRequest.pCommand, rResponse);
+            break;
+
+        case CMD_BATCH:
+            /* Uses the data channel, wait for the EInk transfers */
+            WaitEInkIdle();
+            pBlueToothManager_->BeginTransfer();
+            ExecuteBatch(rkRequest, rResponse);
+            pBlueToothManager_->EndTransfer();
+            break;
+
+        default:
+            rResponse.header.errorCode = INVALID_COMMAND_REQ;
+            rResponse.header.size = 0;
+    }
+}
+
+void SystemState::ExecuteBatch(const SCommandRequest& rkRequest,
+                               SCommandResponse&      rResponse)
+{
+    uint8_t              i;
+    uint8_t*             pStream;
+    size_t               offset;
+    ssize_t              readBytes;
+    bool                 sendResponse;
+    bool                 failed;
+    SBatchHeader         batch;
+    SCommandRequest      subRequest;
+    SCommandResponse     subResponse;
+    SBatchCommandHeader* pSubHeader;
+
+    memcpy(&batch, rkRequest.pCommand, sizeof(SBatchHeader));
+
+    /* Each sub-command holds at least its header and fits a command */
+    if(batch.count == 0 || batch.count > BATCH_MAX_COMMANDS ||
+       batch.size < batch.count * sizeof(SBatchCommandHeader) ||
+       batch.size > batch.count * (sizeof(SBatchCommandHeader) +
+                                   COMMAND_DATA_SIZE))
+    {
+        rResponse.header.errorCode = INVALID_PARAM;
+        rResponse.header.size = 0;
+        return;
+    }
+
+    pStream = new uint8_t[batch.size];
+    if(pStream == nullptr)
+    {
+        rResponse.header.errorCode = NO_MORE_MEMORY;
+        rResponse.header.size = 0;
+        return;
+    }
+
+    /* Send the ack and receive the sub-commands stream */
+    rResponse.header.errorCode = NO_ERROR;
+    rResponse.header.size = 0;
+    pBlueToothManager_->SendCommandResponse(rResponse);
+
+    readBytes = pBlueToothManager_->ReceiveData(
+        pStream,
+        batch.size,
+        BATCH_REQUEST_TIMEOUT
+    );
+    if(readBytes != batch.size)
+    {
+        delete[] pStream;
+        rResponse.header.errorCode = TRANS_RECV_FAILED;
+        rResponse.header.size = 0;
+        return;
+    }
+
+    /* Validate the whole stream before executing anything */
+    offset = 0;
+    for(i = 0; i < batch.count && offset <= batch.size; ++i)
+    {
+        if(offset + sizeof(SBatchCommandHeader) > batch.size)
+        {
+            break;
+        }
+        pSubHeader = (SBatchCommandHeader*)(pStream + offset);
+        if(pSubHeader->size > COMMAND_DATA_SIZE)
+        {
+            break;
         }
+        offset += sizeof(SBatchCommandHeader) + pSubHeader->size;
+    }
+    if(i != batch.count || offset != batch.size)
+    {
+        LOG_ERROR("Malformed batch stream\n");
+        delete[] pStream;
+        rResponse.header.errorCode = CORRUPTED_DATA;
+        rResponse.header.size = 0;
+        return;
+    }
 
-        /* Check if a response shall be given */
-        if(request.second)
+    /* Execute the sub-commands in order */
+    memcpy(&subRequest.header, &rkRequest.header, sizeof(SCommandHeader));
+    memcpy(&subResponse.header, &rResponse.header, sizeof(SCommandHeader));
+
+    failed = false;
+    offset = 0;
+    for(i = 0; i < batch.count; ++i)
+    {
+        pSubHeader = (SBatchCommandHeader*)(pStream + offset);
+        offset += sizeof(SBatchCommandHeader);
+
+        if(failed && (batch.flags & BATCH_FLAG_STOP_ON_ERROR) != 0)
         {
-            /* Init response */
-            response.header.identifier = request.first.header.identifier;
-            memcpy(response.header.pToken,
-                   request.first.header.pToken,
-                   COMM_TOKEN_SIZE);
+            rResponse.pResponse[i] = NO_ACTION;
+            offset += pSubHeader->size;
+            continue;
+        }
 
-            /* Send the bluetooth response */
-            pBlueToothManager_->SendCommandResponse(response);
+        if(IsBatchable((ECommandType)pSubHeader->type))
+        {
+            subRequest.header.type = pSubHeader->type;
+            subRequest.header.size = pSubHeader->size;
+            memset(subRequest.pCommand, 0, COMMAND_DATA_SIZE);
+            memcpy(subRequest.pCommand, pStream + offset, pSubHeader->size);
+
+            /* Only the status is kept */
+            sendResponse = false;
+            DispatchCommand(subRequest, sendResponse, subResponse);
+        }
+        else
+        {
+            subResponse.header.errorCode = INVALID_COMMAND_REQ;
         }
 
-        lastEventTime_ = HWManager::GetTime();
+        rResponse.pResponse[i] = subResponse.header.errorCode;
+        if(subResponse.header.errorCode != NO_ERROR)
+        {
+            LOG_DEBUG(
+                "Batch command %d (%d) failed: %d\n",
+                i,
+                pSubHeader->type,
+                subResponse.header.errorCode
+            );
+            failed = true;
+        }
 
-        /* Take back the lock */
-        xSemaphoreTake(commandsQueueLock_, portMAX_DELAY);
+        offset += pSubHeader->size;
+    }
+
+    delete[] pStream;
+
+    /* One status per sub-command */
+    if(failed)
+    {
+        rResponse.header.errorCode = ACTION_FAILED;
+    }
+    else
+    {
+        rResponse.header.errorCode = NO_ERROR;
+    }
+    rResponse.header.size = batch.count;
+}
+
+bool SystemState::IsBatchable(const ECommandType kType)
+{
+    /* The EInk worker jobs answer once done, their status is not known when
+     * the batch response is sent.
+     */
+    if(IsWorkerCommand(kType))
+    {
+        return false;
+    }
+
+    switch(kType)
+    {
+        /* Commands using the data channel or not returning */
+        case CMD_FACTORY_RESET:
+        case CMD_FIRMWARE_UPDATE:
+        case CMD_RESUME_TRANSFER:
+        case CMD_BATCH:
+            return false;
+
+        default:
+            return kType < MAX_COMMAND_TYPE;
+    }
+}
+
+bool SystemState::IsWorkerCommand(const uint8_t kType)
+{
+    switch(kType)
+    {
+        case CMD_EINK_CLEAR:
+        case CMD_EINK_NEW_IMAGE:
+        case CMD_EINK_REMOVE_IMAGE:
+        case CMD_EINK_SELECT_IMAGE:
+        case CMD_EINK_GET_CURRENT_IMG_NAME:
+        case CMD_EINK_GET_IMAGE_DATA:
+        case CMD_EINK_GET_IMAGE_LIST:
+        case CMD_EINK_GET_IMAGE_PAGE:
+        case CMD_LEDBORDER_GET_PATTERNS:
+        case CMD_LEDBORDER_GET_ANIMATIONS:
+        case CMD_SET_LINK_COMPRESSION:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+bool SystemState::NeedsWorkerIdle(const uint8_t kType)
+{
+    switch(kType)
+    {
+        /* Commands sharing the data channel or the storage with the worker */
+        case CMD_FACTORY_RESET:
+        case CMD_FIRMWARE_UPDATE:
+        case CMD_RESUME_TRANSFER:
+        case CMD_BATCH:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+void SystemState::GetPipelineInfo(SCommandResponse& rResponse)
+{
+    SPipelineInfo info;
+
+    info.maxInFlight = MAX_COMMANDS_IN_FLIGHT;
+    info.inFlight    = inFlightCommands_;
+    info.deferred    = deferredCommands_.size();
+    info.workerJobs  = eInkPendingJobs_;
+
+    rResponse.header.errorCode = NO_ERROR;
+    rResponse.header.size = sizeof(SPipelineInfo);
+    memcpy(rResponse.pResponse, &info, sizeof(SPipelineInfo));
+}
+
+EErrorCode SystemState::EnqueueEInkJob(const SCommandRequest& rkRequest,
+                                       const bool             kRespond)
+{
+    SEInkJob job;
+
+    if(eInkThread_ == nullptr)
+    {
+        return ACTION_FAILED;
+    }
+
+    job.request = rkRequest;
+    job.respond = kRespond;
+
+    /* Jobs are executed in order, conflicting jobs cannot overlap */
+    ++eInkPendingJobs_;
+    if(xQueueSend(eInkJobsQueue_, &job, 0) != pdTRUE)
+    {
+        --eInkPendingJobs_;
+        return MAX_COMMAND_REACHED;
+    }
+
+    return NO_ERROR;
+}
+
+void SystemState::ExecuteEInkJob(const SEInkJob& rkJob)
+{
+    SCommandResponse response;
+    uint64_t         startTime;
+
+    startTime = HWManager::GetTime();
+
+    /* Jobs without data keep the previous transfer statistics */
+    pBlueToothManager_->BeginTransfer();
+
+    switch(rkJob.request.header.type)
+    {
+        case CMD_EINK_CLEAR:
+            pDisplayInterface_->DisplayPopup(
+                "EInk Update",
+                "Clearing EInk display, please wait..."
+            );
+            pEinkManager_->Clear(response);
+            pDisplayInterface_->HidePopup();
+            break;
+        case CMD_EINK_NEW_IMAGE:
+            pDisplayInterface_->DisplayPopup(
+                "EInk Update",
+                "Updating new image, please wait..."
+            );
+            pEinkManager_->DisplayNewImage(
+                std::string((char*)rkJob.request.pCommand),
+                response
+            );
+            pDisplayInterface_->HidePopup();
+            break;
+        case CMD_EINK_REMOVE_IMAGE:
+            pDisplayInterface_->DisplayPopup(
+                "EInk Update",
+                "Removing EInk image, please wait..."
+            );
+            pEinkManager_->RemoveImage(
+                std::string((char*)rkJob.request.pCommand),
+                response
+            );
+            pDisplayInterface_->HidePopup();
+            break;
+        case CMD_EINK_SELECT_IMAGE:
+            pDisplayInterface_->DisplayPopup(
+                "EInk Update",
+                "Updating new image, please wait..."
+            );
+            pEinkManager_->SetDisplayedImage(
+                std::string((char*)rkJob.request.pCommand),
+                response
+            );
+            pDisplayInterface_->HidePopup();
+            break;
+        case CMD_EINK_GET_CURRENT_IMG_NAME:
+            pEinkManager_->GetDisplayedImageName(response);
+            break;
+        case CMD_EINK_GET_IMAGE_DATA:
+            pDisplayInterface_->DisplayPopup(
+                "EInk Update",
+                "Uploading image, please wait..."
+            );
+            pEinkManager_->SendImageData(
+                std::string((char*)rkJob.request.pCommand),
+                response
+            );
+            pDisplayInterface_->HidePopup();
+            break;
+        case CMD_EINK_GET_IMAGE_LIST:
+            pDisplayInterface_->DisplayPopup(
+                "EInk Update",
+                "Uploading image list, please wait..."
+            );
+            pEinkManager_->SendImageList(response);
+            pDisplayInterface_->HidePopup();
+            break;
+        case CMD_EINK_GET_IMAGE_PAGE:
+            pEinkManager_->SendImagePage(rkJob.request.pCommand, response);
+            break;
+
+        case CMD_LEDBORDER_GET_PATTERNS:
+            pLEDBorder_->GetPatterns(response);
+            break;
+        case CMD_LEDBORDER_GET_ANIMATIONS:
+            pLEDBorder_->GetAnimations(response);
+            break;
+
+        case CMD_SET_LINK_COMPRESSION:
+            /* Ordered with the transfers, applies to the next one */
+            pBlueToothManager_->SetCompression(
+                rkJob.request.pCommand[0],
+                response
+            );
+            break;
+
+        default:
+            response.header.errorCode = INVALID_COMMAND_REQ;
+            response.header.size = 0;
+    }
+
+    pBlueToothManager_->EndTransfer();
+
+    LOG_INFO(
+        "EInk job %d done in %lluus (%d)\n",
+        rkJob.request.header.type,
+        HWManager::GetTime() - startTime,
+        response.header.errorCode
+    );
+
+    /* Check if a response shall be given */
+    if(rkJob.respond)
+    {
+        SendResponse(rkJob.request, response);
+    }
+}
+
+void SystemState::WaitEInkIdle(void)
+{
+    /* Used before the commands that share the data channel or the storage
+     * with the EInk jobs.
+     */
+    while(eInkPendingJobs_ > 0)
+    {
+        HWManager::DelayExecUs(EINK_IDLE_POLL_PERIOD);
+    }
+}
+
+void SystemState::EInkJobRoutine(void* pStateParam)
+{
+    SEInkJob     job;
+    SystemState* pState;
+
+    pState = (SystemState*)pStateParam;
+
+    while(true)
+    {
+        if(xQueueReceive(pState->eInkJobsQueue_, &job, portMAX_DELAY) ==
+           pdTRUE)
+        {
+            pState->ExecuteEInkJob(job);
+            --pState->eInkPendingJobs_;
+        }
     }
-    xSemaphoreGive(commandsQueueLock_);
 }
 
 void SystemState::ManageDebugState(void)
@@ -482,7 +945,7 @@ void SystemState::ManageDebugState(void)
     if(pPrevButtonsState_[BUTTON_DOWN] != BTN_STATE_DOWN &&
        pButtonsState_[BUTTON_DOWN] == BTN_STATE_DOWN)
     {
-        if(currDebugState_ == 4)
+        if(currDebugState_ == 5)
         {
             currDebugState_ = 0;
         }
@@ -493,13 +956,13 @@ void SystemState::ManageDebugState(void)
     {
         if(currDebugState_ == 1)
         {
-            currDebugState_ = 5;
+            currDebugState_ = 6;
         }
         --currDebugState_;
     }
     else if(pPrevButtonsState_[BUTTON_ENTER] != BTN_STATE_DOWN &&
             pButtonsState_[BUTTON_ENTER] == BTN_STATE_DOWN &&
-            currDebugState_ == 4)
+            currDebugState_ == 5)
     {
         currDebugState_ = 0;
         LOG_DEBUG("Disabling debug state\n");
@@ -519,6 +982,9 @@ void SystemState::ManageDebugState(void)
 
     debugInfo.batteryState = pBatteryMgr_->GetPercentage();
 
+    pBlueToothManager_->GetTransferStats(true, debugInfo.bleStats);
+    pBlueToothManager_->GetResponseStats(debugInfo.bleResponses);
+
     pDisplayInterface_->SetDebugDisplay(debugInfo);
 }
 
@@ -616,7 +1082,7 @@ void SystemState::SetOwner(const char* kpOwner, SCommandResponse& rReponse)
     }
 
     /* Save to storage */
-    if(pStore_->SetContent(OWNER_FILE_PATH, std::string(kpOwner), true))
+    if(pConfig_->SetString(CONFIG_KEY_OWNER, std::string(kpOwner)))
     {
         rReponse.header.errorCode = NO_ERROR;
         rReponse.header.size = 0;
@@ -639,7 +1105,7 @@ void SystemState::SetContact(const char* kpContact, SCommandResponse& rReponse)
     }
 
     /* Save to storage */
-    if(pStore_->SetContent(CONTACT_FILE_PATH, std::string(kpContact), true))
+    if(pConfig_->SetString(CONFIG_KEY_CONTACT, std::string(kpContact)))
     {
         rReponse.header.errorCode = NO_ERROR;
         rReponse.header.size = 0;
@@ -655,7 +1121,7 @@ void SystemState::GetOwner(SCommandResponse& rReponse)
 {
     std::string contentStr;
 
-    pStore_->GetContent(OWNER_FILE_PATH, "", contentStr, true);
+    pConfig_->GetString(CONFIG_KEY_OWNER, contentStr);
     rReponse.header.errorCode = NO_ERROR;
     rReponse.header.size = contentStr.size();
     memcpy(rReponse.pResponse, contentStr.c_str(), contentStr.size());
@@ -665,7 +1131,7 @@ void SystemState::GetContact(SCommandResponse& rReponse)
 {
     std::string contentStr;
 
-    pStore_->GetContent(CONTACT_FILE_PATH, "", contentStr, true);
+    pConfig_->GetString(CONFIG_KEY_CONTACT, contentStr);
     rReponse.header.errorCode = NO_ERROR;
     rReponse.header.size = contentStr.size();
     memcpy(rReponse.pResponse, contentStr.c_str(), contentStr.size());
@@ -18,15 +18,16 @@
 /*******************************************************************************
  * INCLUDES
  ******************************************************************************/
-#include <cstdint>          /* Generic types */
-#include <HWMgr.h>          /* Hardware layer */
-#include <Update.h>         /* ESP32 Update manager */
-#include <Logger.h>         /* System logger */
-#include <version.h>        /* Versionning information */
-#include <Storage.h>        /* Storage service */
-#include <BlueToothMgr.h>   /* Bluetooth manager */
-#include <mbedtls/sha256.h> /* Checksum functions */
-#include <mbedtls/pk.h>     /* Signature functions */
+#include <cstdint>             /* Generic types */
+#include <HWMgr.h>             /* Hardware layer */
+#include <Update.h>            /* ESP32 Update manager */
+#include <Logger.h>            /* System logger */
+#include <version.h>           /* Versionning information */
+#include <Storage.h>           /* Storage service */
+#include <BlueToothMgr.h>      /* Bluetooth manager */
+#include <mbedtls/sha256.h>    /* Checksum functions */
+#include <mbedtls/pk.h>        /* Signature functions */
+#include <ResumableTransfer.h> /* Resumable transfers */
 
 /* Header File */
 #include <Updater.h>
@@ -137,14 +138,17 @@ void Updater::RequestUpdate(const uint8_t* kpData, SCommandResponse& rReponse)
 
 bool Updater::DownloadUpdateFile(void)
 {
-    uint8_t* pBuffer;
-    size_t   leftToTransfer;
-    size_t   toReceive;
-    ssize_t  readBytes;
-    ssize_t  wroteBytes;
-    size_t   offset;
-    Storage* pStore;
-    FsFile   updateFile;
+    uint8_t*          pBuffer;
+    size_t            leftToTransfer;
+    size_t            toReceive;
+    ssize_t           readBytes;
+    ssize_t           wroteBytes;
+    size_t            offset;
+    bool              resumable;
+    Storage*          pStore;
+    FsFile            updateFile;
+    EErrorCode        retCode;
+    ResumableTransfer transfer;
 
     /* Send the ack */
     pBtMgr_->SendCommandResponse(*pCommandResponse_);
@@ -173,10 +177,29 @@ bool Updater::DownloadUpdateFile(void)
         return false;
     }
 
-    /* Open the update file */
+    /* Open the update file, a prepared transfer continues its partial file.
+     * The client sends the header again then the data from the offset.
+     */
     pStore = Storage::GetInstance();
-    pStore->Remove(UPDATE_FILE_PATH);
-    updateFile = pStore->Open(UPDATE_FILE_PATH, FILE_WRITE);
+    resumable = transfer.Begin();
+    if(resumable)
+    {
+        if(transfer.GetTotalSize() != updateHeader_.size)
+        {
+            transfer.Abort(updateFile);
+            pCommandResponse_->header.errorCode = INVALID_PARAM;
+            pCommandResponse_->header.size = 0;
+            return false;
+        }
+        transfer.Open(updateFile);
+        leftToTransfer = updateHeader_.size - transfer.GetOffset();
+    }
+    else
+    {
+        pStore->Remove(UPDATE_FILE_PATH);
+        updateFile = pStore->Open(UPDATE_FILE_PATH, FILE_WRITE);
+        leftToTransfer = updateHeader_.size;
+    }
     if(!updateFile)
     {
         pCommandResponse_->header.errorCode = FILE_NOT_FOUND;
@@ -188,8 +211,15 @@ bool Updater::DownloadUpdateFile(void)
     pBuffer = new uint8_t[UPDATE_BUFFER_SIZE];
     if(pBuffer == nullptr)
     {
-        updateFile.close();
-        pStore->Remove(UPDATE_FILE_PATH);
+        if(resumable)
+        {
+            transfer.Suspend(updateFile);
+        }
+        else
+        {
+            updateFile.close();
+            pStore->Remove(UPDATE_FILE_PATH);
+        }
         pCommandResponse_->header.errorCode = NO_MORE_MEMORY;
         pCommandResponse_->header.size = 0;
 
@@ -201,7 +231,6 @@ bool Updater::DownloadUpdateFile(void)
     pCommandResponse_->header.size = 0;
     pBtMgr_->SendCommandResponse(*pCommandResponse_);
 
-    leftToTransfer = updateHeader_.size;
     while(leftToTransfer > 0)
     {
         toReceive = MIN(leftToTransfer, UPDATE_BUFFER_SIZE);
@@ -224,12 +253,23 @@ bool Updater::DownloadUpdateFile(void)
                 if(wroteBytes < 0)
                 {
                     delete[] pBuffer;
-                    updateFile.close();
-                    pStore->Remove(UPDATE_FILE_PATH);
+                    if(resumable)
+                    {
+                        transfer.Abort(updateFile);
+                    }
+                    else
+                    {
+                        updateFile.close();
+                        pStore->Remove(UPDATE_FILE_PATH);
+                    }
                     pCommandResponse_->header.errorCode = WRITE_FILE_FAILED;
                     pCommandResponse_->header.size = 0;
                     return false;
                 }
+                if(resumable)
+                {
+                    transfer.Advance(updateFile, wroteBytes);
+                }
                 offset += wroteBytes;
                 readBytes -= wroteBytes;
                 leftToTransfer -= wroteBytes;
@@ -243,17 +283,43 @@ bool Updater::DownloadUpdateFile(void)
         else
         {
             delete[] pBuffer;
-            updateFile.close();
-            pStore->Remove(UPDATE_FILE_PATH);
+
+            /* Keep a resumable transfer to continue it after the link is
+             * back.
+             */
+            if(resumable)
+            {
+                transfer.Suspend(updateFile);
+            }
+            else
+            {
+                updateFile.close();
+                pStore->Remove(UPDATE_FILE_PATH);
+            }
             pCommandResponse_->header.errorCode = TRANS_RECV_FAILED;
             pCommandResponse_->header.size = 0;
             return false;
         }
     }
 
-    updateFile.close();
     delete[] pBuffer;
 
+    /* Resumed transfers are checked against their hash before being used */
+    if(resumable)
+    {
+        retCode = transfer.Commit(updateFile, UPDATE_FILE_PATH);
+        if(retCode != NO_ERROR)
+        {
+            pCommandResponse_->header.errorCode = retCode;
+            pCommandResponse_->header.size = 0;
+            return false;
+        }
+    }
+    else
+    {
+        updateFile.close();
+    }
+
     return true;
 }
 
@@ -18,12 +18,17 @@
 /*******************************************************************************
  * INCLUDES
  ******************************************************************************/
-#include <string>          /* std::string */
-#include <Types.h>         /* Defined Types */
-#include <HWMgr.h>         /* Hardware manager */
-#include <Storage.h>       /* Storage service */
-#include <BlueToothMgr.h>  /* Bluetooth Manager */
-#include <WaveshareEInk.h> /* EInk Driver */
+#include <string>              /* std::string */
+#include <Types.h>             /* Defined Types */
+#include <HWMgr.h>             /* Hardware manager */
+#include <Storage.h>           /* Storage service */
+#include <ConfigStore.h>       /* Configuration store */
+#include <esp_rom_crc.h>       /* CRC32 services */
+#include <ImageCatalog.h>      /* Image catalog */
+#include <ImageCodec.h>        /* Compressed images codec */
+#include <BlueToothMgr.h>      /* Bluetooth Manager */
+#include <WaveshareEInk.h>     /* EInk Driver */
+#include <ResumableTransfer.h> /* Resumable transfers */
 
 /* Header File */
 #include <WaveshareEInkMgr.h>
@@ -38,15 +43,24 @@
 /** @brief Read image timeout. */
 #define IMAGE_READ_TIMEOUT 10000 /* 10 seconds */
 
+/** @brief Panel refresh timeout in milliseconds. */
+#define EINK_REFRESH_TIMEOUT 60000
+
 /** @brief Size in bytes of the internal buffer used for transations. */
 #define INTERNAL_BUFFER_SIZE 32768
 
+/** @brief Number of buffers used by the display pipeline. */
+#define PIPELINE_BUFFER_COUNT 2
+
+/** @brief Size in bytes of each display pipeline buffer. */
+#define PIPELINE_BUFFER_SIZE (INTERNAL_BUFFER_SIZE / PIPELINE_BUFFER_COUNT)
+
+/** @brief Size in bytes of the buffer used to decode compressed images. */
+#define IMAGE_DECODE_BUFFER_SIZE 2048
+
 /** @brief Path to the images directory. */
 #define IMAGE_DIR_PATH "/images"
 
-/** @brief Path to the current image name file. */
-#define CURRENT_IMG_NAME_FILE_PATH "/currimg"
-
 /*******************************************************************************
  * MACROS
  ******************************************************************************/
@@ -93,6 +107,8 @@ EInkDisplayManager::EInkDisplayManager(BluetoothManager* pBtMgr)
 {
     pBtMgr_ = pBtMgr;
     pStore_ = Storage::GetInstance();
+    pConfig_ = ConfigStore::GetInstance();
+    pCatalog_ = nullptr;
 }
 
 void EInkDisplayManager::Init(void)
@@ -106,12 +122,8 @@ void EInkDisplayManager::Init(void)
     {
         LOG_ERROR("Failed to create image directory.\n");
     }
-    pStore_->GetContent(
-        CURRENT_IMG_NAME_FILE_PATH,
-        "",
-        currentImageName_,
-        true
-    );
+    pCatalog_ = ImageCatalog::GetInstance();
+    pConfig_->GetString(CONFIG_KEY_CURRENT_IMAGE, currentImageName_);
 }
 
 void EInkDisplayManager::GetDisplayedImageName(SCommandResponse& rResponse) const
@@ -126,7 +138,7 @@ void EInkDisplayManager::GetDisplayedImageName(SCommandResponse& rResponse) cons
 
 void EInkDisplayManager::Clear(SCommandResponse& rResponse)
 {
-    if(pStore_->SetContent(CURRENT_IMG_NAME_FILE_PATH, "", true))
+    if(pConfig_->SetString(CONFIG_KEY_CURRENT_IMAGE, ""))
     {
         currentImageName_ = "";
         rResponse.header.errorCode = NO_ERROR;
@@ -137,7 +149,10 @@ void EInkDisplayManager::Clear(SCommandResponse& rResponse)
 
         /* Reset the EInk display */
         eInkDriver_.Init();
-        eInkDriver_.Clear(EPD_5IN65F_WHITE);
+        if(!eInkDriver_.Clear(EPD_5IN65F_WHITE))
+        {
+            LOG_ERROR("Failed to clear the EInk display.\n");
+        }
         eInkDriver_.Sleep();
     }
     else
@@ -162,25 +177,41 @@ void EInkDisplayManager::RemoveImage(const std::string& rkFilename,
 
     if(rResponse.header.errorCode == NO_ERROR)
     {
-        status = pStore_->Remove(
-            IMAGE_DIR_PATH + std::string("/") + rkFilename
-        );
+        /* The catalog is rebuilt at boot if the removal is not recorded */
+        status = pCatalog_->MarkDirty() &&
+                 pStore_->Remove(
+                     IMAGE_DIR_PATH + std::string("/") + rkFilename
+                 );
         if(!status)
         {
             rResponse.header.errorCode = ACTION_FAILED;
         }
+        else if(!pCatalog_->Remove(rkFilename))
+        {
+            LOG_ERROR("Failed to remove %s from the catalog.\n",
+                      rkFilename.c_str());
+        }
     }
 }
 
 void EInkDisplayManager::SetDisplayedImage(const std::string& rkFilename,
                                            SCommandResponse&  rResponse)
 {
-    size_t      toRead;
-    ssize_t     readBytes;
-    uint32_t    leftToTransfer;
-    std::string formatedName;
-    uint8_t*    pBuffer;
-    FsFile      file;
+    uint8_t      i;
+    bool         isCompressed;
+    uint32_t     dataSize;
+    uint32_t     leftToTransfer;
+    uint32_t     hash;
+    uint64_t     startTime;
+    uint64_t     waitTime;
+    uint64_t     blockedTime;
+    uint8_t*     pBuffer;
+    FsFile       file;
+    EErrorCode   retCode;
+    SImageChunk  chunk;
+    SImageReader reader;
+    TaskHandle_t readerThread;
+    ImageDecoder decoder;
 
     if(rkFilename == currentImageName_)
     {
@@ -189,38 +220,83 @@ void EInkDisplayManager::SetDisplayedImage(const std::string& rkFilename,
         return;
     }
 
-    if(rkFilename.size() == 0)
+    /* Allocate buffer */
+    pBuffer = new uint8_t[PIPELINE_BUFFER_SIZE * PIPELINE_BUFFER_COUNT +
+                          IMAGE_DECODE_BUFFER_SIZE];
+    if(pBuffer == nullptr)
     {
-        rResponse.header.errorCode = FILE_NOT_FOUND;
+        rResponse.header.errorCode = NO_MORE_MEMORY;
         rResponse.header.size = 0;
         return;
     }
-    formatedName = IMAGE_DIR_PATH + std::string("/") + rkFilename;
 
-    /* Check if file exists */
-    if(!pStore_->FileExists(formatedName))
+    /* Open file, the storage is held until the image is read */
+    pStore_->Lock();
+    retCode = OpenImage(rkFilename, file, dataSize, isCompressed);
+    if(retCode != NO_ERROR)
     {
-        rResponse.header.errorCode = FILE_NOT_FOUND;
+        pStore_->Unlock();
+        rResponse.header.errorCode = retCode;
         rResponse.header.size = 0;
+        delete[] pBuffer;
         return;
     }
-
-    /* Allocate buffer */
-    pBuffer = new uint8_t[INTERNAL_BUFFER_SIZE];
-    if(pBuffer == nullptr)
+    decoder.Reset(EINK_IMAGE_SIZE);
+
+    /* Create the pipeline, all buffers are free at first */
+    reader.pFile       = &file;
+    reader.leftToRead  = dataSize;
+    reader.blockedTime = 0;
+    reader.readTime    = 0;
+    reader.freeQueue   = xQueueCreate(PIPELINE_BUFFER_COUNT,
+                                      sizeof(SImageChunk));
+    reader.fullQueue   = xQueueCreate(PIPELINE_BUFFER_COUNT,
+                                      sizeof(SImageChunk));
+    reader.doneLock    = xSemaphoreCreateBinary();
+    readerThread       = nullptr;
+    if(reader.freeQueue != nullptr &&
+       reader.fullQueue != nullptr &&
+       reader.doneLock != nullptr)
     {
-        rResponse.header.errorCode = NO_MORE_MEMORY;
-        rResponse.header.size = 0;
-        return;
+        for(i = 0; i < PIPELINE_BUFFER_COUNT; ++i)
+        {
+            chunk.pBuffer = pBuffer + i * PIPELINE_BUFFER_SIZE;
+            chunk.size    = 0;
+            xQueueSend(reader.freeQueue, &chunk, portMAX_DELAY);
+        }
+
+        /* Start reading while the panel initializes */
+        xTaskCreatePinnedToCore(
+            ImageReaderRoutine,
+            "EInkReadThread",
+            4096,
+            &reader,
+            15,
+            &readerThread,
+            tskNO_AFFINITY
+        );
     }
 
-    /* Open file */
-    file = pStore_->Open(formatedName, FILE_READ);
-    if(!file)
+    if(readerThread == nullptr)
     {
-        rResponse.header.errorCode = OPEN_FILE_FAILED;
+        LOG_ERROR("Failed to create the image pipeline.\n");
+        if(reader.freeQueue != nullptr)
+        {
+            vQueueDelete(reader.freeQueue);
+        }
+        if(reader.fullQueue != nullptr)
+        {
+            vQueueDelete(reader.fullQueue);
+        }
+        if(reader.doneLock != nullptr)
+        {
+            vSemaphoreDelete(reader.doneLock);
+        }
+        rResponse.header.errorCode = ACTION_FAILED;
         rResponse.header.size = 0;
         delete[] pBuffer;
+        file.close();
+        pStore_->Unlock();
         return;
     }
 
@@ -230,6 +306,9 @@ void EInkDisplayManager::SetDisplayedImage(const std::string& rkFilename,
     pBtMgr_->SendCommandResponse(rResponse);
 
     leftToTransfer = EINK_IMAGE_SIZE;
+    blockedTime    = 0;
+    hash           = 0;
+    startTime      = HWManager::GetTime();
 
     /* Init the EInk display */
     eInkDriver_.Init();
@@ -237,50 +316,54 @@ void EInkDisplayManager::SetDisplayedImage(const std::string& rkFilename,
 
     LOG_DEBUG("Updating EINK Image. Left: %d\n", leftToTransfer);
 
-    /* Get the full image data */
-    while(leftToTransfer > 0)
+    /* Send the buffers as they are filled by the reader */
+    while(true)
     {
-        if(leftToTransfer < INTERNAL_BUFFER_SIZE)
-        {
-            toRead = leftToTransfer;
-        }
-        else
-        {
-            toRead = INTERNAL_BUFFER_SIZE;
-        }
+        waitTime = HWManager::GetTime();
+        xQueueReceive(reader.fullQueue, &chunk, portMAX_DELAY);
+        blockedTime += HWManager::GetTime() - waitTime;
 
-        readBytes = file.read(pBuffer, toRead);
-        if(readBytes > 0)
-        {
-            eInkDriver_.DisplayPerformTrans(pBuffer, readBytes);
-            LOG_DEBUG("Updating EINK Image. Left: %d\n", leftToTransfer);
-
-            leftToTransfer -= readBytes;
-        }
-        else
+        if(chunk.size <= 0)
         {
             break;
         }
+
+        hash = esp_rom_crc32_le(hash, chunk.pBuffer, chunk.size);
+        leftToTransfer -= DisplayImageData(
+            chunk.pBuffer,
+            chunk.size,
+            isCompressed ? &decoder : nullptr,
+            pBuffer + PIPELINE_BUFFER_SIZE * PIPELINE_BUFFER_COUNT
+        );
+        LOG_DEBUG("Updating EINK Image. Left: %d\n", leftToTransfer);
+
+        xQueueSend(reader.freeQueue, &chunk, portMAX_DELAY);
     }
 
-    /* End EINK transation */
-    eInkDriver_.DisplayEndTrans();
-    eInkDriver_.Sleep();
+    /* Wait for the reader to end */
+    xSemaphoreTake(reader.doneLock, portMAX_DELAY);
+    file.close();
+    pStore_->Unlock();
+
+    LOG_INFO(
+        "EInk pipeline: %lluus total, SD read %lluus (blocked %lluus), "
+        "panel blocked %lluus\n",
+        HWManager::GetTime() - startTime,
+        reader.readTime,
+        reader.blockedTime,
+        blockedTime
+    );
 
-    if(leftToTransfer == 0)
+    /* End EINK transation */
+    if(!BeginRefresh() || !WaitRefresh(EINK_REFRESH_TIMEOUT))
     {
-        currentImageName_ = rkFilename;
-        if(!pStore_->SetContent(CURRENT_IMG_NAME_FILE_PATH, rkFilename, true))
-        {
-            LOG_ERROR("Could not save current image name.\n");
-            rResponse.header.errorCode = IMG_NAME_UPDATE_FAIL;
-            rResponse.header.size = 0;
-        }
-        else
-        {
-            rResponse.header.errorCode = NO_ERROR;
-            rResponse.header.size = 0;
-        }
+        rResponse.header.errorCode = ACTION_FAILED;
+        rResponse.header.size = 0;
+    }
+    else if(leftToTransfer == 0)
+    {
+        SetCurrentImageName(rkFilename, rResponse);
+        pCatalog_->RecordDisplay(rkFilename, hash);
     }
     else
     {
@@ -290,22 +373,31 @@ void EInkDisplayManager::SetDisplayedImage(const std::string& rkFilename,
 
     LOG_DEBUG("Updated EINK Image\n");
 
+    vQueueDelete(reader.freeQueue);
+    vQueueDelete(reader.fullQueue);
+    vSemaphoreDelete(reader.doneLock);
     delete[] pBuffer;
-    file.close();
 }
 
 void EInkDisplayManager::DisplayNewImage(const std::string& rkFilename,
                                          SCommandResponse&  rResponse)
 {
-    size_t      toRead;
-    uint32_t    leftToTransfer;
-    ssize_t     readBytes;
-    ssize_t     wroteBytes;
-    size_t      offset;
-    std::string formatedName;
-    uint8_t*    pBuffer;
-    FsFile      file;
-    EErrorCode  retCode;
+    size_t            toRead;
+    bool              isCompressed;
+    bool              resumable;
+    uint32_t          leftToTransfer;
+    uint32_t          leftToDisplay;
+    uint32_t          replayLeft;
+    uint32_t          hash;
+    ssize_t           readBytes;
+    std::string       formatedName;
+    uint8_t*          pBuffer;
+    FsFile            file;
+    EErrorCode        retCode;
+    ImageDecoder      decoder;
+    ResumableTransfer transfer;
+
+    const SImageCodecHeader* kpHeader;
 
     if(rkFilename.size() == 0)
     {
@@ -315,14 +407,8 @@ void EInkDisplayManager::DisplayNewImage(const std::string& rkFilename,
     }
     formatedName = IMAGE_DIR_PATH + std::string("/") + rkFilename;
 
-    /* Check if file exists */
-    if(pStore_->FileExists(formatedName))
-    {
-        pStore_->Remove(formatedName);
-    }
-
     /* Allocate buffer */
-    pBuffer = new uint8_t[INTERNAL_BUFFER_SIZE];
+    pBuffer = new uint8_t[INTERNAL_BUFFER_SIZE + IMAGE_DECODE_BUFFER_SIZE];
     if(pBuffer == nullptr)
     {
         rResponse.header.errorCode = NO_MORE_MEMORY;
@@ -330,8 +416,28 @@ void EInkDisplayManager::DisplayNewImage(const std::string& rkFilename,
         return;
     }
 
-    /* Open file */
-    file = pStore_->Open(formatedName, FILE_WRITE);
+    /* Open the temporary file, the image is only stored once complete. The
+     * storage is only held around the file operations, never while waiting
+     * for the link.
+     */
+    pStore_->Lock();
+    resumable = transfer.Begin();
+    if(resumable)
+    {
+        /* The data received before the link dropped is replayed first */
+        if(!transfer.Open(file) || !file.seekSet(0))
+        {
+            file.close();
+        }
+        replayLeft = transfer.GetOffset();
+    }
+    else
+    {
+        pStore_->Remove(IMAGE_TMP_FILE_PATH);
+        file = pStore_->Open(IMAGE_TMP_FILE_PATH, FILE_WRITE);
+        replayLeft = 0;
+    }
+    pStore_->Unlock();
     if(!file)
     {
         rResponse.header.errorCode = OPEN_FILE_FAILED;
@@ -345,92 +451,226 @@ void EInkDisplayManager::DisplayNewImage(const std::string& rkFilename,
     rResponse.header.size = 0;
     pBtMgr_->SendCommandResponse(rResponse);
 
-    leftToTransfer = EINK_IMAGE_SIZE;
     LOG_DEBUG("Downloading image %s\n", rkFilename.c_str());
 
-    /* Get the full image data */
-    retCode = NO_ERROR;
-    while(leftToTransfer > 0)
+    /* Init the EInk display, the data is sent to the panel as it arrives */
+    eInkDriver_.Init();
+    eInkDriver_.DisplayInitTrans();
+
+    /* Get the header to detect the encoding, raw images have no header */
+    retCode        = NO_ERROR;
+    isCompressed   = false;
+    leftToTransfer = 0;
+    leftToDisplay  = EINK_IMAGE_SIZE;
+    hash           = 0;
+    readBytes = sizeof(SImageCodecHeader);
+    retCode = ReceiveImageData(
+        file,
+        pBuffer,
+        readBytes,
+        replayLeft,
+        resumable ? &transfer : nullptr
+    );
+    if(retCode == NO_ERROR)
     {
-        if(leftToTransfer < INTERNAL_BUFFER_SIZE)
+        kpHeader = (const SImageCodecHeader*)pBuffer;
+        if(ImageDecoder::IsCompressed(*kpHeader))
         {
-            toRead = leftToTransfer;
+            if(ImageDecoder::IsValid(*kpHeader, EINK_IMAGE_SIZE))
+            {
+                isCompressed   = true;
+                leftToTransfer = kpHeader->dataSize;
+                decoder.Reset(EINK_IMAGE_SIZE);
+                LOG_DEBUG(
+                    "Compressed image, %d bytes\n",
+                    kpHeader->dataSize
+                );
+            }
+            else
+            {
+                LOG_ERROR("Invalid compressed image header.\n");
+                retCode = CORRUPTED_DATA;
+            }
         }
         else
         {
-            toRead = INTERNAL_BUFFER_SIZE;
+            /* The codec header is not hashed, raw images have none */
+            hash = esp_rom_crc32_le(hash, pBuffer, readBytes);
+            leftToTransfer = EINK_IMAGE_SIZE - readBytes;
+            leftToDisplay -= DisplayImageData(
+                pBuffer,
+                readBytes,
+                nullptr,
+                nullptr
+            );
         }
+    }
 
-        readBytes = pBtMgr_->ReceiveData(pBuffer, toRead, IMAGE_READ_TIMEOUT);
-        if(readBytes > 0)
+    /* Get the full image data, store it and send it to the panel */
+    while(retCode == NO_ERROR && leftToTransfer > 0)
+    {
+        toRead = MIN(leftToTransfer, INTERNAL_BUFFER_SIZE);
+
+        retCode = ReceiveImageData(
+            file,
+            pBuffer,
+            toRead,
+            replayLeft,
+            resumable ? &transfer : nullptr
+        );
+        if(retCode != NO_ERROR)
         {
-            /* Write the update file */
-            offset = 0;
-            do
-            {
-                wroteBytes = file.write(pBuffer + offset, readBytes);
-                if(wroteBytes < 0)
-                {
-                    retCode = WRITE_FILE_FAILED;
-                    break;
-                }
-                offset += wroteBytes;
-                readBytes -= wroteBytes;
-                leftToTransfer -= wroteBytes;
-            } while(readBytes != 0);
+            break;
         }
-        else
+        readBytes = toRead;
+        leftToTransfer -= readBytes;
+        hash = esp_rom_crc32_le(hash, pBuffer, readBytes);
+
+        leftToDisplay -= DisplayImageData(
+            pBuffer,
+            readBytes,
+            isCompressed ? &decoder : nullptr,
+            pBuffer + INTERNAL_BUFFER_SIZE
+        );
+        if(isCompressed && decoder.HasError())
         {
-            retCode = TRANS_RECV_FAILED;
+            retCode = CORRUPTED_DATA;
             break;
         }
+
         LOG_DEBUG("Downloading EINK Image. Left: %d\n", leftToTransfer);
     }
 
-    delete[] pBuffer;
-    file.close();
+    if(retCode == NO_ERROR && leftToDisplay != 0)
+    {
+        LOG_ERROR("Incomplete image data.\n");
+        retCode = CORRUPTED_DATA;
+    }
 
-    rResponse.header.errorCode = retCode;
-    rResponse.header.size = 0;
+    delete[] pBuffer;
 
+    pStore_->Lock();
     if(retCode != NO_ERROR)
     {
-        pStore_->Remove(formatedName);
+        /* Roll back: drop the partial file and leave the panel untouched, the
+         * panel RAM is only displayed on refresh. A resumable transfer that
+         * lost the link is kept to be resumed.
+         */
+        if(resumable && retCode == TRANS_RECV_FAILED)
+        {
+            transfer.Suspend(file);
+        }
+        else if(resumable)
+        {
+            transfer.Abort(file);
+        }
+        else
+        {
+            file.close();
+            pStore_->Remove(IMAGE_TMP_FILE_PATH);
+        }
+        pStore_->Unlock();
+        eInkDriver_.Sleep();
+
+        rResponse.header.errorCode = retCode;
+        rResponse.header.size = 0;
+        return;
+    }
+
+    /* Commit the image file then refresh the panel, resumed transfers are
+     * checked against their hash first. The catalog is marked dirty first, it
+     * is rebuilt at boot if the image is not recorded.
+     */
+    if(!pCatalog_->MarkDirty())
+    {
+        if(resumable)
+        {
+            transfer.Abort(file);
+        }
+        else
+        {
+            file.close();
+            pStore_->Remove(IMAGE_TMP_FILE_PATH);
+        }
+        retCode = WRITE_FILE_FAILED;
+    }
+    else if(resumable)
+    {
+        retCode = transfer.Commit(file, formatedName);
     }
     else
     {
-        SetDisplayedImage(rkFilename, rResponse);
+        file.close();
+        if(!pStore_->Rename(IMAGE_TMP_FILE_PATH, formatedName))
+        {
+            pStore_->Remove(IMAGE_TMP_FILE_PATH);
+            retCode = WRITE_FILE_FAILED;
+        }
     }
-}
+    if(retCode != NO_ERROR)
+    {
+        LOG_ERROR("Failed to store image %s\n", rkFilename.c_str());
+        pStore_->Unlock();
+        eInkDriver_.Sleep();
 
-void EInkDisplayManager::SendImageData(const std::string& rkFilename,
-                                       SCommandResponse&  rResponse) const
-{
-    size_t      toRead;
-    uint32_t    leftToTransfer;
-    ssize_t     readBytes;
-    ssize_t     wroteBytes;
-    std::string formatedName;
-    uint8_t*    pBuffer;
-    FsFile      file;
-    EErrorCode  retCode;
+        rResponse.header.errorCode = retCode;
+        rResponse.header.size = 0;
+        return;
+    }
 
-    if(rkFilename.size() == 0)
+    /* The images are only reached through the catalog, an image that cannot
+     * be cataloged is removed and the upload fails. A replaced image is
+     * dropped from the catalog with its file.
+     */
+    if(!pCatalog_->Add(rkFilename,
+                       hash,
+                       isCompressed ? IMAGE_ENCODING_COMPRESSED :
+                                      IMAGE_ENCODING_RAW))
     {
-        rResponse.header.errorCode = FILE_NOT_FOUND;
+        LOG_ERROR("Failed to add %s to the catalog.\n", rkFilename.c_str());
+        pStore_->Remove(formatedName);
+        pCatalog_->Remove(rkFilename);
+        pStore_->Unlock();
+        eInkDriver_.Sleep();
+
+        rResponse.header.errorCode = WRITE_FILE_FAILED;
         rResponse.header.size = 0;
         return;
     }
-    formatedName = IMAGE_DIR_PATH + std::string("/") + rkFilename;
+    pStore_->Unlock();
 
-    if(!pStore_->FileExists(formatedName))
+    if(!BeginRefresh() || !WaitRefresh(EINK_REFRESH_TIMEOUT))
     {
-        rResponse.header.errorCode = FILE_NOT_FOUND;
+        rResponse.header.errorCode = ACTION_FAILED;
         rResponse.header.size = 0;
         return;
     }
 
-    LOG_DEBUG("Sending image %s\n", formatedName.c_str());
+    SetCurrentImageName(rkFilename, rResponse);
+    pCatalog_->RecordDisplay(rkFilename, hash);
+
+    LOG_DEBUG("Updated EINK Image\n");
+}
+
+void EInkDisplayManager::SendImageData(const std::string& rkFilename,
+                                       SCommandResponse&  rResponse) const
+{
+    size_t       toRead;
+    size_t       offset;
+    size_t       consumed;
+    size_t       toSend;
+    bool         isCompressed;
+    uint32_t     dataSize;
+    uint32_t     leftToTransfer;
+    ssize_t      readBytes;
+    ssize_t      wroteBytes;
+    uint8_t*     pBuffer;
+    uint8_t*     pSendBuffer;
+    FsFile       file;
+    EErrorCode   retCode;
+    ImageDecoder decoder;
+
+    LOG_DEBUG("Sending image %s\n", rkFilename.c_str());
 
     /* Allocate buffer */
     pBuffer = new uint8_t[INTERNAL_BUFFER_SIZE];
@@ -441,77 +681,156 @@ void EInkDisplayManager::SendImageData(const std::string& rkFilename,
         return;
     }
 
-    /* Open file */
-    file = pStore_->Open(formatedName, FILE_READ);
-    if(!file)
+    /* Open file, the storage is only held around the file operations */
+    pStore_->Lock();
+    retCode = OpenImage(rkFilename, file, dataSize, isCompressed);
+    pStore_->Unlock();
+    if(retCode != NO_ERROR)
     {
-        rResponse.header.errorCode = OPEN_FILE_FAILED;
+        rResponse.header.errorCode = retCode;
         rResponse.header.size = 0;
         delete[] pBuffer;
         return;
     }
 
+    /* Compressed images are decoded in the second half of the buffer, the
+     * client always receives the raw image.
+     */
+    if(isCompressed)
+    {
+        pSendBuffer = pBuffer + INTERNAL_BUFFER_SIZE / 2;
+        decoder.Reset(EINK_IMAGE_SIZE);
+    }
+    else
+    {
+        pSendBuffer = pBuffer;
+    }
+
     /* Send the ack */
     rResponse.header.errorCode = NO_ERROR;
     rResponse.header.size = 0;
     pBtMgr_->SendCommandResponse(rResponse);
 
-    leftToTransfer = EINK_IMAGE_SIZE;
-    LOG_DEBUG("Uploading image %s\n", formatedName.c_str());
+    leftToTransfer = dataSize;
+    LOG_DEBUG("Uploading image %s\n", rkFilename.c_str());
 
     /* Get the full image data */
     retCode = NO_ERROR;
-    while(leftToTransfer > 0)
+    while(leftToTransfer > 0 && retCode == NO_ERROR)
     {
-        if(leftToTransfer < INTERNAL_BUFFER_SIZE)
-        {
-            toRead = leftToTransfer;
-        }
-        else
+        toRead = MIN(leftToTransfer,
+                     isCompressed ? INTERNAL_BUFFER_SIZE / 2 :
+                                    INTERNAL_BUFFER_SIZE);
+
+        pStore_->Lock();
+        readBytes = file.read(pBuffer, toRead);
+        pStore_->Unlock();
+        if(readBytes <= 0)
         {
-            toRead = INTERNAL_BUFFER_SIZE;
+            retCode = READ_FILE_FAILED;
+            LOG_ERROR("Error while reading image.\n");
+            break;
         }
+        leftToTransfer -= readBytes;
 
-        readBytes = file.read(pBuffer, toRead);
-        if(readBytes > 0)
+        offset = 0;
+        do
         {
-            wroteBytes = pBtMgr_->SendData(
-                pBuffer,
-                readBytes,
-                IMAGE_READ_TIMEOUT
-            );
-            if(wroteBytes != readBytes)
+            if(isCompressed)
             {
-                retCode = TRANS_SEND_FAILED;
-                LOG_ERROR("Error while uploading image.\n");
-                break;
+                toSend = decoder.Decode(
+                    pBuffer + offset,
+                    readBytes - offset,
+                    consumed,
+                    pSendBuffer,
+                    INTERNAL_BUFFER_SIZE / 2
+                );
+                offset += consumed;
+                if(decoder.HasError())
+                {
+                    retCode = CORRUPTED_DATA;
+                    LOG_ERROR("Corrupted compressed image.\n");
+                    break;
+                }
             }
-            leftToTransfer -= readBytes;
-        }
+            else
+            {
+                toSend = readBytes;
+                offset = readBytes;
+            }
+
+            if(toSend > 0)
+            {
+                wroteBytes = pBtMgr_->SendData(
+                    pSendBuffer,
+                    toSend,
+                    IMAGE_READ_TIMEOUT
+                );
+                if(wroteBytes != (ssize_t)toSend)
+                {
+                    retCode = TRANS_SEND_FAILED;
+                    LOG_ERROR("Error while uploading image.\n");
+                    break;
+                }
+            }
+        } while(isCompressed && toSend > 0);
 
         LOG_DEBUG("Uploading EINK Image. Left: %d\n", leftToTransfer);
     }
 
+    if(retCode == NO_ERROR && isCompressed && !decoder.IsDone())
+    {
+        retCode = CORRUPTED_DATA;
+        LOG_ERROR("Truncated compressed image.\n");
+    }
+
     delete[] pBuffer;
+    pStore_->Lock();
     file.close();
+    pStore_->Unlock();
 
     rResponse.header.errorCode = retCode;
     rResponse.header.size = 0;
 }
 
-void EInkDisplayManager::SendImageList(SCommandResponse& rResponse) const
+bool EInkDisplayManager::BeginRefresh(void)
+{
+    if(!eInkDriver_.BeginRefresh())
+    {
+        eInkDriver_.Sleep();
+        return false;
+    }
+    return true;
+}
+
+bool EInkDisplayManager::IsRefreshDone(void) const
 {
-    size_t      bufferOffset;
-    ssize_t     sentBytes;
-    uint8_t*    pBuffer;
-    size_t      imageIndex;
-    size_t      fileCount;
-    EErrorCode  retCode;
+    return eInkDriver_.IsRefreshDone();
+}
 
-    std::vector<std::string> imageList;
+bool EInkDisplayManager::WaitRefresh(const uint32_t kTimeout)
+{
+    bool status;
+
+    status = eInkDriver_.WaitRefresh(kTimeout);
+    eInkDriver_.Sleep();
+
+    return status;
+}
+
+void EInkDisplayManager::SendImageList(SCommandResponse& rResponse) const
+{
+    size_t             bufferOffset;
+    size_t             nameLength;
+    ssize_t            sentBytes;
+    uint8_t*           pBuffer;
+    size_t             imageIndex;
+    size_t             fileCount;
+    EErrorCode         retCode;
+    SImageCatalogEntry entry;
 
     /* Get the number of files */
-    fileCount = pStore_->GetFilesCount(IMAGE_DIR_PATH);
+    fileCount = pCatalog_->GetCount();
     if(fileCount == 0)
     {
         memset(rResponse.pResponse, 0, sizeof(size_t));
@@ -535,49 +854,41 @@ void EInkDisplayManager::SendImageList(SCommandResponse& rResponse) const
     memcpy(rResponse.pResponse, &fileCount, sizeof(size_t));
     pBtMgr_->SendCommandResponse(rResponse);
 
-    /* Update the image list, send by chunks */
+    /* Update the image list, send by chunks. The announced count is sent
+     * even if the catalog changed since.
+     */
     retCode = NO_ERROR;
     bufferOffset = 0;
-    while(fileCount != 0)
+    for(imageIndex = 0; imageIndex < fileCount; ++imageIndex)
     {
-        imageList.clear();
-
-        /* Get chunk of 200 images */
-        pStore_->GetFilesListFrom(IMAGE_DIR_PATH, imageList, "", 0, 200);
+        if(!pCatalog_->GetEntry(imageIndex, entry))
+        {
+            retCode = ACTION_FAILED;
+            LOG_ERROR("Error while listing images.\n");
+            break;
+        }
+        nameLength = strlen(entry.pName);
 
-        for(imageIndex = 0; imageIndex < imageList.size(); ++imageIndex)
+        /* Check if we should send */
+        if(bufferOffset + nameLength + 1 > INTERNAL_BUFFER_SIZE)
         {
-            /* Check if we should send */
-            if(bufferOffset + imageList[imageIndex].size() + 1 >
-               INTERNAL_BUFFER_SIZE)
+            sentBytes = pBtMgr_->SendData(
+                pBuffer,
+                bufferOffset,
+                IMAGE_READ_TIMEOUT
+            );
+            if(sentBytes != bufferOffset)
             {
-                sentBytes = pBtMgr_->SendData(
-                    pBuffer,
-                    bufferOffset,
-                    IMAGE_READ_TIMEOUT
-                );
-                if(sentBytes != bufferOffset)
-                {
-                    retCode = TRANS_SEND_FAILED;
-                    LOG_ERROR("Error while uploading image.\n");
-                    break;
-                }
-
-                bufferOffset = 0;
+                retCode = TRANS_SEND_FAILED;
+                LOG_ERROR("Error while uploading image.\n");
+                break;
             }
 
-            memcpy(pBuffer + bufferOffset,
-                   imageList[imageIndex].c_str(),
-                   imageList[imageIndex].size() + 1);
-            bufferOffset += imageList[imageIndex].size() + 1;
-
-            --fileCount;
+            bufferOffset = 0;
         }
 
-        if(retCode != NO_ERROR)
-        {
-            break;
-        }
+        memcpy(pBuffer + bufferOffset, entry.pName, nameLength + 1);
+        bufferOffset += nameLength + 1;
     }
 
     /* Send the rest */
@@ -602,4 +913,362 @@ void EInkDisplayManager::SendImageList(SCommandResponse& rResponse) const
 
     rResponse.header.errorCode = retCode;
     rResponse.header.size = 0;
+}
+
+void EInkDisplayManager::SendImagePage(const uint8_t*    pkData,
+                                       SCommandResponse& rResponse) const
+{
+    size_t             i;
+    size_t             dataSize;
+    size_t             nameLength;
+    ssize_t            sentBytes;
+    uint32_t           nextCursor;
+    uint8_t*           pBuffer;
+    SImageRecord       record;
+    SImagePageHeader   pageHeader;
+    SImagePageRequest  request;
+
+    std::vector<SImageCatalogEntry> entries;
+
+    memcpy(&request, pkData, sizeof(SImagePageRequest));
+    if(request.count == 0 || request.count > IMAGE_PAGE_MAX_ENTRIES)
+    {
+        rResponse.header.errorCode = INVALID_PARAM;
+        rResponse.header.size = 0;
+        return;
+    }
+
+    /* The positions moved since a stale cursor, the listing restarts */
+    nextCursor = FILES_CURSOR_END;
+    if(request.cursor != FILES_CURSOR_END &&
+       !pCatalog_->GetPage(request.cursor, request.count, entries, nextCursor))
+    {
+        LOG_ERROR("Invalid image page cursor 0x%x\n", request.cursor);
+        rResponse.header.errorCode = INVALID_PARAM;
+        rResponse.header.size = 0;
+        return;
+    }
+
+    /* Compute the page size, names are bounded by the catalog name size */
+    dataSize = 0;
+    for(i = 0; i < entries.size(); ++i)
+    {
+        nameLength = strlen(entries[i].pName);
+        if((request.flags & IMAGE_PAGE_FLAG_RECORDS) != 0)
+        {
+            dataSize += sizeof(SImageRecord) + nameLength;
+        }
+        else
+        {
+            dataSize += nameLength + 1;
+        }
+    }
+
+    pBuffer = nullptr;
+    if(dataSize != 0)
+    {
+        pBuffer = new uint8_t[dataSize];
+        if(pBuffer == nullptr)
+        {
+            rResponse.header.errorCode = NO_MORE_MEMORY;
+            rResponse.header.size = 0;
+            return;
+        }
+    }
+
+    /* Serialize the page */
+    dataSize = 0;
+    for(i = 0; i < entries.size(); ++i)
+    {
+        nameLength = strlen(entries[i].pName);
+        if((request.flags & IMAGE_PAGE_FLAG_RECORDS) != 0)
+        {
+            record.size       = entries[i].size;
+            record.modifyDate = entries[i].uploadDate;
+            record.modifyTime = entries[i].uploadTime;
+            record.nameLength = nameLength;
+            memcpy(pBuffer + dataSize, &record, sizeof(SImageRecord));
+            dataSize += sizeof(SImageRecord);
+            memcpy(pBuffer + dataSize, entries[i].pName, nameLength);
+            dataSize += nameLength;
+        }
+        else
+        {
+            memcpy(pBuffer + dataSize, entries[i].pName, nameLength);
+            dataSize += nameLength;
+            pBuffer[dataSize++] = 0;
+        }
+    }
+
+    /* Send the ack with the page header */
+    pageHeader.nextCursor = nextCursor;
+    pageHeader.count      = entries.size();
+    pageHeader.size       = dataSize;
+    rResponse.header.errorCode = NO_ERROR;
+    rResponse.header.size = sizeof(SImagePageHeader);
+    memcpy(rResponse.pResponse, &pageHeader, sizeof(SImagePageHeader));
+    pBtMgr_->SendCommandResponse(rResponse);
+
+    /* The size is known, no end of data transmission is needed */
+    rResponse.header.errorCode = NO_ERROR;
+    if(dataSize != 0)
+    {
+        sentBytes = pBtMgr_->SendData(pBuffer, dataSize, IMAGE_READ_TIMEOUT);
+        if(sentBytes != (ssize_t)dataSize)
+        {
+            rResponse.header.errorCode = TRANS_SEND_FAILED;
+            LOG_ERROR("Error while sending image page.\n");
+        }
+        delete[] pBuffer;
+    }
+
+    rResponse.header.size = 0;
+}
+
+bool EInkDisplayManager::DisplayRegions(const SEInkBlitRegion* pkRegions,
+                                        const uint32_t         kRegionCount,
+                                        const uint8_t          kBackground)
+{
+    bool status;
+
+    /* The regions may be backed by files */
+    pStore_->Lock();
+    eInkDriver_.Init();
+    status = eInkDriver_.Blit(pkRegions, kRegionCount, kBackground);
+    pStore_->Unlock();
+
+    if(!status)
+    {
+        eInkDriver_.Sleep();
+        return false;
+    }
+
+    return BeginRefresh() && WaitRefresh(EINK_REFRESH_TIMEOUT);
+}
+
+bool EInkDisplayManager::ReadFileRegion(void*          pContext,
+                                        const uint32_t kRow,
+                                        uint8_t*       pBuffer,
+                                        const uint32_t kSize)
+{
+    SEInkFileRegion* pRegion;
+
+    pRegion = (SEInkFileRegion*)pContext;
+
+    /* Clipped regions do not read whole rows, always seek to the row */
+    if(!pRegion->pFile->seekSet(pRegion->dataOffset + kRow * pRegion->rowSize))
+    {
+        return false;
+    }
+    return pRegion->pFile->read(pBuffer, kSize) == (int)kSize;
+}
+
+void EInkDisplayManager::ImageReaderRoutine(void* pReaderParam)
+{
+    uint64_t      time;
+    SImageChunk   chunk;
+    SImageReader* pReader;
+
+    pReader = (SImageReader*)pReaderParam;
+
+    while(pReader->leftToRead > 0)
+    {
+        /* Wait for the panel to release a buffer */
+        time = HWManager::GetTime();
+        xQueueReceive(pReader->freeQueue, &chunk, portMAX_DELAY);
+        pReader->blockedTime += HWManager::GetTime() - time;
+
+        /* Fill the buffer */
+        time = HWManager::GetTime();
+        chunk.size = pReader->pFile->read(
+            chunk.pBuffer,
+            MIN(pReader->leftToRead, PIPELINE_BUFFER_SIZE)
+        );
+        pReader->readTime += HWManager::GetTime() - time;
+
+        if(chunk.size <= 0)
+        {
+            LOG_ERROR("Failed to read image file.\n");
+            break;
+        }
+
+        pReader->leftToRead -= chunk.size;
+        xQueueSend(pReader->fullQueue, &chunk, portMAX_DELAY);
+    }
+
+    /* Tell the panel side that the reading is done */
+    chunk.pBuffer = nullptr;
+    chunk.size    = 0;
+    xQueueSend(pReader->fullQueue, &chunk, portMAX_DELAY);
+
+    xSemaphoreGive(pReader->doneLock);
+    vTaskDelete(nullptr);
+}
+
+void EInkDisplayManager::SetCurrentImageName(const std::string& rkFilename,
+                                             SCommandResponse&  rResponse)
+{
+    currentImageName_ = rkFilename;
+    if(!pConfig_->SetString(CONFIG_KEY_CURRENT_IMAGE, rkFilename))
+    {
+        LOG_ERROR("Could not save current image name.\n");
+        rResponse.header.errorCode = IMG_NAME_UPDATE_FAIL;
+        rResponse.header.size = 0;
+    }
+    else
+    {
+        rResponse.header.errorCode = NO_ERROR;
+        rResponse.header.size = 0;
+    }
+}
+
+EErrorCode EInkDisplayManager::OpenImage(const std::string& rkFilename,
+                                         FsFile&            rFile,
+                                         uint32_t&          rDataSize,
+                                         bool&              rIsCompressed) const
+{
+    std::string       formatedName;
+    SImageCodecHeader header;
+
+    if(rkFilename.size() == 0)
+    {
+        return FILE_NOT_FOUND;
+    }
+    formatedName = IMAGE_DIR_PATH + std::string("/") + rkFilename;
+
+    /* Check if the image exists */
+    if(pCatalog_->Find(rkFilename) < 0)
+    {
+        return FILE_NOT_FOUND;
+    }
+
+    rFile = pStore_->Open(formatedName, FILE_READ);
+    if(!rFile)
+    {
+        return OPEN_FILE_FAILED;
+    }
+
+    /* Detect the encoding */
+    if(rFile.read(&header, sizeof(header)) == sizeof(header) &&
+       ImageDecoder::IsCompressed(header))
+    {
+        if(!ImageDecoder::IsValid(header, EINK_IMAGE_SIZE))
+        {
+            LOG_ERROR("Invalid compressed image header.\n");
+            rFile.close();
+            return CORRUPTED_DATA;
+        }
+        rIsCompressed = true;
+        rDataSize     = header.dataSize;
+    }
+    else
+    {
+        rIsCompressed = false;
+        rDataSize     = EINK_IMAGE_SIZE;
+        rFile.seekSet(0);
+    }
+
+    return NO_ERROR;
+}
+
+uint32_t EInkDisplayManager::DisplayImageData(const uint8_t* pkData,
+                                              const size_t   kSize,
+                                              ImageDecoder*  pDecoder,
+                                              uint8_t*       pDecodeBuffer)
+{
+    size_t   offset;
+    size_t   consumed;
+    size_t   decoded;
+    uint32_t sent;
+
+    if(pDecoder == nullptr)
+    {
+        eInkDriver_.DisplayPerformTrans(pkData, kSize);
+        return kSize;
+    }
+
+    /* Decode in the small decode buffer and stream to the panel, a pending
+     * repeat run can still produce data once the input is consumed.
+     */
+    sent   = 0;
+    offset = 0;
+    do
+    {
+        decoded = pDecoder->Decode(
+            pkData + offset,
+            kSize - offset,
+            consumed,
+            pDecodeBuffer,
+            IMAGE_DECODE_BUFFER_SIZE
+        );
+        offset += consumed;
+        if(decoded > 0)
+        {
+            eInkDriver_.DisplayPerformTrans(pDecodeBuffer, decoded);
+            sent += decoded;
+        }
+    } while(decoded > 0);
+
+    if(pDecoder->HasError())
+    {
+        LOG_ERROR("Corrupted compressed image.\n");
+    }
+
+    return sent;
+}
+
+EErrorCode EInkDisplayManager::ReceiveImageData(FsFile&            rFile,
+                                                uint8_t*           pBuffer,
+                                                const size_t       kSize,
+                                                uint32_t&          rReplayLeft,
+                                                ResumableTransfer* pTransfer)
+{
+    size_t  offset;
+    ssize_t readBytes;
+
+    /* Replay the data stored before the transfer was suspended */
+    offset = MIN(kSize, rReplayLeft);
+    if(offset > 0)
+    {
+        pStore_->Lock();
+        readBytes = rFile.read(pBuffer, offset);
+        pStore_->Unlock();
+        if(readBytes != (ssize_t)offset)
+        {
+            return READ_FILE_FAILED;
+        }
+        rReplayLeft -= offset;
+    }
+
+    if(offset == kSize)
+    {
+        return NO_ERROR;
+    }
+
+    /* Receive the rest and store it */
+    readBytes = pBtMgr_->ReceiveData(
+        pBuffer + offset,
+        kSize - offset,
+        IMAGE_READ_TIMEOUT
+    );
+    if(readBytes != (ssize_t)(kSize - offset))
+    {
+        return TRANS_RECV_FAILED;
+    }
+
+    /* The storage is only held to store the chunk */
+    pStore_->Lock();
+    if(rFile.write(pBuffer + offset, readBytes) != (size_t)readBytes)
+    {
+        pStore_->Unlock();
+        return WRITE_FILE_FAILED;
+    }
+
+    if(pTransfer != nullptr)
+    {
+        pTransfer->Advance(rFile, readBytes);
+    }
+    pStore_->Unlock();
+
+    return NO_ERROR;
 }
\ No newline at end of file
@@ -27,6 +27,7 @@
 #include <IOButtonMgr.h>      /* Buttons manager */
 #include <SystemState.h>      /* System state manager */
 #include <BlueToothMgr.h>     /* Bluetooth Manager */
+#include <NimBLETransport.h>  /* BLE transport */
 #include <OLEDScreenMgr.h>    /* OLED screem manager */
 #include <WaveshareEInkMgr.h> /* EInk manager */
 #include <DisplayInterface.h> /* Display interface */
@@ -134,7 +135,7 @@ void setup(void)
     /* Initialize the objects */
     pEInkManager->Init();
     LOG_INFO("Initialized the EInk manager.\n");
-    pBlueToothManager->Init(spSystemState);
+    pBlueToothManager->Init(spSystemState, new NimBLETransport());
     LOG_INFO("Initialized the BlueTooth manager.\n");
 
     SCommandResponse response;
@@ -16,6 +16,12 @@ USED_PALETTE = dict([
 
 DYN_PALETTE_TABLE = [0 for i in range(7)]
 
+# Compressed image format (see ImageCodec.h in the firmware)
+COMPRESSED_MAGIC = bytes([0xEC, 0xB1, ord('R'), ord('L')])
+MAX_LITERAL = 128
+MAX_REPEAT = 32768
+MIN_REPEAT = 3
+
 width = 0
 height = 0
 
@@ -66,6 +72,40 @@ def ContructPalette(fileContent, startPalette):
         DYN_PALETTE_TABLE[i] = USED_PALETTE[color]
     return True
 
+def CompressImage(rawData):
+    # Encodes the raw 4bpp image in the badge compressed format
+    output = bytearray()
+    literal = bytearray()
+    i = 0
+
+    def FlushLiteral():
+        while len(literal) > 0:
+            size = min(len(literal), MAX_LITERAL)
+            output.append(size - 1)
+            output.extend(literal[:size])
+            del literal[:size]
+
+    while i < len(rawData):
+        runLength = 1
+        while (i + runLength < len(rawData) and
+               runLength < MAX_REPEAT and
+               rawData[i + runLength] == rawData[i]):
+            runLength += 1
+
+        if runLength >= MIN_REPEAT:
+            FlushLiteral()
+            output.append(0x80 | ((runLength - 1) >> 8))
+            output.append((runLength - 1) & 0xFF)
+            output.append(rawData[i])
+            i += runLength
+        else:
+            literal.append(rawData[i])
+            i += 1
+
+    FlushLiteral()
+
+    return COMPRESSED_MAGIC + struct.pack('<II', len(rawData), len(output)) + output
+
 def ConvertImage(fileContent, startOffset, outputFileName, mode):
     global width
     global height
@@ -99,14 +139,27 @@ def ConvertImage(fileContent, startOffset, outputFileName, mode):
                         #print(bytearray([currValue]))
                     else:
                         currValue = DYN_PALETTE_TABLE[color] << 4
+    elif mode == "z":
+        rawData = bytearray()
+        for i in range(448):
+            for j in range(0, 600, 2):
+                offset = startOffset + (447 - i) * 600 + j
+                rawData.append((DYN_PALETTE_TABLE[fileContent[offset]] << 4) |
+                               DYN_PALETTE_TABLE[fileContent[offset + 1]])
+
+        compressedData = CompressImage(rawData)
+        print("Compressed " + str(len(rawData)) + " to " + str(len(compressedData)) + " bytes")
+        with open(outputFileName, 'wb') as outputFile:
+            outputFile.write(compressedData)
     else:
-        print("Mode shall either be b or c.")
+        print("Mode shall either be b, c or z.")
 
     return True;
 
 if __name__ == "__main__":
     if len(sys.argv) != 3:
         print("Usage: " + sys.argv[0] + " [input_filename] [output_filename] [mode]")
+        print("Modes: c (C array), b (raw binary), z (compressed binary)")
 
     inputFileName = sys.argv[1]
     outputFileName = sys.argv[2]